@@ -37,6 +37,31 @@ ShaderProgram = {
             -- The type of shader.
             shader_type = ShaderType.Fragment
         }
+    },
+    -- The uniforms of the program and how often their values change.
+    -- Constant uniforms are set once after the program has been linked.
+    -- Frame and Material uniform blocks are read from the buffers provided by the engine.
+    -- Material uniforms with a value are set before each draw, only if they have changed.
+    uniforms = {
+        {
+            -- The texture unit of the diffuse sampler.
+            name = "u_texture",
+            frequency = UniformFrequency.Constant,
+            value = 0
+        },
+        {
+            name = "FrameData",
+            frequency = UniformFrequency.Frame
+        },
+        {
+            name = "MaterialData",
+            frequency = UniformFrequency.Material
+        }
+    },
+    -- The options that permutations of the program may define.
+    -- Each permutation is compiled the first time it is requested.
+    permutations = {
+        -- Discards the transparent texels of the texture.
+        "ALPHA_TEST"
     }
-    -- TODO(Ben): Add functions for binding constant uniforms and uniforms per frame.
 }
\ No newline at end of file
@@ -0,0 +1,89 @@
+/*
+* Pegasus Engine
+* 2017 - Benjamin Carter (bencarterdev@outlook.com)
+*
+* This software is provided 'as-is', without any express or implied warranty.
+* In no event will the authors be held liable for any damages arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it freely,
+* subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented;
+*    you must not claim that you wrote the original software.
+*    If you use this software in a product, an acknowledgement
+*    in the product documentation would be appreciated but is not required.
+*
+* 2. Altered source versions must be plainly marked as such,
+*    and must not be misrepresented as being the original software.
+*
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef _PEGASUS_BENCHMARK_HPP_
+#define _PEGASUS_BENCHMARK_HPP_
+
+//====================
+// C++ includes
+//====================
+#include <chrono>   // Timing the benchmarked functions.
+#include <iostream> // Printing the results to the console.
+#include <iomanip>  // Aligning the printed results.
+#include <string>   // The name of each benchmark.
+
+namespace pegasus
+{
+	namespace benchmark
+	{
+		//====================
+		// Functions
+		//====================
+		/**
+		 * @brief Measures the time taken to invoke a function.
+		 *
+		 * The function is invoked the specified amount of times, the total time of all the
+		 * iterations is returned.
+		 *
+		 * @param function   The function to measure.
+		 * @param iterations The amount of times to invoke the function.
+		 *
+		 * @returns The total time taken in milliseconds.
+		 */
+		template <typename Function>
+		double measure(Function&& function, std::size_t iterations = 1)
+		{
+			auto start = std::chrono::steady_clock::now();
+			for (std::size_t i = 0; i < iterations; i++)
+			{
+				function();
+			}
+			auto end = std::chrono::steady_clock::now();
+
+			return std::chrono::duration<double, std::milli>(end - start).count();
+		}
+
+		/**
+		 * @brief Prints the result of a benchmark to the console.
+		 *
+		 * @param name         The name of the benchmark.
+		 * @param milliseconds The total time taken by the benchmark.
+		 * @param iterations   The amount of iterations the time was measured over.
+		 */
+		inline void report(const std::string& name, double milliseconds, std::size_t iterations = 1)
+		{
+			std::cout << std::left << std::setw(56) << name << std::right << std::setw(12) << std::fixed 
+				<< std::setprecision(3) << milliseconds << " ms";
+
+			if (iterations > 1)
+			{
+				std::cout << std::setw(12) << (milliseconds * 1000.0) / iterations << " us/op";
+			}
+
+			std::cout << std::endl;
+		}
+
+	} // namespace benchmark
+
+} // namespace pegasus
+
+#endif//_PEGASUS_BENCHMARK_HPP_
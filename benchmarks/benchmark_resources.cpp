@@ -0,0 +1,240 @@
+/*
+* Pegasus Engine
+* 2017 - Benjamin Carter (bencarterdev@outlook.com)
+*
+* This software is provided 'as-is', without any express or implied warranty.
+* In no event will the authors be held liable for any damages arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it freely,
+* subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented;
+*    you must not claim that you wrote the original software.
+*    If you use this software in a product, an acknowledgement
+*    in the product documentation would be appreciated but is not required.
+*
+* 2. Altered source versions must be plainly marked as such,
+*    and must not be misrepresented as being the original software.
+*
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+//====================
+// C++ includes
+//====================
+#include <algorithm> // Clamping the amount of instances.
+#include <cstdlib>   // Macros for exit failure or success.
+#include <cstdio>    // Removing the generated catalog files.
+#include <fstream>   // Writing the generated catalog.
+#include <random>    // Requesting random resources from the catalog.
+#include <string>    // Generating resource names.
+#include <thread>    // Running independent instances concurrently.
+#include <vector>    // Grouping the generated resources into shards.
+
+//====================
+// Pegasus includes
+//====================
+#include <pegasus/core/resources.hpp>                     // The manifest being benchmarked.
+#include <pegasus/utilities/xml_serializable_service.hpp> // De-serializing the generated catalog.
+
+//====================
+// Benchmark includes
+//====================
+#include "benchmark.hpp" // Timing and reporting the results.
+
+using namespace pegasus;
+
+//====================
+// Constant variables
+//====================
+/** The amount of resources within the generated catalog. */
+const std::size_t ENTRY_COUNT = 1000000;
+/** The amount of shards the catalog is split into. */
+const std::size_t SHARD_COUNT = 1024;
+/** The amount of random resources requested from the catalog. */
+const std::size_t REQUEST_COUNT = 10000;
+/** The file location of the generated catalog. */
+const std::string CATALOG_FILE = "benchmark_catalog.xml";
+/** The file location of the directory of the sharded catalog. */
+const std::string DIRECTORY_FILE = "benchmark_directory.xml";
+
+//====================
+// Functions
+//====================
+/**********************************************************/
+std::string getName(std::size_t index)
+{
+	return "asset.texture.generated_" + std::to_string(index);
+}
+
+/**********************************************************/
+void writeCatalog(const std::string& filename, const std::vector<std::size_t>& entries)
+{
+	std::ofstream file(filename, std::ios::out | std::ios::trunc);
+	file << "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n<Resources>\n";
+	for (std::size_t index : entries)
+	{
+		file << "\t<Resource>\n"
+			 << "\t\t<Name>" << getName(index) << "</Name>\n"
+			 << "\t\t<Source>assets/textures/generated_" << index << ".xml</Source>\n"
+			 << "\t\t<AssetType>Texture</AssetType>\n"
+			 << "\t</Resource>\n";
+	}
+	file << "</Resources>\n";
+}
+
+/**********************************************************/
+void writeDirectory(const std::string& filename, const std::unordered_map<std::string, Resource_t>& directory)
+{
+	std::ofstream file(filename, std::ios::out | std::ios::trunc);
+	file << "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n<Resources>\n";
+	for (auto& entry : directory)
+	{
+		file << "\t<Resource>\n"
+			 << "\t\t<Name>" << entry.first << "</Name>\n"
+			 << "\t\t<Source>" << entry.second.path << "</Source>\n"
+			 << "\t\t<AssetType>Directory</AssetType>\n"
+			 << "\t</Resource>\n";
+	}
+	file << "</Resources>\n";
+}
+
+/**********************************************************/
+void generateCatalog()
+{
+	std::vector<std::size_t> all(ENTRY_COUNT);
+	std::vector<std::string> names(ENTRY_COUNT);
+	std::vector<std::vector<std::size_t>> shards(SHARD_COUNT);
+	for (std::size_t i = 0; i < ENTRY_COUNT; i++)
+	{
+		all[i] = i;
+		names[i] = getName(i);
+		shards[Resources::getShardIndex(names[i], SHARD_COUNT)].push_back(i);
+	}
+
+	// The monolithic catalog, used as the baseline.
+	writeCatalog(CATALOG_FILE, all);
+	// The same catalog split into shards, with a directory of the shards holding each namespace.
+	writeDirectory(DIRECTORY_FILE, Resources::getDirectory(names, SHARD_COUNT));
+	for (std::size_t i = 0; i < SHARD_COUNT; i++)
+	{
+		writeCatalog(Resources::getShardFilename(DIRECTORY_FILE, i), shards[i]);
+	}
+}
+
+/**********************************************************/
+void removeCatalog()
+{
+	std::remove(CATALOG_FILE.c_str());
+	std::remove(DIRECTORY_FILE.c_str());
+	for (std::size_t i = 0; i < SHARD_COUNT; i++)
+	{
+		std::remove(Resources::getShardFilename(DIRECTORY_FILE, i).c_str());
+	}
+}
+
+/**********************************************************/
+int main(int argc, char** argv)
+{
+	std::cout << "Generating a catalog of " << ENTRY_COUNT << " resources in " << SHARD_COUNT << " shards..." << std::endl;
+	generateCatalog();
+
+	XmlSerializableService service;
+	Resources resources;
+	resources.setService(service);
+
+	// Random names to request, identical for each mode.
+	std::mt19937 generator(42);
+	std::uniform_int_distribution<std::size_t> distribution(0, ENTRY_COUNT - 1);
+	std::vector<std::string> requests;
+	for (std::size_t i = 0; i < REQUEST_COUNT; i++)
+	{
+		requests.push_back(getName(distribution(generator)));
+	}
+
+	// Baseline, the entire catalog is de-serialized before anything can be requested.
+	resources.setShardCount(0);
+	benchmark::report("Resources: eager load (1M entries)", benchmark::measure([&]() {
+		resources.load(CATALOG_FILE);
+	}));
+	benchmark::report("Resources: eager get", benchmark::measure([&]() {
+		for (const auto& name : requests)
+		{
+			resources.get(name);
+		}
+	}), REQUEST_COUNT);
+	// Only the matching sub-tree of the prefix index is visited, not the entire catalog.
+	benchmark::report("Resources: eager list (1111 of 1M entries)", benchmark::measure([&]() {
+		resources.list("asset.texture.generated_999");
+	}));
+
+	// Sharded, nothing is de-serialized until a resource is requested.
+	resources.setShardCount(SHARD_COUNT);
+	benchmark::report("Resources: sharded load", benchmark::measure([&]() {
+		resources.load(DIRECTORY_FILE);
+	}));
+	benchmark::report("Resources: sharded first get (one shard)", benchmark::measure([&]() {
+		resources.get(requests.front());
+	}));
+	benchmark::report("Resources: sharded random get (cold shards)", benchmark::measure([&]() {
+		for (const auto& name : requests)
+		{
+			resources.get(name);
+		}
+	}), REQUEST_COUNT);
+	benchmark::report("Resources: sharded random get (warm shards)", benchmark::measure([&]() {
+		for (const auto& name : requests)
+		{
+			resources.get(name);
+		}
+	}), REQUEST_COUNT);
+
+	// Sharded with the requested shards prefetched on worker threads.
+	resources.load(DIRECTORY_FILE);
+	benchmark::report("Resources: sharded prefetch (worker threads)", benchmark::measure([&]() {
+		for (const auto& name : requests)
+		{
+			resources.prefetch(name);
+		}
+		resources.wait();
+	}));
+	benchmark::report("Resources: sharded random get (prefetched)", benchmark::measure([&]() {
+		for (const auto& name : requests)
+		{
+			resources.get(name);
+		}
+	}), REQUEST_COUNT);
+
+	// Independent instances, each with its own manifest, running on their own threads. The
+	// time per request should stay constant as instances are added, up to the amount of cores.
+	std::size_t cores = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+	for (std::size_t instances = 1; instances <= cores; instances *= 2)
+	{
+		benchmark::report("Resources: " + std::to_string(instances) + " instances, sharded get", benchmark::measure([&]() {
+			std::vector<std::thread> threads;
+			for (std::size_t i = 0; i < instances; i++)
+			{
+				threads.emplace_back([&]() {
+					XmlSerializableService instanceService;
+					Resources instance;
+					instance.setService(instanceService);
+					instance.setShardCount(SHARD_COUNT);
+					instance.load(DIRECTORY_FILE);
+					for (const auto& name : requests)
+					{
+						instance.get(name);
+					}
+				});
+			}
+
+			for (auto& thread : threads)
+			{
+				thread.join();
+			}
+		}), REQUEST_COUNT * instances);
+	}
+
+	removeCatalog();
+	return EXIT_SUCCESS;
+}
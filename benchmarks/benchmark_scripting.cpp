@@ -0,0 +1,183 @@
+/*
+* Pegasus Engine
+* 2017 - Benjamin Carter (bencarterdev@outlook.com)
+*
+* This software is provided 'as-is', without any express or implied warranty.
+* In no event will the authors be held liable for any damages arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it freely,
+* subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented;
+*    you must not claim that you wrote the original software.
+*    If you use this software in a product, an acknowledgement
+*    in the product documentation would be appreciated but is not required.
+*
+* 2. Altered source versions must be plainly marked as such,
+*    and must not be misrepresented as being the original software.
+*
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+//====================
+// C++ includes
+//====================
+#include <cstdlib> // Macros for exit failure or success.
+#include <vector>  // The engine-owned array of transforms.
+
+//====================
+// Pegasus includes
+//====================
+#include <pegasus/scripting/scripting_manager.hpp> // Creating the lua state, exposing the arrays and the script buffers.
+
+//====================
+// Benchmark includes
+//====================
+#include "benchmark.hpp" // Timing and reporting the results.
+
+using namespace pegasus;
+
+//====================
+// Structures
+//====================
+/**
+ * @brief The transform of a single entity, as laid out by an engine-owned array.
+ */
+struct Transform_t
+{
+	float x;
+	float y;
+	float rotation;
+	float scale;
+};
+
+/**
+ * @brief An object moved by a binding that is called once per object.
+ */
+struct Entity_t
+{
+	float x;
+	float y;
+
+	void setPosition(float newX, float newY)
+	{
+		x = newX;
+		y = newY;
+	}
+};
+
+//====================
+// Constant variables
+//====================
+/** The amount of entities updated by the script each frame. */
+const std::size_t ENTITIES = 10000;
+/** The amount of objects moved by the script each frame. */
+const std::size_t OBJECTS = 50000;
+/** The amount of frames each access path is measured over. */
+const std::size_t FRAMES = 100;
+/** The C declaration of Transform_t, given to the FFI. */
+const char* TRANSFORM_DECLARATION = "typedef struct { float x, y, rotation, scale; } Transform;";
+/** Moves every entity, the same script is used by both access paths. */
+const char* UPDATE_SCRIPT =
+	"function update(dt)\n"
+	"	local transforms = arrays.transforms\n"
+	"	local data = transforms.data\n"
+	"	for i = 0, transforms.count - 1 do\n"
+	"		local transform = data[i]\n"
+	"		transform.x = transform.x + dt\n"
+	"		transform.y = transform.y - dt\n"
+	"		transform.rotation = transform.rotation + transform.scale * dt\n"
+	"	end\n"
+	"end\n";
+/** Moves every object, once with a call per object and once with a single batched call. */
+const char* MOVE_SCRIPT =
+	"function move_each(entities, dt)\n"
+	"	for i = 1, #entities do\n"
+	"		local entity = entities[i]\n"
+	"		entity:setPosition(entity.x + dt, entity.y + dt)\n"
+	"	end\n"
+	"end\n"
+	"function move_batched(positions, velocities, dt)\n"
+	"	positions:add(velocities, dt)\n"
+	"end\n";
+
+//====================
+// Functions
+//====================
+/**********************************************************/
+void run(const std::string& name, sol::state& state)
+{
+	sol::protected_function update = state["update"];
+	benchmark::report(name, benchmark::measure([&]() {
+		update(1.0f / 60.0f);
+	}, FRAMES), FRAMES * ENTITIES);
+}
+
+/**********************************************************/
+int main(int argc, char** argv)
+{
+	ScriptingManager scripting;
+	sol::state& state = scripting.getState();
+	LuaDataArrays& arrays = scripting.getArrays();
+	std::vector<Transform_t> transforms(ENTITIES, Transform_t{ 0.0f, 0.0f, 0.0f, 1.0f });
+
+	// The sol2 path pushes a usertype reference for each element, and calls a property for each field.
+	state.new_usertype<Transform_t>("Transform",
+		"x", &Transform_t::x,
+		"y", &Transform_t::y,
+		"rotation", &Transform_t::rotation,
+		"scale", &Transform_t::scale);
+	state.script(UPDATE_SCRIPT);
+
+	arrays.setFFIEnabled(false);
+	arrays.expose("transforms", "Transform", transforms.data(), transforms.size());
+	run("Lua: transform update through sol2 (per entity)", state);
+
+	// The FFI path reads and writes the array directly, and is compiled by the JIT.
+	if (LuaDataArrays::isFFIAvailable())
+	{
+		arrays.setFFIEnabled(true);
+		arrays.declare(TRANSFORM_DECLARATION);
+		arrays.expose("transforms", "Transform", transforms.data(), transforms.size());
+		run("Lua: transform update through the FFI (per entity)", state);
+	}
+	else
+	{
+		benchmark::report("Lua: transform update through the FFI (requires PEGASUS_LUAJIT)", 0.0);
+	}
+
+	arrays.remove("transforms");
+
+	// Moving objects through a per-object binding, compared against a single call on packed buffers.
+	state.new_usertype<Entity_t>("Entity",
+		"x", &Entity_t::x,
+		"y", &Entity_t::y,
+		"setPosition", &Entity_t::setPosition);
+	state.script(MOVE_SCRIPT);
+	{
+		std::vector<Entity_t> entities(OBJECTS, Entity_t{ 0.0f, 0.0f });
+		sol::table list = state.create_table(static_cast<int>(OBJECTS), 0);
+		for (std::size_t i = 0; i < OBJECTS; i++)
+		{
+			list[i + 1] = &entities[i];
+		}
+
+		sol::protected_function move = state["move_each"];
+		benchmark::report("Lua: object move through setPosition (per object)", benchmark::measure([&]() {
+			move(list, 1.0f / 60.0f);
+		}, FRAMES), FRAMES * OBJECTS);
+	}
+	{
+		ScriptBuffer positions(OBJECTS, 2);
+		ScriptBuffer velocities(OBJECTS, 2);
+		velocities.fill(1.0f);
+
+		sol::protected_function move = state["move_batched"];
+		benchmark::report("Lua: object move through a ScriptBuffer (per object)", benchmark::measure([&]() {
+			move(&positions, &velocities, 1.0f / 60.0f);
+		}, FRAMES), FRAMES * OBJECTS);
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,210 @@
+/*
+* Pegasus Engine
+* 2017 - Benjamin Carter (bencarterdev@outlook.com)
+*
+* This software is provided 'as-is', without any express or implied warranty.
+* In no event will the authors be held liable for any damages arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it freely,
+* subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented;
+*    you must not claim that you wrote the original software.
+*    If you use this software in a product, an acknowledgement
+*    in the product documentation would be appreciated but is not required.
+*
+* 2. Altered source versions must be plainly marked as such,
+*    and must not be misrepresented as being the original software.
+*
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+//====================
+// C++ includes
+//====================
+#include <cstdio>   // Removing the cooked files.
+#include <cstdlib>  // Macros for exit failure or success.
+#include <fstream>  // Writing the generated asset descriptors.
+#include <iostream> // Reporting the assets that failed to de-serialize.
+#include <memory>   // Owning the de-serialized assets.
+#include <string>   // The generated descriptor file locations.
+#include <vector>   // Storing the generated descriptor file locations.
+
+//====================
+// Pegasus includes
+//====================
+#include <pegasus/core/config_file.hpp>                      // Loading the window settings.
+#include <pegasus/core/window.hpp>                           // Creating the OpenGL context the assets require.
+#include <pegasus/graphics/release_queue.hpp>                // Deleting the OpenGL objects of the de-serialized assets.
+#include <pegasus/scripting/scripting_manager.hpp>           // Creating the lua state.
+#include <pegasus/utilities/logger.hpp>                      // Creating the logger used by the assets.
+#include <pegasus/utilities/file_policy.hpp>                 // Sending the asset messages to an external file.
+#include <pegasus/utilities/logger_factory.hpp>              // Registering the logger.
+#include <pegasus/utilities/json_serializable_service.hpp>   // The json service being benchmarked.
+#include <pegasus/utilities/binary_serializable_service.hpp> // The cooked binary service being benchmarked.
+#include <pegasus/utilities/cooked_asset_writer.hpp>         // Cooking the benchmarked assets.
+#include <pegasus/utilities/file_utils.hpp>                  // Creating the descriptor directory.
+#include <pegasus/utilities/lua_serializable_service.hpp>    // The lua service being benchmarked.
+#include <pegasus/utilities/xml_serializable_service.hpp>    // The xml service being benchmarked.
+
+//====================
+// Benchmark includes
+//====================
+#include "benchmark.hpp" // Timing and reporting the results.
+
+using namespace pegasus;
+
+//====================
+// Constant variables
+//====================
+/** The amount of times each asset is de-serialized. */
+const std::size_t ITERATIONS = 1000;
+/** The amount of asset descriptors parsed when measuring the start-up of the lua service. */
+const std::size_t DESCRIPTORS = 2000;
+
+//====================
+// Functions
+//====================
+/**********************************************************/
+bool run(const std::string& name, const ISerializableService& service, eAssetType type, const std::string& filename)
+{
+	// Timing an asset that fails to de-serialize would only measure how quickly the error is reported.
+	auto asset = service.deserialize(type, filename);
+	if (!asset)
+	{
+		std::cout << name << " failed: " << asset.getError().message << std::endl;
+		return false;
+	}
+	std::unique_ptr<Asset> pFirst(asset.getValue());
+
+	benchmark::report(name, benchmark::measure([&]() {
+		auto result = service.deserialize(type, filename);
+		std::unique_ptr<Asset> pAsset(result ? result.getValue() : nullptr);
+	}, ITERATIONS), ITERATIONS);
+
+	// Delete the released objects outside of the measurement, so they do not accumulate between benchmarks.
+	pFirst.reset();
+	ReleaseQueue::getInstance().finish();
+	return true;
+}
+
+/**********************************************************/
+std::vector<std::string> generateDescriptors(const std::string& directory)
+{
+	FileUtils::createDirectory(directory);
+
+	std::vector<std::string> filenames;
+	for (std::size_t i = 0; i < DESCRIPTORS; i++)
+	{
+		filenames.push_back(directory + "/texture_" + std::to_string(i) + ".lua");
+
+		std::ofstream file(filenames.back(), std::ios::out | std::ios::trunc);
+		file << "Texture = {\n"
+			<< "    name = \"Texture " << i << "\",\n"
+			<< "    texture_type = TextureType.Texture2D,\n"
+			<< "    source = \"data/textures/image.png\",\n"
+			<< "    wrap_mode = WrapType.Clamp,\n"
+			<< "    filter = FilterType.Nearest\n"
+			<< "}\n";
+	}
+
+	return filenames;
+}
+
+/**********************************************************/
+void parseDescriptors(const std::string& name, const LuaSerializableService& service, const std::vector<std::string>& filenames)
+{
+	benchmark::report(name, benchmark::measure([&]() {
+		for (auto& filename : filenames)
+		{
+			service.parseTexture(filename);
+		}
+	}), filenames.size());
+}
+
+/**********************************************************/
+int main(int argc, char** argv)
+{
+	// The scripting state should be first object to be instantiated.
+	ScriptingManager scripting;
+	LoggerFactory::registerLogger("file.logger", std::make_unique<Logger>(std::make_unique<FilePolicy>("benchmark.log")));
+
+	// The assets create OpenGL objects, so a context is required.
+	ConfigFile config;
+	config.open("config.pegasus");
+	Window window;
+	window.create(config);
+
+	LuaSerializableService lua(scripting);
+	XmlSerializableService xml;
+	JsonSerializableService json;
+	BinarySerializableService binary;
+
+	// Cook the same assets that the other formats describe.
+	TextureDescription_t desc;
+	desc.source = "data/textures/image.png";
+	desc.type = gl::eTextureType::TEXTURE_2D;
+	desc.filtering = gl::eFilterType::NEAREST;
+	desc.wrapping = gl::eWrapType::CLAMP;
+	CookedAssetWriter::save("benchmark_texture.bin", CookedAssetWriter::cookTexture("Basic Texture", desc));
+	CookedAssetWriter::save("benchmark_shader.bin", CookedAssetWriter::cookShaderProgram("basic shader", {
+		{ gl::eShaderType::VERTEX, "data/shaders/basic_vertex.glsl" },
+		{ gl::eShaderType::FRAGMENT, "data/shaders/basic_fragment.glsl" } }));
+	CookedAssetWriter::save("benchmark_resources.bin", CookedAssetWriter::cookResources(lua.deserializeResources("Resources.lua")));
+
+	bool succeeded = true;
+	succeeded &= run("Lua: shader program", lua, eAssetType::SHADER, "assets/shaders/basic_shader.lua");
+	succeeded &= run("Xml: shader program", xml, eAssetType::SHADER, "assets/shaders/basic_shader.xml");
+	succeeded &= run("Json: shader program", json, eAssetType::SHADER, "assets/shaders/basic_shader.json");
+	succeeded &= run("Binary: shader program", binary, eAssetType::SHADER, "benchmark_shader.bin");
+	succeeded &= run("Lua: texture", lua, eAssetType::TEXTURE, "assets/textures/basic_texture.lua");
+	succeeded &= run("Xml: texture", xml, eAssetType::TEXTURE, "assets/textures/basic_texture.xml");
+	succeeded &= run("Json: texture", json, eAssetType::TEXTURE, "assets/textures/basic_texture.json");
+	succeeded &= run("Binary: texture", binary, eAssetType::TEXTURE, "benchmark_texture.bin");
+
+	// The Resources files are parsed without creating any OpenGL objects.
+	benchmark::report("Lua: Resources file", benchmark::measure([&]() {
+		lua.deserializeResources("Resources.lua");
+	}, ITERATIONS), ITERATIONS);
+	benchmark::report("Json: Resources file", benchmark::measure([&]() {
+		json.deserializeResources("Resources.json");
+	}, ITERATIONS), ITERATIONS);
+	benchmark::report("Binary: Resources file", benchmark::measure([&]() {
+		binary.deserializeResources("benchmark_resources.bin");
+	}, ITERATIONS), ITERATIONS);
+
+	// Parsing thousands of descriptors at start-up, with and without the bytecode cache. The disk cache is
+	// kept between runs of the benchmark, so only the first run measures the cost of compiling and caching.
+	std::vector<std::string> descriptors = generateDescriptors("benchmark_descriptors");
+	{
+		scripting.getBytecodeCache().setEnabled(false);
+		parseDescriptors("Lua: descriptors compiled from source", lua, descriptors);
+
+		scripting.getBytecodeCache().setEnabled(true);
+		scripting.getBytecodeCache().setDirectory("benchmark_lua_cache");
+		parseDescriptors("Lua: descriptors compiled and cached", lua, descriptors);
+		parseDescriptors("Lua: descriptors from the memory cache", lua, descriptors);
+	}
+	{
+		// A new scripting manager has an empty memory cache, as on the next run of the engine.
+		ScriptingManager restarted;
+		restarted.getBytecodeCache().setDirectory("benchmark_lua_cache");
+		LuaSerializableService service(restarted);
+		parseDescriptors("Lua: descriptors from the disk cache", service, descriptors);
+	}
+
+	for (auto& descriptor : descriptors)
+	{
+		std::remove(descriptor.c_str());
+	}
+
+	std::remove("benchmark_texture.bin");
+	std::remove("benchmark_shader.bin");
+	std::remove("benchmark_resources.bin");
+
+	// Delete any remaining objects whilst the context still exists.
+	ReleaseQueue::getInstance().finish();
+	config.close();
+	return succeeded ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,48 @@
+# Pegasus Engine
+# 2017 - Benjamin Carter (bencarterdev@outlook.com)
+#
+# This software is provided 'as-is', without any express or implied warranty.
+# In no event will the authors be held liable for any damages arising from the use of this software.
+#
+# Permission is granted to anyone to use this software for any purpose,
+# including commercial applications, and to alter it and redistribute it freely,
+# subject to the following restrictions:
+#
+# 1. The origin of this software must not be misrepresented;
+#    you must not claim that you wrote the original software.
+#    if  you use this software in a product, an acknowledgement
+#    in the product documentation would be appreciated but is not required.
+#
+# 2. Altered source versions must be plainly marked as such,
+#    and must not be misrepresented as being the original software.
+#
+# 3. This notice may not be removed or altered from any source distribution.
+
+
+################################################################################
+# Find LuaJIT
+
+# LuaJIT search paths.
+set(LUAJIT_SEARCH_PATHS ~/Library/Frameworks
+                        /Library/Frameworks
+                        /usr/local
+                        /usr
+                        /sw # Fink
+                        /opt/local # DarwinPorts
+                        /opt/csw # Blastwave
+                        /opt)
+
+# Find the path to the include files.
+find_path(LUAJIT_INCLUDE_DIR NAMES luajit.h
+                             HINTS $ENV{LUAJITDIR}
+                             PATH_SUFFIXES include/luajit-2.1 include/luajit-2.0 include
+                             PATHS ${LUAJIT_SEARCH_PATHS})
+
+# Find the luajit libraries.
+find_library(LUAJIT_LIBRARY NAMES luajit-5.1 luajit lua51
+                            HINTS $ENV{LUAJITDIR}
+                            PATH_SUFFIXES lib lib64 src
+                            PATHS ${LUAJIT_SEARCH_PATHS})
+
+include(FindPackageHandleStandardArgs)
+find_package_handle_standard_args(LuaJIT REQUIRED_VARS LUAJIT_LIBRARY LUAJIT_INCLUDE_DIR)
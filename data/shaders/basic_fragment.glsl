@@ -27,6 +27,11 @@
 //====================
 uniform sampler2D u_texture;
 
+//====================
+// Includes
+//====================
+#include "material_data.glsl"
+
 //====================
 // Interfaces
 //====================
@@ -49,5 +54,13 @@ void main()
 	// Create the diffuse texture and map it to the rendering context.
 	vec4 diffuse_texture = texture2D(u_texture, fs_in.uv_coords);
 	// Set the diffuse colour of the fragment and output it.
-	diffuse_colour = vec4(diffuse_texture.rgb, 1.0);
+	diffuse_colour = vec4(diffuse_texture.rgb * u_tint.rgb, u_tint.a);
+
+#ifdef ALPHA_TEST
+	// Discard the transparent texels, rather than blending them.
+	if (diffuse_texture.a < 0.5)
+	{
+		discard;
+	}
+#endif
 }
\ No newline at end of file
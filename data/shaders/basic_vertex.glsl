@@ -28,6 +28,11 @@
 layout (location = 0) in vec2 position;
 layout (location = 1) in vec2 uv_coords;
 
+//====================
+// Includes
+//====================
+#include "frame_data.glsl"
+
 //====================
 // Interfaces
 //====================
@@ -46,5 +51,5 @@ void main()
 	vs_out.uv_coords = uv_coords;
 	
 	// Set the position of the processing vertex.
-	gl_Position = vec4(position, 0.0, 1.0); 
+	gl_Position = u_view_projection * vec4(position, 0.0, 1.0);
 }
\ No newline at end of file
@@ -26,7 +26,9 @@
 //====================
 // C++ includes
 //====================
-#include <string> // Storing the name of the asset, for debugging purposes.
+#include <atomic>  // Counting references from multiple threads.
+#include <string>  // Storing the name of the asset, for debugging purposes.
+#include <cstddef> // Reporting the memory usage of the asset.
 
 namespace pegasus
 {
@@ -39,6 +41,8 @@ namespace pegasus
         SHADER,
         /** Asset type is a texture. */
         TEXTURE,
+		/** Not an asset, lists the shards holding a namespace of a sharded Resources file. */
+		DIRECTORY,
 		/** Represents an erroneous asset type. */
 		NONE
     };
@@ -53,8 +57,8 @@ namespace pegasus
         unsigned int m_ID;
         /** The name of the asset, primarily used for debugging purposes. */
         std::string  m_name;
-        /** The number of references to the asset object. */
-        unsigned int m_references;
+        /** The number of references to the asset object, assets may be released by loader threads. */
+        std::atomic<unsigned int> m_references;
 
     public:
         //====================
@@ -129,6 +133,17 @@ namespace pegasus
          */
         bool isReferenced() const;
 
+        /**
+         * @brief Retrieves an estimate of the memory owned by the asset.
+         *
+         * The estimate covers the data uploaded to the graphics API, such as the pixels of
+         * a texture, and is used to account for the memory used by each resource namespace.
+         * Assets that own no significant data report zero.
+         *
+         * @returns The estimated memory usage in bytes.
+         */
+        virtual std::size_t getMemoryUsage() const;
+
         //====================
         // Methods
         //====================
@@ -0,0 +1,152 @@
+/*
+* Pegasus Engine
+* 2017 - Benjamin Carter (bencarterdev@outlook.com)
+*
+* This software is provided 'as-is', without any express or implied warranty.
+* In no event will the authors be held liable for any damages arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it freely,
+* subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented;
+*    you must not claim that you wrote the original software.
+*    If you use this software in a product, an acknowledgement
+*    in the product documentation would be appreciated but is not required.
+*
+* 2. Altered source versions must be plainly marked as such,
+*    and must not be misrepresented as being the original software.
+*
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef _PEGASUS_ENGINE_HPP_
+#define _PEGASUS_ENGINE_HPP_
+
+//====================
+// C++ includes
+//====================
+#include <string> // The keys of the serializable services.
+
+//====================
+// Pegasus includes
+//====================
+#include <pegasus/utilities/non_copyable.hpp>          // The engine cannot be copied.
+#include <pegasus/utilities/factory.hpp>               // Storing the serializable services.
+#include <pegasus/utilities/iserializable_service.hpp> // The services owned by the engine.
+#include <pegasus/scripting/scripting_manager.hpp>     // The lua state of the engine.
+#include <pegasus/core/resources.hpp>                  // The manifest of the engine.
+#include <pegasus/core/resource_manager.hpp>           // The asset factories of the engine.
+#include <pegasus/graphics/shader_program_factory.hpp> // The shader program factory and its traits.
+#include <pegasus/graphics/texture_factory.hpp>        // The texture factory and its traits.
+
+namespace pegasus
+{
+	//====================
+	// Forward declarations
+	//====================
+	class ConfigFile;
+
+	/**
+	 * @author Benjamin Carter
+	 *
+	 * @class pegasus::Engine
+	 * @ingroup core
+	 *
+	 * @brief Owns every subsystem that makes up a single instance of the engine.
+	 *
+	 * The Engine owns the scripting manager, the serializable services, the Resources manifest and
+	 * the ResourceManager. None of these subsystems hold any global state, so any number of engines
+	 * can exist within the same process, e.g. one independent simulation per core. Each engine must
+	 * only be used by one thread at a time, but different engines can be used concurrently.
+	 *
+	 * The subsystems are destroyed in the reverse order they are declared. The lua state is closed
+	 * first, so the asset handles held by scripts are released while their factories still exist,
+	 * and the assets are then deleted before the manifest they were created with.
+	 */
+	class Engine final : NonCopyable
+	{
+	private:
+		//====================
+		// Member variables
+		//====================
+		/** The file locations of the resources. */
+		Resources                                  m_resources;
+		/** The asset factories, bound to the resources of this engine. */
+		ResourceManager                            m_resourceManager;
+		/** The lua state used by the lua serializable service, scripts may hold handles to the assets. */
+		ScriptingManager                           m_scripting;
+		/** The serializable services, keyed by their format within the configuration file. */
+		Factory<ISerializableService, std::string> m_services;
+
+	public:
+		//====================
+		// Ctors and dtor
+		//====================
+		/**
+		 * @brief Default constructor for the Engine.
+		 *
+		 * The constructor creates each subsystem and registers the xml, lua, json and binary
+		 * serializable services. The engine cannot load any assets until it has been initialised.
+		 */
+		explicit Engine();
+
+		/**
+		 * @brief Default destructor.
+		 */
+		~Engine() = default;
+
+		//====================
+		// Getters and setters
+		//====================
+		/**
+		 * @brief Retrieves the scripting manager of the engine.
+		 *
+		 * @returns The scripting manager.
+		 */
+		ScriptingManager& getScripting();
+
+		/**
+		 * @brief Retrieves a serializable service registered with the engine.
+		 *
+		 * @param format The key of the service, e.g. "xml" or "binary".
+		 *
+		 * @returns The serializable service.
+		 *
+		 * @throws std::out_of_range If no service has been registered with the key.
+		 */
+		ISerializableService& getService(const std::string& format);
+
+		/**
+		 * @brief Retrieves the Resources manifest of the engine.
+		 *
+		 * @returns The Resources object.
+		 */
+		Resources& getResources();
+
+		/**
+		 * @brief Retrieves the resource manager of the engine.
+		 *
+		 * @returns The resource manager.
+		 */
+		ResourceManager& getResourceManager();
+
+		//====================
+		// Methods
+		//====================
+		/**
+		 * @brief Loads the Resources file and registers the asset factories.
+		 *
+		 * The serialization formats, shard count, factory thresholds and lua settings are read from
+		 * the [Core], [Serialization], [Resources] and [Scripting] sections of the configuration file.
+		 *
+		 * @param config The parsed configuration file.
+		 *
+		 * @throws NoResourceException If the Resources file cannot be loaded.
+		 */
+		void initialise(const ConfigFile& config);
+	};
+
+} // namespace pegasus
+
+#endif//_PEGASUS_ENGINE_HPP_
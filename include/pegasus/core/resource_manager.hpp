@@ -26,42 +26,58 @@
 //==================== 
 // C++ includes
 //==================== 
-#include <unordered_map> // Store the factories in a map.
+#include <vector>        // Store the factories in slots indexed by TypeID.
 #include <memory>        // Factories stored as unique pointers.
 #include <type_traits>   // Comparing objects types with static asserts.
 
 //==================== 
 // Pegasus includes
 //====================
-#include <pegasus/utilities/singleton.hpp> // Inherits from the singleton class.
+#include <pegasus/utilities/non_copyable.hpp> // The manager cannot be copied.
 #include <pegasus/utilities/iasset_factory.hpp> // Contains a list of factories.
 #include <pegasus/utilities/exceptions/no_factory_found_exception.hpp> // No factory found.
 #include <pegasus/core/resource_handle.hpp> // Returning handles to different resources.
 
 namespace pegasus
 {
-    class ResourceManager final : public Singleton<ResourceManager>
+    class ResourceManager final : NonCopyable
     {
-		friend class Singleton<ResourceManager>;
-
     private:
-        /** A map of all registered asset factories within the manager. */
-        std::unordered_map<std::type_index, std::unique_ptr<IAssetFactory>>m_factories;
+        /** The registered asset factories, indexed by the TypeID of the asset they create. Unused slots are null. */
+        std::vector<std::unique_ptr<IAssetFactory>> m_factories;
+        /** The Resources object that factories created by the manager are bound to. */
+        Resources& m_resources;
 
     private:
+        //==================== 
+        // Private methods
+        //==================== 
+        /**
+         * @brief Stores a factory within the slot of the asset type it creates.
+         *
+         * @param factory The factory to store.
+         * @param slot    The TypeID of the asset type the factory creates.
+         *
+         * @throws std::runtime_error If the factory is null, a factory has already been registered
+         * within the slot or the factory is bound to a different TypeID.
+         */
+        void insertFactory(std::unique_ptr<IAssetFactory>&& factory, std::size_t slot);
+
+    public:
         //==================== 
         // Ctors and dtor
         //==================== 
         /**
          * @brief Constructor for the ResourceManager.
          *
-         * The constructor is called when the ResourceManager instance is
-         * registered. It will initialise the map needed to retain all of the
-         * asset factories.
+         * The ResourceManager is owned by an Engine, so every instance of the engine
+         * has its own factories and assets. It will initialise the map needed to retain
+         * all of the asset factories.
+         *
+         * @param resources The Resources object of the owning Engine, it must outlive the manager.
          */
-        explicit ResourceManager();
+        explicit ResourceManager(Resources& resources);
 
-    public:
         /**
          * @brief Default destructor.
          *
@@ -81,6 +97,10 @@ namespace pegasus
          * found, a new resource is either created or pulled from the factories
          * cache and returned to the user. If a factory for the type has not
          * been registed, a NoFactoryFoundException will be thrown.
+         *
+         * The factory is found by indexing its slot with the TypeID of T, and is
+         * called as the concrete AssetFactoryTraits<T>::Factory, so no hashing or
+         * virtual dispatch takes place.
          * 
          * @tparam T The asset to retrieve from the manager.
          * @param name The name of the asset to retrieve.
@@ -103,19 +123,25 @@ namespace pegasus
          * used to construct objects of a specific type when a resource is
          * requested from the manager, depending on the type requested. Only one
          * factory of each type can be registered with the manager, an exception
-         * will be thrown if a duplicate is detected or the factory is null.
+         * will be thrown if a duplicate is detected or the factory is null. The
+         * factory must be the AssetFactoryTraits::Factory of the AssetType it declares,
+         * which is checked at compile-time, so the manager can always call it as its
+         * concrete type.
          *
+         * @tparam T The concrete type of the factory.
          * @param pFactory The factory to register with the manager.
          *
          * @throws std::runtime_error If the factory has already been registered
          * or is equal to nullptr.
          */
-        void registerFactory(std::unique_ptr<IAssetFactory>&& factory);
+        template <typename T>
+        void registerFactory(std::unique_ptr<T>&& factory);
         
         /**
          * @brief Registers a factory with the manager with the factory class type.
          *
-         * When a factory is registered with the ResourceManager, it will be
+         * The factory is constructed with the Resources object of the manager. When a
+         * factory is registered with the ResourceManager, it will be
          * used to construct objects of a specific type when a resource is
          * requested from the manager, depending on the type requested. Only one
          * factory of each type can be registered with the manager, an exception
@@ -128,6 +154,49 @@ namespace pegasus
          */
         template <typename T>
         void registerFactory();
+
+        /**
+         * @brief Loads every asset within a namespace.
+         *
+         * Each registered factory loads the resources of its own type that begin with the
+         * prefix, and retains them until the namespace is unloaded. This is used to stream
+         * in a level or a mod ahead of time, e.g. load("level3.").
+         *
+         * @param prefix The namespace to load.
+         *
+         * @returns The amount of assets that were loaded.
+         */
+        std::size_t load(const std::string& prefix);
+
+        /**
+         * @brief Unloads every asset within a namespace.
+         *
+         * The assets retained by ResourceManager::load are released, and any asset within the
+         * namespace that is no longer referenced is deleted immediately.
+         *
+         * @param prefix The namespace to unload.
+         *
+         * @returns The amount of assets that were deleted.
+         */
+        std::size_t unload(const std::string& prefix);
+
+        /**
+         * @brief Retrieves the memory used by the loaded assets within a namespace.
+         *
+         * @param prefix The namespace to account for. An empty prefix accounts for every loaded asset.
+         *
+         * @returns The estimated memory usage in bytes, across all of the registered factories.
+         */
+        std::size_t getMemoryUsage(const std::string& prefix) const;
+
+        /**
+         * @brief Retries the assets that failed to load from files that have since been modified.
+         *
+         * Each registered factory forgets the failures whose files have changed on disk, so the
+         * next request loads the fixed file instead of returning the default. This should be invoked
+         * when files are expected to have changed, such as when the application regains focus.
+         */
+        void revalidate();
     };
 
     //==================== 
@@ -137,16 +206,18 @@ namespace pegasus
     template <typename T>
     ResourceHandle<T> ResourceManager::get(const std::string& name) const
     {
-        // Search the factories.
-        auto itr = m_factories.find(typeid(T));
+        typedef typename AssetFactoryTraits<T>::Factory Factory;
+
+        // Find the slot of the factory.
+        std::size_t slot = TypeID::get<T>();
         // No factory was found, throw the exception.
-        if (itr == m_factories.end())
+        if (slot >= m_factories.size() || !m_factories[slot])
         {
 			throw NoFactoryFoundException("No factory for object type has been registered");
         }
 
-        // Attempt to load the resource with the factory.
-        return ResourceHandle<T>(static_cast<T*>(itr->second->load(name)));
+        // The concrete factories are final, so the load is called directly and returns a T.
+        return ResourceHandle<T>(static_cast<Factory*>(m_factories[slot].get())->load(name));
     } 
  
     //==================== 
@@ -154,19 +225,20 @@ namespace pegasus
     //====================    
     /**********************************************************/
     template <typename T>
-    void ResourceManager::registerFactory()
+    void ResourceManager::registerFactory(std::unique_ptr<T>&& factory)
     {
         static_assert(std::is_base_of<IAssetFactory, T>::value, "T must be a type of IAssetFactory.");
+        static_assert(std::is_same<typename AssetFactoryTraits<typename T::AssetType>::Factory, T>::value,
+            "T must be the AssetFactoryTraits::Factory of the asset type it creates.");
 
-        auto factory = std::make_unique<T>();
-        auto itr = m_factories.find(factory->getType());
-
-        if (itr != m_factories.end())
-        {
-            // TODO(Ben): Throw an exception.
-        }
+        this->insertFactory(std::move(factory), TypeID::get<typename T::AssetType>());
+    }
 
-        m_factories.insert({ factory->getType(), factory });
+    /**********************************************************/
+    template <typename T>
+    void ResourceManager::registerFactory()
+    {
+        this->registerFactory(std::make_unique<T>(m_resources));
     }
 
 } // namespace pegasus
@@ -29,12 +29,20 @@
 #include <unordered_map> // Stores all of the resources and their locations.
 #include <memory>        // The serializable service is a smart pointer.
 #include <string>        // Stores the key and value of the resources.
+#include <mutex>         // Loading each shard exactly once.
+#include <atomic>        // Flagging shards that have been requested for prefetching.
+#include <future>        // Prefetching shards on worker threads.
+#include <vector>        // Storing the prefetch workers and listed names.
+#include <deque>         // Queueing the shards waiting to be prefetched.
 
 //==================== 
 // Pegasus includes
 //==================== 
 #include <pegasus/core/resource.hpp>                   // A struct representing a single resource.
 #include <pegasus/utilities/iserializable_service.hpp> // De-serializing the resources into a format the engine can use.
+#include <pegasus/utilities/expected.hpp>              // Reporting missing resources without exceptions.
+#include <pegasus/utilities/radix_tree.hpp>            // Indexing the resource names by prefix.
+#include <pegasus/utilities/non_copyable.hpp>          // The Resources object cannot be copied.
 
 namespace pegasus
 {   
@@ -47,25 +55,108 @@ namespace pegasus
      * @brief Loads and stores the file locations for all resources within the
      * pegasus engine.
      *
-     * The Resources class is a static class that is used to store the file
-     * locations of all resources used within the Pegasus Engine. The resources
+     * The Resources class is used to store the file locations of all resources
+     * used within the Pegasus Engine. Each Engine owns its own Resources object,
+     * so independent instances can load different manifests. The resources
      * are defined within the Resources.xml file, which maps a simple name to a
      * more complex file location.
      *
      * This class aids in retrieving resources from the ResourceManager with a
      * simpler naming convention that will not have to rely on hard-coded file
      * directories for caching and retrieval of assets.
+     *
+     * Very large catalogs can be split into shards. When a shard count is set, the
+     * resource name is hashed to select a shard file (Resources.0.lua, Resources.1.lua, ...)
+     * and each shard is only de-serialized the first time one of its names is requested.
+     * Loading the manifest is therefore independent of the size of the catalog, and shards
+     * that are never requested are never read from disk. The Resources file itself becomes a
+     * directory, with an entry of type eAssetType::DIRECTORY for each namespace listing the
+     * shards that hold its names, so a namespace can be listed without loading every shard.
+     *
+     * Resource names are dotted namespaces, e.g. level3.texture.wall. Alongside the hash map
+     * used for single lookups, the names are indexed in a RadixTree so every resource within a
+     * namespace can be listed without scanning the entire catalog.
      */
-    class Resources final
+    class Resources final : NonCopyable
     {
+	public:
+		//==================== 
+		// Constant variables
+		//==================== 
+		/** The most worker threads that prefetch shards at once, any further shards are queued. */
+		static constexpr std::size_t MAX_PREFETCH_THREADS = 4;
+
     private:
+        //==================== 
+        // Structures
+        //==================== 
+        struct Shard_t
+        {
+            /** Ensures the shard is only de-serialized once, regardless of the calling thread. */
+            std::once_flag                              loaded;
+            /** Whether the shard has already been queued for prefetching. */
+            std::atomic<bool>                           requested;
+            /** Whether a requested shard has finished loading, successfully or not. */
+            std::atomic<bool>                           settled;
+            /** Whether the shard has been de-serialized successfully. */
+            std::atomic<bool>                           available;
+            /** The file locations of the resources that hash into this shard. */
+            std::unordered_map<std::string, Resource_t> resources;
+            /** The names of the resources within this shard, indexed by prefix. */
+            RadixTree<const Resource_t*>                index;
+        };
+
         //==================== 
         // Member variables
         //==================== 
         /** Stores all of the file locations of the defined resources.*/
-        static std::unordered_map<std::string, Resource_t> m_resources;
+        std::unordered_map<std::string, Resource_t> m_resources;
+        /** The names of the defined resources, indexed by prefix. */
+        RadixTree<const Resource_t*> m_index;
+		/** The shards holding the names of each namespace, only populated when sharding is enabled. */
+		RadixTree<std::vector<std::size_t>> m_directory;
 		/** The unique serializable service type assigned to de-serialize the Resources file. */
-		static ISerializableService* m_pService;
+		ISerializableService*             m_pService;
+		/** The lazily loaded shards of the manifest, only allocated when sharding is enabled. */
+		std::unique_ptr<Shard_t[]>        m_shards;
+		/** The amount of shards the manifest is split into. Zero disables sharding. */
+		std::size_t                       m_shardCount;
+		/** The file location of the Resources file, used to resolve the shard file names. */
+		std::string                       m_filename;
+		/** Guards the prefetch queue and workers. */
+		std::mutex                        m_mutex;
+		/** The shards that have been prefetched, but not yet picked up by a worker. */
+		std::deque<std::size_t>           m_queue;
+		/** The worker threads that de-serialize the queued shards. */
+		std::vector<std::future<void>>    m_workers;
+		/** The amount of workers still taking shards from the queue. */
+		std::size_t                       m_activeWorkers;
+		/** Incremented each time the Resources file is loaded, so cached lookups can detect a new manifest. */
+		std::atomic<std::size_t>          m_generation;
+
+	private:
+		//==================== 
+		// Private methods
+		//==================== 
+		/**
+		 * @brief De-serializes the specified shard if it has not already been loaded.
+		 *
+		 * The shard is loaded exactly once, any other threads requesting the same shard
+		 * will block until the first load has completed. If the shard fails to load, the
+		 * exception is propagated and the next request will attempt to load it again.
+		 *
+		 * @param index The index of the shard to load.
+		 *
+		 * @returns The loaded shard.
+		 *
+		 * @throws NoResourceException If the shard file cannot be de-serialized.
+		 */
+		Shard_t& loadShard(std::size_t index) const;
+
+		/**
+		 * @brief De-serializes the queued shards on a worker thread, until the queue is empty.
+		 */
+		void prefetchShards();
 
     public:
         //==================== 
@@ -73,13 +164,19 @@ namespace pegasus
         //==================== 
         /**
          * @brief Default constructor.
+         *
+         * The Resources object is empty until a serializable service has been set
+         * and a Resources file has been loaded.
          */
-        explicit Resources() = default;
+        explicit Resources();
 
         /**
-         * @brief Default destructor.
+         * @brief Destructor for the Resources object.
+         *
+         * The destructor blocks until any shards being prefetched on worker threads
+         * have finished loading, as they refer to this object.
          */
-        ~Resources() = default;
+        ~Resources();
 
         //==================== 
         // Getters and setters
@@ -96,21 +193,124 @@ namespace pegasus
 		 */
 		 void setService(ISerializableService& service);
 
+		/**
+		 * @brief Sets the amount of shards the Resources file is split into.
+		 *
+		 * The shard count must match the amount of shard files that were generated for the
+		 * catalog, and takes effect the next time the Resources file is loaded. A shard count
+		 * of zero disables sharding and loads the entire catalog at once.
+		 *
+		 * @param count The amount of shards.
+		 */
+		void setShardCount(std::size_t count);
+
+		/**
+		 * @brief Retrieves the amount of shards the Resources file is split into.
+		 *
+		 * @returns The amount of shards, zero if sharding is disabled.
+		 */
+		std::size_t getShardCount() const;
+
+		/**
+		 * @brief Retrieves the shard that a resource name belongs to.
+		 *
+		 * The index is derived from a stable hash of the name, so tools that generate the
+		 * shard files will produce the same layout as the engine expects.
+		 *
+		 * @param name  The name of the resource.
+		 * @param count The amount of shards. Must be greater than zero.
+		 *
+		 * @returns The index of the shard.
+		 */
+		static std::size_t getShardIndex(const std::string& name, std::size_t count);
+
+		/**
+		 * @brief Retrieves the file location of a single shard.
+		 *
+		 * The index is inserted before the file extension, e.g. Resources.lua becomes
+		 * Resources.3.lua for the fourth shard.
+		 *
+		 * @param filename The file location of the Resources file.
+		 * @param index    The index of the shard.
+		 *
+		 * @returns The file location of the shard.
+		 */
+		static std::string getShardFilename(const std::string& filename, std::size_t index);
+
+		/**
+		 * @brief Builds the directory of a sharded Resources file.
+		 *
+		 * The namespace of a name is everything up to and including its last dot, e.g. level3.texture.wall
+		 * is within level3.texture. Each namespace is listed once, with the shards holding its names stored
+		 * as a space separated list of indices in place of the file location. Tools that generate the shard
+		 * files serialize the directory as the Resources file.
+		 *
+		 * @param names The names of every resource within the catalog.
+		 * @param count The amount of shards. Must be greater than zero.
+		 *
+		 * @returns The directory entries, keyed by namespace.
+		 */
+		static std::unordered_map<std::string, Resource_t> getDirectory(const std::vector<std::string>& names, std::size_t count);
+
+		/**
+		 * @brief Retrieves the generation of the loaded Resources file.
+		 *
+		 * The generation is incremented each time the Resources file is loaded. Any results
+		 * derived from an older generation, such as failed lookups, may no longer be valid.
+		 *
+		 * @returns The generation of the loaded Resources file.
+		 */
+		std::size_t getGeneration() const;
+
+		/**
+		 * @brief Retrieves whether the shard of a resource is still being prefetched.
+		 *
+		 * Unlike get(), this never blocks, so it can be polled each frame until the shard
+		 * is ready. A shard that failed to load is no longer pending.
+		 *
+		 * @param name The name of the resource.
+		 *
+		 * @returns True if the shard has been prefetched and has not finished loading.
+		 */
+		bool isPending(const std::string& name) const;
+
+		/**
+		 * @brief Retrieves whether a shard has been de-serialized.
+		 *
+		 * @param index The index of the shard.
+		 *
+		 * @returns True if sharding is enabled and the shard has been loaded successfully.
+		 */
+		bool isShardLoaded(std::size_t index) const;
+
         /**
          * @brief Retrieves a resource object from the map.
          *
          * When a resource is requested, it will utilitise the loaded
          * Resoures.xxx file and search for the specified name. If the name is
          * found it will return the mapped resource object. If the resource has
-         * not been found, a NoResourceException will be thrown.
+         * not been found, or the shard containing it cannot be loaded, an error
+         * is returned instead.
          *
          * @param name The name of the resource within the Resources.xml file.
          *
-         * @returns The relevant Resource object.
-         * 
-         * @throws NoResourceException If the resource is not found.
+         * @returns The relevant Resource object, or an eErrorCode::NOT_FOUND error.
+         */
+        Expected<const Resource_t*> get(const std::string& name) const;
+
+        /**
+         * @brief Retrieves the names of every resource within a namespace.
+         *
+         * Only the resources beginning with the prefix are visited, so the cost depends on the
+         * size of the namespace rather than the size of the catalog. When sharding is enabled, the
+         * directory is used to find the shards holding the namespace, and only those shards are
+         * loaded. Shards that fail to load are skipped.
+         *
+         * @param prefix The namespace to list, e.g. "level3." or "asset.shader.". An empty prefix lists every resource.
+         *
+         * @returns The names of the resources, in lexicographical order.
          */
-        const Resource_t& get(const std::string& name) const;
+        std::vector<std::string> list(const std::string& prefix) const;
     
         //==================== 
         // Methods
@@ -125,11 +325,37 @@ namespace pegasus
          * development. If the file cannot be found, an exception will be
          * thrown.
          * 
+         * When sharding is enabled, only the directory of namespaces is read by this method.
+         * Each shard is de-serialized the first time a resource within it is requested.
+         *
          * @param filename The file location of the Resources.xml file.
          * 
          * @throws NoResourceException Thrown if the file cannot be found. 
          */
         void load(const std::string& filename);
+
+        /**
+         * @brief Starts loading the shard that contains the specified resource.
+         *
+         * If the bound serializable service supports concurrent de-serialization, the shard
+         * is loaded on a worker thread so that it is ready by the time the resource is requested.
+         * At most MAX_PREFETCH_THREADS workers run at once, the remaining shards are queued and
+         * picked up by the workers in the order they were prefetched. Otherwise the shard is
+         * loaded immediately on the calling thread. Either way a shard that fails to load is
+         * not reported until the resource is requested. This method has no
+         * effect when sharding is disabled or the shard has already been requested.
+         *
+         * @param name The name of the resource that will be requested.
+         */
+        void prefetch(const std::string& name);
+
+        /**
+         * @brief Blocks until all of the prefetched shards have finished loading.
+         *
+         * Any shard that failed to load on a worker thread will be loaded again, and report
+         * its error, the next time one of its resources is requested.
+         */
+        void wait();
     };
 
 } // namespace pegasus
@@ -70,6 +70,8 @@ namespace pegasus
 		glm::vec4     m_background;
 		/** Whether the window is currently running. */
 		bool          m_running;
+		/** Whether the window regained focus during the last poll of events. */
+		bool          m_focusGained;
 
 	public:
 		//====================
@@ -178,6 +180,15 @@ namespace pegasus
 		 */
 		bool isRunning() const;
 
+		/** @brief Retrieves whether the Window regained focus during the last poll.
+		 *
+		 * The flag is reset each time Window::pollEvents is invoked. It is used to
+		 * check for modified files when the user returns from editing them.
+		 *
+		 * @returns True if the Window regained focus since the previous poll.
+		 */
+		bool isFocusGained() const;
+
 		//====================
 		// Methods
 		//====================
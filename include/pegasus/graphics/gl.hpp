@@ -39,7 +39,9 @@ namespace pegasus
         enum class eBufferType
         {
             /** A buffer that will be constructed as a vertex buffer. */
-            VERTEX = GL_ARRAY_BUFFER
+            VERTEX = GL_ARRAY_BUFFER,
+            /** A buffer that holds the values of a uniform block shared between programs. */
+            UNIFORM = GL_UNIFORM_BUFFER
         };
 
         enum class eDrawType
@@ -220,6 +222,21 @@ namespace pegasus
          */
         void linkProgram(GLuint ID);
 
+        /**
+         * @brief Assigns a uniform block of a linked program to a binding point.
+         *
+         * Every program that declares the block reads it from the buffer bound to the binding
+         * point, so the values are uploaded once rather than once per program. Programs that
+         * do not declare the block are left unchanged.
+         *
+         * @param ID      The id of the linked program.
+         * @param pName   The name of the block within the glsl.
+         * @param binding The binding point of the block.
+         *
+         * @returns True if the program declares the block.
+         */
+        bool uniformBlockBinding(GLuint ID, const char* pName, GLuint binding);
+
         /**
          * @brief Generates an ID for a texture object.
          * 
@@ -0,0 +1,300 @@
+/*
+* Pegasus Engine
+* 2017 - Benjamin Carter (bencarterdev@outlook.com)
+*
+* This software is provided 'as-is', without any express or implied warranty.
+* In no event will the authors be held liable for any damages arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it freely,
+* subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented;
+*    you must not claim that you wrote the original software.
+*    If you use this software in a product, an acknowledgement
+*    in the product documentation would be appreciated but is not required.
+*
+* 2. Altered source versions must be plainly marked as such,
+*    and must not be misrepresented as being the original software.
+*
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef _PEGASUS_PROGRAM_BINARY_CACHE_HPP_
+#define _PEGASUS_PROGRAM_BINARY_CACHE_HPP_
+
+//====================
+// C++ includes
+//====================
+#include <cstddef> // The amount of loaded and stored binaries.
+#include <cstdint> // The program keys.
+#include <string>  // The cache directory.
+#include <vector>  // The shaders of a program.
+
+//====================
+// Pegasus includes
+//====================
+#include <pegasus/graphics/gl.hpp>            // OpenGL functions and object IDs.
+#include <pegasus/graphics/shader.hpp>        // Hashing the sources of the shaders.
+#include <pegasus/utilities/non_copyable.hpp> // The cache serves a single context.
+
+namespace pegasus
+{
+	/**
+	 * @author Benjamin Carter
+	 *
+	 * @class pegasus::ProgramBinaryCache
+	 * @ingroup graphics
+	 *
+	 * @brief Persists linked shader programs to disk, so later runs skip compiling and linking glsl.
+	 *
+	 * Once a program has been linked, its driver-specific binary is retrieved with glGetProgramBinary
+	 * and written to the cache directory. The next time a program with the same shaders is compiled,
+	 * the binary is loaded with glProgramBinary instead, which typically takes a fraction of a millisecond
+	 * rather than the tens of milliseconds a full compile and link takes.
+	 *
+	 * Binaries are keyed by a hash of the type and source of every shader, including any defines
+	 * prepended to the source, so editing a shader produces a new binary rather than loading a stale one.
+	 * Each file also records a hash of the vendor, renderer and version strings of the driver and a
+	 * checksum of the binary. A file whose driver or checksum does not match, or that the driver rejects,
+	 * is ignored and the program is compiled from source again, which replaces the file.
+	 *
+	 * Program binaries require OpenGL 4.1 or ARB_get_program_binary, and a driver that supports at least
+	 * one binary format. Without them, the cache is disabled and every program is compiled.
+	 *
+	 * A context is only ever current on one thread, so each thread has its own cache, which queries the
+	 * driver of the context current on that thread and counts the binaries of its programs. The directory
+	 * and whether the cache is enabled are set on each thread that creates a context. Threads may share a
+	 * directory, since every binary is keyed by its driver and replaced as a whole.
+	 */
+	class ProgramBinaryCache final : NonCopyable
+	{
+	public:
+		//====================
+		// Constant variables
+		//====================
+		/** The version of the file format, files of any other version are ignored. */
+		static constexpr std::uint32_t VERSION = 1;
+
+		//====================
+		// Enumerations
+		//====================
+		/**
+		 * @brief The outcome of reading a cached binary.
+		 */
+		enum class eBinaryStatus
+		{
+			/** The binary has not been cached. */
+			MISSING = 0,
+			/** The binary was written by another driver or format version, or has been truncated or corrupted. */
+			INVALID = 1,
+			/** The binary can be passed to the driver. */
+			VALID = 2
+		};
+
+	private:
+		//====================
+		// Structures
+		//====================
+		/**
+		 * @brief The header at the beginning of every cached binary, followed by the binary itself.
+		 */
+		struct Header_t
+		{
+			/** Identifies the file as a program binary, "PGPB". */
+			char          magic[4];
+			/** The version of the file format. */
+			std::uint32_t version;
+			/** The key of the program. */
+			std::uint64_t key;
+			/** The hash of the driver that produced the binary. */
+			std::uint64_t driver;
+			/** The checksum of the binary. */
+			std::uint64_t checksum;
+			/** The driver-specific format of the binary. */
+			std::uint32_t format;
+			/** The size of the binary in bytes. */
+			std::uint32_t length;
+		};
+
+		//====================
+		// Member variables
+		//====================
+		/** The directory the binaries are persisted to, empty if the cache is disabled. */
+		std::string   m_directory;
+		/** Whether programs are loaded through the cache. */
+		bool          m_enabled;
+		/** The hash of the driver strings, computed once the context exists. */
+		std::uint64_t m_driver;
+		/** Whether the driver supports program binaries, computed once the context exists. */
+		bool          m_supported;
+		/** Whether the driver has been queried since the cache was invalidated. */
+		bool          m_queried;
+		/** The amount of programs loaded from a binary. */
+		std::size_t   m_loaded;
+		/** The amount of binaries written to the cache. */
+		std::size_t   m_stored;
+		/** The amount of cached binaries that were stale, corrupt or rejected by the driver. */
+		std::size_t   m_rejected;
+
+	private:
+		//====================
+		// Ctors and dtor
+		//====================
+		/**
+		 * @brief Constructs a disabled cache.
+		 */
+		explicit ProgramBinaryCache();
+
+		//====================
+		// Private methods
+		//====================
+		/**
+		 * @brief Queries the driver strings and binary support of the context, if not already queried.
+		 */
+		void query();
+
+		/**
+		 * @brief Retrieves the location of a binary within the cache directory.
+		 *
+		 * @param key The key of the program.
+		 *
+		 * @returns The file location of the binary.
+		 */
+		std::string getBinaryPath(std::uint64_t key) const;
+
+	public:
+		/**
+		 * @brief Default destructor.
+		 */
+		~ProgramBinaryCache() = default;
+
+		//====================
+		// Getters and setters
+		//====================
+		/**
+		 * @brief Retrieves the cache of the calling thread, created on first use as a disabled cache.
+		 *
+		 * @returns The cache of the context current on the calling thread.
+		 */
+		static ProgramBinaryCache& getInstance();
+
+		/**
+		 * @brief Sets the directory the binaries are persisted to.
+		 *
+		 * The directory is created if it does not exist. An empty directory disables the cache.
+		 *
+		 * @param directory The cache directory.
+		 */
+		void setDirectory(const std::string& directory);
+
+		/**
+		 * @brief Sets whether programs are loaded through the cache.
+		 *
+		 * @param enabled False to compile every program from source.
+		 */
+		void setEnabled(bool enabled);
+
+		/**
+		 * @brief Retrieves whether programs are loaded through the cache.
+		 *
+		 * Must be called once the context has been created.
+		 *
+		 * @returns True if the cache is enabled, has a directory and the driver supports program binaries.
+		 */
+		bool isEnabled();
+
+		/**
+		 * @brief Computes the key of a program from the shaders attached to it.
+		 *
+		 * @param shaders The shaders of the program.
+		 *
+		 * @returns The key of the program, zero if the source of any shader is unknown.
+		 */
+		static std::uint64_t getKey(const std::vector<Shader*>& shaders);
+
+		/**
+		 * @brief Retrieves the amount of programs loaded from a binary.
+		 *
+		 * @returns The amount of cache hits.
+		 */
+		std::size_t getLoadedCount() const;
+
+		/**
+		 * @brief Retrieves the amount of binaries written to the cache.
+		 *
+		 * @returns The amount of cache misses that were stored.
+		 */
+		std::size_t getStoredCount() const;
+
+		/**
+		 * @brief Retrieves the amount of cached binaries that were stale, corrupt or rejected by the driver.
+		 *
+		 * @returns The amount of rejected binaries.
+		 */
+		std::size_t getRejectedCount() const;
+
+		//====================
+		// Methods
+		//====================
+		/**
+		 * @brief Prepares a program that is about to be linked, so its binary can be retrieved.
+		 *
+		 * @param ID The ID of the program.
+		 */
+		void prepare(GLuint ID);
+
+		/**
+		 * @brief Loads the cached binary of a program.
+		 *
+		 * @param ID  The ID of the program, which must not have been linked.
+		 * @param key The key of the program.
+		 *
+		 * @returns True if the binary was loaded and the program is linked, false if it must be compiled.
+		 */
+		bool load(GLuint ID, std::uint64_t key);
+
+		/**
+		 * @brief Writes the binary of a linked program to the cache.
+		 *
+		 * @param ID  The ID of the linked program.
+		 * @param key The key of the program.
+		 */
+		void store(GLuint ID, std::uint64_t key);
+
+		/**
+		 * @brief Forgets the queried driver, which must be queried again for a new context.
+		 */
+		void invalidate();
+
+		/**
+		 * @brief Reads a cached binary, validating its header.
+		 *
+		 * @param path   The file location of the binary.
+		 * @param key    The key of the program the binary must belong to.
+		 * @param driver The hash of the driver that must have produced the binary.
+		 * @param format Receives the driver-specific format of the binary.
+		 * @param binary Receives the binary.
+		 *
+		 * @returns Whether the binary was missing, invalid or can be passed to the driver.
+		 */
+		static eBinaryStatus readBinary(const std::string& path, std::uint64_t key, std::uint64_t driver, GLenum& format, std::vector<char>& binary);
+
+		/**
+		 * @brief Writes a binary and its header to the cache, replacing any previous binary.
+		 *
+		 * @param path    The file location of the binary.
+		 * @param key     The key of the program.
+		 * @param driver  The hash of the driver that produced the binary.
+		 * @param format  The driver-specific format of the binary.
+		 * @param pBinary The binary.
+		 * @param length  The size of the binary in bytes.
+		 *
+		 * @returns True if the file was replaced.
+		 */
+		static bool writeBinary(const std::string& path, std::uint64_t key, std::uint64_t driver, GLenum format, const char* pBinary, std::size_t length);
+	};
+
+} // namespace pegasus
+
+#endif//_PEGASUS_PROGRAM_BINARY_CACHE_HPP_
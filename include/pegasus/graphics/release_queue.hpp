@@ -0,0 +1,195 @@
+/*
+* Pegasus Engine
+* 2017 - Benjamin Carter (bencarterdev@outlook.com)
+*
+* This software is provided 'as-is', without any express or implied warranty.
+* In no event will the authors be held liable for any damages arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it freely,
+* subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented;
+*    you must not claim that you wrote the original software.
+*    If you use this software in a product, an acknowledgement
+*    in the product documentation would be appreciated but is not required.
+*
+* 2. Altered source versions must be plainly marked as such,
+*    and must not be misrepresented as being the original software.
+*
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef _PEGASUS_RELEASE_QUEUE_HPP_
+#define _PEGASUS_RELEASE_QUEUE_HPP_
+
+//====================
+// C++ includes
+//====================
+#include <deque>  // Storing the batches waiting for the GPU.
+#include <mutex>  // Releasing objects from any thread.
+#include <vector> // Storing the released object IDs.
+
+//====================
+// Pegasus includes
+//====================
+#include <pegasus/graphics/gl.hpp>         // OpenGL object IDs and fences.
+#include <pegasus/utilities/singleton.hpp> // The queue is a singleton.
+
+namespace pegasus
+{
+	//====================
+	// Enumerations
+	//====================
+	enum class eObjectType
+	{
+		/** The object is a vertex buffer. */
+		BUFFER,
+		/** The object is a linked shader program. */
+		PROGRAM,
+		/** The object is a compiled glsl shader. */
+		SHADER,
+		/** The object is a texture. */
+		TEXTURE
+	};
+
+	/**
+	 * @author Benjamin Carter
+	 *
+	 * @class pegasus::ReleaseQueue
+	 * @ingroup graphics
+	 *
+	 * @brief Defers the destruction of OpenGL objects to a safe point within the frame.
+	 *
+	 * OpenGL objects can only be deleted on the thread that owns the context. Rather than deleting
+	 * their objects directly, the destructors of the graphics classes queue the IDs with ReleaseQueue::release,
+	 * which can be called from any thread. The render thread calls ReleaseQueue::flush once per frame,
+	 * which deletes the queued objects in batches.
+	 *
+	 * When fencing is enabled, each batch is guarded by a fence inserted at the end of the frame it was
+	 * released in, and is only deleted once the GPU has finished that frame. The driver can then reclaim
+	 * the memory straight away, instead of stalling or keeping the objects alive internally.
+	 */
+	class ReleaseQueue final : public Singleton<ReleaseQueue>
+	{
+		friend class Singleton<ReleaseQueue>;
+
+	private:
+		//====================
+		// Structures
+		//====================
+		struct Batch_t
+		{
+			/** Signalled once the GPU has finished the frame the batch was released in. */
+			GLsync              fence;
+			/** The released vertex buffers. */
+			std::vector<GLuint> buffers;
+			/** The released shader programs. */
+			std::vector<GLuint> programs;
+			/** The released glsl shaders. */
+			std::vector<GLuint> shaders;
+			/** The released textures. */
+			std::vector<GLuint> textures;
+		};
+
+		//====================
+		// Member variables
+		//====================
+		/** Guards the objects released since the last flush. */
+		mutable std::mutex  m_mutex;
+		/** The objects released since the last flush. */
+		Batch_t             m_pending;
+		/** The flushed batches whose fences have not yet been signalled. Only used on the render thread. */
+		std::deque<Batch_t> m_batches;
+		/** Whether batches wait for their fence before being deleted. */
+		bool                m_fenced;
+
+	private:
+		//====================
+		// Ctors and dtor
+		//====================
+		/**
+		 * @brief Constructs an empty queue with fencing enabled.
+		 */
+		explicit ReleaseQueue();
+
+		//====================
+		// Private methods
+		//====================
+		/**
+		 * @brief Deletes every object within a batch.
+		 *
+		 * @param batch The batch to delete.
+		 */
+		static void destroy(Batch_t& batch);
+
+	public:
+		/**
+		 * @brief Default destructor.
+		 *
+		 * The queue is destroyed after the OpenGL context, so any objects still queued are
+		 * left for the driver to reclaim. ReleaseQueue::finish should be called before the
+		 * context is destroyed.
+		 */
+		~ReleaseQueue() = default;
+
+		//====================
+		// Getters and setters
+		//====================
+		/**
+		 * @brief Retrieves whether batches wait for their fence before being deleted.
+		 *
+		 * @returns True if fencing is enabled.
+		 */
+		bool isFenced() const;
+
+		/**
+		 * @brief Sets whether batches wait for their fence before being deleted.
+		 *
+		 * Fencing is ignored if the context does not support sync objects, in which case
+		 * each batch is deleted as soon as it is flushed.
+		 *
+		 * @param fenced True to enable fencing.
+		 */
+		void setFenced(bool fenced);
+
+		/**
+		 * @brief Retrieves the amount of objects that have been released but not yet deleted.
+		 *
+		 * @returns The amount of queued objects.
+		 */
+		std::size_t getPendingCount() const;
+
+		//====================
+		// Methods
+		//====================
+		/**
+		 * @brief Queues an OpenGL object for deletion.
+		 *
+		 * This method is thread-safe, and is the only method that may be called from a thread
+		 * other than the render thread. IDs of zero are ignored.
+		 *
+		 * @param type The type of the object.
+		 * @param ID   The ID of the object.
+		 */
+		void release(eObjectType type, GLuint ID);
+
+		/**
+		 * @brief Deletes the released objects that are no longer in use by the GPU.
+		 *
+		 * This method must be called on the render thread, once per frame after the buffers
+		 * have been swapped.
+		 */
+		void flush();
+
+		/**
+		 * @brief Deletes every queued object immediately.
+		 *
+		 * This method must be called on the render thread, and is used before the context is destroyed.
+		 */
+		void finish();
+	};
+
+} // namespace pegasus
+
+#endif//_PEGASUS_RELEASE_QUEUE_HPP_
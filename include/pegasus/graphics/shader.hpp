@@ -23,6 +23,12 @@
 #ifndef _PEGASUS_SHADER_HPP_
 #define _PEGASUS_SHADER_HPP_
 
+//====================
+// C++ includes
+//====================
+#include <cstdint> // The hash of the shader.
+#include <string>  // The source of the shader.
+
 //====================
 // Pegasus includes
 //====================
@@ -48,6 +54,8 @@ namespace pegasus
     	gl::eShaderType m_type;
     	/** Whether the shader has been compiled. */
     	bool            m_compiled;
+		/** The hash of the type and source of the shader. */
+		std::uint64_t   m_key;
 
     public:
     	//====================
@@ -93,6 +101,39 @@ namespace pegasus
          * @returns The compilation state of the shader.
          */
         bool isCompiled() const;
+
+		/**
+		 * @brief Retrieves the source of the shader.
+		 *
+		 * The source is kept once the shader has been compiled, so permutations can be built from it.
+		 *
+		 * @returns The preprocessed glsl source of the shader.
+		 */
+		const std::string& getSource() const;
+
+		/**
+		 * @brief Retrieves the hash of the type and source of the shader.
+		 *
+		 * @returns The key identifying the shader, zero if no source has been loaded.
+		 */
+		std::uint64_t getKey() const;
+
+		/**
+		 * @brief Computes the key of a shader from its type and source.
+		 *
+		 * @param type   The type of the shader.
+		 * @param source The preprocessed glsl source.
+		 *
+		 * @returns The key identifying the shader, zero if the source is empty.
+		 */
+		static std::uint64_t getKey(gl::eShaderType type, const std::string& source);
+
+		/**
+		 * @brief Retrieves the type of the shader.
+		 *
+		 * @returns The stage of the shader within the program.
+		 */
+		gl::eShaderType getType() const;
         
         //====================
         // Methods
@@ -100,10 +141,11 @@ namespace pegasus
         /**
          * @brief Loads a shader from a specified file directory.
          * 
-         * When this method is invoked, it will create a file reader and load in the contents
-         * of the specified file. If the file does not exist or was unable to open, a message 
-         * will be logged to the external log file. If the file opened successfully, the source
-         * of the file is stored until the shader is compiled.
+         * When this method is invoked, it will load in the contents of the specified file
+         * and resolve any #include directives relative to it. If the file or one of its includes
+         * does not exist or was unable to open, a message will be logged to the external log file.
+         * If the file opened successfully, the source of the file is stored, and is kept once the shader has
+         * been compiled so permutations can be built from it.
          * 
          * @param type The type of shader to create.
          * @param filename The file directory of the shader to load.
@@ -129,10 +171,27 @@ namespace pegasus
          * 
          * When this method is invoked, the graphics API will attempt to parse and compile the
          * external shader file. If the shader failed to compile, a warning is logged (with the specified
-         * reason for failure) and the compilation state is set to false. The source is cleared after compilation
-         * is attempted.
+         * reason for failure) and the compilation state is set to false.
          */
         void compile();
+
+		/**
+		 * @brief Submits the shader source to the driver, without waiting for it to compile.
+		 *
+		 * The compilation state is not known until Shader::check is called, which waits for the driver,
+		 * so a shader program should submit every shader and link before checking any of them.
+		 * The source is retained after submission, since permutations and the ShaderCache are built from it.
+		 */
+		void submit();
+
+		/**
+		 * @brief Waits for a submitted shader to compile and retrieves its compilation state.
+		 *
+		 * If the shader failed to compile, a warning is logged with the reason for failure and the shader is deleted.
+		 *
+		 * @returns True if the shader compiled successfully.
+		 */
+		bool check();
     };
 
 } // namespace pegasus
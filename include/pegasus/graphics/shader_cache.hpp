@@ -0,0 +1,181 @@
+/*
+* Pegasus Engine
+* 2017 - Benjamin Carter (bencarterdev@outlook.com)
+*
+* This software is provided 'as-is', without any express or implied warranty.
+* In no event will the authors be held liable for any damages arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it freely,
+* subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented;
+*    you must not claim that you wrote the original software.
+*    If you use this software in a product, an acknowledgement
+*    in the product documentation would be appreciated but is not required.
+*
+* 2. Altered source versions must be plainly marked as such,
+*    and must not be misrepresented as being the original software.
+*
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef _PEGASUS_SHADER_CACHE_HPP_
+#define _PEGASUS_SHADER_CACHE_HPP_
+
+//====================
+// C++ includes
+//====================
+#include <cstddef>       // The reference counts of the shaders.
+#include <cstdint>       // The keys of the shaders.
+#include <string>        // The sources and file locations of the shaders.
+#include <unordered_map> // Looking up the shared shaders.
+
+//====================
+// Pegasus includes
+//====================
+#include <pegasus/graphics/shader.hpp>         // The shared shaders.
+#include <pegasus/utilities/non_copyable.hpp> // The cache serves a single context.
+
+namespace pegasus
+{
+	/**
+	 * @author Benjamin Carter
+	 *
+	 * @class pegasus::ShaderCache
+	 * @ingroup graphics
+	 *
+	 * @brief Shares the shaders that are identical between shader programs.
+	 *
+	 * Shaders are keyed by the hash of their type and preprocessed source, so programs that attach
+	 * the same shader, or permutations that leave a shader unchanged, link against a single shader
+	 * object that is read, stored and compiled once. Each shader is reference counted and deleted
+	 * once the last program referencing it releases it.
+	 *
+	 * Files are read every time they are loaded, since the file or one of its includes may have
+	 * changed, so only the compiled shader is shared.
+	 *
+	 * A shader object belongs to the context it was compiled in, and a context is only ever current on
+	 * one thread, so each thread has its own cache. Programs create their program object when they are
+	 * constructed, so they are always created on the thread that owns their context, and must acquire
+	 * and release their shaders on that thread. Shaders are never shared between two contexts.
+	 */
+	class ShaderCache final : NonCopyable
+	{
+	private:
+		//====================
+		// Structures
+		//====================
+		/**
+		 * @brief A shared shader and the amount of programs referencing it.
+		 */
+		struct Stage_t
+		{
+			/** The shared shader. */
+			Shader      shader;
+			/** The amount of programs referencing the shader. */
+			std::size_t references;
+		};
+
+		//====================
+		// Member variables
+		//====================
+		/** The shared shaders, keyed by the hash of their type and source. */
+		std::unordered_map<std::uint64_t, Stage_t> m_stages;
+		/** The amount of shaders that were shared with another program. */
+		std::size_t                                m_hits;
+		/** The amount of shaders that had to be created. */
+		std::size_t                                m_misses;
+
+	private:
+		//====================
+		// Ctors and dtor
+		//====================
+		/**
+		 * @brief Constructs an empty cache.
+		 */
+		explicit ShaderCache();
+
+		//====================
+		// Private methods
+		//====================
+		/**
+		 * @brief References a shared shader, if it exists.
+		 *
+		 * @param key The key of the shader.
+		 *
+		 * @returns The shader, nullptr if no shader has the key.
+		 */
+		Shader* reference(std::uint64_t key);
+
+	public:
+		/**
+		 * @brief Default destructor.
+		 */
+		~ShaderCache() = default;
+
+		//====================
+		// Getters and setters
+		//====================
+		/**
+		 * @brief Retrieves the cache of the calling thread, created on first use without any shaders.
+		 *
+		 * @returns The cache of the context current on the calling thread.
+		 */
+		static ShaderCache& getInstance();
+
+		/**
+		 * @brief Retrieves the amount of unique shaders that are referenced.
+		 *
+		 * @returns The amount of shared shaders.
+		 */
+		std::size_t getStageCount() const;
+
+		/**
+		 * @brief Retrieves the amount of shaders that were shared with another program.
+		 *
+		 * @returns The amount of cache hits.
+		 */
+		std::size_t getHitCount() const;
+
+		/**
+		 * @brief Retrieves the amount of shaders that had to be created.
+		 *
+		 * @returns The amount of cache misses.
+		 */
+		std::size_t getMissCount() const;
+
+		//====================
+		// Methods
+		//====================
+		/**
+		 * @brief References the shared shader with a source, creating it if necessary.
+		 *
+		 * @param type   The type of the shader.
+		 * @param source The preprocessed glsl source.
+		 *
+		 * @returns The shader, which must be released with ShaderCache::release.
+		 */
+		Shader* acquire(gl::eShaderType type, const std::string& source);
+
+		/**
+		 * @brief Reads a file and references the shared shader with its source, creating it if necessary.
+		 *
+		 * @param type     The type of the shader.
+		 * @param filename The file location of the glsl.
+		 *
+		 * @returns The shader, which must be released with ShaderCache::release, nullptr if the file could not be loaded.
+		 */
+		Shader* load(gl::eShaderType type, const std::string& filename);
+
+		/**
+		 * @brief Releases a reference to a shader, deleting it once it is no longer referenced.
+		 *
+		 * @param pShader The shader returned by ShaderCache::acquire or ShaderCache::load.
+		 */
+		void release(Shader* pShader);
+	};
+
+} // namespace pegasus
+
+#endif//_PEGASUS_SHADER_CACHE_HPP_
@@ -0,0 +1,169 @@
+/*
+* Pegasus Engine
+* 2017 - Benjamin Carter (bencarterdev@outlook.com)
+*
+* This software is provided 'as-is', without any express or implied warranty.
+* In no event will the authors be held liable for any damages arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it freely,
+* subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented;
+*    you must not claim that you wrote the original software.
+*    If you use this software in a product, an acknowledgement
+*    in the product documentation would be appreciated but is not required.
+*
+* 2. Altered source versions must be plainly marked as such,
+*    and must not be misrepresented as being the original software.
+*
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef _PEGASUS_SHADER_COMPILER_HPP_
+#define _PEGASUS_SHADER_COMPILER_HPP_
+
+//====================
+// C++ includes
+//====================
+#include <cstddef> // The amount of pending programs.
+#include <vector>  // Storing the pending programs.
+
+//====================
+// Pegasus includes
+//====================
+#include <pegasus/graphics/gl.hpp>            // Querying parallel compilation support.
+#include <pegasus/utilities/non_copyable.hpp> // The compiler serves a single context.
+
+namespace pegasus
+{
+	//====================
+	// Forward declarations
+	//====================
+	class ShaderProgram;
+
+	/**
+	 * @author Benjamin Carter
+	 *
+	 * @class pegasus::ShaderCompiler
+	 * @ingroup graphics
+	 *
+	 * @brief Compiles batches of shader programs without waiting for the driver.
+	 *
+	 * Querying the compile or link status of a program forces the driver to finish compiling it,
+	 * so compiling programs one at a time serialises every compile. Programs submitted to the
+	 * compiler have their shaders compiled and linked straight away, but their statuses are only
+	 * checked by poll(), once the driver reports that they are complete. Until then, binding a
+	 * program binds the default program instead.
+	 *
+	 * With KHR_parallel_shader_compile or ARB_parallel_shader_compile, the driver compiles on its own
+	 * threads and poll() only finishes the programs that are complete. Without them, poll() finishes
+	 * every pending program, which still lets the driver overlap the whole batch before the first
+	 * status is queried.
+	 *
+	 * A context is only ever current on one thread, so each thread has its own compiler, which only
+	 * holds the programs submitted on that thread and queries the driver of the context current on it.
+	 * Programs must be submitted, polled and deleted on the thread that created them.
+	 */
+	class ShaderCompiler final : NonCopyable
+	{
+	private:
+		//====================
+		// Member variables
+		//====================
+		/** The programs that have been submitted, but not finished. */
+		std::vector<ShaderProgram*> m_pending;
+		/** Whether the driver compiles programs on its own threads, computed once the context exists. */
+		bool                        m_parallel;
+		/** Whether the driver has been queried since the compiler was invalidated. */
+		bool                        m_queried;
+
+	private:
+		//====================
+		// Ctors and dtor
+		//====================
+		/**
+		 * @brief Constructs a compiler without any pending programs.
+		 */
+		explicit ShaderCompiler();
+
+		//====================
+		// Private methods
+		//====================
+		/**
+		 * @brief Queries parallel compilation support and lets the driver use as many threads as it likes.
+		 */
+		void query();
+
+	public:
+		/**
+		 * @brief Default destructor.
+		 */
+		~ShaderCompiler() = default;
+
+		//====================
+		// Getters and setters
+		//====================
+		/**
+		 * @brief Retrieves the compiler of the calling thread, created on first use without any pending programs.
+		 *
+		 * @returns The compiler of the context current on the calling thread.
+		 */
+		static ShaderCompiler& getInstance();
+
+		/**
+		 * @brief Retrieves whether the driver compiles programs on its own threads.
+		 *
+		 * Must be called once the context has been created.
+		 *
+		 * @returns True if KHR_parallel_shader_compile or ARB_parallel_shader_compile is supported.
+		 */
+		bool isParallel();
+
+		/**
+		 * @brief Retrieves the amount of programs that have not been finished.
+		 *
+		 * @returns The amount of pending programs.
+		 */
+		std::size_t getPendingCount() const;
+
+		//====================
+		// Methods
+		//====================
+		/**
+		 * @brief Submits a program to the driver, without waiting for it to compile.
+		 *
+		 * @param program The program to compile, which must outlive its compilation or be cancelled.
+		 */
+		void submit(ShaderProgram& program);
+
+		/**
+		 * @brief Removes a pending program, without finishing it.
+		 *
+		 * @param program The program to remove.
+		 */
+		void cancel(ShaderProgram& program);
+
+		/**
+		 * @brief Finishes the pending programs the driver has completed.
+		 *
+		 * Should be called once per frame whilst programs are pending.
+		 *
+		 * @returns The amount of programs that are still pending.
+		 */
+		std::size_t poll();
+
+		/**
+		 * @brief Finishes every pending program, waiting for the driver if necessary.
+		 */
+		void finish();
+
+		/**
+		 * @brief Forgets the queried driver, which must be queried again for a new context.
+		 */
+		void invalidate();
+	};
+
+} // namespace pegasus
+
+#endif//_PEGASUS_SHADER_COMPILER_HPP_
@@ -0,0 +1,142 @@
+/*
+* Pegasus Engine
+* 2017 - Benjamin Carter (bencarterdev@outlook.com)
+*
+* This software is provided 'as-is', without any express or implied warranty.
+* In no event will the authors be held liable for any damages arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it freely,
+* subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented;
+*    you must not claim that you wrote the original software.
+*    If you use this software in a product, an acknowledgement
+*    in the product documentation would be appreciated but is not required.
+*
+* 2. Altered source versions must be plainly marked as such,
+*    and must not be misrepresented as being the original software.
+*
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef _PEGASUS_SHADER_PREPROCESSOR_HPP_
+#define _PEGASUS_SHADER_PREPROCESSOR_HPP_
+
+//====================
+// C++ includes
+//====================
+#include <cstddef> // The line numbers of the included files.
+#include <string>  // The glsl sources and file locations.
+#include <vector>  // The included files and the injected defines.
+
+//====================
+// Pegasus includes
+//====================
+#include <pegasus/utilities/expected.hpp> // Reporting missing or malformed includes.
+
+namespace pegasus
+{
+	/**
+	 * @author Benjamin Carter
+	 *
+	 * @class pegasus::ShaderPreprocessor
+	 * @ingroup graphics
+	 *
+	 * @brief Resolves the #include directives of a glsl file and injects permutation defines.
+	 *
+	 * An #include "file.glsl" directive is replaced by the contents of the file, located relative
+	 * to the directory of the file that includes it. Each file is included at most once per shader,
+	 * so shared blocks need no include guards and cyclic includes are harmless. #line directives are
+	 * written around each included file, so compile errors report the line within the included file,
+	 * and the source string number of each file is its index within getFiles().
+	 *
+	 * Defines are injected after the #version directive by define(), once the includes have been
+	 * resolved, so the expensive file reads happen once per shader rather than once per permutation.
+	 */
+	class ShaderPreprocessor final
+	{
+	private:
+		//====================
+		// Member variables
+		//====================
+		/** The files included by the last call to process(), in the order they were included. */
+		std::vector<std::string> m_files;
+
+	private:
+		//====================
+		// Private methods
+		//====================
+		/**
+		 * @brief Appends the contents of a file to the output, resolving its includes.
+		 *
+		 * @param filename The file location of the glsl.
+		 * @param output   The preprocessed source.
+		 * @param nested   Whether the file is included by another file, rather than being the shader itself.
+		 *
+		 * @returns The error that prevented the file from being included, eErrorCode::NONE if it was included.
+		 */
+		Error_t include(const std::string& filename, std::string& output, bool nested);
+
+	public:
+		//====================
+		// Ctors and dtor
+		//====================
+		/**
+		 * @brief Default constructor.
+		 */
+		explicit ShaderPreprocessor();
+
+		/**
+		 * @brief Default destructor.
+		 */
+		~ShaderPreprocessor() = default;
+
+		//====================
+		// Getters and setters
+		//====================
+		/**
+		 * @brief Retrieves the files included by the last processed shader.
+		 *
+		 * @returns The file locations, indexed by their glsl source string number.
+		 */
+		const std::vector<std::string>& getFiles() const;
+
+		//====================
+		// Methods
+		//====================
+		/**
+		 * @brief Reads a glsl file and resolves its includes.
+		 *
+		 * @param filename The file location of the shader.
+		 *
+		 * @returns The preprocessed source, or the error if the shader or any of its includes could not be read.
+		 */
+		Expected<std::string> process(const std::string& filename);
+
+		/**
+		 * @brief Injects defines into a preprocessed source, after its #version directive.
+		 *
+		 * Each name is defined as 1, so it can be tested with both #ifdef and #if.
+		 *
+		 * @param source  The preprocessed source.
+		 * @param defines The names to define.
+		 *
+		 * @returns The source with the defines injected, unchanged if there are no defines.
+		 */
+		static std::string define(const std::string& source, const std::vector<std::string>& defines);
+
+		/**
+		 * @brief Retrieves whether a source refers to a name, so defining it can change the shader.
+		 *
+		 * @param source The preprocessed source.
+		 * @param name   The identifier to search for.
+		 *
+		 * @returns True if the name appears as a whole identifier.
+		 */
+		static bool isReferenced(const std::string& source, const std::string& name);
+	};
+
+} // namespace pegasus
+
+#endif//_PEGASUS_SHADER_PREPROCESSOR_HPP_
@@ -26,14 +26,18 @@
 //====================
 // C++ includes
 //====================
-#include <vector> // Storing a list of shaders attached to this program.
+#include <cstdint>       // The masks of the permutation options.
+#include <string>        // The names of the permutation options.
+#include <unordered_map> // Looking up the linked permutations.
+#include <vector>        // Storing a list of shaders attached to this program.
 
 //====================
 // Pegasus includes
 //====================
-#include <pegasus/core/asset.hpp>       // shader program is a type of retained asset.
-#include <pegasus/graphics/shader.hpp>  // Storing different shader objects.
-#include <pegasus/graphics/uniform.hpp> // Binds uniform variables to the shader.
+#include <pegasus/core/asset.hpp>                          // shader program is a type of retained asset.
+#include <pegasus/graphics/shader.hpp>                     // Storing different shader objects.
+#include <pegasus/graphics/shader_program_description.hpp> // The uniforms declared by the asset.
+#include <pegasus/graphics/uniform.hpp>                    // Binds uniform variables to the shader.
 
 namespace pegasus
 {
@@ -44,20 +48,78 @@ namespace pegasus
 
 	class ShaderProgram final : public Asset
 	{
+	public:
+		//====================
+		// Constant variables
+		//====================
+		/** The most permutation options a program may declare, one for each bit of a mask. */
+		static constexpr std::size_t MAX_PERMUTATION_OPTIONS = 32;
+
 	private:
+		//====================
+		// Structures
+		//====================
+		/**
+		 * @brief A uniform set by process() before each draw, resolved once the program has been linked.
+		 */
+		struct UniformBinding_t
+		{
+			/** The handle of the uniform. */
+			UniformHandle_t handle;
+			/** The offset of the encoded value within the plan's values. */
+			std::size_t     offset;
+		};
+
 		//====================
 		// Member variables
 		//====================
 		/** A default representation of a shader. */
-		static ShaderProgram* m_pDefault;
+		static ShaderProgram*             m_pDefault;
 		/** Logging warnings and errors to the external file. */
-		Logger&               m_logger;
-		/** A list of all shaders attached to this program. */
-		std::vector<Shader>   m_shaders;
+		Logger&                           m_logger;
+		/** A list of all shaders attached to this program, shared with other programs through the ShaderCache. */
+		std::vector<Shader*>              m_shaders;
 		/** Used to send variables as uniform values to the glsl shaders. */
-		Uniform               m_uniform;
+		Uniform                           m_uniform;
+		/** The uniforms and uniform blocks declared by the asset. */
+		std::vector<UniformDeclaration_t> m_declarations;
+		/** The per-material uniforms set by process(), in declaration order. */
+		std::vector<UniformBinding_t>     m_plan;
+		/** The encoded values of the per-material uniforms. */
+		std::vector<unsigned char>        m_planValues;
+		/** The permutation options declared by the asset, each selected by the bit at its index. */
+		std::vector<std::string>                          m_options;
+		/** The linked permutations owned by the program, keyed by the hash of their sources. */
+		std::unordered_map<std::uint64_t, ShaderProgram*> m_permutations;
+		/** The permutation selected by each mask that has been requested. */
+		std::unordered_map<std::uint32_t, ShaderProgram*> m_masks;
+		/** The hash of the sources the program was compiled from, zero if they are unknown. */
+		std::uint64_t                                     m_key;
+		/** Whether the program has been submitted to the driver, but its link status has not been checked. */
+		bool                                              m_pending;
 		/** The compilation flag for the compiling and linking of shaders. */
-		bool                  m_compiled;
+		bool                                              m_compiled;
+
+	private:
+		//====================
+		// Private methods
+		//====================
+		/**
+		 * @brief Compiles the declared uniforms into the binding plan of the linked program.
+		 *
+		 * Constant uniforms are uploaded immediately and never again, per-frame and per-material
+		 * uniform blocks are assigned to the binding points of the engine's buffers, and per-material
+		 * uniforms are encoded for process(). Declarations that do not match the program are logged.
+		 */
+		void resolve();
+
+		/**
+		 * @brief Prepares a linked program for drawing.
+		 *
+		 * The active uniforms are reflected, the shared uniform blocks are bound and the
+		 * declared uniforms are compiled into the binding plan.
+		 */
+		void configure();
 
 	public:
 		//====================
@@ -76,7 +138,7 @@ namespace pegasus
 		 * @brief Destructor for the shader program.
 		 * 
 		 * The destructor will destroy the retained program ID and free the memory
-		 * for additional use.
+		 * for additional use, along with every permutation of the program.
 		 */
 		~ShaderProgram();
 
@@ -105,6 +167,61 @@ namespace pegasus
 		 */
 		bool isCompiled() const;
 
+		/**
+		 * @brief Retrieves whether the program has been submitted, but has not been finished.
+		 *
+		 * @returns True if ShaderProgram::finish must still be called.
+		 */
+		bool isPending() const;
+
+		/**
+		 * @brief Retrieves whether the driver has finished compiling and linking a pending program.
+		 *
+		 * Without KHR_parallel_shader_compile or ARB_parallel_shader_compile, the driver cannot be
+		 * asked, and a pending program is always reported as ready.
+		 *
+		 * @returns True if ShaderProgram::finish will not wait for the driver.
+		 */
+		bool isReady() const;
+
+		/**
+		 * @brief Retrieves the uniforms reflected from the program when it was linked.
+		 *
+		 * Handles should be retrieved once after compilation, and reused whenever the
+		 * uniforms are set.
+		 *
+		 * @returns The uniforms of the program.
+		 */
+		Uniform& getUniform();
+
+		/**
+		 * @brief Retrieves the mask that selects a set of permutation options.
+		 *
+		 * @param options The names of the options, names the program has not declared are ignored.
+		 *
+		 * @returns The mask to pass to ShaderProgram::getPermutation.
+		 */
+		std::uint32_t getPermutationMask(const std::vector<std::string>& options) const;
+
+		/**
+		 * @brief Retrieves the permutation of the program compiled with a set of options defined.
+		 *
+		 * Each option selected by the mask is injected as a define into the shaders that refer to it,
+		 * and the permutation is compiled the first time the mask is requested. Permutations whose
+		 * shaders are identical are compiled once and shared, so options that no shader refers to,
+		 * and the empty mask, return the program itself.
+		 *
+		 * Permutations are owned by the program and deleted with it, so the returned pointer is
+		 * only valid while the program is retained. Callers must hold a ResourceHandle to the
+		 * program for as long as they use the permutation, and must not retain the permutation
+		 * itself. Both are asserted in debug builds.
+		 *
+		 * @param mask The options to define, as returned by ShaderProgram::getPermutationMask.
+		 *
+		 * @returns The permutation, which is submitted to the ShaderCompiler and may still be compiling.
+		 */
+		ShaderProgram* getPermutation(std::uint32_t mask);
+
 		//====================
 		// Methods
 		//====================
@@ -112,7 +229,8 @@ namespace pegasus
 		 * @brief Attaches the shader at the specified file directory.
 		 * 
 		 * When a shader is attached in this manner, it is loaded from the specified
-		 * directory. The shader is only attached to the program if it was loaded without
+		 * directory, or shared with any program that has already loaded an identical shader.
+		 * The shader is only attached to the program if it was loaded without
 		 * any errors. The shader is not compiled during this process, an additional call
 		 * to ShaderProgram::compile must be made.
 		 * 
@@ -124,28 +242,69 @@ namespace pegasus
 		/**
 		 * @brief Attaches the shader object to the program.
 		 * 
-		 * When the shader is attached in this manner, the shader object is moved into the
-		 * program, which will now control its life-time. The shader object will be unuseable
-		 * outside the scope of this class.
+		 * When the shader is attached in this manner, the source of the shader object is
+		 * shared through the ShaderCache, and compiled along with the program. The shader
+		 * object itself is not referenced by the program.
 		 *
 		 * @param shader The shader object to attach to the program.  
 		 */
 		void attach(const Shader& shader);
 
+		/**
+		 * @brief Declares a uniform or uniform block of the program and how often its value changes.
+		 *
+		 * The declarations are compiled into the binding plan of the program when it is linked,
+		 * so they must be declared before ShaderProgram::compile.
+		 *
+		 * @param declaration The declaration of the uniform.
+		 */
+		void declare(const UniformDeclaration_t& declaration);
+
+		/**
+		 * @brief Declares an option that permutations of the program may define.
+		 *
+		 * The options are selected by the bit at the index they were declared in, up to
+		 * MAX_PERMUTATION_OPTIONS options. Every permutation also inherits the uniform declarations.
+		 *
+		 * @param option The name of the define within the glsl.
+		 */
+		void declarePermutation(const std::string& option);
+
 		/** @brief Compiles the shader object, ready for use.
 		 *
 		 * This method abstracts the behavior from the Shader objects
 		 * and invokes the subsequent objects compile method. The ShaderProgram
-		 * will only compile if it not already been compiled.
+		 * will only compile if it not already been compiled. Once linked, the
+		 * active uniforms of the program are reflected and the declared uniforms
+		 * are compiled into the binding plan. The method waits for the driver, the
+		 * ShaderCompiler should be used to compile many programs without stalling.
 		 */
 		void compile();
 
+		/**
+		 * @brief Submits the shaders and the link of the program to the driver, without waiting for them.
+		 *
+		 * None of the compile or link statuses are queried, so the driver is free to compile several
+		 * programs at once. The program remains pending until ShaderProgram::finish is called, which
+		 * is best left to the ShaderCompiler. A program loaded from the binary cache is finished immediately.
+		 */
+		void submit();
+
+		/**
+		 * @brief Checks the link status of a submitted program and prepares it for drawing.
+		 *
+		 * This waits for the driver if the program is not ready. If the program failed to link,
+		 * the compile errors of its shaders and the link error are logged.
+		 */
+		void finish();
+
 		/** @brief Processes the uniforms attached to the shader.
 		 *
-		 * When this method is invoked, it will update all of the subsequent
-		 * uniform variables contained within the external shaders and change their
-		 * values. This will also invoke the on_update function contained within the 
-		 * attached shaders, which is used to update uniform variables without re-compilation.
+		 * When this method is invoked, the per-material uniforms of the binding plan
+		 * are set to their declared values. The values are shadowed, so only uniforms
+		 * that have been changed since the last draw reach the driver. Constant and
+		 * per-frame uniforms are never touched. The program is bound through the state
+		 * cache before any changed value is uploaded.
 		 */
 		void process();
 
@@ -154,6 +313,9 @@ namespace pegasus
 		 * When a shader program is bound, any object that is subsequently rendered
 		 * will utilise the behavior defined in the external glsl shaders.
 		 *
+		 * A program that has not finished compiling, or that failed to compile, binds
+		 * the default program instead, so loading never waits on the driver.
+		 *
 		 * @param program The shader program to bind to the context.
 		 */
 		static void bind(const ShaderProgram& program);
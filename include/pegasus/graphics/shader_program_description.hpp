@@ -0,0 +1,86 @@
+/*
+* Pegasus Engine
+* 2017 - Benjamin Carter (bencarterdev@outlook.com)
+*
+* This software is provided 'as-is', without any express or implied warranty.
+* In no event will the authors be held liable for any damages arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it freely,
+* subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented;
+*    you must not claim that you wrote the original software.
+*    If you use this software in a product, an acknowledgement
+*    in the product documentation would be appreciated but is not required.
+*
+* 2. Altered source versions must be plainly marked as such,
+*    and must not be misrepresented as being the original software.
+*
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef _PEGASUS_SHADER_PROGRAM_DESCRIPTION_HPP_
+#define _PEGASUS_SHADER_PROGRAM_DESCRIPTION_HPP_
+
+//====================
+// C++ includes
+//====================
+#include <string>                   // Stores the name of the program and the shader locations.
+#include <utility>                  // Pairing shader types with their sources.
+#include <vector>                   // Stores the attached shaders.
+
+//====================
+// Pegasus includes
+//====================
+#include <pegasus/graphics/gl.hpp>  // The graphics API.
+
+namespace pegasus
+{
+	//====================
+	// Enumerations
+	//====================
+	enum class eUniformFrequency
+	{
+		/** The uniform is set once, after the program has been linked, e.g. the unit of a sampler. */
+		CONSTANT,
+		/** The uniform block is read from the per-frame buffer provided by the engine. */
+		FRAME,
+		/** The uniform block is read from the per-material buffer, or the uniform is set before each draw. */
+		MATERIAL
+	};
+
+	//====================
+	// Structures
+	//====================
+	struct UniformDeclaration_t
+	{
+		//====================
+		// Member variables
+		//====================
+		/** The name of the uniform, or of the uniform block, within the glsl. */
+		std::string        name;
+		/** How often the value of the uniform changes. */
+		eUniformFrequency  frequency;
+		/** The components of the value, in column-major order for matrices. Empty for uniform blocks. */
+		std::vector<float> value;
+	};
+
+	struct ShaderProgramDescription_t
+	{
+		//====================
+		// Member variables
+		//====================
+		/** The debug name of the program. */
+		std::string name;
+		/** The type and file location of each shader within the program. */
+		std::vector<std::pair<gl::eShaderType, std::string>> shaders;
+		/** The uniforms and uniform blocks declared by the asset. */
+		std::vector<UniformDeclaration_t> uniforms;
+		/** The options that permutations of the program may define, in the order of their mask bits. */
+		std::vector<std::string> permutations;
+	};
+
+} // namespace pegasus
+
+#endif//_PEGASUS_SHADER_PROGRAM_DESCRIPTION_HPP_
@@ -0,0 +1,317 @@
+/*
+* Pegasus Engine
+* 2017 - Benjamin Carter (bencarterdev@outlook.com)
+*
+* This software is provided 'as-is', without any express or implied warranty.
+* In no event will the authors be held liable for any damages arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it freely,
+* subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented;
+*    you must not claim that you wrote the original software.
+*    If you use this software in a product, an acknowledgement
+*    in the product documentation would be appreciated but is not required.
+*
+* 2. Altered source versions must be plainly marked as such,
+*    and must not be misrepresented as being the original software.
+*
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef _PEGASUS_STATE_CACHE_HPP_
+#define _PEGASUS_STATE_CACHE_HPP_
+
+//====================
+// C++ includes
+//====================
+#include <array>         // The textures bound to each unit.
+#include <cstddef>       // The amount of issued and skipped calls.
+#include <cstdint>       // The keys of the indexed buffer bindings.
+#include <unordered_map> // The buffers and capabilities keyed by their OpenGL enumeration.
+
+//====================
+// Pegasus includes
+//====================
+#include <pegasus/graphics/gl.hpp>            // OpenGL functions and object IDs.
+#include <pegasus/utilities/non_copyable.hpp> // The cache shadows a single context.
+
+namespace pegasus
+{
+	namespace gl
+	{
+		/**
+		 * @author Benjamin Carter
+		 *
+		 * @class pegasus::gl::StateCache
+		 * @ingroup graphics
+		 *
+		 * @brief Shadows the OpenGL state of the context and skips any redundant state changes.
+		 *
+		 * Every bind and state change of the engine is routed through the cache, which remembers the
+		 * bound program, the textures bound to each unit, the active unit, the buffers bound to each
+		 * target and indexed binding point, the vertex array, the enabled capabilities, the blend and depth functions and the
+		 * clear colour. A call that would set the state to its current value is never passed to the
+		 * driver, so objects can be bound before every draw without paying for it.
+		 *
+		 * Any state that has not been set through the cache is unknown, and the first call that sets it
+		 * always reaches the driver. The cache must be invalidated whenever the context is recreated, or
+		 * after any code changes the state without going through the cache.
+		 *
+		 * A context is only ever current on one thread, so each thread has its own cache, which shadows
+		 * the context current on that thread. A thread that switches between several contexts must
+		 * invalidate its cache after each switch.
+		 */
+		class StateCache final : NonCopyable
+		{
+		public:
+			//====================
+			// Constant variables
+			//====================
+			/** The amount of texture units shadowed by the cache, binds to any further units are always issued. */
+			static constexpr std::size_t MAX_TEXTURE_UNITS = 32;
+			/** Marks an object binding or value that has not been set through the cache. */
+			static constexpr GLuint UNKNOWN = ~0u;
+
+		private:
+			//====================
+			// Structures
+			//====================
+			/**
+			 * @brief The texture bound to a single unit.
+			 */
+			struct TextureBinding_t
+			{
+				/** The target the texture is bound to. */
+				GLenum target;
+				/** The ID of the bound texture. */
+				GLuint ID;
+			};
+
+			//====================
+			// Member variables
+			//====================
+			/** The bound shader program. */
+			GLuint                                             m_program;
+			/** The active texture unit. */
+			GLuint                                             m_activeTexture;
+			/** The texture bound to each unit. */
+			std::array<TextureBinding_t, MAX_TEXTURE_UNITS>    m_textures;
+			/** The buffer bound to each target. */
+			std::unordered_map<GLenum, GLuint>                 m_buffers;
+			/** The buffer bound to each indexed binding point, keyed by the target and the index. */
+			std::unordered_map<std::uint64_t, GLuint>          m_bufferBases;
+			/** The bound vertex array. */
+			GLuint                                             m_vertexArray;
+			/** Whether each capability is enabled. */
+			std::unordered_map<GLenum, bool>                   m_capabilities;
+			/** The source factor of the blend function. */
+			GLenum                                             m_blendSource;
+			/** The destination factor of the blend function. */
+			GLenum                                             m_blendDestination;
+			/** The depth comparison function. */
+			GLenum                                             m_depthFunction;
+			/** Whether the depth buffer is written to, unknown until it has been set. */
+			GLuint                                             m_depthMask;
+			/** The clear colour. */
+			glm::vec4                                          m_clearColour;
+			/** Whether the clear colour has been set through the cache. */
+			bool                                               m_clearColourKnown;
+			/** The amount of calls passed to the driver since the statistics were reset. */
+			std::size_t                                        m_issued;
+			/** The amount of redundant calls skipped since the statistics were reset. */
+			std::size_t                                        m_skipped;
+
+		private:
+			//====================
+			// Ctors and dtor
+			//====================
+			/**
+			 * @brief Constructs a cache where the entire state is unknown.
+			 */
+			explicit StateCache();
+
+			//====================
+			// Private methods
+			//====================
+			/**
+			 * @brief Records whether a call was redundant.
+			 *
+			 * @param redundant Whether the state already has the requested value.
+			 *
+			 * @returns True if the call must be passed to the driver.
+			 */
+			bool record(bool redundant);
+
+		public:
+			/**
+			 * @brief Default destructor.
+			 */
+			~StateCache() = default;
+
+			//====================
+			// Getters and setters
+			//====================
+			/**
+			 * @brief Retrieves the cache of the calling thread, created on first use with the entire state unknown.
+			 *
+			 * @returns The cache of the context current on the calling thread.
+			 */
+			static StateCache& getInstance();
+
+			/**
+			 * @brief Retrieves the amount of calls passed to the driver since the statistics were reset.
+			 *
+			 * @returns The amount of issued calls.
+			 */
+			std::size_t getIssuedCalls() const;
+
+			/**
+			 * @brief Retrieves the amount of redundant calls skipped since the statistics were reset.
+			 *
+			 * @returns The amount of skipped calls.
+			 */
+			std::size_t getSkippedCalls() const;
+
+			/**
+			 * @brief Retrieves the active texture unit.
+			 *
+			 * @returns The index of the unit, starting at zero.
+			 */
+			GLuint getActiveTexture() const;
+
+			//====================
+			// Methods
+			//====================
+			/**
+			 * @brief Binds a shader program, i.e. glUseProgram.
+			 *
+			 * @param ID The ID of the program, zero to unbind.
+			 */
+			void useProgram(GLuint ID);
+
+			/**
+			 * @brief Selects the texture unit that textures are bound to, i.e. glActiveTexture.
+			 *
+			 * @param unit The index of the unit, starting at zero.
+			 */
+			void activeTexture(GLuint unit);
+
+			/**
+			 * @brief Binds a texture to the active texture unit, i.e. glBindTexture.
+			 *
+			 * @param target The target to bind the texture to.
+			 * @param ID     The ID of the texture, zero to unbind.
+			 */
+			void bindTexture(GLenum target, GLuint ID);
+
+			/**
+			 * @brief Binds a buffer to a target, i.e. glBindBuffer.
+			 *
+			 * @param target The target to bind the buffer to.
+			 * @param ID     The ID of the buffer, zero to unbind.
+			 */
+			void bindBuffer(GLenum target, GLuint ID);
+
+			/**
+			 * @brief Binds a buffer to an indexed binding point of a target, i.e. glBindBufferBase.
+			 *
+			 * The buffer is also bound to the target itself, as OpenGL does.
+			 *
+			 * @param target The indexed target, e.g. GL_UNIFORM_BUFFER.
+			 * @param index  The binding point.
+			 * @param ID     The ID of the buffer, zero to unbind.
+			 */
+			void bindBufferBase(GLenum target, GLuint index, GLuint ID);
+
+			/**
+			 * @brief Binds a vertex array, i.e. glBindVertexArray.
+			 *
+			 * Binding a vertex array also changes the element array buffer, so its cached binding is forgotten.
+			 *
+			 * @param ID The ID of the vertex array, zero to unbind.
+			 */
+			void bindVertexArray(GLuint ID);
+
+			/**
+			 * @brief Enables a capability, i.e. glEnable.
+			 *
+			 * @param capability The capability to enable, e.g. GL_BLEND.
+			 */
+			void enable(GLenum capability);
+
+			/**
+			 * @brief Disables a capability, i.e. glDisable.
+			 *
+			 * @param capability The capability to disable, e.g. GL_DEPTH_TEST.
+			 */
+			void disable(GLenum capability);
+
+			/**
+			 * @brief Sets the blend function, i.e. glBlendFunc.
+			 *
+			 * @param source      The factor of the incoming colour.
+			 * @param destination The factor of the colour within the frame buffer.
+			 */
+			void blendFunc(GLenum source, GLenum destination);
+
+			/**
+			 * @brief Sets the depth comparison function, i.e. glDepthFunc.
+			 *
+			 * @param function The comparison, e.g. GL_LESS.
+			 */
+			void depthFunc(GLenum function);
+
+			/**
+			 * @brief Sets whether the depth buffer is written to, i.e. glDepthMask.
+			 *
+			 * @param enabled True to write depth values.
+			 */
+			void depthMask(bool enabled);
+
+			/**
+			 * @brief Sets the colour the frame buffer is cleared to, i.e. glClearColor.
+			 *
+			 * @param colour The clear colour.
+			 */
+			void clearColor(const glm::vec4& colour);
+
+			/**
+			 * @brief Forgets the bindings of deleted buffers, which OpenGL resets to zero.
+			 *
+			 * The IDs of deleted objects are reused, so a later bind of a new object with the
+			 * same ID must not be skipped.
+			 *
+			 * @param pIDs  The IDs of the deleted buffers.
+			 * @param count The amount of IDs.
+			 */
+			void forgetBuffers(const GLuint* pIDs, std::size_t count);
+
+			/**
+			 * @brief Forgets the bindings of deleted textures, which OpenGL resets to zero.
+			 *
+			 * @param pIDs  The IDs of the deleted textures.
+			 * @param count The amount of IDs.
+			 */
+			void forgetTextures(const GLuint* pIDs, std::size_t count);
+
+			/**
+			 * @brief Marks the entire state as unknown, so the next call for each state reaches the driver.
+			 *
+			 * This must be called when the context is created, or after the state has been changed
+			 * without going through the cache.
+			 */
+			void invalidate();
+
+			/**
+			 * @brief Resets the amount of issued and skipped calls.
+			 */
+			void resetStatistics();
+		};
+
+	} // namespace gl
+
+} // namespace pegasus
+
+#endif//_PEGASUS_STATE_CACHE_HPP_
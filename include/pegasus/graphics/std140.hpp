@@ -0,0 +1,120 @@
+/*
+* Pegasus Engine
+* 2017 - Benjamin Carter (bencarterdev@outlook.com)
+*
+* This software is provided 'as-is', without any express or implied warranty.
+* In no event will the authors be held liable for any damages arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it freely,
+* subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented;
+*    you must not claim that you wrote the original software.
+*    If you use this software in a product, an acknowledgement
+*    in the product documentation would be appreciated but is not required.
+*
+* 2. Altered source versions must be plainly marked as such,
+*    and must not be misrepresented as being the original software.
+*
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef _PEGASUS_STD140_HPP_
+#define _PEGASUS_STD140_HPP_
+
+//====================
+// C++ includes
+//====================
+#include <cstddef>     // Offsets of the block members.
+#include <cstdint>     // The scalar types of glsl.
+#include <type_traits> // Checking the block types at compile-time.
+
+//====================
+// Library includes
+//====================
+#include <glm/glm.hpp> // The vector and matrix types of the blocks.
+
+namespace pegasus
+{
+	namespace std140
+	{
+		//====================
+		// Structures
+		//====================
+		/**
+		 * @brief The std140 base alignment of a C++ type that mirrors a glsl type.
+		 *
+		 * Only types whose C++ layout matches their std140 layout are defined, so using any other
+		 * type within a uniform block, such as glm::mat3 whose columns are not padded to a vec4,
+		 * fails to compile.
+		 */
+		template <typename T>
+		struct Alignment;
+
+		template <> struct Alignment<float>         { static constexpr std::size_t value = 4; };
+		template <> struct Alignment<std::int32_t>  { static constexpr std::size_t value = 4; };
+		template <> struct Alignment<std::uint32_t> { static constexpr std::size_t value = 4; };
+		template <> struct Alignment<glm::vec2>     { static constexpr std::size_t value = 8; };
+		template <> struct Alignment<glm::ivec2>    { static constexpr std::size_t value = 8; };
+		template <> struct Alignment<glm::uvec2>    { static constexpr std::size_t value = 8; };
+		template <> struct Alignment<glm::vec3>     { static constexpr std::size_t value = 16; };
+		template <> struct Alignment<glm::ivec3>    { static constexpr std::size_t value = 16; };
+		template <> struct Alignment<glm::uvec3>    { static constexpr std::size_t value = 16; };
+		template <> struct Alignment<glm::vec4>     { static constexpr std::size_t value = 16; };
+		template <> struct Alignment<glm::ivec4>    { static constexpr std::size_t value = 16; };
+		template <> struct Alignment<glm::uvec4>    { static constexpr std::size_t value = 16; };
+		template <> struct Alignment<glm::mat4>     { static constexpr std::size_t value = 16; };
+		template <> struct Alignment<glm::mat2x4>   { static constexpr std::size_t value = 16; };
+		template <> struct Alignment<glm::mat3x4>   { static constexpr std::size_t value = 16; };
+
+		/**
+		 * @brief Arrays are aligned to a vec4, and each element must occupy a multiple of a vec4.
+		 */
+		template <typename T, std::size_t N>
+		struct Alignment<T[N]>
+		{
+			static_assert(sizeof(T) % 16 == 0, "The elements of std140 arrays must be padded to a multiple of 16 bytes, use vec4 elements.");
+			static constexpr std::size_t value = Alignment<T>::value > 16 ? Alignment<T>::value : 16;
+		};
+
+		//====================
+		// Functions
+		//====================
+		/**
+		 * @brief Checks whether a member is placed at an offset allowed by std140.
+		 *
+		 * @param offset The offset of the member within the block.
+		 *
+		 * @returns True if the offset is a multiple of the base alignment of the member.
+		 */
+		template <typename T>
+		constexpr bool isAligned(std::size_t offset)
+		{
+			return offset % Alignment<T>::value == 0;
+		}
+
+		/**
+		 * @brief Checks whether a type can be copied directly into a uniform buffer.
+		 *
+		 * @returns True if the type is standard layout, trivially copyable and padded to a multiple of a vec4.
+		 */
+		template <typename T>
+		constexpr bool isBlock()
+		{
+			return std::is_standard_layout<T>::value && std::is_trivially_copyable<T>::value && sizeof(T) % 16 == 0;
+		}
+
+	} // namespace std140
+
+} // namespace pegasus
+
+//====================
+// Macros
+//====================
+/** Verifies at compile-time that a member of a uniform block struct matches the std140 layout. */
+#define PEGASUS_STD140_MEMBER(Type, member) \
+	static_assert(pegasus::std140::isAligned<decltype(Type::member)>(offsetof(Type, member)), \
+		#Type "::" #member " is not placed at its std140 offset, add explicit padding before it.")
+
+#endif//_PEGASUS_STD140_HPP_
@@ -55,6 +55,8 @@ namespace pegasus
 		glm::ivec2       m_size;
 		/** The type of texture being used. */
 		gl::eTextureType m_type;
+		/** The amount of memory used by the pixels and mip-maps of the texture. */
+		std::size_t      m_memoryUsage;
 
 	public:
 		//====================
@@ -128,6 +130,16 @@ namespace pegasus
 		 */
 		gl::eTextureType getType() const;
 
+		/**
+		 * @brief Retrieves an estimate of the memory used by the texture.
+		 *
+		 * The estimate is the size of the uploaded pixels, plus a third for the generated
+		 * mip-maps. A texture that has not been loaded uses no memory.
+		 *
+		 * @returns The estimated memory usage in bytes.
+		 */
+		std::size_t getMemoryUsage() const override;
+
 		//====================
 		// Methods
 		//====================
@@ -27,12 +27,19 @@
 // Pegasus includes
 //====================
 #include <pegasus/utilities/iasset_factory.hpp> // The factory is a type of asset factory.
+#include <pegasus/graphics/texture.hpp>         // The type of asset the factory creates.
 
 namespace pegasus
 {	
 	class TextureFactory final : public IAssetFactory
 	{
 	public:
+		//====================
+		// Types
+		//====================
+		/** The type of asset the factory creates. */
+		typedef Texture AssetType;
+
 		//====================
 		// Ctors and dtor
 		//====================
@@ -41,8 +48,10 @@ namespace pegasus
 		 * 
 		 * The default constructor will set the member variables to default
 		 * values and set the logger to log messages to the external log file.
+		 *
+		 * @param resources The Resources object of the Engine that owns the factory.
 		 */
-		explicit TextureFactory();
+		explicit TextureFactory(Resources& resources);
 
 		/**
 		 * @brief Default destructor.
@@ -60,7 +69,17 @@ namespace pegasus
 		 * @param name The name of the asset to retrieve.
 		 * @returns The asset being loaded.
 		 */
-		Asset* load(const std::string& name) override;
+		Texture* load(const std::string& name) override;
+	};
+
+	//====================
+	// Traits
+	//====================
+	template <>
+	struct AssetFactoryTraits<Texture>
+	{
+		/** The factory that loads texture assets. */
+		typedef TextureFactory Factory;
 	};
 
 } // namespace pegasus
@@ -26,13 +26,16 @@
 //====================
 // C++ includes
 //====================
-#include <string>                    // Passing uniform names.
-#include <utility>                   // Forwarding variables passed into the templated method.
+#include <cstdint>                  // The hashed uniform names.
+#include <cstring>                  // Comparing the shadowed values.
+#include <string>                   // Passing uniform names.
+#include <vector>                   // The reflected uniforms and their shadowed values.
 
 //====================
 // Pegasus includes
 //====================
-#include <pegasus/graphics/gl.hpp>  // OpenGL API.
+#include <pegasus/graphics/gl.hpp>       // OpenGL API.
+#include <pegasus/utilities/hash.hpp>    // Hashing the uniform names.
 
 //====================
 // Library includes
@@ -41,53 +44,171 @@
 
 namespace pegasus
 {
+	//====================
+	// Structures
+	//====================
+	/**
+	 * @brief A precomputed reference to a reflected uniform of a shader program.
+	 *
+	 * Handles are retrieved once with Uniform::getHandle and remain valid until the program is
+	 * linked again. Setting an invalid handle has no effect, as with a location of -1 in OpenGL.
+	 */
+	struct UniformHandle_t
+	{
+		/** The index of the uniform within the reflected table. */
+		std::uint32_t index;
+
+		/** Whether the handle refers to an active uniform. */
+		bool isValid() const { return index != ~0u; }
+	};
+
+	/**
+	 * @brief Maps the type of a value to the OpenGL type of the uniforms that receive it.
+	 *
+	 * Each specialisation declares the OpenGL type as Type, e.g. UniformTraits<glm::vec4>::Type is
+	 * GL_FLOAT_VEC4. Setting a uniform with a type that has no specialisation is a compile-time error.
+	 *
+	 * @tparam T The type of the value.
+	 */
+	template <typename T>
+	struct UniformTraits;
+
+	/**
+	 * @author Benjamin Carter
+	 *
+	 * @class pegasus::Uniform
+	 * @ingroup graphics
+	 *
+	 * @brief The active uniforms of a shader program, reflected once when the program is linked.
+	 *
+	 * After linking, every active uniform is read with glGetActiveUniform into a compact table sorted by
+	 * the hash of its name, along with its location, type and array size. A uniform is addressed by a
+	 * UniformHandle_t, which can be computed from a name hashed at compile-time, so setting a uniform
+	 * never calls glGetUniformLocation. The last value uploaded to each element of each uniform is
+	 * shadowed, and setting an element to its current value is skipped without calling the driver.
+	 *
+	 * Values are uploaded with glUniform*, which targets the bound program, so the program is bound
+	 * through the gl::StateCache before a changed value is uploaded. The cache skips the bind when the
+	 * program is already in use. A value is only sent to a uniform whose reflected type matches its
+	 * UniformTraits, so a value of the same size but a different type never reaches the driver or the
+	 * shadow. Booleans and samplers receive integers. Two uniforms whose names share a hash cannot be told apart by their
+	 * handles, so they are left out of the table when the program is reflected.
+	 */
 	class Uniform final
 	{
 	private:
+		//====================
+		// Structures
+		//====================
+		/**
+		 * @brief A single element of a reflected uniform.
+		 */
+		struct Element_t
+		{
+			/** The location of the element within the program. */
+			GLint location;
+			/** Whether a value has been uploaded since the program was linked. */
+			bool  known;
+		};
+
+		/**
+		 * @brief A single reflected uniform.
+		 */
+		struct Entry_t
+		{
+			/** The hash of the name of the uniform, without any array suffix. */
+			std::uint64_t hash;
+			/** The location of the uniform within the program. */
+			GLint         location;
+			/** The OpenGL type of the uniform, e.g. GL_FLOAT_VEC4. */
+			GLenum        type;
+			/** The OpenGL type of the values the uniform receives, e.g. GL_INT for samplers. */
+			GLenum        valueType;
+			/** The amount of array elements, one if the uniform is not an array. */
+			GLint         size;
+			/** The offset of the shadowed value of the first element within the value storage. */
+			std::size_t   offset;
+			/** The size of the shadowed value of a single element in bytes. */
+			std::size_t   bytes;
+			/** The index of the first element within the element storage. */
+			std::size_t   element;
+		};
+
 		//====================
 		// Member variables
 		//====================
 		/** A reference to the ID of the shader program this uniform is attached to. */
-		GLuint m_ID;
+		GLuint                     m_ID;
+		/** The active uniforms of the program, sorted by the hash of their names. */
+		std::vector<Entry_t>       m_entries;
+		/** The elements of every uniform, stored contiguously for each uniform. */
+		std::vector<Element_t>     m_elements;
+		/** The last value uploaded to each element of each uniform. */
+		std::vector<unsigned char> m_values;
 
 	private:
 		//====================
 		// Private methods
 		//====================
 		/**
-		 * @brief Retrieves the location of the uniform within the shader.
+		 * @brief Retrieves the size of the value of an OpenGL uniform type.
 		 *
-		 * Each uniform within a shader is assigned a unique value, this
-		 * method can be used to retrieve the location of the uniform within
-		 * the shader.
+		 * @param type The OpenGL type, e.g. GL_FLOAT_MAT4.
 		 *
-		 * @param uniform    The name of the uniform within the shader.
-		 *
-		 * @returns          The location of the uniform within the shader.
+		 * @returns The size in bytes of a single value, samplers are the size of an int.
 		 */
-		GLint getLocation(const std::string& name) const;
+		static std::size_t getTypeSize(GLenum type);
 
 		/**
-		 * @brief Sets the value of a uniform variable.
+		 * @brief Retrieves the type of the values received by an OpenGL uniform type.
 		 *
-		 * This method is used to set a uniform variable to the value
-		 * of an integer.
+		 * @param type The OpenGL type, e.g. GL_SAMPLER_2D.
 		 *
-		 * @param location The location of the uniform within the shader.
-		 * @param value    The integer value to send to the shader.
+		 * @returns The type of the values, booleans and samplers receive integers, e.g. GL_INT_VEC2 for GL_BOOL_VEC2.
+		 */
+		static GLenum getValueType(GLenum type);
+
+		/**
+		 * @brief Binds the program through the state cache, so the next upload targets it.
 		 */
-		void setParameter(GLint location, int value) const;
+		void bind() const;
 
 		/**
-		 * @brief Sets the value of a uniform variable.
+		 * @brief Uploads a value to the uniform at a location within the bound program.
 		 *
-		 * This method is used to set a uniform variable to the value
-		 * of a vec4 object.
+		 * @param location The location of the uniform within the shader.
+		 * @param value    The value to send to the shader.
+		 */
+		static void upload(GLint location, int value);
+		static void upload(GLint location, unsigned int value);
+		static void upload(GLint location, float value);
+		static void upload(GLint location, const glm::vec2& value);
+		static void upload(GLint location, const glm::vec3& value);
+		static void upload(GLint location, const glm::vec4& value);
+		static void upload(GLint location, const glm::ivec2& value);
+		static void upload(GLint location, const glm::ivec3& value);
+		static void upload(GLint location, const glm::ivec4& value);
+		static void upload(GLint location, const glm::uvec2& value);
+		static void upload(GLint location, const glm::uvec3& value);
+		static void upload(GLint location, const glm::uvec4& value);
+		static void upload(GLint location, const glm::mat2& value);
+		static void upload(GLint location, const glm::mat3& value);
+		static void upload(GLint location, const glm::mat4& value);
+		static void upload(GLint location, const glm::mat2x3& value);
+		static void upload(GLint location, const glm::mat3x2& value);
+		static void upload(GLint location, const glm::mat2x4& value);
+		static void upload(GLint location, const glm::mat4x2& value);
+		static void upload(GLint location, const glm::mat3x4& value);
+		static void upload(GLint location, const glm::mat4x3& value);
+
+		/**
+		 * @brief Uploads an encoded value to the uniform at a location within the bound program.
 		 *
 		 * @param location The location of the uniform within the shader.
-		 * @param vector   The vec4 values to send to the shader.
+		 * @param type     The OpenGL type of the uniform.
+		 * @param pValue   The value, encoded by Uniform::encode.
 		 */
-		void setParameter(GLint location, const glm::vec4& vector) const;
+		static void upload(GLint location, GLenum type, const unsigned char* pValue);
 
 	public:
 		//====================
@@ -121,35 +242,341 @@ namespace pegasus
 		 */
 		void setID(GLuint ID);
 
+		/**
+		 * @brief Retrieves the handle of a uniform from the hash of its name.
+		 *
+		 * The hash can be computed at compile-time, e.g. getHandle(Hash::fnv1a("u_texture")).
+		 *
+		 * @param hash The hash of the name of the uniform, without any array suffix.
+		 *
+		 * @returns The handle of the uniform, invalid if the program has no such active uniform.
+		 */
+		UniformHandle_t getHandle(std::uint64_t hash) const;
+
+		/**
+		 * @brief Retrieves the handle of a uniform from its name.
+		 *
+		 * @param name The name of the uniform within the shader.
+		 *
+		 * @returns The handle of the uniform, invalid if the program has no such active uniform.
+		 */
+		UniformHandle_t getHandle(const std::string& name) const;
+
+		/**
+		 * @brief Retrieves the location of a uniform within the program.
+		 *
+		 * @param handle The handle of the uniform.
+		 *
+		 * @returns The location of the uniform, -1 if the handle is invalid.
+		 */
+		GLint getLocation(UniformHandle_t handle) const;
+
+		/**
+		 * @brief Retrieves the OpenGL type of a uniform.
+		 *
+		 * @param handle The handle of the uniform.
+		 *
+		 * @returns The type of the uniform, e.g. GL_FLOAT_VEC4, or GL_NONE if the handle is invalid.
+		 */
+		GLenum getType(UniformHandle_t handle) const;
+
+		/**
+		 * @brief Retrieves the amount of active uniforms within the program.
+		 *
+		 * @returns The amount of reflected uniforms.
+		 */
+		std::size_t getCount() const;
+
 		//====================
 		// Methods
 		//====================
+		/**
+		 * @brief Reads the active uniforms of the linked program, replacing any previous reflection.
+		 *
+		 * This method is invoked by the shader program once it has been linked successfully, any
+		 * handles retrieved beforehand are no longer valid.
+		 *
+		 * @returns The names of the uniforms whose hashes collide, which have no valid handle.
+		 */
+		std::vector<std::string> reflect();
+
+		/**
+		 * @brief Sends a variable as a uniform to the attached shaders.
+		 *
+		 * The value is only uploaded if it differs from the last value uploaded to the uniform.
+		 * Booleans are sent as integers. Arrays receive the value within their first element.
+		 * Values whose UniformTraits do not match the type of the uniform are ignored.
+		 *
+		 * @param handle The handle of the uniform.
+		 * @param value  The value to send to the shader, any glm scalar, vector or matrix type.
+		 */
+		template <typename T>
+		void set(UniformHandle_t handle, const T& value);
+
+		/**
+		 * @brief Sends a variable to a single element of a uniform array.
+		 *
+		 * The value is only uploaded if it differs from the last value uploaded to the element.
+		 * Elements beyond the size of the array, and values whose UniformTraits do not match the
+		 * type of the uniform, are ignored.
+		 *
+		 * @param handle  The handle of the uniform.
+		 * @param element The index of the element, zero if the uniform is not an array.
+		 * @param value   The value to send to the shader, any glm scalar, vector or matrix type.
+		 */
+		template <typename T>
+		void set(UniformHandle_t handle, std::size_t element, const T& value);
+
+		/**
+		 * @brief Sends a variable as a uniform to the attached shaders.
+		 *
+		 * @param handle The handle of the uniform.
+		 * @param value  The value to send to the shader.
+		 */
+		void set(UniformHandle_t handle, bool value);
+
+		/**
+		 * @brief Sends a variable to a single element of a uniform array.
+		 *
+		 * @param handle  The handle of the uniform.
+		 * @param element The index of the element, zero if the uniform is not an array.
+		 * @param value   The value to send to the shader.
+		 */
+		void set(UniformHandle_t handle, std::size_t element, bool value);
+
+		/**
+		 * @brief Converts the components of a value to the type of a uniform, e.g. a value declared by an asset.
+		 *
+		 * The components are converted to integers for integer, boolean and sampler uniforms.
+		 *
+		 * @param handle     The handle of the uniform.
+		 * @param components The components of the value, in column-major order for matrices.
+		 * @param value      Receives the encoded value.
+		 *
+		 * @returns True if the handle is valid and the amount of components matches the type of the uniform.
+		 */
+		bool encode(UniformHandle_t handle, const std::vector<float>& components, std::vector<unsigned char>& value) const;
+
+		/**
+		 * @brief Sends an encoded value as a uniform to the attached shaders.
+		 *
+		 * The value is only uploaded if it differs from the last value uploaded to the element.
+		 *
+		 * @param handle  The handle of the uniform.
+		 * @param pValue  The value, encoded by Uniform::encode for the same handle.
+		 * @param element The index of the element, zero if the uniform is not an array.
+		 */
+		void setEncoded(UniformHandle_t handle, const unsigned char* pValue, std::size_t element = 0);
+
 		/**
 		 * @brief Sends a variable as a uniform to the attached shaders.
 		 *
-		 * So communication can be achieved between C++ and glsl, uniform
-		 * variables can be transferred to give shaders additional behavior. 
-		 * This method makes use of forwarding of variables in order to support
-		 * many different variable types.
+		 * The name is hashed and looked up on every call, handles should be retrieved once and
+		 * reused for uniforms that are set every frame.
 		 *
-		 * @param uniform   The name of the uniform in the glsl shader.
-		 * @param value     The value to send to the shader.
+		 * @param name  The name of the uniform in the glsl shader.
+		 * @param value The value to send to the shader.
 		 */
 		template <typename T>
-		void set(const std::string& name, T value) const;
+		void set(const std::string& name, const T& value);
+	};
+
+	//====================
+	// Traits
+	//====================
+	template <>
+	struct UniformTraits<int>
+	{
+		/** The type of the uniforms that receive the value. */
+		static const GLenum Type = GL_INT;
+	};
+
+	template <>
+	struct UniformTraits<unsigned int>
+	{
+		/** The type of the uniforms that receive the value. */
+		static const GLenum Type = GL_UNSIGNED_INT;
+	};
+
+	template <>
+	struct UniformTraits<float>
+	{
+		/** The type of the uniforms that receive the value. */
+		static const GLenum Type = GL_FLOAT;
+	};
+
+	template <>
+	struct UniformTraits<glm::vec2>
+	{
+		/** The type of the uniforms that receive the value. */
+		static const GLenum Type = GL_FLOAT_VEC2;
+	};
+
+	template <>
+	struct UniformTraits<glm::vec3>
+	{
+		/** The type of the uniforms that receive the value. */
+		static const GLenum Type = GL_FLOAT_VEC3;
+	};
+
+	template <>
+	struct UniformTraits<glm::vec4>
+	{
+		/** The type of the uniforms that receive the value. */
+		static const GLenum Type = GL_FLOAT_VEC4;
+	};
+
+	template <>
+	struct UniformTraits<glm::ivec2>
+	{
+		/** The type of the uniforms that receive the value. */
+		static const GLenum Type = GL_INT_VEC2;
+	};
+
+	template <>
+	struct UniformTraits<glm::ivec3>
+	{
+		/** The type of the uniforms that receive the value. */
+		static const GLenum Type = GL_INT_VEC3;
+	};
+
+	template <>
+	struct UniformTraits<glm::ivec4>
+	{
+		/** The type of the uniforms that receive the value. */
+		static const GLenum Type = GL_INT_VEC4;
+	};
+
+	template <>
+	struct UniformTraits<glm::uvec2>
+	{
+		/** The type of the uniforms that receive the value. */
+		static const GLenum Type = GL_UNSIGNED_INT_VEC2;
+	};
+
+	template <>
+	struct UniformTraits<glm::uvec3>
+	{
+		/** The type of the uniforms that receive the value. */
+		static const GLenum Type = GL_UNSIGNED_INT_VEC3;
+	};
+
+	template <>
+	struct UniformTraits<glm::uvec4>
+	{
+		/** The type of the uniforms that receive the value. */
+		static const GLenum Type = GL_UNSIGNED_INT_VEC4;
+	};
+
+	template <>
+	struct UniformTraits<glm::mat2>
+	{
+		/** The type of the uniforms that receive the value. */
+		static const GLenum Type = GL_FLOAT_MAT2;
+	};
+
+	template <>
+	struct UniformTraits<glm::mat3>
+	{
+		/** The type of the uniforms that receive the value. */
+		static const GLenum Type = GL_FLOAT_MAT3;
+	};
+
+	template <>
+	struct UniformTraits<glm::mat4>
+	{
+		/** The type of the uniforms that receive the value. */
+		static const GLenum Type = GL_FLOAT_MAT4;
+	};
+
+	template <>
+	struct UniformTraits<glm::mat2x3>
+	{
+		/** The type of the uniforms that receive the value. */
+		static const GLenum Type = GL_FLOAT_MAT2x3;
+	};
+
+	template <>
+	struct UniformTraits<glm::mat3x2>
+	{
+		/** The type of the uniforms that receive the value. */
+		static const GLenum Type = GL_FLOAT_MAT3x2;
+	};
+
+	template <>
+	struct UniformTraits<glm::mat2x4>
+	{
+		/** The type of the uniforms that receive the value. */
+		static const GLenum Type = GL_FLOAT_MAT2x4;
+	};
+
+	template <>
+	struct UniformTraits<glm::mat4x2>
+	{
+		/** The type of the uniforms that receive the value. */
+		static const GLenum Type = GL_FLOAT_MAT4x2;
+	};
+
+	template <>
+	struct UniformTraits<glm::mat3x4>
+	{
+		/** The type of the uniforms that receive the value. */
+		static const GLenum Type = GL_FLOAT_MAT3x4;
+	};
+
+	template <>
+	struct UniformTraits<glm::mat4x3>
+	{
+		/** The type of the uniforms that receive the value. */
+		static const GLenum Type = GL_FLOAT_MAT4x3;
 	};
-	
 
 	//====================
 	// Methods
 	//====================
 	/**********************************************************/
 	template <typename T>
-	void Uniform::set(const std::string& name, T value) const
+	void Uniform::set(UniformHandle_t handle, const T& value)
+	{
+		this->set(handle, 0, value);
+	}
+
+	/**********************************************************/
+	template <typename T>
+	void Uniform::set(UniformHandle_t handle, std::size_t element, const T& value)
+	{
+		if (handle.index >= m_entries.size() || element >= static_cast<std::size_t>(m_entries[handle.index].size))
+		{
+			return;
+		}
+
+		const Entry_t& entry = m_entries[handle.index];
+		// A value of another type would be uploaded with the wrong call, even if it has the same size as the uniform.
+		if (UniformTraits<T>::Type != entry.valueType)
+		{
+			return;
+		}
+
+		Element_t& shadow = m_elements[entry.element + element];
+		unsigned char* pShadow = m_values.data() + entry.offset + element * entry.bytes;
+		if (shadow.known && std::memcmp(pShadow, &value, sizeof(T)) == 0)
+		{
+			return;
+		}
+
+		this->bind();
+		Uniform::upload(shadow.location, value);
+		std::memcpy(pShadow, &value, sizeof(T));
+		shadow.known = true;
+	}
+
+	/**********************************************************/
+	template <typename T>
+	void Uniform::set(const std::string& name, const T& value)
 	{
-		this->setParameter(this->getLocation(name), std::forward<T>(value));
+		this->set(this->getHandle(name), value);
 	}
 
 } // namespace pegasus
 
-#endif//_PEGASUS_UNIFORM_HPP_
\ No newline at end of file
+#endif//_PEGASUS_UNIFORM_HPP_
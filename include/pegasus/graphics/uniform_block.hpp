@@ -0,0 +1,326 @@
+/*
+* Pegasus Engine
+* 2017 - Benjamin Carter (bencarterdev@outlook.com)
+*
+* This software is provided 'as-is', without any express or implied warranty.
+* In no event will the authors be held liable for any damages arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it freely,
+* subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented;
+*    you must not claim that you wrote the original software.
+*    If you use this software in a product, an acknowledgement
+*    in the product documentation would be appreciated but is not required.
+*
+* 2. Altered source versions must be plainly marked as such,
+*    and must not be misrepresented as being the original software.
+*
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef _PEGASUS_UNIFORM_BLOCK_HPP_
+#define _PEGASUS_UNIFORM_BLOCK_HPP_
+
+//====================
+// C++ includes
+//====================
+#include <algorithm> // Growing the dirty range.
+#include <cstddef>   // The offsets and sizes of the dirty range.
+#include <cstring>   // Comparing and copying the values of the block.
+
+//====================
+// Pegasus includes
+//====================
+#include <pegasus/graphics/gl.hpp>            // OpenGL functions and object IDs.
+#include <pegasus/graphics/release_queue.hpp> // Deferring the deletion of the buffer.
+#include <pegasus/graphics/state_cache.hpp>   // Binding the buffer without redundant calls.
+#include <pegasus/graphics/std140.hpp>        // Verifying the layout of the blocks.
+#include <pegasus/utilities/non_copyable.hpp> // The block owns its buffer.
+
+namespace pegasus
+{
+	//====================
+	// Enumerations
+	//====================
+	/**
+	 * @brief The fixed binding points of the uniform blocks shared by every shader program.
+	 */
+	enum class eUniformBlock : GLuint
+	{
+		/** The values that change once per frame, declared in glsl as the block FrameData. */
+		FRAME = 0,
+		/** The values of the material being drawn, declared in glsl as the block MaterialData. */
+		MATERIAL = 1
+	};
+
+	//====================
+	// Structures
+	//====================
+	/**
+	 * @brief The values of the FrameData block, uploaded once per frame.
+	 *
+	 *	layout (std140) uniform FrameData {
+	 *		mat4  u_view_projection;
+	 *		float u_time;
+	 *		float u_delta_time;
+	 *		vec2  u_resolution;
+	 *	};
+	 */
+	struct FrameData_t
+	{
+		/** The combined view and projection matrix of the camera. */
+		glm::mat4 viewProjection;
+		/** The seconds elapsed since the first frame. */
+		float     time;
+		/** The seconds elapsed since the previous frame. */
+		float     deltaTime;
+		/** The size of the window in pixels. */
+		glm::vec2 resolution;
+	};
+
+	PEGASUS_STD140_MEMBER(FrameData_t, viewProjection);
+	PEGASUS_STD140_MEMBER(FrameData_t, time);
+	PEGASUS_STD140_MEMBER(FrameData_t, deltaTime);
+	PEGASUS_STD140_MEMBER(FrameData_t, resolution);
+
+	/**
+	 * @brief The values of the MaterialData block, uploaded whenever the material changes.
+	 *
+	 *	layout (std140) uniform MaterialData {
+	 *		vec4 u_tint;
+	 *	};
+	 */
+	struct MaterialData_t
+	{
+		/** The colour the texture is multiplied by. */
+		glm::vec4 tint;
+	};
+
+	PEGASUS_STD140_MEMBER(MaterialData_t, tint);
+
+	//====================
+	// Functions
+	//====================
+	/**
+	 * @brief Assigns every shared uniform block declared by a linked program to its fixed binding point.
+	 *
+	 * @param ID The ID of the linked program.
+	 */
+	void bindUniformBlocks(GLuint ID);
+
+	/**
+	 * @author Benjamin Carter
+	 *
+	 * @class pegasus::UniformBlock
+	 * @ingroup graphics
+	 *
+	 * @brief A uniform buffer holding the values of a block shared by every shader program.
+	 *
+	 * The C++ struct is copied into the buffer as-is, so its layout must match the std140 layout
+	 * of the glsl block. The struct is verified when the template is instantiated, and each member
+	 * should be verified with PEGASUS_STD140_MEMBER after the struct has been declared.
+	 *
+	 * The values are shadowed on the CPU. Setting a member to a different value only grows the
+	 * dirty range of the block, and upload() sends the dirty bytes to the buffer with a single
+	 * glBufferSubData, so setting several members each frame costs a single upload and setting
+	 * unchanged values costs nothing. The buffer stays bound to the binding point of the block,
+	 * so programs never need to be rebound when the values change.
+	 */
+	template <typename T>
+	class UniformBlock final : NonCopyable
+	{
+		static_assert(std140::isBlock<T>(), "The struct of a uniform block must be standard layout, trivially copyable and padded to a multiple of 16 bytes.");
+
+	private:
+		//====================
+		// Member variables
+		//====================
+		/** The ID of the uniform buffer. */
+		GLuint      m_ID;
+		/** The binding point the buffer is bound to. */
+		GLuint      m_binding;
+		/** The values of the block. */
+		T           m_data;
+		/** The first byte that has changed since the last upload. */
+		std::size_t m_dirtyBegin;
+		/** One past the last byte that has changed since the last upload. */
+		std::size_t m_dirtyEnd;
+
+	private:
+		//====================
+		// Private methods
+		//====================
+		/**
+		 * @brief Replaces a range of bytes of the block, growing the dirty range if they have changed.
+		 *
+		 * @param offset The offset of the first byte within the block.
+		 * @param pData  The new values of the bytes.
+		 * @param size   The amount of bytes.
+		 */
+		void write(std::size_t offset, const void* pData, std::size_t size);
+
+	public:
+		//====================
+		// Ctors and dtor
+		//====================
+		/**
+		 * @brief Creates the buffer with zeroed values and binds it to the binding point of the block.
+		 *
+		 * @param binding The binding point of the block.
+		 */
+		explicit UniformBlock(eUniformBlock binding);
+
+		/**
+		 * @brief Destructor, releases the buffer.
+		 */
+		~UniformBlock();
+
+		//====================
+		// Getters and setters
+		//====================
+		/**
+		 * @brief Sets a single member of the block.
+		 *
+		 * @param pMember The member to set, e.g. &FrameData_t::time.
+		 * @param value   The new value of the member.
+		 */
+		template <typename M>
+		void set(M T::* pMember, const M& value);
+
+		/**
+		 * @brief Sets every member of the block.
+		 *
+		 * @param data The new values of the block.
+		 */
+		void set(const T& data);
+
+		/**
+		 * @brief Retrieves the values of the block.
+		 *
+		 * @returns The values, including any that have not been uploaded.
+		 */
+		const T& get() const;
+
+		/**
+		 * @brief Retrieves whether any values have changed since the last upload.
+		 *
+		 * @returns True if upload() would send data to the buffer.
+		 */
+		bool isDirty() const;
+
+		//====================
+		// Methods
+		//====================
+		/**
+		 * @brief Binds the buffer to the binding point of the block, if it is not already bound.
+		 */
+		void bind();
+
+		/**
+		 * @brief Sends the values that have changed since the last upload to the buffer.
+		 */
+		void upload();
+	};
+
+	//====================
+	// Ctors and dtor
+	//====================
+	/**********************************************************/
+	template <typename T>
+	UniformBlock<T>::UniformBlock(eUniformBlock binding)
+		: NonCopyable(), m_ID(0), m_binding(static_cast<GLuint>(binding)), m_data(), m_dirtyBegin(sizeof(T)), m_dirtyEnd(0)
+	{
+		m_ID = gl::genBuffer();
+		gl::bindBuffer(gl::eBufferType::UNIFORM, m_ID);
+		gl::bufferData(gl::eBufferType::UNIFORM, sizeof(T), &m_data, gl::eDrawType::DYNAMIC);
+		this->bind();
+	}
+
+	/**********************************************************/
+	template <typename T>
+	UniformBlock<T>::~UniformBlock()
+	{
+		ReleaseQueue::getInstance().release(eObjectType::BUFFER, m_ID);
+	}
+
+	//====================
+	// Private methods
+	//====================
+	/**********************************************************/
+	template <typename T>
+	void UniformBlock<T>::write(std::size_t offset, const void* pData, std::size_t size)
+	{
+		unsigned char* pBytes = reinterpret_cast<unsigned char*>(&m_data) + offset;
+		if (std::memcmp(pBytes, pData, size) == 0)
+		{
+			return;
+		}
+
+		std::memcpy(pBytes, pData, size);
+		m_dirtyBegin = std::min(m_dirtyBegin, offset);
+		m_dirtyEnd = std::max(m_dirtyEnd, offset + size);
+	}
+
+	//====================
+	// Getters and setters
+	//====================
+	/**********************************************************/
+	template <typename T>
+	template <typename M>
+	void UniformBlock<T>::set(M T::* pMember, const M& value)
+	{
+		std::size_t offset = reinterpret_cast<const unsigned char*>(&(m_data.*pMember)) - reinterpret_cast<const unsigned char*>(&m_data);
+		this->write(offset, &value, sizeof(M));
+	}
+
+	/**********************************************************/
+	template <typename T>
+	void UniformBlock<T>::set(const T& data)
+	{
+		this->write(0, &data, sizeof(T));
+	}
+
+	/**********************************************************/
+	template <typename T>
+	const T& UniformBlock<T>::get() const
+	{
+		return m_data;
+	}
+
+	/**********************************************************/
+	template <typename T>
+	bool UniformBlock<T>::isDirty() const
+	{
+		return m_dirtyBegin < m_dirtyEnd;
+	}
+
+	//====================
+	// Methods
+	//====================
+	/**********************************************************/
+	template <typename T>
+	void UniformBlock<T>::bind()
+	{
+		gl::StateCache::getInstance().bindBufferBase(GL_UNIFORM_BUFFER, m_binding, m_ID);
+	}
+
+	/**********************************************************/
+	template <typename T>
+	void UniformBlock<T>::upload()
+	{
+		if (!this->isDirty())
+		{
+			return;
+		}
+
+		gl::bindBuffer(gl::eBufferType::UNIFORM, m_ID);
+		glBufferSubData(GL_UNIFORM_BUFFER, m_dirtyBegin, m_dirtyEnd - m_dirtyBegin, reinterpret_cast<const unsigned char*>(&m_data) + m_dirtyBegin);
+		m_dirtyBegin = sizeof(T);
+		m_dirtyEnd = 0;
+	}
+
+} // namespace pegasus
+
+#endif//_PEGASUS_UNIFORM_BLOCK_HPP_
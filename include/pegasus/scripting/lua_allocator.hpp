@@ -0,0 +1,265 @@
+/*
+* Pegasus Engine
+* 2017 - Benjamin Carter (bencarterdev@outlook.com)
+*
+* This software is provided 'as-is', without any express or implied warranty.
+* In no event will the authors be held liable for any damages arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it freely,
+* subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented;
+*    you must not claim that you wrote the original software.
+*    If you use this software in a product, an acknowledgement
+*    in the product documentation would be appreciated but is not required.
+*
+* 2. Altered source versions must be plainly marked as such,
+*    and must not be misrepresented as being the original software.
+*
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef _PEGASUS_LUA_ALLOCATOR_HPP_
+#define _PEGASUS_LUA_ALLOCATOR_HPP_
+
+//====================
+// C++ includes
+//====================
+#include <array>   // The free lists of each size class.
+#include <atomic>  // The memory limit can be changed from any thread.
+#include <cstddef> // Sizes of the allocations.
+#include <vector>  // Storing the pages of the size classes.
+
+//====================
+// Pegasus includes
+//====================
+#include <pegasus/utilities/non_copyable.hpp> // The allocator owns its pages.
+
+namespace pegasus
+{
+	//====================
+	// Structures
+	//====================
+	/**
+	 * @brief The memory statistics of a single lua state.
+	 */
+	struct LuaMemoryStatistics_t
+	{
+		/** The amount of bytes currently allocated by the state. */
+		std::size_t liveBytes;
+		/** The highest amount of bytes the state has allocated at once. */
+		std::size_t peakBytes;
+		/** The amount of allocations made since the state was created. */
+		std::size_t totalAllocations;
+		/** The amount of allocations made since the last frame ended. */
+		std::size_t frameAllocations;
+		/** The amount of bytes the state has grown by since the last frame ended, ignoring any releases. */
+		std::size_t frameBytes;
+		/** The amount of allocations refused because they would exceed the memory limit. */
+		std::size_t failedAllocations;
+	};
+
+	/**
+	 * @author Benjamin Carter
+	 *
+	 * @class pegasus::LuaAllocator
+	 * @ingroup scripting
+	 *
+	 * @brief The allocator passed to lua_newstate for each lua state created by the engine.
+	 *
+	 * Lua allocates a very large amount of small, short lived objects such as strings, tables
+	 * and closures. Requests of up to MAX_SMALL_SIZE bytes are rounded up to a multiple of
+	 * SIZE_CLASS_STEP and served from a free list of equally sized blocks, carved from pages that
+	 * are only returned to the system when the allocator is destroyed. Larger requests are
+	 * forwarded to std::realloc.
+	 *
+	 * The allocator counts every byte that lua requests, which allows the memory used by each
+	 * state to be measured and capped. When an allocation would exceed the limit, it is refused
+	 * and lua raises a memory error within the script that caused it.
+	 *
+	 * A lua state is only used by one thread at a time, so the size classes are not synchronised.
+	 * The statistics are kept in atomic counters, so they can be read from any thread, such as the
+	 * main thread reporting on the states leased by worker threads.
+	 *
+	 * Lua expects a block to always shrink successfully. If a shrinking block must move to another
+	 * size class, or std::realloc fails to shrink a large block, the original block is kept and
+	 * reported at its new size.
+	 *
+	 * LuaJIT refuses custom allocators on 64-bit targets built without LJ_GC64, so the engine does not
+	 * pass the allocator to its states under PEGASUS_LUAJIT.
+	 */
+	class LuaAllocator final : NonCopyable
+	{
+	public:
+		//====================
+		// Types
+		//====================
+		/** Resizes a block forwarded to the system allocator, with the signature of std::realloc. */
+		typedef void* (*Resize_t)(void* pBlock, std::size_t size);
+
+		//====================
+		// Constant variables
+		//====================
+		/** The difference in size between each size class. */
+		static constexpr std::size_t SIZE_CLASS_STEP = 16;
+		/** The largest request served from the size classes. */
+		static constexpr std::size_t MAX_SMALL_SIZE = 256;
+		/** The size of each page carved into blocks. */
+		static constexpr std::size_t PAGE_SIZE = 16384;
+
+	private:
+		//====================
+		// Structures
+		//====================
+		/**
+		 * @brief A free block within a size class, linked to the next free block.
+		 */
+		struct Block_t
+		{
+			Block_t* pNext;
+		};
+
+		//====================
+		// Member variables
+		//====================
+		/** The first free block of each size class. */
+		std::array<Block_t*, MAX_SMALL_SIZE / SIZE_CLASS_STEP> m_free;
+		/** The pages owned by the size classes. */
+		std::vector<void*>                                     m_pages;
+		/** The amount of bytes currently allocated by the state. */
+		std::atomic<std::size_t>                               m_liveBytes;
+		/** The highest amount of bytes the state has allocated at once. */
+		std::atomic<std::size_t>                               m_peakBytes;
+		/** The amount of allocations made since the state was created. */
+		std::atomic<std::size_t>                               m_totalAllocations;
+		/** The amount of allocations made since the last frame ended. */
+		std::atomic<std::size_t>                               m_frameAllocations;
+		/** The amount of bytes the state has grown by since the last frame ended. */
+		std::atomic<std::size_t>                               m_frameBytes;
+		/** The amount of allocations refused because they would exceed the memory limit. */
+		std::atomic<std::size_t>                               m_failedAllocations;
+		/** The maximum amount of bytes the state can allocate, zero if unlimited. */
+		std::atomic<std::size_t>                               m_limit;
+		/** Resizes the blocks larger than MAX_SMALL_SIZE. */
+		Resize_t                                               m_pResize;
+
+	private:
+		//====================
+		// Private methods
+		//====================
+		/**
+		 * @brief Retrieves the size class of a request.
+		 *
+		 * @param size The size of the request, between 1 and MAX_SMALL_SIZE.
+		 *
+		 * @returns The index of the size class.
+		 */
+		static std::size_t getSizeClass(std::size_t size);
+
+		/**
+		 * @brief Allocates a block of memory.
+		 *
+		 * @param size The size of the block, greater than zero.
+		 *
+		 * @returns The block, or nullptr if the system is out of memory.
+		 */
+		void* allocate(std::size_t size);
+
+		/**
+		 * @brief Releases a block of memory.
+		 *
+		 * @param pBlock The block to release.
+		 * @param size   The size the block was allocated with.
+		 */
+		void deallocate(void* pBlock, std::size_t size);
+
+		/**
+		 * @brief Resizes, allocates or releases a block of memory on behalf of lua.
+		 *
+		 * @param pBlock  The block to resize, nullptr to allocate a new block.
+		 * @param oldSize The size of the block.
+		 * @param newSize The requested size, zero to release the block.
+		 *
+		 * @returns The resized block, or nullptr if the block was released or could not be resized.
+		 */
+		void* reallocate(void* pBlock, std::size_t oldSize, std::size_t newSize);
+
+	public:
+		//====================
+		// Ctors and dtor
+		//====================
+		/**
+		 * @brief Constructor for the LuaAllocator.
+		 *
+		 * @param limit The maximum amount of bytes the state can allocate, zero if unlimited.
+		 */
+		explicit LuaAllocator(std::size_t limit = 0);
+
+		/**
+		 * @brief Destructor, releases every page. The state must have been closed beforehand.
+		 */
+		~LuaAllocator();
+
+		//====================
+		// Getters and setters
+		//====================
+		/**
+		 * @brief Sets the maximum amount of bytes the state can allocate.
+		 *
+		 * Lowering the limit below the live bytes does not release any memory, it only
+		 * prevents the state from growing further.
+		 *
+		 * @param limit The limit in bytes, zero if unlimited.
+		 */
+		void setLimit(std::size_t limit);
+
+		/**
+		 * @brief Retrieves the maximum amount of bytes the state can allocate.
+		 *
+		 * @returns The limit in bytes, zero if unlimited.
+		 */
+		std::size_t getLimit() const;
+
+		/**
+		 * @brief Sets the function that resizes the blocks larger than MAX_SMALL_SIZE.
+		 *
+		 * Defaults to std::realloc, and is only replaced to simulate the system running out of memory.
+		 *
+		 * @param pResize The function to resize the blocks with.
+		 */
+		void setResize(Resize_t pResize);
+
+		/**
+		 * @brief Retrieves the memory statistics of the state.
+		 *
+		 * This can be called from any thread, whilst the state is in use.
+		 *
+		 * @returns A copy of the statistics.
+		 */
+		LuaMemoryStatistics_t getStatistics() const;
+
+		//====================
+		// Methods
+		//====================
+		/**
+		 * @brief Resets the allocations and bytes counted for the current frame.
+		 */
+		void endFrame();
+
+		/**
+		 * @brief The lua_Alloc function passed to lua_newstate.
+		 *
+		 * @param pUserData The LuaAllocator of the state.
+		 * @param pBlock    The block to resize, nullptr to allocate a new block.
+		 * @param oldSize   The size of the block, or the type of object being allocated if the block is nullptr.
+		 * @param newSize   The requested size, zero to release the block.
+		 *
+		 * @returns The resized block, or nullptr if the block was released or could not be resized.
+		 */
+		static void* luaAlloc(void* pUserData, void* pBlock, std::size_t oldSize, std::size_t newSize);
+	};
+
+} // namespace pegasus
+
+#endif//_PEGASUS_LUA_ALLOCATOR_HPP_
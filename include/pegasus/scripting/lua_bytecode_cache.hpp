@@ -0,0 +1,237 @@
+/*
+* Pegasus Engine
+* 2017 - Benjamin Carter (bencarterdev@outlook.com)
+*
+* This software is provided 'as-is', without any express or implied warranty.
+* In no event will the authors be held liable for any damages arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it freely,
+* subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented;
+*    you must not claim that you wrote the original software.
+*    If you use this software in a product, an acknowledgement
+*    in the product documentation would be appreciated but is not required.
+*
+* 2. Altered source versions must be plainly marked as such,
+*    and must not be misrepresented as being the original software.
+*
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef _PEGASUS_LUA_BYTECODE_CACHE_HPP_
+#define _PEGASUS_LUA_BYTECODE_CACHE_HPP_
+
+//====================
+// C++ includes
+//====================
+#include <cstdint>       // The source hash keys.
+#include <mutex>         // Loading scripts from multiple states.
+#include <string>        // The compiled chunks and file locations.
+#include <unordered_map> // Storing the compiled chunks.
+
+//====================
+// Pegasus includes
+//====================
+#include <pegasus/utilities/non_copyable.hpp> // The cache cannot be copied.
+
+//====================
+// Library includes
+//====================
+#include <sol/sol.hpp> // Loading the chunks into a lua state.
+
+namespace pegasus
+{
+	/**
+	 * @author Benjamin Carter
+	 *
+	 * @class pegasus::LuaBytecodeCache
+	 * @ingroup scripting
+	 *
+	 * @brief Stores the compiled bytecode of lua scripts so each script is only parsed once.
+	 *
+	 * When a script is first loaded, its source is compiled and the resulting chunk is dumped
+	 * with lua_dump. The chunk is kept in memory and, if a directory has been set, written to
+	 * disk so later runs of the engine can skip the compiler entirely. Each script has a single
+	 * chunk, named by a hash of its file location, and the chunk records a hash of the source it
+	 * was compiled from. Editing a script therefore replaces its chunk rather than loading a stale one.
+	 *
+	 * The chunk files start with a header holding the source hash, the length and a checksum of the
+	 * bytecode, and are written to a temporary file before being renamed into place. A truncated or
+	 * corrupted chunk is never handed to lua, the script is compiled from source instead.
+	 *
+	 * Bytecode is specific to the lua version and build it was compiled with. If a cached chunk
+	 * cannot be loaded, the script is compiled from source again and the chunk is replaced.
+	 *
+	 * The cache is shared by every state of a ScriptingManager and can be used from multiple threads.
+	 */
+	class LuaBytecodeCache final : NonCopyable
+	{
+	public:
+		//====================
+		// Constant variables
+		//====================
+		/** The version of the chunk file format, incremented whenever the header changes. */
+		static constexpr std::uint32_t VERSION = 1;
+
+	private:
+		//====================
+		// Structures
+		//====================
+		struct Header_t
+		{
+			/** Identifies the file as a lua chunk, "PGLC". */
+			char          magic[4];
+			/** The version of the file format. */
+			std::uint32_t version;
+			/** The hash of the file location and source the chunk was compiled from. */
+			std::uint64_t key;
+			/** The checksum of the bytecode. */
+			std::uint64_t checksum;
+			/** The size of the bytecode in bytes. */
+			std::uint64_t length;
+		};
+
+		struct Chunk_t
+		{
+			/** The hash of the file location and source the chunk was compiled from. */
+			std::uint64_t key;
+			/** The bytecode of the chunk. */
+			std::string   bytecode;
+		};
+
+		//====================
+		// Member variables
+		//====================
+		/** The compiled chunks, keyed by the hash of their file location. */
+		std::unordered_map<std::uint64_t, Chunk_t>     m_chunks;
+		/** The directory the chunks are persisted to, empty if they are only kept in memory. */
+		std::string                                    m_directory;
+		/** Whether scripts are loaded through the cache or compiled each time. */
+		bool                                           m_enabled;
+		/** Guards the chunks and settings. */
+		mutable std::mutex                             m_mutex;
+
+	private:
+		//====================
+		// Private methods
+		//====================
+		/**
+		 * @brief Retrieves the location of a chunk within the cache directory.
+		 *
+		 * @param directory The cache directory.
+		 * @param file      The hash of the file location of the script.
+		 *
+		 * @returns The file location of the chunk.
+		 */
+		static std::string getChunkPath(const std::string& directory, std::uint64_t file);
+
+		/**
+		 * @brief Reads a chunk from the cache directory, validating its header.
+		 *
+		 * @param path The file location of the chunk.
+		 * @param key  The hash of the file location and source the chunk must have been compiled from.
+		 *
+		 * @returns The bytecode, or an empty string if the chunk is missing, stale, truncated or corrupted.
+		 */
+		static std::string readChunk(const std::string& path, std::uint64_t key);
+
+		/**
+		 * @brief Compiles a script from source and stores the resulting chunk.
+		 *
+		 * @param lua      The state to compile the script with.
+		 * @param file     The hash of the file location of the script.
+		 * @param key      The hash of the file location and source of the script.
+		 * @param source   The source of the script.
+		 * @param filename The file location of the script, used to name the chunk.
+		 *
+		 * @returns The compiled function, or the compilation error.
+		 */
+		sol::load_result compile(sol::state& lua, std::uint64_t file, std::uint64_t key, const std::string& source, const std::string& filename);
+
+	public:
+		//====================
+		// Ctors and dtor
+		//====================
+		/**
+		 * @brief Default constructor, the cache is enabled and only kept in memory.
+		 */
+		explicit LuaBytecodeCache();
+
+		/**
+		 * @brief Default destructor.
+		 */
+		~LuaBytecodeCache() = default;
+
+		//====================
+		// Getters and setters
+		//====================
+		/**
+		 * @brief Sets the directory the chunks are persisted to.
+		 *
+		 * The directory is created if it does not exist. An empty directory keeps the
+		 * chunks in memory only.
+		 *
+		 * @param directory The cache directory.
+		 */
+		void setDirectory(const std::string& directory);
+
+		/**
+		 * @brief Retrieves the directory the chunks are persisted to.
+		 *
+		 * @returns The cache directory, empty if the chunks are only kept in memory.
+		 */
+		std::string getDirectory() const;
+
+		/**
+		 * @brief Sets whether scripts are loaded through the cache.
+		 *
+		 * @param enabled False to compile every script from source.
+		 */
+		void setEnabled(bool enabled);
+
+		/**
+		 * @brief Retrieves whether scripts are loaded through the cache.
+		 *
+		 * @returns True if the cache is enabled.
+		 */
+		bool isEnabled() const;
+
+		/**
+		 * @brief Retrieves the amount of chunks held in memory.
+		 *
+		 * @returns The amount of chunks.
+		 */
+		std::size_t getSize() const;
+
+		//====================
+		// Methods
+		//====================
+		/**
+		 * @brief Loads a script as a function without executing it.
+		 *
+		 * The chunk is taken from memory, then from the cache directory, and is only compiled
+		 * from source if neither contains it.
+		 *
+		 * The source is read and hashed on every call, even when the chunk is in memory. Modification
+		 * times only have a resolution of a second on some platforms, so a script edited within the
+		 * same second as its last load would keep its stale chunk. Reading and hashing a script costs
+		 * a small fraction of parsing and compiling it, which is what the cache avoids.
+		 *
+		 * @param lua      The state to load the script into.
+		 * @param filename The file location of the lua script.
+		 *
+		 * @returns The loaded function, or the error if the script could not be read or compiled.
+		 */
+		sol::load_result load(sol::state& lua, const std::string& filename);
+
+		/**
+		 * @brief Removes every chunk held in memory. Chunks within the cache directory are kept.
+		 */
+		void clear();
+	};
+
+} // namespace pegasus
+
+#endif//_PEGASUS_LUA_BYTECODE_CACHE_HPP_
@@ -0,0 +1,229 @@
+/*
+* Pegasus Engine
+* 2017 - Benjamin Carter (bencarterdev@outlook.com)
+*
+* This software is provided 'as-is', without any express or implied warranty.
+* In no event will the authors be held liable for any damages arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it freely,
+* subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented;
+*    you must not claim that you wrote the original software.
+*    If you use this software in a product, an acknowledgement
+*    in the product documentation would be appreciated but is not required.
+*
+* 2. Altered source versions must be plainly marked as such,
+*    and must not be misrepresented as being the original software.
+*
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef _PEGASUS_LUA_DATA_ARRAYS_HPP_
+#define _PEGASUS_LUA_DATA_ARRAYS_HPP_
+
+//====================
+// C++ includes
+//====================
+#include <cstddef>       // The amount of elements within an array.
+#include <string>        // The names of the arrays and their element types.
+#include <unordered_set> // The element types bound to the state.
+
+//====================
+// Pegasus includes
+//====================
+#include <pegasus/utilities/non_copyable.hpp> // The arrays are bound to a single state.
+
+//====================
+// Library includes
+//====================
+#include <sol/sol.hpp> // The lua state the arrays are exposed to.
+
+namespace pegasus
+{
+	/**
+	 * @author Benjamin Carter
+	 *
+	 * @class pegasus::LuaDataArrays
+	 * @ingroup scripting
+	 *
+	 * @brief Exposes contiguous arrays owned by the engine to the scripts of a lua state.
+	 *
+	 * Each exposed array is available to lua as arrays.<name>, a table holding the element count
+	 * and a zero-indexed view of the elements, so scripts can update many objects within a single call:
+	 *
+	 *	local transforms = arrays.transforms
+	 *	for i = 0, transforms.count - 1 do
+	 *		transforms.data[i].x = transforms.data[i].x + 1
+	 *	end
+	 *
+	 * When the engine is built against LuaJIT, the view is an FFI pointer cast from the address of the
+	 * array, so each field access compiles down to a plain load or store. The element type must have
+	 * been declared to the FFI with declare() beforehand. Otherwise each element is pushed through sol2
+	 * as a reference to a usertype, which must have been registered with the state under the same name.
+	 *
+	 * The views do not own the memory. Arrays must be exposed again whenever they are reallocated or
+	 * resized, and removed before they are destroyed.
+	 */
+	class LuaDataArrays final : NonCopyable
+	{
+	private:
+		//====================
+		// Structures
+		//====================
+		/**
+		 * @brief A zero-indexed view of an array, used when the FFI is not available.
+		 */
+		template <typename T>
+		struct View_t
+		{
+			/** The first element of the array. */
+			T*          pData;
+			/** The amount of elements within the array. */
+			std::size_t count;
+		};
+
+		//====================
+		// Member variables
+		//====================
+		/** The state the arrays are exposed to. */
+		sol::state&                     m_state;
+		/** The arrays table within the state. */
+		sol::table                      m_arrays;
+		/** The element types whose views have been bound to the state. */
+		std::unordered_set<std::string> m_viewTypes;
+		/** Whether the arrays are exposed through the FFI. */
+		bool                            m_ffi;
+
+	private:
+		//====================
+		// Private methods
+		//====================
+		/**
+		 * @brief Exposes an array as an FFI pointer to its elements.
+		 *
+		 * @param name  The name of the array within lua.
+		 * @param type  The name of the element type declared to the FFI.
+		 * @param pData The first element of the array.
+		 * @param count The amount of elements within the array.
+		 */
+		void exposeFFI(const std::string& name, const std::string& type, void* pData, std::size_t count);
+
+		/**
+		 * @brief Creates, or retrieves, the table holding an exposed array.
+		 *
+		 * @param name  The name of the array within lua.
+		 * @param count The amount of elements within the array.
+		 *
+		 * @returns The table of the array.
+		 */
+		sol::table getEntry(const std::string& name, std::size_t count);
+
+	public:
+		//====================
+		// Ctors and dtor
+		//====================
+		/**
+		 * @brief Constructor for the LuaDataArrays, creates the arrays table within the state.
+		 *
+		 * @param state The state the arrays are exposed to.
+		 */
+		explicit LuaDataArrays(sol::state& state);
+
+		/**
+		 * @brief Default destructor.
+		 */
+		~LuaDataArrays() = default;
+
+		//====================
+		// Getters and setters
+		//====================
+		/**
+		 * @brief Retrieves whether the engine has been built against LuaJIT.
+		 *
+		 * @returns True if the FFI can be used.
+		 */
+		static bool isFFIAvailable();
+
+		/**
+		 * @brief Sets whether arrays exposed from now on use the FFI.
+		 *
+		 * The FFI is used by default whenever it is available, disabling it allows the sol2 views to be
+		 * compared against the FFI views within the same build. Has no effect if the FFI is not available.
+		 *
+		 * @param enabled Whether the FFI is used.
+		 */
+		void setFFIEnabled(bool enabled);
+
+		/**
+		 * @brief Retrieves whether arrays are exposed through the FFI.
+		 *
+		 * @returns True if the FFI is used.
+		 */
+		bool isFFIEnabled() const;
+
+		//====================
+		// Methods
+		//====================
+		/**
+		 * @brief Declares C types to the FFI, so they can be used as element types.
+		 *
+		 * The declaration must match the layout of the C++ types exactly. Has no effect if the FFI
+		 * is not available.
+		 *
+		 * @param declaration The C declarations, e.g. "typedef struct { float x, y; } Position;".
+		 */
+		void declare(const std::string& declaration);
+
+		/**
+		 * @brief Exposes an array to lua as arrays.<name>, replacing any array of the same name.
+		 *
+		 * @param name  The name of the array within lua.
+		 * @param type  The name of the element type, declared to the FFI or registered as a usertype.
+		 * @param pData The first element of the array.
+		 * @param count The amount of elements within the array.
+		 */
+		template <typename T>
+		void expose(const std::string& name, const std::string& type, T* pData, std::size_t count);
+
+		/**
+		 * @brief Removes an array, so lua can no longer access its memory.
+		 *
+		 * Any views that the scripts have kept hold of remain dangling, so scripts should always
+		 * access the arrays through the arrays table.
+		 *
+		 * @param name The name of the array.
+		 */
+		void remove(const std::string& name);
+	};
+
+	//====================
+	// Methods
+	//====================
+	/**********************************************************/
+	template <typename T>
+	void LuaDataArrays::expose(const std::string& name, const std::string& type, T* pData, std::size_t count)
+	{
+		if (m_ffi)
+		{
+			this->exposeFFI(name, type, static_cast<void*>(pData), count);
+			return;
+		}
+
+		// Bind the view of the element type the first time it is exposed.
+		if (m_viewTypes.insert(type).second)
+		{
+			m_state.new_usertype<View_t<T>>(type + "Array",
+				sol::meta_function::index, [](const View_t<T>& view, std::size_t index) -> T* {
+					return index < view.count ? view.pData + index : nullptr;
+				},
+				sol::meta_function::length, [](const View_t<T>& view) { return view.count; });
+		}
+
+		this->getEntry(name, count)["data"] = View_t<T>{ pData, count };
+	}
+
+} // namespace pegasus
+
+#endif//_PEGASUS_LUA_DATA_ARRAYS_HPP_
@@ -0,0 +1,205 @@
+/*
+* Pegasus Engine
+* 2017 - Benjamin Carter (bencarterdev@outlook.com)
+*
+* This software is provided 'as-is', without any express or implied warranty.
+* In no event will the authors be held liable for any damages arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it freely,
+* subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented;
+*    you must not claim that you wrote the original software.
+*    If you use this software in a product, an acknowledgement
+*    in the product documentation would be appreciated but is not required.
+*
+* 2. Altered source versions must be plainly marked as such,
+*    and must not be misrepresented as being the original software.
+*
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef _PEGASUS_LUA_GARBAGE_COLLECTOR_HPP_
+#define _PEGASUS_LUA_GARBAGE_COLLECTOR_HPP_
+
+//====================
+// C++ includes
+//====================
+#include <chrono>  // The time budget of each frame.
+#include <cstddef> // The amount of steps and failed allocations.
+
+//====================
+// Pegasus includes
+//====================
+#include <pegasus/utilities/non_copyable.hpp>  // The collector is bound to a single state.
+#include <pegasus/scripting/lua_allocator.hpp> // Measuring the allocation rate of the state.
+
+//====================
+// Library includes
+//====================
+#include <sol/sol.hpp> // The lua state being collected.
+
+namespace pegasus
+{
+	/**
+	 * @author Benjamin Carter
+	 *
+	 * @class pegasus::LuaGarbageCollector
+	 * @ingroup scripting
+	 *
+	 * @brief Runs the incremental garbage collector of a lua state within a fixed budget each frame.
+	 *
+	 * By default lua decides when to collect garbage, which can cause a large step part way through a
+	 * frame. Once a budget has been set, the automatic collector is stopped and the engine calls step()
+	 * at an idle point in the main loop instead. Each call runs incremental steps until the budget has
+	 * been spent or the current cycle has finished.
+	 *
+	 * The size of each step adapts to the allocation rate of the state: the more the state allocated
+	 * during the frame, the more work each step performs, so the collector keeps pace with the script
+	 * without exceeding the budget. If the allocator refused an allocation because the collector fell
+	 * behind, a full collection is run regardless of the budget.
+	 *
+	 * Whilst the automatic collector is stopped, not every lua version collects garbage before reporting
+	 * that it ran out of memory, so a script could fail part way through a frame even though most of its
+	 * memory is garbage. Once the live bytes of a limited state pass HIGH_WATER_PERCENT of the limit, a full
+	 * collection is run at the end of the frame instead of an incremental step, keeping the state clear of the limit.
+	 * A full collection cannot free memory that is still live, so whilst the state stays above the high water mark
+	 * another is only run once the state has used half of the room the last one left it, and the budgeted steps
+	 * continue in between.
+	 *
+	 * Lua 5.1 and LuaJIT restart the automatic collector whenever they step or collect, so it is stopped again
+	 * at the end of every step().
+	 *
+	 * LuaJIT states are not created with a LuaAllocator, so the collector measures their memory through lua_gc
+	 * instead, and the growth of the state since the last step stands in for the bytes allocated during the frame.
+	 */
+	class LuaGarbageCollector final : NonCopyable
+	{
+	public:
+		//====================
+		// Constant variables
+		//====================
+		/** The smallest step size, in kilobytes. */
+		static constexpr int MIN_STEP_SIZE = 1;
+		/** The largest step size, in kilobytes. */
+		static constexpr int MAX_STEP_SIZE = 1024;
+		/** The percentage of the memory limit the live bytes can reach before a full collection is run. */
+		static constexpr std::size_t HIGH_WATER_PERCENT = 75;
+
+	private:
+		//====================
+		// Member variables
+		//====================
+		/** The state being collected. */
+		sol::state&               m_state;
+		/** The allocator the state was created with. */
+		LuaAllocator&             m_allocator;
+		/** The time that can be spent collecting each frame, zero if lua collects automatically. */
+		std::chrono::microseconds m_budget;
+		/** The time spent collecting during the last frame. */
+		std::chrono::microseconds m_frameTime;
+		/** The amount of steps run during the last frame. */
+		std::size_t               m_frameSteps;
+		/** The size of each step during the last frame, in kilobytes. */
+		int                       m_stepSize;
+		/** Whether the last step finished a collection cycle. */
+		bool                      m_cycleFinished;
+		/** The amount of refused allocations when the collector last ran. */
+		std::size_t               m_failedAllocations;
+		/** The live bytes of the state when the collector last ran. */
+		std::size_t               m_liveBytes;
+		/** The live bytes of the state after the last full collection. */
+		std::size_t               m_collectedBytes;
+		/** The amount of full collections run since the collector was created. */
+		std::size_t               m_fullCollections;
+
+	private:
+		//====================
+		// Private methods
+		//====================
+		/**
+		 * @brief Retrieves the memory statistics of the state.
+		 *
+		 * @returns The statistics of the allocator, or those measured from the state under LuaJIT.
+		 */
+		LuaMemoryStatistics_t getStatistics() const;
+
+	public:
+		//====================
+		// Ctors and dtor
+		//====================
+		/**
+		 * @brief Constructor for the LuaGarbageCollector, lua continues to collect automatically.
+		 *
+		 * @param state     The state to collect.
+		 * @param allocator The allocator the state was created with.
+		 */
+		explicit LuaGarbageCollector(sol::state& state, LuaAllocator& allocator);
+
+		/**
+		 * @brief Default destructor.
+		 */
+		~LuaGarbageCollector() = default;
+
+		//====================
+		// Getters and setters
+		//====================
+		/**
+		 * @brief Sets the time that can be spent collecting each frame.
+		 *
+		 * A non-zero budget stops the automatic collector, a zero budget restarts it.
+		 *
+		 * @param budget The budget of each frame.
+		 */
+		void setBudget(std::chrono::microseconds budget);
+
+		/**
+		 * @brief Retrieves the time that can be spent collecting each frame.
+		 *
+		 * @returns The budget, zero if lua collects automatically.
+		 */
+		std::chrono::microseconds getBudget() const;
+
+		/**
+		 * @brief Retrieves the time spent collecting during the last frame.
+		 *
+		 * @returns The time spent within step().
+		 */
+		std::chrono::microseconds getFrameTime() const;
+
+		/**
+		 * @brief Retrieves the amount of incremental steps run during the last frame.
+		 *
+		 * @returns The amount of steps.
+		 */
+		std::size_t getFrameSteps() const;
+
+		/**
+		 * @brief Retrieves the size of each step during the last frame.
+		 *
+		 * @returns The step size in kilobytes.
+		 */
+		int getStepSize() const;
+
+		/**
+		 * @brief Retrieves the amount of full collections run instead of incremental steps.
+		 *
+		 * @returns The amount of full collections since the collector was created.
+		 */
+		std::size_t getFullCollectionCount() const;
+
+		//====================
+		// Methods
+		//====================
+		/**
+		 * @brief Runs the collector for up to the budget, should be invoked once per frame.
+		 *
+		 * The method must be invoked before the frame statistics of the allocator are reset.
+		 */
+		void step();
+	};
+
+} // namespace pegasus
+
+#endif//_PEGASUS_LUA_GARBAGE_COLLECTOR_HPP_
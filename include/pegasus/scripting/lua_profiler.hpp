@@ -0,0 +1,222 @@
+/*
+* Pegasus Engine
+* 2017 - Benjamin Carter (bencarterdev@outlook.com)
+*
+* This software is provided 'as-is', without any express or implied warranty.
+* In no event will the authors be held liable for any damages arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it freely,
+* subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented;
+*    you must not claim that you wrote the original software.
+*    If you use this software in a product, an acknowledgement
+*    in the product documentation would be appreciated but is not required.
+*
+* 2. Altered source versions must be plainly marked as such,
+*    and must not be misrepresented as being the original software.
+*
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef _PEGASUS_LUA_PROFILER_HPP_
+#define _PEGASUS_LUA_PROFILER_HPP_
+
+//====================
+// C++ includes
+//====================
+#include <atomic>             // Whether the profiler is running.
+#include <chrono>             // The sampling period.
+#include <condition_variable> // Waking the timer thread when the profiler stops.
+#include <cstddef>            // Sizes of the ring buffer.
+#include <mutex>              // Guarding the ring buffer.
+#include <string>             // The names of the sampled functions.
+#include <thread>             // The timer thread.
+#include <vector>             // The ring buffer of samples.
+
+//====================
+// Pegasus includes
+//====================
+#include <pegasus/utilities/non_copyable.hpp> // The profiler is bound to a single state.
+
+//====================
+// Library includes
+//====================
+#include <sol/sol.hpp> // The lua state being profiled.
+
+namespace pegasus
+{
+	/**
+	 * @author Benjamin Carter
+	 *
+	 * @class pegasus::LuaProfiler
+	 * @ingroup scripting
+	 *
+	 * @brief A sampling profiler for the scripts executed by a lua state.
+	 *
+	 * While the profiler is running, a timer thread arms a single-instruction count hook on the
+	 * state once per period. The next instruction executed by the state invokes the hook, which
+	 * records the lua call stack into a ring buffer and removes itself. Sampling by time rather
+	 * than by instruction count means each sample represents the same amount of wall time, so the
+	 * samples can be aggregated into folded stacks and rendered directly as a flamegraph.
+	 *
+	 * When the profiler is stopped, no hook is installed and no thread is running, so profiling
+	 * costs nothing. The oldest samples are overwritten once the ring buffer is full. A profiler
+	 * started with a rate of zero runs no timer thread and only samples when triggered.
+	 *
+	 * Samples are only taken by the interpreter, LuaJIT does not invoke hooks from compiled traces.
+	 */
+	class LuaProfiler final : NonCopyable
+	{
+	public:
+		//====================
+		// Constant variables
+		//====================
+		/** The deepest call stack recorded by a sample, any deeper frames are discarded. */
+		static constexpr std::size_t MAX_DEPTH = 64;
+
+	private:
+		//====================
+		// Structures
+		//====================
+		/**
+		 * @brief The call stack recorded by a single sample.
+		 */
+		struct Sample_t
+		{
+			/** The functions on the stack, from the innermost to the outermost. The strings are reused by later samples. */
+			std::vector<std::string> frames;
+			/** The amount of frames recorded. */
+			std::size_t              depth;
+		};
+
+		//====================
+		// Member variables
+		//====================
+		/** The state being profiled. */
+		sol::state&               m_state;
+		/** The recorded samples. */
+		std::vector<Sample_t>     m_samples;
+		/** The next sample to overwrite. */
+		std::size_t               m_next;
+		/** The amount of samples recorded since the profiler was cleared, including overwritten samples. */
+		std::size_t               m_recorded;
+		/** The time between samples. */
+		std::chrono::microseconds m_period;
+		/** Whether the profiler is running. */
+		std::atomic<bool>         m_running;
+		/** Arms the hook once per period. */
+		std::thread               m_timer;
+		/** Guards the samples. */
+		mutable std::mutex        m_mutex;
+		/** Guards the sleeping timer thread. */
+		std::mutex                m_timerMutex;
+		/** Wakes the timer thread when the profiler is stopped. */
+		std::condition_variable   m_stopped;
+
+	private:
+		//====================
+		// Private methods
+		//====================
+		/**
+		 * @brief The lua hook, records the call stack of the state and removes itself.
+		 *
+		 * @param pState The state that executed the hooked instruction.
+		 * @param pDebug The debug information of the hook event.
+		 */
+		static void hook(lua_State* pState, lua_Debug* pDebug);
+
+		/**
+		 * @brief Records the current call stack of a state into the ring buffer.
+		 *
+		 * @param pState The state to sample.
+		 */
+		void sample(lua_State* pState);
+
+		/**
+		 * @brief Arms the hook once per period until the profiler is stopped.
+		 */
+		void run();
+
+	public:
+		//====================
+		// Ctors and dtor
+		//====================
+		/**
+		 * @brief Constructor for the LuaProfiler, the profiler is stopped.
+		 *
+		 * @param state    The state to profile.
+		 * @param capacity The amount of samples held by the ring buffer.
+		 */
+		explicit LuaProfiler(sol::state& state, std::size_t capacity = 65536);
+
+		/**
+		 * @brief Destructor, stops the profiler.
+		 */
+		~LuaProfiler();
+
+		//====================
+		// Getters and setters
+		//====================
+		/**
+		 * @brief Sets the amount of samples held by the ring buffer, clearing any recorded samples.
+		 *
+		 * @param capacity The amount of samples.
+		 */
+		void setCapacity(std::size_t capacity);
+
+		/**
+		 * @brief Retrieves whether the profiler is running.
+		 *
+		 * @returns True if the state is being sampled.
+		 */
+		bool isRunning() const;
+
+		/**
+		 * @brief Retrieves the amount of samples recorded since the profiler was cleared.
+		 *
+		 * @returns The amount of samples, including any that have been overwritten.
+		 */
+		std::size_t getSampleCount() const;
+
+		/**
+		 * @brief Aggregates the samples within the ring buffer into folded stacks.
+		 *
+		 * Each line contains the functions of a unique call stack, from the outermost to the
+		 * innermost separated by semicolons, followed by the amount of samples of that stack.
+		 * The output can be passed directly to flamegraph.pl.
+		 *
+		 * @returns The folded stacks.
+		 */
+		std::string getFoldedStacks() const;
+
+		//====================
+		// Methods
+		//====================
+		/**
+		 * @brief Starts sampling the state. The profiler must be started by the thread that uses the state.
+		 *
+		 * @param rate The amount of samples taken each second, or zero to only sample when triggered.
+		 */
+		void start(unsigned int rate);
+
+		/**
+		 * @brief Samples the call stack of the next instruction executed by the state. May be called from any thread.
+		 */
+		void trigger();
+
+		/**
+		 * @brief Stops sampling the state and removes the hook.
+		 */
+		void stop();
+
+		/**
+		 * @brief Removes every recorded sample.
+		 */
+		void clear();
+	};
+
+} // namespace pegasus
+
+#endif//_PEGASUS_LUA_PROFILER_HPP_
@@ -0,0 +1,236 @@
+/*
+* Pegasus Engine
+* 2017 - Benjamin Carter (bencarterdev@outlook.com)
+*
+* This software is provided 'as-is', without any express or implied warranty.
+* In no event will the authors be held liable for any damages arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it freely,
+* subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented;
+*    you must not claim that you wrote the original software.
+*    If you use this software in a product, an acknowledgement
+*    in the product documentation would be appreciated but is not required.
+*
+* 2. Altered source versions must be plainly marked as such,
+*    and must not be misrepresented as being the original software.
+*
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef _PEGASUS_LUA_STATE_POOL_HPP_
+#define _PEGASUS_LUA_STATE_POOL_HPP_
+
+//====================
+// C++ includes
+//====================
+#include <condition_variable> // Waiting for a state to be returned.
+#include <functional>         // Initialising each new state.
+#include <memory>             // The states are stored as unique pointers.
+#include <mutex>              // Leasing states from multiple threads.
+#include <vector>             // Storing the states.
+
+//====================
+// Pegasus includes
+//====================
+#include <pegasus/utilities/non_copyable.hpp>  // The pool cannot be copied.
+#include <pegasus/scripting/lua_allocator.hpp> // Each state owns an allocator.
+
+//====================
+// Library includes
+//====================
+#include <sol/sol.hpp> // The sol lua state object.
+
+namespace pegasus
+{
+	/**
+	 * @author Benjamin Carter
+	 *
+	 * @class pegasus::LuaStatePool
+	 * @ingroup scripting
+	 *
+	 * @brief A pool of initialised lua states that can be leased by multiple threads.
+	 *
+	 * A lua state can only be used by a single thread at a time. The pool owns a fixed set of states,
+	 * each initialised with the same libraries and bindings when it is created, and leases them out to
+	 * the threads that need to execute scripts. If every state is leased, the next thread blocks until
+	 * one is returned. The states are never reset between leases, so scripts should be executed within
+	 * their own sol::environment to avoid observing each other's globals.
+	 *
+	 * Every state is created with its own LuaAllocator, so the memory used by each state can be
+	 * measured and capped independently.
+	 */
+	class LuaStatePool final : NonCopyable
+	{
+	private:
+		//====================
+		// Structures
+		//====================
+		/**
+		 * @brief A lua state and the allocator it was created with.
+		 */
+		struct Slot_t
+		{
+			/** The allocator of the state, it must outlive the state. */
+			LuaAllocator allocator;
+			/** The state, created through lua_newstate with the allocator. */
+			sol::state   state;
+
+			/**
+			 * @brief Constructor for the Slot_t.
+			 *
+			 * @param limit The maximum amount of bytes the state can allocate, zero if unlimited.
+			 */
+			explicit Slot_t(std::size_t limit);
+		};
+
+	public:
+		/**
+		 * @brief Grants exclusive use of a single state until it is destroyed.
+		 */
+		class Lease final
+		{
+		private:
+			//====================
+			// Member variables
+			//====================
+			/** The pool the state is returned to. */
+			LuaStatePool* m_pPool;
+			/** The leased state and its allocator. */
+			Slot_t*       m_pSlot;
+
+		public:
+			//====================
+			// Ctors and dtor
+			//====================
+			/**
+			 * @brief Constructor for the Lease.
+			 *
+			 * @param pool The pool the state was leased from.
+			 * @param slot The leased state and its allocator.
+			 */
+			explicit Lease(LuaStatePool& pool, Slot_t& slot);
+
+			/**
+			 * @brief Move constructor, the other lease no longer returns the state.
+			 *
+			 * @param lease The lease to take the state from.
+			 */
+			Lease(Lease&& lease);
+
+			Lease(const Lease&) = delete;
+			Lease& operator=(const Lease&) = delete;
+
+			/**
+			 * @brief Returns the state to the pool.
+			 */
+			~Lease();
+
+			//====================
+			// Getters and setters
+			//====================
+			/**
+			 * @brief Retrieves the leased state.
+			 *
+			 * @returns The lua state, only valid for the life-time of the lease.
+			 */
+			sol::state& getState() const;
+
+			/**
+			 * @brief Retrieves the allocator of the leased state.
+			 *
+			 * @returns The allocator, only valid for the life-time of the lease.
+			 */
+			LuaAllocator& getAllocator() const;
+		};
+
+	private:
+		//====================
+		// Member variables
+		//====================
+		/** Initialises each state when it is created. */
+		std::function<void(sol::state&)>     m_initialiser;
+		/** Every state owned by the pool. */
+		std::vector<std::unique_ptr<Slot_t>> m_slots;
+		/** The states that are not currently leased. */
+		std::vector<Slot_t*>                 m_free;
+		/** The memory limit of each state, zero if unlimited. */
+		std::size_t                          m_limit;
+		/** Guards the lists of states. */
+		mutable std::mutex                   m_mutex;
+		/** Signalled each time a state is returned. */
+		std::condition_variable              m_returned;
+
+	private:
+		//====================
+		// Private methods
+		//====================
+		/**
+		 * @brief Returns a leased state to the pool and wakes a waiting thread.
+		 *
+		 * @param slot The state to return.
+		 */
+		void release(Slot_t& slot);
+
+	public:
+		//====================
+		// Ctors and dtor
+		//====================
+		/**
+		 * @brief Constructor for the LuaStatePool.
+		 *
+		 * @param initialiser Opens the libraries and binds the engine types to each new state.
+		 * @param count       The amount of states to create.
+		 */
+		explicit LuaStatePool(std::function<void(sol::state&)> initialiser, std::size_t count);
+
+		/**
+		 * @brief Default destructor. No states may be leased when the pool is destroyed.
+		 */
+		~LuaStatePool() = default;
+
+		//====================
+		// Getters and setters
+		//====================
+		/**
+		 * @brief Retrieves the amount of states owned by the pool.
+		 *
+		 * @returns The amount of states, leased or not.
+		 */
+		std::size_t getSize() const;
+
+		/**
+		 * @brief Sets the maximum amount of bytes each state can allocate.
+		 *
+		 * The limit applies to every existing state, including those currently leased, and to
+		 * any state created afterwards.
+		 *
+		 * @param limit The limit in bytes, zero if unlimited.
+		 */
+		void setMemoryLimit(std::size_t limit);
+
+		//====================
+		// Methods
+		//====================
+		/**
+		 * @brief Creates and initialises states until the pool contains at least the specified amount.
+		 *
+		 * The pool never shrinks, as states may currently be leased.
+		 *
+		 * @param count The minimum amount of states.
+		 */
+		void reserve(std::size_t count);
+
+		/**
+		 * @brief Leases a state from the pool, blocking until one is available.
+		 *
+		 * @returns The lease, the state is returned to the pool when the lease is destroyed.
+		 */
+		Lease acquire();
+	};
+
+} // namespace pegasus
+
+#endif//_PEGASUS_LUA_STATE_POOL_HPP_
@@ -0,0 +1,236 @@
+/*
+* Pegasus Engine
+* 2017 - Benjamin Carter (bencarterdev@outlook.com)
+*
+* This software is provided 'as-is', without any express or implied warranty.
+* In no event will the authors be held liable for any damages arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it freely,
+* subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented;
+*    you must not claim that you wrote the original software.
+*    If you use this software in a product, an acknowledgement
+*    in the product documentation would be appreciated but is not required.
+*
+* 2. Altered source versions must be plainly marked as such,
+*    and must not be misrepresented as being the original software.
+*
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef _PEGASUS_SCRIPT_BUFFER_HPP_
+#define _PEGASUS_SCRIPT_BUFFER_HPP_
+
+//====================
+// C++ includes
+//====================
+#include <cstddef> // The amount of elements and components.
+#include <vector>  // The packed values.
+
+//====================
+// Library includes
+//====================
+#include <sol/sol.hpp> // Binding the buffer to lua.
+
+namespace pegasus
+{
+	/**
+	 * @author Benjamin Carter
+	 *
+	 * @class pegasus::ScriptBuffer
+	 * @ingroup scripting
+	 *
+	 * @brief A packed array of floats that scripts and the engine exchange in a single call.
+	 *
+	 * Each call into a sol2 binding crosses the lua boundary, so an API that is called once per
+	 * object per frame does not scale to large amounts of objects. A script buffer holds the values
+	 * of every object, e.g. the x and y of each position, within a single userdata. Scripts pass
+	 * whole buffers to the engine, and the bulk operations of the buffer process every element
+	 * within one call:
+	 *
+	 *	local positions = ScriptBuffer.new(50000, 2)
+	 *	local velocities = ScriptBuffer.new(50000, 2)
+	 *	velocities:fill(1.0)
+	 *	positions:add(velocities, dt) -- Moves all 50000 positions within a single call.
+	 *
+	 * Lua indices start at one. Integer data such as sprite identifiers is stored exactly up to 2^24.
+	 */
+	class ScriptBuffer final
+	{
+	private:
+		//====================
+		// Member variables
+		//====================
+		/** The values of every element, the components of each element are adjacent. */
+		std::vector<float> m_data;
+		/** The amount of values held by each element. */
+		std::size_t        m_components;
+
+	private:
+		//====================
+		// Private methods
+		//====================
+		/**
+		 * @brief Ensures another buffer has the same layout as this buffer.
+		 *
+		 * @param other The buffer to compare.
+		 *
+		 * @throws std::invalid_argument If the amount of elements or components differ.
+		 */
+		void checkLayout(const ScriptBuffer& other) const;
+
+		/**
+		 * @brief Retrieves the offset of a value within the packed array.
+		 *
+		 * @param index     The index of the element.
+		 * @param component The index of the component within the element.
+		 *
+		 * @returns The offset of the value.
+		 *
+		 * @throws std::out_of_range If the element or component does not exist.
+		 */
+		std::size_t getOffset(std::size_t index, std::size_t component) const;
+
+	public:
+		//====================
+		// Ctors and dtor
+		//====================
+		/**
+		 * @brief Constructor for the ScriptBuffer, every value is zero.
+		 *
+		 * @param count      The amount of elements.
+		 * @param components The amount of values held by each element, at least one.
+		 */
+		explicit ScriptBuffer(std::size_t count, std::size_t components = 1);
+
+		/**
+		 * @brief Default destructor.
+		 */
+		~ScriptBuffer() = default;
+
+		//====================
+		// Getters and setters
+		//====================
+		/**
+		 * @brief Sets a single value of the buffer.
+		 *
+		 * @param index     The index of the element.
+		 * @param component The index of the component within the element.
+		 * @param value     The new value.
+		 *
+		 * @throws std::out_of_range If the element or component does not exist.
+		 */
+		void set(std::size_t index, std::size_t component, float value);
+
+		/**
+		 * @brief Retrieves a single value of the buffer.
+		 *
+		 * @param index     The index of the element.
+		 * @param component The index of the component within the element.
+		 *
+		 * @returns The value.
+		 *
+		 * @throws std::out_of_range If the element or component does not exist.
+		 */
+		float get(std::size_t index, std::size_t component) const;
+
+		/**
+		 * @brief Retrieves the amount of elements within the buffer.
+		 *
+		 * @returns The amount of elements.
+		 */
+		std::size_t getCount() const;
+
+		/**
+		 * @brief Retrieves the amount of values held by each element.
+		 *
+		 * @returns The amount of components.
+		 */
+		std::size_t getComponents() const;
+
+		/**
+		 * @brief Retrieves the packed values, so the engine can process them directly.
+		 *
+		 * @returns The first value of the buffer.
+		 */
+		float* getData();
+
+		/**
+		 * @brief Retrieves the packed values, so the engine can process them directly.
+		 *
+		 * @returns The first value of the buffer.
+		 */
+		const float* getData() const;
+
+		//====================
+		// Methods
+		//====================
+		/**
+		 * @brief Changes the amount of elements, any new values are zero.
+		 *
+		 * @param count The amount of elements.
+		 */
+		void resize(std::size_t count);
+
+		/**
+		 * @brief Sets every value of the buffer.
+		 *
+		 * @param value The new value.
+		 */
+		void fill(float value);
+
+		/**
+		 * @brief Multiplies every value of the buffer.
+		 *
+		 * @param factor The value to multiply by.
+		 */
+		void scale(float factor);
+
+		/**
+		 * @brief Adds the scaled values of another buffer to this buffer, e.g. integrating velocities.
+		 *
+		 * @param other  The buffer to add, with the same layout as this buffer.
+		 * @param factor The value each of the other values is multiplied by.
+		 *
+		 * @throws std::invalid_argument If the layouts differ.
+		 */
+		void add(const ScriptBuffer& other, float factor);
+
+		/**
+		 * @brief Copies the values of another buffer into this buffer.
+		 *
+		 * @param other The buffer to copy, with the same layout as this buffer.
+		 *
+		 * @throws std::invalid_argument If the layouts differ.
+		 */
+		void copy(const ScriptBuffer& other);
+
+		/**
+		 * @brief Copies the values of a lua array into the buffer, in packed order.
+		 *
+		 * @param table The values, any beyond the size of the buffer are ignored.
+		 */
+		void fromTable(const sol::table& table);
+
+		/**
+		 * @brief Copies the values of the buffer into a new lua array, in packed order.
+		 *
+		 * @param state The state the array is created within.
+		 *
+		 * @returns The array of values.
+		 */
+		sol::table toTable(sol::this_state state) const;
+
+		/**
+		 * @brief Binds the ScriptBuffer usertype to a lua state.
+		 *
+		 * @param state The state to bind the usertype to.
+		 */
+		static void bind(sol::state& state);
+	};
+
+} // namespace pegasus
+
+#endif//_PEGASUS_SCRIPT_BUFFER_HPP_
@@ -26,7 +26,15 @@
 //====================
 // Pegasus includes
 //====================
-#include <pegasus/utilities/singleton.hpp> // The scripting manager is a type of singleton.
+#include <pegasus/utilities/non_copyable.hpp>          // The lua state cannot be copied.
+#include <pegasus/scripting/lua_state_pool.hpp>        // The states used to de-serialize assets.
+#include <pegasus/scripting/lua_bytecode_cache.hpp>    // The compiled scripts shared by the states.
+#include <pegasus/scripting/lua_allocator.hpp>         // Allocating the memory of the main state.
+#include <pegasus/scripting/lua_garbage_collector.hpp> // Collecting the garbage of the main state each frame.
+#include <pegasus/scripting/lua_profiler.hpp>          // Sampling the scripts of the main state.
+#include <pegasus/scripting/task_scheduler.hpp>        // Running the coroutines of the main state.
+#include <pegasus/scripting/lua_data_arrays.hpp>       // Exposing the engine's arrays to the main state.
+#include <pegasus/scripting/script_buffer.hpp>         // Exchanging packed arrays with the main state.
 
 //====================
 // Library includes
@@ -41,44 +49,64 @@ namespace pegasus
 	 * @class pegasus::ScriptingManager
 	 * @ingroup scripting
 	 *
-	 * @brief The global scripting manager responsible for storing and loading the lua libraries.
+	 * @brief The scripting manager responsible for storing and loading the lua libraries.
 	 *
-	 * The scripting manager is responsible for storing and utilising the global lua state and making
-	 * it globally available to the entire application. When the scripting manager is first initialised,
-	 * it will load all of the default lua libaries and bind all of the functions that are exposed from within
-	 * the engine to lua scripting interface.
+	 * The scripting manager is responsible for storing and utilising the lua state of an Engine. Each
+	 * Engine owns its own scripting manager, so scripts executed by one instance never observe the globals
+	 * of another. When the scripting manager is first initialised, it will load all of the default lua libaries
+	 * and bind all of the functions that are exposed from within the engine to lua scripting interface.
+	 *
+	 * Alongside the main state, the scripting manager owns a LuaStatePool. Every state within the pool
+	 * receives the same libraries and bindings, so asset descriptions can be executed on worker threads
+	 * without sharing the main state. The states share a LuaBytecodeCache, so each script is only
+	 * compiled once regardless of which state executes it.
+	 *
+	 * Every state is created through lua_newstate with its own LuaAllocator, which bounds and
+	 * measures the memory each state uses. LuaJIT refuses custom allocators on 64-bit targets built
+	 * without LJ_GC64, so under PEGASUS_LUAJIT the states allocate for themselves: the memory limit
+	 * is ignored and the allocator statistics remain empty. LuaJIT never invokes hooks from compiled
+	 * traces either, so the LuaProfiler only samples the code run by the interpreter. The garbage of the main state is collected by a
+	 * LuaGarbageCollector, which the engine can restrict to a fixed budget at the end of each frame,
+	 * and its scripts can be sampled at runtime by a LuaProfiler. Long-lived scripts run as coroutines
+	 * within the TaskScheduler, which is resumed once per frame. Contiguous engine data is exposed to
+	 * the scripts of the main state through LuaDataArrays, as FFI views when built against LuaJIT.
+	 * Scripts of the main state can also pass whole arrays to the engine as packed ScriptBuffers,
+	 * so bulk updates cost a single call rather than a call per object.
 	 */
-	class ScriptingManager final : public Singleton<ScriptingManager>
+	class ScriptingManager final : NonCopyable
 	{
-		friend class Singleton<ScriptingManager>;
-
 	private:
 		//====================
 		// Member variables
 		//====================
-		/** The lua state that executes all lua scripts. */
-		sol::state m_state;
+		/** The allocator of the main state, it must outlive the state. */
+		LuaAllocator        m_allocator;
+		/** The lua state that executes the engine's scripts. */
+		sol::state          m_state;
+		/** Collects the garbage of the main state. */
+		LuaGarbageCollector m_collector;
+		/** Samples the scripts executed by the main state. */
+		LuaProfiler         m_profiler;
+		/** Runs the coroutines of the main state. */
+		TaskScheduler       m_scheduler;
+		/** The engine arrays exposed to the main state. */
+		LuaDataArrays       m_arrays;
+		/** The states leased by threads that de-serialize assets. */
+		LuaStatePool        m_pool;
+		/** The compiled scripts, shared by every state. */
+		LuaBytecodeCache    m_bytecode;
 
 	private:
 		//====================
-		// Private ctor
+		// Private methods
 		//====================
-		/**
-		 * @brief The default constructor for the ScriptingManager singleton.
-		 *
-		 * The constructor for the scripting manager is private to apply to the
-		 * singleton design pattern. The constructor will initialise the lua state
-		 * and load of the needed lua libraries.
-		 */
-		explicit ScriptingManager();
-
 		/**
 		 * @brief Binds the shader type enum to the scripting interface.
 		 * 
 		 * This method is invoked when the scripting API is first instantiated, it will bind
 		 * the eAssetType enum to the scripts so that it can be used within the Resources.lua.
 		 */
-		void bindAssetType();
+		static void bindAssetType(sol::state& state);
 
 		/**
 		 * @brief Binds the shader type enum to the scripting interface.
@@ -87,7 +115,7 @@ namespace pegasus
 		 * the eShaderType enum to the scripts so that it can be used within the serialized
 		 * shader program tables.
 		 */
-		void bindShaderType();
+		static void bindShaderType(sol::state& state);
 
 		/**
 		 * @brief Binds the textue type enum to the scripting interface.
@@ -96,7 +124,7 @@ namespace pegasus
 		 * the eTextureType enum to the scripts so that it can be used within the serialized
 		 * texture tables.
 		 */
-		void bindTextureType();
+		static void bindTextureType(sol::state& state);
 
 		/**
 		 * @brief Binds the textue type enum to the scripting interface.
@@ -105,7 +133,7 @@ namespace pegasus
 		 * the eFilterType enum to the scripts so that it can be used within the serialized
 		 * texture tables.
 		 */
-		void bindFilterType();
+		static void bindFilterType(sol::state& state);
 
 		/**
 		 * @brief Binds the textue type enum to the scripting interface.
@@ -114,12 +142,28 @@ namespace pegasus
 		 * the wWrapType enum to the scripts so that it can be used within the serialized
 		 * texture tables.
 		 */
-		void bindWrapType();
+		static void bindWrapType(sol::state& state);
+
+		/**
+		 * @brief Binds the uniform frequency enum to the scripting interface.
+		 *
+		 * This method is invoked when the scripting API is first instantiated, it will bind
+		 * the eUniformFrequency enum to the scripts so that it can be used within the uniform
+		 * declarations of the serialized shader program tables.
+		 */
+		static void bindUniformFrequency(sol::state& state);
 
 	public:
 		//====================
-		// Dtor
+		// Ctors and dtor
 		//====================
+		/**
+		 * @brief The default constructor for the ScriptingManager.
+		 *
+		 * The constructor will initialise the lua state and load of the needed lua libraries.
+		 */
+		explicit ScriptingManager();
+
 		/**
 		 * @brief Default destructor for the ScriptingManager.
 		 *
@@ -137,9 +181,84 @@ namespace pegasus
 		 * the subsequent scripts. It is used for de-serializing different objects into formats
 		 * that the Pegasus Engine can utilise.
 		 *
-		 * @returns The global lua state.
+		 * @returns The lua state of the engine.
 		 */
 		sol::state& getState();
+
+		/**
+		 * @brief Retrieves the pool of states used to de-serialize assets.
+		 *
+		 * The pool initially contains a single state, more can be reserved once the
+		 * [Scripting] section of the configuration file has been read.
+		 *
+		 * @returns The state pool.
+		 */
+		LuaStatePool& getPool();
+
+		/**
+		 * @brief Retrieves the cache of compiled scripts.
+		 *
+		 * @returns The bytecode cache.
+		 */
+		LuaBytecodeCache& getBytecodeCache();
+
+		/**
+		 * @brief Retrieves the allocator of the main state.
+		 *
+		 * The statistics of the pooled states are retrieved through their leases.
+		 *
+		 * @returns The allocator of the main state.
+		 */
+		LuaAllocator& getAllocator();
+
+		/**
+		 * @brief Retrieves the garbage collector of the main state.
+		 *
+		 * @returns The garbage collector.
+		 */
+		LuaGarbageCollector& getCollector();
+
+		/**
+		 * @brief Retrieves the profiler of the main state.
+		 *
+		 * @returns The profiler.
+		 */
+		LuaProfiler& getProfiler();
+
+		/**
+		 * @brief Retrieves the task scheduler of the main state.
+		 *
+		 * @returns The task scheduler.
+		 */
+		TaskScheduler& getScheduler();
+
+		/**
+		 * @brief Retrieves the engine arrays exposed to the main state.
+		 *
+		 * @returns The exposed arrays.
+		 */
+		LuaDataArrays& getArrays();
+
+		/**
+		 * @brief Sets the maximum amount of bytes the main state and each pooled state can allocate.
+		 *
+		 * The limit is ignored under PEGASUS_LUAJIT, as the states are not created with their allocators.
+		 *
+		 * @param limit The limit in bytes, zero if unlimited.
+		 */
+		void setMemoryLimit(std::size_t limit);
+
+		//====================
+		// Methods
+		//====================
+		/**
+		 * @brief Opens the default libraries and binds the engine types to a lua state.
+		 *
+		 * This method is invoked for the main state and each state within the pool.
+		 *
+		 * @param state The state to initialise.
+		 */
+		static void initialise(sol::state& state);
 	};
 
 } // namespace pegasus
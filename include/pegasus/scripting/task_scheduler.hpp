@@ -0,0 +1,285 @@
+/*
+* Pegasus Engine
+* 2017 - Benjamin Carter (bencarterdev@outlook.com)
+*
+* This software is provided 'as-is', without any express or implied warranty.
+* In no event will the authors be held liable for any damages arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it freely,
+* subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented;
+*    you must not claim that you wrote the original software.
+*    If you use this software in a product, an acknowledgement
+*    in the product documentation would be appreciated but is not required.
+*
+* 2. Altered source versions must be plainly marked as such,
+*    and must not be misrepresented as being the original software.
+*
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef _PEGASUS_TASK_SCHEDULER_HPP_
+#define _PEGASUS_TASK_SCHEDULER_HPP_
+
+//====================
+// C++ includes
+//====================
+#include <chrono>        // The execution budget of each frame.
+#include <cstddef>       // The task identifiers.
+#include <deque>         // The tasks ready to be resumed.
+#include <functional>    // Resolving awaited assets and reporting errors.
+#include <queue>         // The timer-ordered wake-ups.
+#include <string>        // The names of the awaited assets.
+#include <unordered_map> // Storing the tasks by identifier.
+#include <utility>       // Pairing the tasks with their awaited assets.
+#include <vector>        // The tasks awaiting assets.
+
+//====================
+// Pegasus includes
+//====================
+#include <pegasus/utilities/non_copyable.hpp> // The scheduler is bound to a single state.
+
+//====================
+// Library includes
+//====================
+#include <sol/sol.hpp> // The lua coroutines.
+
+namespace pegasus
+{
+	/**
+	 * @author Benjamin Carter
+	 *
+	 * @class pegasus::TaskScheduler
+	 * @ingroup scripting
+	 *
+	 * @brief Runs long-lived lua functions as coroutines that are resumed by the frame loop.
+	 *
+	 * A task is a lua function running within its own coroutine, started from lua with spawn(function)
+	 * or from the engine with TaskScheduler::spawn. Rather than polling every frame, a task suspends
+	 * itself with one of the following functions and is only resumed once the condition has been met:
+	 *
+	 *	wait(seconds)     : Resumes the task once the amount of time has elapsed.
+	 *	wait_frames(n)    : Resumes the task after n frames.
+	 *	await(name)       : Resumes the task once the named asset has been loaded, returning its handle.
+	 *	coroutine.yield() : Resumes the task on the next frame.
+	 *
+	 * Sleeping tasks are kept in min-heaps ordered by their wake-up time or frame, so each frame only
+	 * visits the tasks that are due. The due tasks are resumed in order until the execution budget of
+	 * the frame has been spent, any remaining tasks are resumed first on the next frame.
+	 *
+	 * Each task runs on its own lua thread, which inherits the hook of the state when it is spawned.
+	 * A LuaProfiler only arms the hook of the main thread, so tasks are not sampled while they run.
+	 */
+	class TaskScheduler final : NonCopyable
+	{
+	public:
+		//====================
+		// Enumerations
+		//====================
+		/**
+		 * @brief The condition a task is suspended on, yielded by the lua functions as their first value.
+		 */
+		enum class eWaitType
+		{
+			NEXT_FRAME = 0,
+			TIME = 1,
+			FRAMES = 2,
+			ASSET = 3
+		};
+
+	private:
+		//====================
+		// Structures
+		//====================
+		/**
+		 * @brief A lua function running within its own coroutine.
+		 */
+		struct Task_t
+		{
+			/** The lua thread the coroutine runs on. */
+			sol::thread    thread;
+			/** The function being resumed. */
+			sol::coroutine coroutine;
+			/** The asset the task is awaiting, it is loaded and passed to the task when it is resumed. */
+			std::string    asset;
+		};
+
+		/**
+		 * @brief A sleeping task and the time or frame it wakes up.
+		 */
+		template <typename T>
+		struct Wakeup_t
+		{
+			/** The time or frame the task is resumed. */
+			T           when;
+			/** The identifier of the task. */
+			std::size_t task;
+
+			bool operator>(const Wakeup_t& other) const
+			{
+				return when > other.when || (when == other.when && task > other.task);
+			}
+		};
+
+		/** A min-heap of wake-ups, the earliest is at the top. */
+		template <typename T>
+		using Timeline = std::priority_queue<Wakeup_t<T>, std::vector<Wakeup_t<T>>, std::greater<Wakeup_t<T>>>;
+
+		//====================
+		// Member variables
+		//====================
+		/** The state the coroutines are created within. */
+		sol::state&                                      m_state;
+		/** Every task that has not finished, keyed by identifier. */
+		std::unordered_map<std::size_t, Task_t>          m_tasks;
+		/** The tasks that are due to be resumed, in order. */
+		std::deque<std::size_t>                          m_ready;
+		/** The tasks sleeping for an amount of time. */
+		Timeline<double>                                 m_timers;
+		/** The tasks sleeping for an amount of frames. */
+		Timeline<std::size_t>                            m_frameTimers;
+		/** The tasks awaiting an asset. */
+		std::vector<std::pair<std::size_t, std::string>> m_awaiting;
+		/** Returns true once the named asset is available. */
+		std::function<bool(const std::string&)>          m_resolver;
+		/** Loads an available asset, returning the value an awaiting task is resumed with. */
+		std::function<sol::object(const std::string&)>   m_loader;
+		/** Receives the error of any task that fails. */
+		std::function<void(const std::string&)>          m_errorHandler;
+		/** The time that can be spent resuming tasks each frame. */
+		std::chrono::microseconds                        m_budget;
+		/** The time spent resuming tasks during the last frame. */
+		std::chrono::microseconds                        m_frameTime;
+		/** The amount of tasks resumed during the last frame. */
+		std::size_t                                      m_frameResumed;
+		/** The seconds elapsed since the scheduler was created. */
+		double                                           m_time;
+		/** The frames elapsed since the scheduler was created. */
+		std::size_t                                      m_frame;
+		/** The identifier of the next task. */
+		std::size_t                                      m_nextID;
+
+	private:
+		//====================
+		// Private methods
+		//====================
+		/**
+		 * @brief Resumes a task and schedules it according to the condition it yields.
+		 *
+		 * @param id The identifier of the task.
+		 */
+		void resume(std::size_t id);
+
+		/**
+		 * @brief Moves the sleeping and awaiting tasks that are due into the ready queue.
+		 */
+		void wake();
+
+	public:
+		//====================
+		// Ctors and dtor
+		//====================
+		/**
+		 * @brief Constructor for the TaskScheduler, binds spawn, wait, wait_frames and await to the state.
+		 *
+		 * @param state The state the tasks run within.
+		 */
+		explicit TaskScheduler(sol::state& state);
+
+		/**
+		 * @brief Default destructor.
+		 */
+		~TaskScheduler() = default;
+
+		//====================
+		// Getters and setters
+		//====================
+		/**
+		 * @brief Sets the time that can be spent resuming tasks each frame.
+		 *
+		 * At least one task is resumed each frame, so every task eventually makes progress.
+		 *
+		 * @param budget The budget of each frame, zero if unlimited.
+		 */
+		void setBudget(std::chrono::microseconds budget);
+
+		/**
+		 * @brief Sets the function that decides whether an awaited asset is available.
+		 *
+		 * The resolver is invoked once per frame for each awaiting task. Without a resolver,
+		 * awaited assets are treated as available immediately.
+		 *
+		 * @param resolver Returns true once the named asset is available.
+		 */
+		void setAssetResolver(std::function<bool(const std::string&)> resolver);
+
+		/**
+		 * @brief Sets the function that loads an awaited asset once it is available.
+		 *
+		 * The loader is invoked when the awaiting task is resumed, and its result is returned
+		 * to the task by await. Without a loader, await returns nil.
+		 *
+		 * @param loader Returns the handle of the named asset, or nil if it cannot be loaded.
+		 */
+		void setAssetLoader(std::function<sol::object(const std::string&)> loader);
+
+		/**
+		 * @brief Sets the function that receives the error of any task that fails.
+		 *
+		 * @param handler Receives the lua error message.
+		 */
+		void setErrorHandler(std::function<void(const std::string&)> handler);
+
+		/**
+		 * @brief Retrieves the amount of tasks that have not finished.
+		 *
+		 * @returns The amount of tasks.
+		 */
+		std::size_t getTaskCount() const;
+
+		/**
+		 * @brief Retrieves the time spent resuming tasks during the last frame.
+		 *
+		 * @returns The time spent within update().
+		 */
+		std::chrono::microseconds getFrameTime() const;
+
+		/**
+		 * @brief Retrieves the amount of tasks resumed during the last frame.
+		 *
+		 * @returns The amount of tasks.
+		 */
+		std::size_t getFrameResumed() const;
+
+		//====================
+		// Methods
+		//====================
+		/**
+		 * @brief Starts running a function as a task, it is first resumed by the next update.
+		 *
+		 * @param function The lua function to run.
+		 *
+		 * @returns The identifier of the task.
+		 */
+		std::size_t spawn(const sol::function& function);
+
+		/**
+		 * @brief Stops a task, it is never resumed again.
+		 *
+		 * @param id The identifier of the task.
+		 */
+		void cancel(std::size_t id);
+
+		/**
+		 * @brief Advances the scheduler by a single frame and resumes the tasks that are due.
+		 *
+		 * @param deltaTime The seconds elapsed since the last frame.
+		 */
+		void update(double deltaTime);
+	};
+
+} // namespace pegasus
+
+#endif//_PEGASUS_TASK_SCHEDULER_HPP_
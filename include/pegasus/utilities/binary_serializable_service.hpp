@@ -0,0 +1,142 @@
+/*
+* Pegasus Engine
+* 2017 - Benjamin Carter (bencarterdev@outlook.com)
+*
+* This software is provided 'as-is', without any express or implied warranty.
+* In no event will the authors be held liable for any damages arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it freely,
+* subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented;
+*    you must not claim that you wrote the original software.
+*    If you use this software in a product, an acknowledgement
+*    in the product documentation would be appreciated but is not required.
+*
+* 2. Altered source versions must be plainly marked as such,
+*    and must not be misrepresented as being the original software.
+*
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef _PEGASUS_BINARY_SERIALIZABLE_SERVICE_HPP_
+#define _PEGASUS_BINARY_SERIALIZABLE_SERVICE_HPP_
+
+//====================
+// Pegasus includes
+//====================
+#include <pegasus/utilities/iserializable_service.hpp> // BinarySerializableService is a serializable service.
+#include <pegasus/utilities/cooked_asset.hpp>          // The layout of the cooked files.
+
+namespace pegasus
+{
+	//====================
+	// Forward declarations
+	//====================
+	class MappedFile;
+
+	/**
+	 * @author Benjamin Carter
+	 *
+	 * @class pegasus::BinarySerializableService
+	 * @ingroup utilities
+	 *
+	 * @brief De-serializes cooked assets and Resources files.
+	 *
+	 * Cooked files are produced ahead of time by the CookedAssetWriter and store the flat
+	 * structures declared in cooked_asset.hpp. The files are memory-mapped and the structures
+	 * are read in-place, so there is no parsing or scripting involved in loading an asset. Only
+	 * the header and the bounds of each offset are validated. This is the format intended for
+	 * production builds.
+	 */
+	class BinarySerializableService final : public ISerializableService
+	{
+	private:
+		//====================
+		// Private methods
+		//====================
+		/**
+		 * @brief Maps a cooked file and validates its header.
+		 *
+		 * @param filename The file location of the cooked file.
+		 * @param type     The type of structure the file is expected to hold.
+		 * @param file     The file object that will hold the mapping.
+		 *
+		 * @returns The validated header, or an error if the file could not be found or is not a valid
+		 * cooked file of the specified type.
+		 */
+		static Expected<const CookedHeader_t*> open(const std::string& filename, eCookedType type, MappedFile& file);
+
+		/**
+		 * @brief De-serializes a cooked shader program.
+		 *
+		 * @param filename The file location of the cooked file.
+		 *
+		 * @returns A new shader program object, or an error if the file cannot be read or declares no shaders.
+		 */
+		Expected<Asset*> deserializeShaderProgram(const std::string& filename) const;
+
+		/**
+		 * @brief De-serializes a cooked texture.
+		 *
+		 * @param filename The file location of the cooked file.
+		 *
+		 * @returns A new Texture object, or an error if the file cannot be read or declares no source.
+		 */
+		Expected<Asset*> deserializeTexture(const std::string& filename) const;
+
+	public:
+		//====================
+		// Ctors and dtor
+		//====================
+		/**
+		 * @brief Default constructor for the BinarySerializableService.
+		 */
+		explicit BinarySerializableService();
+
+		/**
+		 * @brief Default destructor.
+		 */
+		~BinarySerializableService() = default;
+
+		//====================
+		// Getters and setters
+		//====================
+		/**
+		 * @brief Retrieves whether the service can de-serialize files from multiple threads.
+		 *
+		 * The service holds no state, so it can always be invoked concurrently.
+		 *
+		 * @returns True.
+		 */
+		bool isConcurrent() const override;
+
+		//====================
+		// Methods
+		//====================
+		/**
+		 * @brief Deserializes the specified cooked asset into a format that the engine can utilise.
+		 *
+		 * @param type     The asset type to de-serialize.
+		 * @param filename The file location of the cooked asset.
+		 *
+		 * @returns A pointer to a Asset resource, or the error that prevented it being created.
+		 */
+		Expected<Asset*> deserialize(eAssetType type, const std::string& filename) const override;
+
+		/**
+		 * @brief De-serializes a cooked Resources file into a format that the pegasus engine can utilise.
+		 *
+		 * If the Resources file is not found or is not a valid cooked file, a NoResourceException will be thrown.
+		 *
+		 * @param filename The file location of the cooked Resources file.
+		 *
+		 * @returns A map of resources and their subsequent names.
+		 */
+		std::unordered_map<std::string, Resource_t> deserializeResources(const std::string& filename) const override;
+	};
+
+} // namespace pegasus
+
+#endif//_PEGASUS_BINARY_SERIALIZABLE_SERVICE_HPP_
@@ -0,0 +1,142 @@
+/*
+* Pegasus Engine
+* 2017 - Benjamin Carter (bencarterdev@outlook.com)
+*
+* This software is provided 'as-is', without any express or implied warranty.
+* In no event will the authors be held liable for any damages arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it freely,
+* subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented;
+*    you must not claim that you wrote the original software.
+*    If you use this software in a product, an acknowledgement
+*    in the product documentation would be appreciated but is not required.
+*
+* 2. Altered source versions must be plainly marked as such,
+*    and must not be misrepresented as being the original software.
+*
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef _PEGASUS_COOKED_ASSET_HPP_
+#define _PEGASUS_COOKED_ASSET_HPP_
+
+//====================
+// C++ includes
+//====================
+#include <cstdint> // Fixed width fields, so the layout is identical on every platform.
+
+namespace pegasus
+{
+	//====================
+	// Enumerations
+	//====================
+	enum class eCookedType : std::uint32_t
+	{
+		/** The file is a cooked Resources file. */
+		RESOURCES,
+		/** The file is a cooked shader program. */
+		SHADER_PROGRAM,
+		/** The file is a cooked texture. */
+		TEXTURE
+	};
+
+	//====================
+	// Constant variables
+	//====================
+	/** Identifies a cooked asset file, "PGSB" when read as bytes. */
+	const char          COOKED_MAGIC[4] = { 'P', 'G', 'S', 'B' };
+	/** The layout version written by the CookedAssetWriter. Files of any other version are rejected. */
+	const std::uint32_t COOKED_VERSION = 1;
+
+	//====================
+	// Structures
+	//====================
+	/*
+	 * Cooked assets are flat, little-endian images of the structures below. Every structure is
+	 * four byte aligned and references other data by its offset from the start of the file, so
+	 * a mapped file can be read in-place without any parsing. Strings are stored in a table after
+	 * the structures and are always null-terminated.
+	 */
+	struct CookedHeader_t
+	{
+		/** Must match COOKED_MAGIC. */
+		char          magic[4];
+		/** Must match COOKED_VERSION. */
+		std::uint32_t version;
+		/** The type of structure that follows the header. */
+		eCookedType   type;
+		/** The total size of the file in bytes, used to detect truncated files. */
+		std::uint32_t size;
+	};
+
+	struct CookedString_t
+	{
+		/** The offset of the first character from the start of the file. */
+		std::uint32_t offset;
+		/** The length of the string, excluding the null-terminator. */
+		std::uint32_t length;
+	};
+
+	struct CookedResource_t
+	{
+		/** The name the resource is requested with. */
+		CookedString_t name;
+		/** The file location of the resource. */
+		CookedString_t path;
+		/** The eAssetType of the resource. */
+		std::uint32_t  type;
+	};
+
+	struct CookedResources_t
+	{
+		/** The amount of CookedResource_t entries. */
+		std::uint32_t count;
+		/** The offset of the first CookedResource_t entry. */
+		std::uint32_t offset;
+	};
+
+	struct CookedShader_t
+	{
+		/** The file location of the glsl source. */
+		CookedString_t source;
+		/** The GLenum value of the gl::eShaderType. */
+		std::uint32_t  type;
+	};
+
+	struct CookedShaderProgram_t
+	{
+		/** The debug name of the program. */
+		CookedString_t name;
+		/** The amount of CookedShader_t entries. */
+		std::uint32_t  count;
+		/** The offset of the first CookedShader_t entry. */
+		std::uint32_t  offset;
+	};
+
+	struct CookedTexture_t
+	{
+		/** The debug name of the texture. */
+		CookedString_t name;
+		/** The file location of the image. */
+		CookedString_t source;
+		/** The GLenum value of the gl::eTextureType. */
+		std::uint32_t  type;
+		/** The GLenum value of the gl::eFilterType. */
+		std::uint32_t  filtering;
+		/** The GLenum value of the gl::eWrapType. */
+		std::uint32_t  wrapping;
+	};
+
+	static_assert(sizeof(CookedHeader_t) == 16, "The cooked header layout has changed, increment COOKED_VERSION.");
+	static_assert(sizeof(CookedString_t) == 8, "The cooked string layout has changed, increment COOKED_VERSION.");
+	static_assert(sizeof(CookedResource_t) == 20, "The cooked resource layout has changed, increment COOKED_VERSION.");
+	static_assert(sizeof(CookedShader_t) == 12, "The cooked shader layout has changed, increment COOKED_VERSION.");
+	static_assert(sizeof(CookedShaderProgram_t) == 16, "The cooked program layout has changed, increment COOKED_VERSION.");
+	static_assert(sizeof(CookedTexture_t) == 28, "The cooked texture layout has changed, increment COOKED_VERSION.");
+
+} // namespace pegasus
+
+#endif//_PEGASUS_COOKED_ASSET_HPP_
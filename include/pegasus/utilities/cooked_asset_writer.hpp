@@ -0,0 +1,161 @@
+/*
+* Pegasus Engine
+* 2017 - Benjamin Carter (bencarterdev@outlook.com)
+*
+* This software is provided 'as-is', without any express or implied warranty.
+* In no event will the authors be held liable for any damages arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it freely,
+* subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented;
+*    you must not claim that you wrote the original software.
+*    If you use this software in a product, an acknowledgement
+*    in the product documentation would be appreciated but is not required.
+*
+* 2. Altered source versions must be plainly marked as such,
+*    and must not be misrepresented as being the original software.
+*
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef _PEGASUS_COOKED_ASSET_WRITER_HPP_
+#define _PEGASUS_COOKED_ASSET_WRITER_HPP_
+
+//====================
+// C++ includes
+//====================
+#include <string>        // File locations and names of the cooked assets.
+#include <unordered_map> // Cooking a map of resources.
+#include <utility>       // Pairing shader types with their sources.
+#include <vector>        // The cooked data.
+
+//====================
+// Pegasus includes
+//====================
+#include <pegasus/core/resource.hpp>                // Cooking the Resources file.
+#include <pegasus/graphics/texture_description.hpp> // Cooking textures.
+#include <pegasus/utilities/cooked_asset.hpp>       // The cooked layout.
+
+namespace pegasus
+{
+	/**
+	 * @author Benjamin Carter
+	 *
+	 * @class pegasus::CookedAssetWriter
+	 * @ingroup utilities
+	 *
+	 * @brief Produces cooked asset files that can be read by the BinarySerializableService.
+	 *
+	 * The writer is used by content tools to convert the lua, xml and json descriptions into
+	 * the flat binary layout declared in cooked_asset.hpp. Each method returns the complete file,
+	 * which can be written to disk with CookedAssetWriter::save.
+	 */
+	class CookedAssetWriter final
+	{
+	private:
+		//====================
+		// Member variables
+		//====================
+		/** The file being built. */
+		std::vector<char> m_data;
+
+	private:
+		//====================
+		// Private ctors
+		//====================
+		/**
+		 * @brief Starts a new file with a header of the specified type.
+		 *
+		 * @param type The type of structure that follows the header.
+		 */
+		explicit CookedAssetWriter(eCookedType type);
+
+		//====================
+		// Private methods
+		//====================
+		/**
+		 * @brief Reserves zeroed, four byte aligned space at the end of the file.
+		 *
+		 * @param size The amount of bytes to reserve.
+		 *
+		 * @returns The offset of the reserved space.
+		 */
+		std::uint32_t allocate(std::size_t size);
+
+		/**
+		 * @brief Retrieves a structure previously allocated within the file.
+		 *
+		 * The pointer is invalidated by the next allocation.
+		 *
+		 * @param offset The offset of the structure.
+		 *
+		 * @returns The structure at the offset.
+		 */
+		template <typename T>
+		T* at(std::uint32_t offset);
+
+		/**
+		 * @brief Appends a null-terminated string to the end of the file.
+		 *
+		 * @param str The string to append.
+		 *
+		 * @returns The location of the string.
+		 */
+		CookedString_t addString(const std::string& str);
+
+		/**
+		 * @brief Completes the header and releases the file.
+		 *
+		 * @returns The complete file.
+		 */
+		std::vector<char> finish();
+
+	public:
+		//====================
+		// Methods
+		//====================
+		/**
+		 * @brief Cooks a map of resources.
+		 *
+		 * @param resources The resources to cook, keyed by name.
+		 *
+		 * @returns The cooked file.
+		 */
+		static std::vector<char> cookResources(const std::unordered_map<std::string, Resource_t>& resources);
+
+		/**
+		 * @brief Cooks a shader program.
+		 *
+		 * @param name    The debug name of the program.
+		 * @param shaders The type and file location of each shader within the program.
+		 *
+		 * @returns The cooked file.
+		 */
+		static std::vector<char> cookShaderProgram(const std::string& name, const std::vector<std::pair<gl::eShaderType, std::string>>& shaders);
+
+		/**
+		 * @brief Cooks a texture.
+		 *
+		 * @param name        The debug name of the texture.
+		 * @param description The description the texture is created from.
+		 *
+		 * @returns The cooked file.
+		 */
+		static std::vector<char> cookTexture(const std::string& name, const TextureDescription_t& description);
+
+		/**
+		 * @brief Writes a cooked file to disk.
+		 *
+		 * @param filename The file location to write to.
+		 * @param data     The cooked file.
+		 *
+		 * @returns True if the file was written successfully.
+		 */
+		static bool save(const std::string& filename, const std::vector<char>& data);
+	};
+
+} // namespace pegasus
+
+#endif//_PEGASUS_COOKED_ASSET_WRITER_HPP_
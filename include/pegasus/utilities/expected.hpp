@@ -0,0 +1,195 @@
+/*
+* Pegasus Engine
+* 2017 - Benjamin Carter (bencarterdev@outlook.com)
+*
+* This software is provided 'as-is', without any express or implied warranty.
+* In no event will the authors be held liable for any damages arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it freely,
+* subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented;
+*    you must not claim that you wrote the original software.
+*    If you use this software in a product, an acknowledgement
+*    in the product documentation would be appreciated but is not required.
+*
+* 2. Altered source versions must be plainly marked as such,
+*    and must not be misrepresented as being the original software.
+*
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef _PEGASUS_EXPECTED_HPP_
+#define _PEGASUS_EXPECTED_HPP_
+
+//====================
+// C++ includes
+//====================
+#include <string>  // The message describing the error.
+#include <utility> // Moving the value and error into the result.
+
+namespace pegasus
+{
+	//====================
+	// Enumerations
+	//====================
+	enum class eErrorCode
+	{
+		/** No error has occurred. */
+		NONE,
+		/** The requested name or file does not exist. */
+		NOT_FOUND,
+		/** The file exists, but its contents are not valid. */
+		INVALID_FORMAT,
+		/** The file was produced for a different version or type. */
+		UNSUPPORTED
+	};
+
+	//====================
+	// Structures
+	//====================
+	struct Error_t
+	{
+		/** The category of the error. */
+		eErrorCode  code;
+		/** A description of the error, suitable for logging. */
+		std::string message;
+	};
+
+	/**
+	 * @author Benjamin Carter
+	 *
+	 * @class pegasus::Expected
+	 * @ingroup utilities
+	 *
+	 * @brief Holds either the result of an operation or the error that prevented it.
+	 *
+	 * Expected is returned by operations that are expected to fail during normal use, such as
+	 * looking up an asset that does not exist. Failures are reported to the caller as values
+	 * instead of exceptions, so a failed request costs no more than a successful one. An Error_t
+	 * is implicitly converted into a failed result, which allows functions to simply return it.
+	 */
+	template <typename T>
+	class Expected final
+	{
+	private:
+		//====================
+		// Member variables
+		//====================
+		/** The result of the operation, only valid if there is no error. */
+		T       m_value;
+		/** The error that occurred, eErrorCode::NONE if the operation succeeded. */
+		Error_t m_error;
+
+	public:
+		//====================
+		// Ctors and dtor
+		//====================
+		/**
+		 * @brief Constructs a successful result.
+		 *
+		 * @param value The result of the operation.
+		 */
+		Expected(T value);
+
+		/**
+		 * @brief Constructs a failed result.
+		 *
+		 * @param error The error that occurred.
+		 */
+		Expected(Error_t error);
+
+		//====================
+		// Getters and setters
+		//====================
+		/**
+		 * @brief Retrieves whether the operation succeeded.
+		 *
+		 * @returns True if the result holds a value.
+		 */
+		bool hasValue() const;
+
+		/**
+		 * @brief Retrieves the result of the operation.
+		 *
+		 * The value must only be retrieved if hasValue returns true.
+		 *
+		 * @returns The result of the operation.
+		 */
+		const T& getValue() const;
+
+		/**
+		 * @brief Retrieves the error that occurred.
+		 *
+		 * @returns The error, with an eErrorCode::NONE code if the operation succeeded.
+		 */
+		const Error_t& getError() const;
+
+		//====================
+		// Operators
+		//====================
+		/**
+		 * @brief Checks whether the operation succeeded.
+		 *
+		 * @returns True if the result holds a value.
+		 */
+		explicit operator bool() const;
+	};
+
+	//====================
+	// Ctors and dtor
+	//====================
+	/**********************************************************/
+	template <typename T>
+	Expected<T>::Expected(T value)
+		: m_value(std::move(value)), m_error{ eErrorCode::NONE, std::string() }
+	{
+		// Empty.
+	}
+
+	/**********************************************************/
+	template <typename T>
+	Expected<T>::Expected(Error_t error)
+		: m_value(), m_error(std::move(error))
+	{
+		// Empty.
+	}
+
+	//====================
+	// Getters and setters
+	//====================
+	/**********************************************************/
+	template <typename T>
+	bool Expected<T>::hasValue() const
+	{
+		return m_error.code == eErrorCode::NONE;
+	}
+
+	/**********************************************************/
+	template <typename T>
+	const T& Expected<T>::getValue() const
+	{
+		return m_value;
+	}
+
+	/**********************************************************/
+	template <typename T>
+	const Error_t& Expected<T>::getError() const
+	{
+		return m_error;
+	}
+
+	//====================
+	// Operators
+	//====================
+	/**********************************************************/
+	template <typename T>
+	Expected<T>::operator bool() const
+	{
+		return this->hasValue();
+	}
+
+} // namespace pegasus
+
+#endif//_PEGASUS_EXPECTED_HPP_
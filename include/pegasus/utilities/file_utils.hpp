@@ -0,0 +1,83 @@
+/*
+* Pegasus Engine
+* 2017 - Benjamin Carter (bencarterdev@outlook.com)
+*
+* This software is provided 'as-is', without any express or implied warranty.
+* In no event will the authors be held liable for any damages arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it freely,
+* subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented;
+*    you must not claim that you wrote the original software.
+*    If you use this software in a product, an acknowledgement
+*    in the product documentation would be appreciated but is not required.
+*
+* 2. Altered source versions must be plainly marked as such,
+*    and must not be misrepresented as being the original software.
+*
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef _PEGASUS_FILE_UTILS_HPP_
+#define _PEGASUS_FILE_UTILS_HPP_
+
+//====================
+// C++ includes
+//====================
+#include <cstdint> // The modification time is a fixed width value.
+#include <cstddef> // The size of the written data.
+#include <string>  // The file location to query.
+
+namespace pegasus
+{
+	class FileUtils final
+	{
+	public:
+		//====================
+		// Methods
+		//====================
+		/**
+		 * @brief Retrieves the time a file was last modified.
+		 *
+		 * The value is only meaningful when compared against another value retrieved from this
+		 * method, and is used to detect whether a file has changed on disk.
+		 *
+		 * @param filename The file location to query.
+		 *
+		 * @returns The last modification time of the file, or -1 if the file does not exist.
+		 */
+		static std::int64_t getModifiedTime(const std::string& filename);
+
+		/**
+		 * @brief Creates a directory if it does not already exist.
+		 *
+		 * Only the last component of the path is created, its parent must already exist.
+		 *
+		 * @param path The location of the directory.
+		 *
+		 * @returns True if the directory exists once the method returns.
+		 */
+		static bool createDirectory(const std::string& path);
+
+		/**
+		 * @brief Replaces the contents of a file, without leaving a partially written file behind.
+		 *
+		 * The data is written to a temporary file next to the destination, which is then renamed over
+		 * the destination. A reader either sees the previous file or the complete new file, even if the
+		 * application exits whilst writing. The temporary file is named after the process and thread
+		 * writing it, so several processes sharing a directory never write to the same temporary file.
+		 *
+		 * @param filename The file location to write.
+		 * @param pData    The data to write.
+		 * @param size     The size of the data in bytes.
+		 *
+		 * @returns True if the file was replaced.
+		 */
+		static bool replaceFile(const std::string& filename, const void* pData, std::size_t size);
+	};
+
+} // namespace pegasus
+
+#endif//_PEGASUS_FILE_UTILS_HPP_
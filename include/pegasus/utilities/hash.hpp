@@ -0,0 +1,121 @@
+/*
+* Pegasus Engine
+* 2017 - Benjamin Carter (bencarterdev@outlook.com)
+*
+* This software is provided 'as-is', without any express or implied warranty.
+* In no event will the authors be held liable for any damages arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it freely,
+* subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented;
+*    you must not claim that you wrote the original software.
+*    If you use this software in a product, an acknowledgement
+*    in the product documentation would be appreciated but is not required.
+*
+* 2. Altered source versions must be plainly marked as such,
+*    and must not be misrepresented as being the original software.
+*
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef _PEGASUS_HASH_HPP_
+#define _PEGASUS_HASH_HPP_
+
+//====================
+// C++ includes
+//====================
+#include <cstdint> // Fixed width hash values.
+#include <cstddef> // Sizes of the data being hashed.
+#include <string>  // Hashing string objects.
+
+namespace pegasus
+{
+	/**
+	 * @author Benjamin Carter
+	 *
+	 * @class pegasus::Hash
+	 * @ingroup utilities
+	 *
+	 * @brief Provides stable, platform independent hashing of strings and raw data.
+	 *
+	 * std::hash is not guaranteed to produce the same value between runs, compilers or
+	 * platforms, which makes it unsuitable for anything that is written to disk or used to
+	 * partition data between files. The Hash class implements the 64-bit FNV-1a algorithm,
+	 * which is cheap to compute and can be evaluated at compile-time for string literals.
+	 */
+	class Hash final
+	{
+	public:
+		//====================
+		// Constants
+		//====================
+		/** The initial value of a FNV-1a hash. */
+		static constexpr std::uint64_t OFFSET_BASIS = 14695981039346656037ULL;
+		/** The FNV-1a multiplication prime. */
+		static constexpr std::uint64_t PRIME = 1099511628211ULL;
+
+		//====================
+		// Methods
+		//====================
+		/**
+		 * @brief Hashes a null-terminated string.
+		 *
+		 * This overload can be evaluated at compile-time, which allows hashed names to be
+		 * used as constant keys without any runtime cost.
+		 *
+		 * @param pStr The null-terminated string to hash.
+		 * @param seed The value to continue hashing from.
+		 *
+		 * @returns The 64-bit hash of the string.
+		 */
+		static constexpr std::uint64_t fnv1a(const char* pStr, std::uint64_t seed = OFFSET_BASIS)
+		{
+			std::uint64_t hash = seed;
+			while (*pStr)
+			{
+				hash = (hash ^ static_cast<unsigned char>(*pStr++)) * PRIME;
+			}
+
+			return hash;
+		}
+
+		/**
+		 * @brief Hashes a block of raw memory.
+		 *
+		 * @param pData The data to hash.
+		 * @param size  The amount of bytes to hash.
+		 * @param seed  The value to continue hashing from, used to combine multiple blocks.
+		 *
+		 * @returns The 64-bit hash of the data.
+		 */
+		static std::uint64_t fnv1aBytes(const void* pData, std::size_t size, std::uint64_t seed = OFFSET_BASIS)
+		{
+			const unsigned char* pBytes = static_cast<const unsigned char*>(pData);
+			std::uint64_t hash = seed;
+			for (std::size_t i = 0; i < size; i++)
+			{
+				hash = (hash ^ pBytes[i]) * PRIME;
+			}
+
+			return hash;
+		}
+
+		/**
+		 * @brief Hashes a string object.
+		 *
+		 * @param str  The string to hash.
+		 * @param seed The value to continue hashing from.
+		 *
+		 * @returns The 64-bit hash of the string.
+		 */
+		static std::uint64_t fnv1a(const std::string& str, std::uint64_t seed = OFFSET_BASIS)
+		{
+			return Hash::fnv1aBytes(str.data(), str.size(), seed);
+		}
+	};
+
+} // namespace pegasus
+
+#endif//_PEGASUS_HASH_HPP_
@@ -28,8 +28,8 @@
 //====================
 #include <unordered_map> // Storing a list of assets.
 #include <memory>        // The serializable service is stored as a smart pointer.
-#include <typeindex>     // Stores the type the factory is registered with.
 #include <string>        // Retrieving assets from the resource name.
+#include <cstdint>       // Storing the modification time of failed files.
 
 //==================== 
 // Pegasus includes
@@ -37,6 +37,7 @@
 #include <pegasus/utilities/non_copyable.hpp>          // The factory cannot be copied.
 #include <pegasus/utilities/iserializable_service.hpp> // The serializable service for the asset factory.
 #include <pegasus/core/resources.hpp>                  // Retrieving the resource from the Resources.xxx file.
+#include <pegasus/utilities/type_id.hpp>               // Identifying the type the factory is registered with.
 
 namespace pegasus
 {
@@ -46,6 +47,19 @@ namespace pegasus
 	class Logger;
     class Asset;
 
+	/**
+	 * @brief Maps an asset type to the concrete factory that creates it.
+	 *
+	 * Each factory specialises the traits for the asset it loads, declaring the factory as Factory,
+	 * e.g. AssetFactoryTraits<Texture>::Factory is the TextureFactory. Requesting an asset type that has
+	 * no specialisation from the ResourceManager is a compile-time error. In turn, each factory declares
+	 * the asset it creates as AssetType, so the ResourceManager only registers the matching factory.
+	 *
+	 * @tparam T The type of asset.
+	 */
+	template <typename T>
+	struct AssetFactoryTraits;
+
 	/**
 	 * @author Benjamin Carter
 	 * 
@@ -59,33 +73,60 @@ namespace pegasus
 	 * can be utilised by the application. The majority of asset factories will cache resources to prevent duplication
 	 * of data. 
 	 * 
-	 * Each factory is assigned a unique type upon construction. The type is used when the factory is registered with the
-	 * ResourceManager. The type is then utilised to retrieve the correct factory when requesting resources through the manager.
-	 * There cannot be multiple factories registered to the same type, each factory is uniquely defined. The life-time of each
-	 * factory is managed through the ResourceManager object, and should not be manually deleted outside this scope.
+	 * Each factory is assigned a unique TypeID upon construction. The TypeID is used as the factory's slot when it is registered
+	 * with the ResourceManager, and AssetFactoryTraits maps each asset type to its concrete factory, so the manager can retrieve
+	 * and call the correct factory without any hashing or virtual dispatch. There cannot be multiple factories registered to the
+	 * same type, each factory is uniquely defined. The life-time of each factory is managed through the ResourceManager object,
+	 * and should not be manually deleted outside this scope.
+	 * 
+	 * Names that fail to load are remembered by the factory, so repeated requests for a broken asset return the
+	 * default without touching the disk again. A failed name is retried once the Resources file has been re-loaded,
+	 * or once IAssetFactory::revalidate finds that the file has been modified.
+	 * 
+	 * Whole namespaces of assets can be loaded and unloaded at once, e.g. every asset beginning with "level3.". Assets
+	 * loaded this way are retained by the factory until the namespace is unloaded, regardless of the threshold.
 	 * 
 	 * An implementation of the IAssetFactory abstract class is provided with the TextureFactory class. 
 	 */
 	class IAssetFactory : NonCopyable
 	{
 	private:
+		//====================
+		// Structures
+		//====================
+		struct Failure_t
+		{
+			/** The generation of the Resources file when the load failed. */
+			std::size_t  generation;
+			/** The file location of the asset, empty if the name was not found within the Resources file. */
+			std::string  path;
+			/** The modification time of the file when the load failed. */
+			std::int64_t modified;
+		};
+
 		//====================
 		// Member variables
 		//====================
         /** The injected serialization method this factory will utilitize. */
         ISerializableService* m_pService;
-		/** The unique object type that this asset factory is bound to/will produce. */
-	    std::type_index       m_type; 
+		/** The TypeID of the object type that this asset factory is bound to/will produce. */
+	    std::size_t           m_typeID; 
+		/** The type of the resources within the Resources file that this factory loads. */
+		eAssetType            m_assetType;
 		/** The threshold in which un-used resources will be cleared from memory. */
 	    std::size_t           m_threshold;
+		/** The names that have failed to load, and the state they failed in. */
+		std::unordered_map<std::string, Failure_t> m_failures;
+		/** The assets retained by the factory after being loaded as part of a namespace, keyed by name. */
+		std::unordered_map<std::string, Asset*>    m_pinned;
 	
 	protected:
 		/** Logging the details of the factory. */
 		Logger& m_logger;
 		/** Store the assets within a map for quick retrieval. */
 		std::unordered_map<std::string, Asset*> m_assets;
-		/** Loading file locations from the Resources.xxx file. */
-		Resources m_resources;
+		/** Loading file locations from the Resources.xxx file, owned by the Engine. */
+		Resources& m_resources;
 
 	protected:
 		//====================
@@ -102,6 +143,39 @@ namespace pegasus
 		 */
 		void checkThreshold();
 
+		/**
+		 * @brief Checks whether a name has previously failed to load.
+		 *
+		 * A failure is only remembered for the generation of the Resources file it occurred in,
+		 * any failure recorded against an older Resources file is discarded.
+		 *
+		 * @param name The name of the resource within the Resources.xxx file.
+		 *
+		 * @returns True if the name has failed to load and should not be retried.
+		 */
+		bool isFailed(const std::string& name);
+
+		/**
+		 * @brief Remembers that a name has failed to load.
+		 *
+		 * @param name The name of the resource within the Resources.xxx file.
+		 * @param path The file location of the asset, or an empty string if the name could not be resolved.
+		 */
+		void setFailed(const std::string& name, const std::string& path);
+
+		/**
+		 * @brief Resolves and de-serializes an asset, re-using any asset already loaded from the same file.
+		 *
+		 * This is the shared loading path of the factories. The threshold is checked, names that have
+		 * previously failed are skipped, and any new asset is retained within the factory. A failure of the
+		 * serializable service, including any exception it throws, is logged and remembered.
+		 *
+		 * @param name The name of the resource within the Resources.xxx file.
+		 *
+		 * @returns The asset, or nullptr if the asset could not be loaded and the default should be used instead.
+		 */
+		Asset* loadAsset(const std::string& name);
+
 	private:
 		//====================
 		// Private ctors
@@ -110,7 +184,7 @@ namespace pegasus
 		 * @brief Default constructor for the asset factory.
 		 * 
 		 * The default constructor for the asset factory is deleted. The factory must have a definition
-		 * for the name and type_index supplied at construction for correct behavior when being registered with
+		 * for the name and TypeID supplied at construction for correct behavior when being registered with
 		 * the ResourceManager. 
 		 */
 		explicit IAssetFactory() = delete;
@@ -134,13 +208,15 @@ namespace pegasus
 		 * @brief IAssetFactory constructor with definitions for name and type.
 		 * 
 		 * This constructor is the only publically available constructor to all child factory classes. When a factory is
-		 * registered with the ResourceManager, it uses the std::type_index to define which resources individual factories
+		 * registered with the ResourceManager, it uses the TypeID to define which resources individual factories
 		 * will be responsible for. Only one factory of a specific type can be registed with the ResourceManager.
 		 * 
-		 * @param type      The resource type that this asset factory will be bound to when requesting resources.
+		 * @param resources The Resources object the factory resolves names with, it must outlive the factory.
+		 * @param typeID    The TypeID of the resource type that this asset factory will be bound to when requesting resources.
+		 * @param assetType The type of the resources within the Resources file that this factory loads.
 		 * @param threshold How many resources can be retained before un-referenced resources will be cleared from memory.
 		 */
-	    explicit IAssetFactory(const std::type_index& type, std::size_t threshold = 10);
+	    explicit IAssetFactory(Resources& resources, std::size_t typeID, eAssetType assetType, std::size_t threshold = 10);
 	    
 	    /**
 	     * @brief Destructor for the asset factory.
@@ -184,9 +260,19 @@ namespace pegasus
 	     * manage the creation and lifetime of. The type is also used to retrieve the correct factory when requesting resources
 	     * via the ResourceManager. Only one factory of each type can be registered.
 	     * 
-	     * @returns The resource type this factory is bound to.
+	     * @returns The TypeID of the resource type this factory is bound to.
 	     */
-	    const std::type_index& getType() const;
+	    std::size_t getTypeID() const;
+
+		/**
+		 * @brief Retrieves the type of resources that this factory loads.
+		 *
+		 * When a namespace is loaded, only the resources declared with this type within the
+		 * Resources file are loaded by the factory.
+		 *
+		 * @returns The asset type of the factory.
+		 */
+		eAssetType getAssetType() const;
 	    
 	    /**
 	     * @brief Retrieves the current threshold of the factory.
@@ -226,6 +312,51 @@ namespace pegasus
 	     * @returns The request asset, or a default resource if retrieval fails.
 	     */
 	    virtual Asset* load(const std::string& name) = 0;
+
+		/**
+		 * @brief Forgets any failed names whose files have since been modified.
+		 *
+		 * Failed names are not checked against the disk when they are requested, as that would cost a
+		 * file system query on every request. This method should be invoked when files are expected to have
+		 * changed, such as when the application regains focus during development. Failures that were caused by
+		 * a missing name are only retried once the Resources file is re-loaded.
+		 */
+		void revalidate();
+
+		/**
+		 * @brief Loads every asset of this factory's type within a namespace.
+		 *
+		 * Each loaded asset is retained until the namespace is unloaded, so the assets remain in memory
+		 * regardless of the threshold. Assets that fail to load are skipped.
+		 *
+		 * @param prefix The namespace to load, e.g. "level3.".
+		 *
+		 * @returns The amount of assets that were loaded.
+		 */
+		std::size_t loadAll(const std::string& prefix);
+
+		/**
+		 * @brief Releases every asset that was loaded within a namespace.
+		 *
+		 * The assets retained by IAssetFactory::loadAll are released, and any asset within the namespace
+		 * that is no longer referenced is deleted immediately.
+		 *
+		 * @param prefix The namespace to unload, e.g. "level3.".
+		 *
+		 * @returns The amount of assets that were deleted.
+		 */
+		std::size_t unloadAll(const std::string& prefix);
+
+		/**
+		 * @brief Retrieves the memory used by the loaded assets within a namespace.
+		 *
+		 * Assets that are shared by multiple names within the namespace are only counted once.
+		 *
+		 * @param prefix The namespace to account for. An empty prefix accounts for every asset.
+		 *
+		 * @returns The estimated memory usage in bytes.
+		 */
+		std::size_t getMemoryUsage(const std::string& prefix) const;
 	};
 	
 } // namespace pegasus
@@ -9,7 +9,8 @@
 //==================== 
 // Pegasus includes
 //==================== 
-#include <pegasus/core/resource.hpp> // Represents a single resource.
+#include <pegasus/core/resource.hpp>       // Represents a single resource.
+#include <pegasus/utilities/expected.hpp> // Reporting de-serialization failures without exceptions.
 
 namespace pegasus
 {
@@ -44,6 +45,20 @@ namespace pegasus
          */
         virtual ~ISerializableService() = default;
 
+        //==================== 
+        // Getters and setters
+        //==================== 
+        /**
+         * @brief Retrieves whether the service can de-serialize files from multiple threads.
+         *
+         * Services that share state between calls, such as a single scripting state, cannot
+         * be invoked concurrently. The Resources class uses this flag to decide whether shards
+         * can be prefetched on worker threads. By default services are not concurrent.
+         *
+         * @returns True if the service can be used from multiple threads simultaneously.
+         */
+        virtual bool isConcurrent() const { return false; }
+
         //==================== 
         // Methods
         //==================== 
@@ -54,12 +69,15 @@ namespace pegasus
          * methods. When this method is invoked, it will de-serialize an external file into the
          * specified asset so that it can be used within the pegasus engine.
          *
+         * Missing or malformed files are common during development, so they are reported through
+         * the returned value instead of an exception.
+         *
          * @param type The type of asset to de-serialize the file into.
          * @param name The name of the resource to be de-serialized.
          *
-         * @returns A pointer to a new de-serialized asset. 
+         * @returns A pointer to a new de-serialized asset, or the error that prevented it being created.
          */
-        virtual Asset* deserialize(eAssetType type, const std::string& name) const = 0;
+        virtual Expected<Asset*> deserialize(eAssetType type, const std::string& name) const = 0;
 
 		/**
 		 * @brief Abstract method for de-serializaing all the resources in the specified files. 
@@ -0,0 +1,261 @@
+/*
+* Pegasus Engine
+* 2017 - Benjamin Carter (bencarterdev@outlook.com)
+*
+* This software is provided 'as-is', without any express or implied warranty.
+* In no event will the authors be held liable for any damages arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it freely,
+* subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented;
+*    you must not claim that you wrote the original software.
+*    If you use this software in a product, an acknowledgement
+*    in the product documentation would be appreciated but is not required.
+*
+* 2. Altered source versions must be plainly marked as such,
+*    and must not be misrepresented as being the original software.
+*
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef _PEGASUS_JSON_READER_HPP_
+#define _PEGASUS_JSON_READER_HPP_
+
+//====================
+// C++ includes
+//====================
+#include <cstddef> // Sizes and offsets within the parsed buffer.
+#include <string>  // Describing parse errors.
+
+namespace pegasus
+{
+	/**
+	 * @author Benjamin Carter
+	 *
+	 * @class pegasus::IJsonHandler
+	 * @ingroup utilities
+	 *
+	 * @brief Interface that receives the values of a json document as they are parsed.
+	 *
+	 * The JsonReader does not build a tree of the document. Instead each value is passed
+	 * to the handler in the order it appears, and the handler is responsible for storing
+	 * anything it needs. String values point directly into the parsed buffer and are only
+	 * valid for the life-time of that buffer.
+	 */
+	class IJsonHandler
+	{
+	public:
+		//====================
+		// Ctors and dtor
+		//====================
+		/**
+		 * @brief Default destructor.
+		 */
+		virtual ~IJsonHandler() = default;
+
+		//====================
+		// Methods
+		//====================
+		/** @brief Invoked when an object is opened. */
+		virtual void onStartObject() = 0;
+		/** @brief Invoked when an object is closed. */
+		virtual void onEndObject() = 0;
+		/** @brief Invoked when an array is opened. */
+		virtual void onStartArray() = 0;
+		/** @brief Invoked when an array is closed. */
+		virtual void onEndArray() = 0;
+
+		/**
+		 * @brief Invoked when the key of an object member is parsed.
+		 *
+		 * @param pKey   The null-terminated, unescaped key.
+		 * @param length The length of the key in bytes.
+		 */
+		virtual void onKey(const char* pKey, std::size_t length) = 0;
+
+		/**
+		 * @brief Invoked when a string value is parsed.
+		 *
+		 * @param pValue The null-terminated, unescaped value.
+		 * @param length The length of the value in bytes.
+		 */
+		virtual void onString(const char* pValue, std::size_t length) = 0;
+
+		/**
+		 * @brief Invoked when a number value is parsed.
+		 *
+		 * @param value The value of the number.
+		 */
+		virtual void onNumber(double value) = 0;
+
+		/**
+		 * @brief Invoked when a true or false value is parsed.
+		 *
+		 * @param value The value of the boolean.
+		 */
+		virtual void onBool(bool value) = 0;
+
+		/** @brief Invoked when a null value is parsed. */
+		virtual void onNull() = 0;
+	};
+
+	/**
+	 * @author Benjamin Carter
+	 *
+	 * @class pegasus::JsonReader
+	 * @ingroup utilities
+	 *
+	 * @brief A streaming json parser that passes each value to a handler.
+	 *
+	 * The reader parses the buffer in-place. Strings are unescaped and null-terminated within
+	 * the buffer itself, so no memory is allocated for keys or values. The buffer must therefore
+	 * be writable, such as a MappedFile or a copy of the document.
+	 *
+	 * Where SSE2 is available, the contents of strings are scanned sixteen bytes at a time for
+	 * quotes, escapes and control characters, which is where most of the time is spent in
+	 * typical asset descriptions and manifests.
+	 */
+	class JsonReader final
+	{
+	private:
+		//====================
+		// Member variables
+		//====================
+		/** The start of the buffer being parsed. */
+		char*         m_pBegin;
+		/** The current position within the buffer. */
+		char*         m_pCursor;
+		/** One past the end of the buffer. */
+		char*         m_pEnd;
+		/** The handler receiving the parsed values. */
+		IJsonHandler* m_pHandler;
+		/** A description of the first error encountered. */
+		std::string   m_error;
+		/** The offset within the buffer of the first error encountered. */
+		std::size_t   m_errorOffset;
+
+	private:
+		//====================
+		// Private methods
+		//====================
+		/**
+		 * @brief Records an error at the current position.
+		 *
+		 * @param pMessage A description of the error.
+		 *
+		 * @returns False, so errors can be returned directly.
+		 */
+		bool fail(const char* pMessage);
+
+		/**
+		 * @brief Advances the cursor past any whitespace.
+		 */
+		void skipWhitespace();
+
+		/**
+		 * @brief Parses any json value and passes it to the handler.
+		 *
+		 * @param depth The nesting depth of the value.
+		 *
+		 * @returns True if the value was parsed successfully.
+		 */
+		bool parseValue(std::size_t depth);
+
+		/**
+		 * @brief Parses an object and all of its members.
+		 *
+		 * @param depth The nesting depth of the object.
+		 *
+		 * @returns True if the object was parsed successfully.
+		 */
+		bool parseObject(std::size_t depth);
+
+		/**
+		 * @brief Parses an array and all of its elements.
+		 *
+		 * @param depth The nesting depth of the array.
+		 *
+		 * @returns True if the array was parsed successfully.
+		 */
+		bool parseArray(std::size_t depth);
+
+		/**
+		 * @brief Unescapes and null-terminates a string in-place.
+		 *
+		 * The cursor must be positioned after the opening quote.
+		 *
+		 * @param ppValue The start of the unescaped string.
+		 * @param length  The length of the unescaped string.
+		 *
+		 * @returns True if the string was parsed successfully.
+		 */
+		bool parseString(char** ppValue, std::size_t& length);
+
+		/**
+		 * @brief Parses a number and passes it to the handler.
+		 *
+		 * @returns True if the number was parsed successfully.
+		 */
+		bool parseNumber();
+
+		/**
+		 * @brief Parses one of the literal values true, false or null.
+		 *
+		 * @returns True if the literal was parsed successfully.
+		 */
+		bool parseLiteral();
+
+	public:
+		//====================
+		// Ctors and dtor
+		//====================
+		/**
+		 * @brief Default constructor.
+		 */
+		explicit JsonReader();
+
+		/**
+		 * @brief Default destructor.
+		 */
+		~JsonReader() = default;
+
+		//====================
+		// Getters and setters
+		//====================
+		/**
+		 * @brief Retrieves a description of the last parse error.
+		 *
+		 * @returns The error, empty if the last parse was successful.
+		 */
+		const std::string& getError() const;
+
+		/**
+		 * @brief Retrieves the position of the last parse error.
+		 *
+		 * @returns The offset in bytes from the start of the buffer.
+		 */
+		std::size_t getErrorOffset() const;
+
+		//====================
+		// Methods
+		//====================
+		/**
+		 * @brief Parses a json document, passing each value to the handler.
+		 *
+		 * The buffer is modified while it is parsed and must remain valid for as long as the
+		 * handler references any of the strings it was given. Parsing stops at the first error.
+		 *
+		 * @param pData   The writable buffer holding the document.
+		 * @param size    The size of the buffer in bytes.
+		 * @param handler The handler receiving the parsed values.
+		 *
+		 * @returns True if the entire document was parsed successfully.
+		 */
+		bool parse(char* pData, std::size_t size, IJsonHandler& handler);
+	};
+
+} // namespace pegasus
+
+#endif//_PEGASUS_JSON_READER_HPP_
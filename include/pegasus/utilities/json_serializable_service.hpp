@@ -0,0 +1,164 @@
+/*
+* Pegasus Engine
+* 2017 - Benjamin Carter (bencarterdev@outlook.com)
+*
+* This software is provided 'as-is', without any express or implied warranty.
+* In no event will the authors be held liable for any damages arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it freely,
+* subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented;
+*    you must not claim that you wrote the original software.
+*    If you use this software in a product, an acknowledgement
+*    in the product documentation would be appreciated but is not required.
+*
+* 2. Altered source versions must be plainly marked as such,
+*    and must not be misrepresented as being the original software.
+*
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef _PEGASUS_JSON_SERIALIZABLE_SERVICE_HPP_
+#define _PEGASUS_JSON_SERIALIZABLE_SERVICE_HPP_
+
+//====================
+// Pegasus includes
+//====================
+#include <pegasus/utilities/iserializable_service.hpp> // JsonSerializableService is a serializable service.
+
+namespace pegasus
+{
+	//====================
+	// Forward declarations
+	//====================
+	class Logger;
+	class IJsonHandler;
+	class MappedFile;
+
+	/**
+	 * @author Benjamin Carter
+	 *
+	 * @class pegasus::JsonSerializableService
+	 * @ingroup utilities
+	 *
+	 * @brief De-serializes assets and the Resources file from json documents.
+	 *
+	 * The documents are memory-mapped and parsed in a single pass by the streaming JsonReader,
+	 * so no document tree is built and keys and values are never copied. This makes json the
+	 * preferred format for large manifests and assets exported by content tools. The keys of
+	 * each document match the lua table format, e.g. "name", "source" and "asset_type".
+	 */
+	class JsonSerializableService final : public ISerializableService
+	{
+	private:
+		//====================
+		// Member variables
+		//====================
+		/** Logging warnings from the Resources.json file. */
+		Logger& m_logger;
+
+	private:
+		//====================
+		// Private methods
+		//====================
+		/**
+		 * @brief Maps and parses a json file, passing each value to the handler.
+		 *
+		 * The strings passed to the handler reference the mapped file, so they remain valid
+		 * for as long as the file remains mapped.
+		 *
+		 * @param filename The file location of the json file.
+		 * @param file     The file object that will hold the mapping.
+		 * @param handler  The handler receiving the parsed values.
+		 *
+		 * @returns An error with the eErrorCode::NONE code if the file was parsed, otherwise the reason
+		 * the file could not be opened or parsed.
+		 */
+		static Error_t parse(const std::string& filename, MappedFile& file, IJsonHandler& handler);
+
+		/**
+		 * @brief De-serializes an asset into a shader program object.
+		 *
+		 * The de-serialization of the shader will fail if no shaders have been defined, a shader
+		 * has no source, or a shader_type is not Vertex or Fragment.
+		 *
+		 * @param filename The file location of the json file to de-serialize.
+		 *
+		 * @returns A new shader program object, or an error if the file cannot be parsed or declares no valid shaders.
+		 */
+		Expected<Asset*> deserializeShaderProgram(const std::string& filename) const;
+
+		/**
+		 * @brief De-serializes an asset into a Texture object.
+		 *
+		 * The de-serialization of the texture will fail if no image source has been defined, or the
+		 * texture_type, filter or wrap_mode is missing or unknown.
+		 *
+		 * @param filename The file location of the json file to de-serialize.
+		 *
+		 * @returns A new Texture object, or an error if the file cannot be parsed or declares an invalid value.
+		 */
+		Expected<Asset*> deserializeTexture(const std::string& filename) const;
+
+	public:
+		//====================
+		// Ctors and dtor
+		//====================
+		/**
+		 * @brief Default constructor for the JsonSerializableService.
+		 *
+		 * The default constructor for the JsonSerializableService calls the
+		 * ISerializableService parent constructor and initializes the member variables.
+		 */
+		explicit JsonSerializableService();
+
+		/**
+		 * @brief Default destructor.
+		 */
+		~JsonSerializableService() = default;
+
+		//====================
+		// Getters and setters
+		//====================
+		/**
+		 * @brief Retrieves whether the service can de-serialize files from multiple threads.
+		 *
+		 * Each call uses its own reader and handler, so the json service can always be invoked
+		 * concurrently.
+		 *
+		 * @returns True.
+		 */
+		bool isConcurrent() const override;
+
+		//====================
+		// Methods
+		//====================
+		/**
+		 * @brief Deserializes the specified asset into a format that the engine can utilise.
+		 *
+		 * @param type     The asset type to de-serialize.
+		 * @param filename The file location of the asset description.
+		 *
+		 * @returns A pointer to a Asset resource, or the error that prevented it being created.
+		 */
+		Expected<Asset*> deserialize(eAssetType type, const std::string& filename) const override;
+
+		/**
+		 * @brief De-serializes the Resources.json into a format that the pegasus engine can utilise.
+		 *
+		 * When the Resources.json file is de-serialized, it will de-serialize each object in the Resources
+		 * array. If the Resources file is not found or can't be parsed, a NoResourceException will be thrown.
+		 * Resources without a name or a known asset_type are skipped, and a warning is logged.
+		 *
+		 * @param filename The file location of the Resources.json file.
+		 *
+		 * @returns A map of resources and their subsequent names.
+		 */
+		std::unordered_map<std::string, Resource_t> deserializeResources(const std::string& filename) const override;
+	};
+
+} // namespace pegasus
+
+#endif//_PEGASUS_JSON_SERIALIZABLE_SERVICE_HPP_
@@ -26,7 +26,9 @@
 //==================== 
 // Pegasus includes
 //====================  
-#include <pegasus/utilities/iserializable_service.hpp> // LuaSerializableService is a serializable service.
+#include <pegasus/utilities/iserializable_service.hpp>       // LuaSerializableService is a serializable service.
+#include <pegasus/graphics/shader_program_description.hpp> // Parsing shader programs without creating OpenGL objects.
+#include <pegasus/graphics/texture_description.hpp>        // Parsing textures without creating OpenGL objects.
 
 namespace pegasus
 {
@@ -34,7 +36,22 @@ namespace pegasus
 	// Forward declarations
 	//====================
 	class Logger;
+	class ScriptingManager;
 
+	/**
+	 * @author Benjamin Carter
+	 *
+	 * @class pegasus::LuaSerializableService
+	 * @ingroup utilities
+	 *
+	 * @brief De-serializes assets and the Resources file from lua scripts.
+	 *
+	 * Each script is executed by a state leased from the LuaStatePool of the ScriptingManager, within
+	 * its own environment. The tables declared by one script are therefore never visible to another,
+	 * and as many scripts can be executed in parallel as there are states within the pool. Parsing a
+	 * script is separated from creating the OpenGL objects, so the descriptions of many assets can be
+	 * parsed on worker threads while the objects themselves are created on the rendering thread.
+	 */
 	class LuaSerializableService final : public ISerializableService
 	{
 	private:
@@ -42,7 +59,9 @@ namespace pegasus
 		// Member variables
 		//====================
 		/** Logging warnings from the Resources.lua file. */
-		Logger& m_logger;
+		Logger&           m_logger;
+		/** The scripting manager whose state pool executes the scripts. */
+		ScriptingManager& m_scripting;
 
 	private:
 		//====================
@@ -58,9 +77,9 @@ namespace pegasus
 		 * 
 		 * @param name The file location of the lua script to de-serialize.
 		 * 
-		 * @returns A new shader program object.
+		 * @returns A new shader program object, or an error if the script fails or declares no shaders.
 		 */
-		Asset* deserializeShaderProgram(const std::string& name) const;
+		Expected<Asset*> deserializeShaderProgram(const std::string& name) const;
 
 		/**
 		 * @brief De-serializes an asset into a Texture object.
@@ -72,30 +91,66 @@ namespace pegasus
 		 * 
 		 * @param name The file location of the lua script to de-serialize.
 		 * 
-		 * @returns A new Texture object.
+		 * @returns A new Texture object, or an error if the script fails or declares no source.
 		 */		
-		Asset* deserializeTexture(const std::string& name) const;
+		Expected<Asset*> deserializeTexture(const std::string& name) const;
 
 	public:
 		//==================== 
 		// Ctors and dtor
 		//====================  
 		/**
-		 * @brief Default constructor for the LuaSerializableService.
+		 * @brief Constructor for the LuaSerializableService.
 		 *
-		 * The default constructor for the LuaSerializableService calls the
+		 * The constructor for the LuaSerializableService calls the
 		 * ISerializableService parent constructor and initializes the member variables.
+		 *
+		 * @param scripting The scripting manager of the owning Engine, it must outlive the service.
 		 */
-		explicit LuaSerializableService();
+		explicit LuaSerializableService(ScriptingManager& scripting);
 
 		/**
 		 * @brief Default destructor. 
 		 */
 		~LuaSerializableService() = default;
 
+		//==================== 
+		// Getters and setters
+		//====================  
+		/**
+		 * @brief Retrieves whether the service can de-serialize files from multiple threads.
+		 *
+		 * Each script is executed by its own leased state, so the service is concurrent.
+		 *
+		 * @returns True.
+		 */
+		bool isConcurrent() const override;
+
 		//==================== 
 		// Methods
 		//====================  
+		/**
+		 * @brief Parses a lua shader program description without creating any OpenGL objects.
+		 *
+		 * This method can be invoked from any thread.
+		 *
+		 * @param name The file location of the lua script to parse.
+		 *
+		 * @returns The description of the program, or an error if the script fails, declares no shaders or a shader without a valid shader_type.
+		 */
+		Expected<ShaderProgramDescription_t> parseShaderProgram(const std::string& name) const;
+
+		/**
+		 * @brief Parses a lua texture description without creating any OpenGL objects.
+		 *
+		 * This method can be invoked from any thread.
+		 *
+		 * @param name The file location of the lua script to parse.
+		 *
+		 * @returns The description of the texture, or an error if the script fails, declares no source or a missing or misspelled enum.
+		 */
+		Expected<TextureDescription_t> parseTexture(const std::string& name) const;
+
 		/**
 		 * @brief Deserializes the specified asset into a format that the engine can utilise.
 		 *
@@ -106,15 +161,16 @@ namespace pegasus
 		 * @param type The asset type to de-serialize.
 		 * @param name The name of the resource within the Resources.xxx file
 		 * 
-		 * @returns A pointer to a Asset resource.
+		 * @returns A pointer to a Asset resource, or the error that prevented it being created.
 		 */
-		Asset* deserialize(eAssetType type, const std::string& name) const override;
+		Expected<Asset*> deserialize(eAssetType type, const std::string& name) const override;
 
 		/**
 		 * @brief De-serializes the Resources.lua into a format that the pegasus engine can utilise.
 		 * 
 		 * When the Resources.lua file is de-serialized, it will de-serialize each table in the Resources table
 		 * array. If the Resources file is not found or can't be opened, a NoResourceException will be thrown.
+		 * Resources without a valid asset_type are skipped, and a warning is logged.
 		 * 
 		 * @param filename The file location of the Resources.lua file.
 		 * 
@@ -0,0 +1,139 @@
+/*
+* Pegasus Engine
+* 2017 - Benjamin Carter (bencarterdev@outlook.com)
+*
+* This software is provided 'as-is', without any express or implied warranty.
+* In no event will the authors be held liable for any damages arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it freely,
+* subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented;
+*    you must not claim that you wrote the original software.
+*    If you use this software in a product, an acknowledgement
+*    in the product documentation would be appreciated but is not required.
+*
+* 2. Altered source versions must be plainly marked as such,
+*    and must not be misrepresented as being the original software.
+*
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef _PEGASUS_MAPPED_FILE_HPP_
+#define _PEGASUS_MAPPED_FILE_HPP_
+
+//====================
+// C++ includes
+//====================
+#include <cstddef> // The size of the mapped file.
+#include <string>  // The file location to map.
+
+//====================
+// Pegasus includes
+//====================
+#include <pegasus/utilities/non_copyable.hpp> // The mapping cannot be shared between objects.
+
+namespace pegasus
+{
+	/**
+	 * @author Benjamin Carter
+	 *
+	 * @class pegasus::MappedFile
+	 * @ingroup utilities
+	 *
+	 * @brief Maps the contents of an external file directly into memory.
+	 *
+	 * Unlike the FileReader, the MappedFile does not copy the contents of the file into a
+	 * string. The operating system pages the file in as it is accessed, which avoids an
+	 * allocation and a copy for every file that is parsed.
+	 *
+	 * The mapping is private and writable. Any modifications are made to a copy-on-write page
+	 * and are never written back to disk, which allows parsers to terminate and unescape
+	 * values in-place.
+	 */
+	class MappedFile final : public NonCopyable
+	{
+	private:
+		//====================
+		// Member variables
+		//====================
+		/** The start of the mapped file, nullptr if no file is mapped. */
+		char*       m_pData;
+		/** The size of the mapped file in bytes. */
+		std::size_t m_size;
+
+	public:
+		//====================
+		// Ctors and dtor
+		//====================
+		/**
+		 * @brief Default constructor, no file is mapped.
+		 */
+		explicit MappedFile();
+
+		/**
+		 * @brief Constructor that maps a file upon instantiation.
+		 *
+		 * @param filename The file on disk to map.
+		 */
+		explicit MappedFile(const std::string& filename);
+
+		/**
+		 * @brief Destructor, unmaps the file.
+		 */
+		~MappedFile();
+
+		//====================
+		// Getters and setters
+		//====================
+		/**
+		 * @brief Retrieves the start of the mapped file.
+		 *
+		 * The data is not null-terminated, the size must be used to determine where the
+		 * file ends.
+		 *
+		 * @returns The mapped contents, nullptr if no file is mapped.
+		 */
+		char* getData() const;
+
+		/**
+		 * @brief Retrieves the size of the mapped file.
+		 *
+		 * @returns The size in bytes, zero if no file is mapped.
+		 */
+		std::size_t getSize() const;
+
+		/**
+		 * @brief Retrieves whether a file is currently mapped.
+		 *
+		 * Empty files cannot be mapped, so opening an empty file will also leave the
+		 * object unmapped.
+		 *
+		 * @returns True if a file is mapped.
+		 */
+		bool isOpen() const;
+
+		//====================
+		// Methods
+		//====================
+		/**
+		 * @brief Maps the specified file into memory.
+		 *
+		 * Any previously mapped file is unmapped first.
+		 *
+		 * @param filename The file on disk to map.
+		 *
+		 * @returns True if the file was mapped successfully.
+		 */
+		bool open(const std::string& filename);
+
+		/**
+		 * @brief Unmaps the current file, if any.
+		 */
+		void close();
+	};
+
+} // namespace pegasus
+
+#endif//_PEGASUS_MAPPED_FILE_HPP_
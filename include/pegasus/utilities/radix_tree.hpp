@@ -0,0 +1,475 @@
+/*
+* Pegasus Engine
+* 2017 - Benjamin Carter (bencarterdev@outlook.com)
+*
+* This software is provided 'as-is', without any express or implied warranty.
+* In no event will the authors be held liable for any damages arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it freely,
+* subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented;
+*    you must not claim that you wrote the original software.
+*    If you use this software in a product, an acknowledgement
+*    in the product documentation would be appreciated but is not required.
+*
+* 2. Altered source versions must be plainly marked as such,
+*    and must not be misrepresented as being the original software.
+*
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef _PEGASUS_RADIX_TREE_HPP_
+#define _PEGASUS_RADIX_TREE_HPP_
+
+//====================
+// C++ includes
+//====================
+#include <algorithm> // Searching the sorted children of each node.
+#include <memory>    // The nodes and values are stored as unique pointers.
+#include <string>    // The keys of the tree.
+#include <vector>    // Storing the children of each node.
+
+namespace pegasus
+{
+	/**
+	 * @author Benjamin Carter
+	 *
+	 * @class pegasus::RadixTree
+	 * @ingroup utilities
+	 *
+	 * @brief A compact prefix tree that maps string keys to values.
+	 *
+	 * Each edge of the tree holds the longest run of characters shared by the keys below it, so
+	 * dotted names such as asset.texture.basic and asset.texture.brick only store the common
+	 * asset.texture.b once. Retrieving every key that begins with a prefix only walks the prefix
+	 * and the matching sub-tree, independent of the total amount of keys. Keys are visited in
+	 * lexicographical order.
+	 */
+	template <typename T>
+	class RadixTree final
+	{
+	private:
+		//====================
+		// Structures
+		//====================
+		struct Node_t
+		{
+			/** The characters of the edge leading into this node. */
+			std::string                          label;
+			/** The value of the key ending at this node, nullptr if no key ends here. */
+			std::unique_ptr<T>                   pValue;
+			/** The child nodes, sorted by the first character of their label. */
+			std::vector<std::unique_ptr<Node_t>> children;
+		};
+
+		//====================
+		// Member variables
+		//====================
+		/** The root of the tree, which always has an empty label. */
+		Node_t      m_root;
+		/** The amount of keys stored within the tree. */
+		std::size_t m_size;
+
+	private:
+		//====================
+		// Private methods
+		//====================
+		/**
+		 * @brief Finds where a child beginning with the specified character is, or should be, stored.
+		 *
+		 * @param node      The parent node.
+		 * @param character The first character of the child's label.
+		 *
+		 * @returns The position of the first child that does not begin before the character.
+		 */
+		static typename std::vector<std::unique_ptr<Node_t>>::const_iterator findChild(const Node_t& node, char character);
+
+		/**
+		 * @brief Counts the characters of a label that match the key from the specified offset.
+		 *
+		 * @param label  The label of the edge.
+		 * @param key    The key being searched for.
+		 * @param offset The offset of the first character within the key to compare.
+		 *
+		 * @returns The amount of matching characters.
+		 */
+		static std::size_t match(const std::string& label, const std::string& key, std::size_t offset);
+
+		/**
+		 * @brief Finds the node a key ends at.
+		 *
+		 * @param key The key to search for.
+		 *
+		 * @returns The node, or nullptr if the key does not end at a node.
+		 */
+		const Node_t* findNode(const std::string& key) const;
+
+		/**
+		 * @brief Removes a key from the sub-tree, merging any nodes left with a single child.
+		 *
+		 * @param node   The node to remove the key from.
+		 * @param key    The key to remove.
+		 * @param offset The offset of the first character of the key below this node.
+		 *
+		 * @returns True if the key was removed.
+		 */
+		static bool erase(Node_t& node, const std::string& key, std::size_t offset);
+
+		/**
+		 * @brief Invokes a function for every key within the sub-tree.
+		 *
+		 * @param node     The root of the sub-tree.
+		 * @param key      The key of the node, which is extended while the sub-tree is visited.
+		 * @param function The function to invoke.
+		 */
+		template <typename Function>
+		static void visit(const Node_t& node, std::string& key, Function& function);
+
+	public:
+		//====================
+		// Ctors and dtor
+		//====================
+		/**
+		 * @brief Constructs an empty tree.
+		 */
+		explicit RadixTree();
+
+		/**
+		 * @brief Default destructor.
+		 */
+		~RadixTree() = default;
+
+		//====================
+		// Getters and setters
+		//====================
+		/**
+		 * @brief Retrieves the amount of keys stored within the tree.
+		 *
+		 * @returns The amount of keys.
+		 */
+		std::size_t getSize() const;
+
+		/**
+		 * @brief Retrieves the value of a key.
+		 *
+		 * @param key The key to retrieve.
+		 *
+		 * @returns The value of the key, or nullptr if the key has not been inserted.
+		 */
+		const T* find(const std::string& key) const;
+
+		/**
+		 * @brief Retrieves every key that begins with the specified prefix.
+		 *
+		 * @param prefix The prefix of the keys. An empty prefix retrieves every key.
+		 *
+		 * @returns The matching keys, in lexicographical order.
+		 */
+		std::vector<std::string> getKeys(const std::string& prefix) const;
+
+		//====================
+		// Methods
+		//====================
+		/**
+		 * @brief Inserts a key into the tree, replacing the value if the key already exists.
+		 *
+		 * @param key   The key to insert.
+		 * @param value The value of the key.
+		 */
+		void insert(const std::string& key, T value);
+
+		/**
+		 * @brief Removes a key from the tree.
+		 *
+		 * @param key The key to remove.
+		 *
+		 * @returns True if the key was found and removed.
+		 */
+		bool erase(const std::string& key);
+
+		/**
+		 * @brief Removes every key from the tree.
+		 */
+		void clear();
+
+		/**
+		 * @brief Invokes a function for every key that begins with the specified prefix.
+		 *
+		 * The function is invoked with the key and a reference to its value, in lexicographical
+		 * order. The tree must not be modified while it is being visited.
+		 *
+		 * @param prefix   The prefix of the keys. An empty prefix visits every key.
+		 * @param function The function to invoke, with the signature void(const std::string&, const T&).
+		 */
+		template <typename Function>
+		void forEach(const std::string& prefix, Function function) const;
+	};
+
+	//====================
+	// Ctors and dtor
+	//====================
+	/**********************************************************/
+	template <typename T>
+	RadixTree<T>::RadixTree()
+		: m_root(), m_size(0)
+	{
+		// Empty.
+	}
+
+	//====================
+	// Private methods
+	//====================
+	/**********************************************************/
+	template <typename T>
+	typename std::vector<std::unique_ptr<typename RadixTree<T>::Node_t>>::const_iterator RadixTree<T>::findChild(const Node_t& node, char character)
+	{
+		return std::lower_bound(node.children.begin(), node.children.end(), character, [](const std::unique_ptr<Node_t>& child, char c) {
+			return static_cast<unsigned char>(child->label[0]) < static_cast<unsigned char>(c);
+		});
+	}
+
+	/**********************************************************/
+	template <typename T>
+	std::size_t RadixTree<T>::match(const std::string& label, const std::string& key, std::size_t offset)
+	{
+		std::size_t length = std::min(label.size(), key.size() - offset);
+		std::size_t i = 0;
+		while (i < length && label[i] == key[offset + i])
+		{
+			i++;
+		}
+
+		return i;
+	}
+
+	/**********************************************************/
+	template <typename T>
+	const typename RadixTree<T>::Node_t* RadixTree<T>::findNode(const std::string& key) const
+	{
+		const Node_t* pNode = &m_root;
+		std::size_t offset = 0;
+		while (offset < key.size())
+		{
+			auto itr = RadixTree<T>::findChild(*pNode, key[offset]);
+			if (itr == pNode->children.end() || (*itr)->label[0] != key[offset])
+			{
+				return nullptr;
+			}
+
+			const Node_t* pChild = itr->get();
+			if (RadixTree<T>::match(pChild->label, key, offset) != pChild->label.size())
+			{
+				return nullptr;
+			}
+
+			offset += pChild->label.size();
+			pNode = pChild;
+		}
+
+		return pNode;
+	}
+
+	/**********************************************************/
+	template <typename T>
+	bool RadixTree<T>::erase(Node_t& node, const std::string& key, std::size_t offset)
+	{
+		if (offset == key.size())
+		{
+			if (!node.pValue)
+			{
+				return false;
+			}
+
+			node.pValue.reset();
+			return true;
+		}
+
+		auto position = RadixTree<T>::findChild(node, key[offset]);
+		if (position == node.children.end() || (*position)->label[0] != key[offset])
+		{
+			return false;
+		}
+
+		auto itr = node.children.begin() + (position - node.children.cbegin());
+		Node_t& child = **itr;
+		if (RadixTree<T>::match(child.label, key, offset) != child.label.size() ||
+			!RadixTree<T>::erase(child, key, offset + child.label.size()))
+		{
+			return false;
+		}
+
+		// Remove the child if it no longer leads to any keys.
+		if (!child.pValue && child.children.empty())
+		{
+			node.children.erase(itr);
+		}
+		// Merge the child with its only remaining child, keeping the tree compact.
+		else if (!child.pValue && child.children.size() == 1)
+		{
+			std::unique_ptr<Node_t> pGrandchild = std::move(child.children.front());
+			child.label += pGrandchild->label;
+			child.pValue = std::move(pGrandchild->pValue);
+			child.children = std::move(pGrandchild->children);
+		}
+
+		return true;
+	}
+
+	/**********************************************************/
+	template <typename T>
+	template <typename Function>
+	void RadixTree<T>::visit(const Node_t& node, std::string& key, Function& function)
+	{
+		if (node.pValue)
+		{
+			function(static_cast<const std::string&>(key), static_cast<const T&>(*node.pValue));
+		}
+
+		for (auto& child : node.children)
+		{
+			std::size_t length = key.size();
+			key += child->label;
+			RadixTree<T>::visit(*child, key, function);
+			key.resize(length);
+		}
+	}
+
+	//====================
+	// Getters and setters
+	//====================
+	/**********************************************************/
+	template <typename T>
+	std::size_t RadixTree<T>::getSize() const
+	{
+		return m_size;
+	}
+
+	/**********************************************************/
+	template <typename T>
+	const T* RadixTree<T>::find(const std::string& key) const
+	{
+		const Node_t* pNode = this->findNode(key);
+		return pNode ? pNode->pValue.get() : nullptr;
+	}
+
+	/**********************************************************/
+	template <typename T>
+	std::vector<std::string> RadixTree<T>::getKeys(const std::string& prefix) const
+	{
+		std::vector<std::string> keys;
+		this->forEach(prefix, [&keys](const std::string& key, const T&) {
+			keys.push_back(key);
+		});
+
+		return keys;
+	}
+
+	//====================
+	// Methods
+	//====================
+	/**********************************************************/
+	template <typename T>
+	void RadixTree<T>::insert(const std::string& key, T value)
+	{
+		Node_t* pNode = &m_root;
+		std::size_t offset = 0;
+		while (offset < key.size())
+		{
+			auto position = RadixTree<T>::findChild(*pNode, key[offset]);
+			auto itr = pNode->children.begin() + (position - pNode->children.cbegin());
+			// No edge shares the next character, so the rest of the key becomes a new leaf.
+			if (itr == pNode->children.end() || (*itr)->label[0] != key[offset])
+			{
+				std::unique_ptr<Node_t> pLeaf(new Node_t());
+				pLeaf->label = key.substr(offset);
+				pLeaf->pValue.reset(new T(std::move(value)));
+				pNode->children.insert(itr, std::move(pLeaf));
+				m_size++;
+				return;
+			}
+
+			Node_t* pChild = itr->get();
+			std::size_t length = RadixTree<T>::match(pChild->label, key, offset);
+			// The key only shares part of the edge, split it at the point they diverge.
+			if (length < pChild->label.size())
+			{
+				std::unique_ptr<Node_t> pSplit(new Node_t());
+				pSplit->label = pChild->label.substr(0, length);
+				pChild->label.erase(0, length);
+				pSplit->children.push_back(std::move(*itr));
+				*itr = std::move(pSplit);
+				pChild = itr->get();
+			}
+
+			offset += length;
+			pNode = pChild;
+		}
+
+		if (!pNode->pValue)
+		{
+			m_size++;
+		}
+
+		pNode->pValue.reset(new T(std::move(value)));
+	}
+
+	/**********************************************************/
+	template <typename T>
+	bool RadixTree<T>::erase(const std::string& key)
+	{
+		if (!RadixTree<T>::erase(m_root, key, 0))
+		{
+			return false;
+		}
+
+		m_size--;
+		return true;
+	}
+
+	/**********************************************************/
+	template <typename T>
+	void RadixTree<T>::clear()
+	{
+		m_root.pValue.reset();
+		m_root.children.clear();
+		m_size = 0;
+	}
+
+	/**********************************************************/
+	template <typename T>
+	template <typename Function>
+	void RadixTree<T>::forEach(const std::string& prefix, Function function) const
+	{
+		const Node_t* pNode = &m_root;
+		std::string key;
+		std::size_t offset = 0;
+		while (offset < prefix.size())
+		{
+			auto itr = RadixTree<T>::findChild(*pNode, prefix[offset]);
+			if (itr == pNode->children.end() || (*itr)->label[0] != prefix[offset])
+			{
+				return;
+			}
+
+			const Node_t* pChild = itr->get();
+			std::size_t length = RadixTree<T>::match(pChild->label, prefix, offset);
+			// The prefix diverges from the edge, so no keys begin with it.
+			if (length < pChild->label.size() && offset + length < prefix.size())
+			{
+				return;
+			}
+
+			// Either the whole edge matched, or the prefix ends part-way along it.
+			key += pChild->label;
+			offset += length;
+			pNode = pChild;
+		}
+
+		RadixTree<T>::visit(*pNode, key, function);
+	}
+
+} // namespace pegasus
+
+#endif//_PEGASUS_RADIX_TREE_HPP_
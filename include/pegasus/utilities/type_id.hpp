@@ -0,0 +1,86 @@
+/*
+* Pegasus Engine
+* 2017 - Benjamin Carter (bencarterdev@outlook.com)
+*
+* This software is provided 'as-is', without any express or implied warranty.
+* In no event will the authors be held liable for any damages arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it freely,
+* subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented;
+*    you must not claim that you wrote the original software.
+*    If you use this software in a product, an acknowledgement
+*    in the product documentation would be appreciated but is not required.
+*
+* 2. Altered source versions must be plainly marked as such,
+*    and must not be misrepresented as being the original software.
+*
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef _PEGASUS_TYPE_ID_HPP_
+#define _PEGASUS_TYPE_ID_HPP_
+
+//====================
+// C++ includes
+//====================
+#include <atomic>  // Allocating identifiers from any thread.
+#include <cstddef> // The identifiers are indices.
+
+namespace pegasus
+{
+	/**
+	 * @author Benjamin Carter
+	 *
+	 * @class pegasus::TypeID
+	 * @ingroup utilities
+	 *
+	 * @brief Assigns each type a small, dense integer identifier.
+	 *
+	 * Unlike std::type_index, the identifier can be used directly as an index into an array,
+	 * so a lookup by type costs a single bounds check instead of a hash and a comparison. The
+	 * identifier of a type is allocated the first time it is requested and is then constant for
+	 * the life-time of the program, but may differ between runs. It must therefore never be
+	 * written to disk.
+	 */
+	class TypeID final
+	{
+	private:
+		//====================
+		// Private methods
+		//====================
+		/**
+		 * @brief Allocates the next unused identifier.
+		 *
+		 * @returns The new identifier.
+		 */
+		static std::size_t next()
+		{
+			static std::atomic<std::size_t> counter(0);
+			return counter.fetch_add(1, std::memory_order_relaxed);
+		}
+
+	public:
+		//====================
+		// Getters and setters
+		//====================
+		/**
+		 * @brief Retrieves the identifier of a type.
+		 *
+		 * @tparam T The type to identify.
+		 *
+		 * @returns The identifier of the type, starting from zero.
+		 */
+		template <typename T>
+		static std::size_t get()
+		{
+			static const std::size_t id = TypeID::next();
+			return id;
+		}
+	};
+
+} // namespace pegasus
+
+#endif//_PEGASUS_TYPE_ID_HPP_
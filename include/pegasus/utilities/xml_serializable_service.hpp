@@ -28,10 +28,67 @@
 //==================== 
 #include <pegasus/utilities/iserializable_service.hpp>
 
+//====================
+// Forward declarations
+//====================
+namespace pugi
+{
+	class xml_document;
+} // namespace pugi
+
 namespace pegasus
 {
+	//====================
+	// Forward declarations
+	//====================
+	class MappedFile;
+
 	class XmlSerializableService final : public ISerializableService
 	{
+	private:
+		//====================
+		// Private methods
+		//====================
+		/**
+		 * @brief Maps and parses an xml file into a reusable document.
+		 *
+		 * The file is parsed in-place, so the returned document references the memory of the
+		 * mapped file and is only valid while the file remains mapped. Each thread reuses a single
+		 * document, which is reset by the next call on the same thread.
+		 *
+		 * @param filename The file location of the xml file.
+		 * @param file     The file object that will hold the mapping.
+		 *
+		 * @returns The parsed document, or nullptr if the file could not be mapped or parsed.
+		 */
+		static pugi::xml_document* loadDocument(const std::string& filename, MappedFile& file);
+
+		/**
+		 * @brief De-serializes an asset into a shader program object.
+		 *
+		 * The ShaderProgram node must contain a Shaders node with at least one Shader, each
+		 * declaring a Source and ShaderType. The de-serialization will fail if no shaders have
+		 * been defined, or a ShaderType is not Vertex or Fragment.
+		 *
+		 * @param filename The file location of the xml file to de-serialize.
+		 *
+		 * @returns A new shader program object, or an error if the file cannot be parsed or declares no valid shaders.
+		 */
+		Expected<Asset*> deserializeShaderProgram(const std::string& filename) const;
+
+		/**
+		 * @brief De-serializes an asset into a Texture object.
+		 *
+		 * The Texture node must declare an image Source, a TextureType, a Filter and a WrapMode.
+		 * The de-serialization will fail if no image source has been defined, or any of the
+		 * enumerations has an unknown value.
+		 *
+		 * @param filename The file location of the xml file to de-serialize.
+		 *
+		 * @returns A new Texture object, or an error if the file cannot be parsed or declares an invalid value.
+		 */
+		Expected<Asset*> deserializeTexture(const std::string& filename) const;
+
 	public:
 		//==================== 
 		// Ctors and dtor
@@ -49,6 +106,19 @@ namespace pegasus
 		 */
 		~XmlSerializableService() = default;
 
+		//==================== 
+		// Getters and setters
+		//==================== 
+		/**
+		 * @brief Retrieves whether the service can de-serialize files from multiple threads.
+		 *
+		 * Each thread parses into its own thread_local document, which is reused by the calls
+		 * made on that thread, so the xml service can always be invoked concurrently.
+		 *
+		 * @returns True.
+		 */
+		bool isConcurrent() const override;
+
 		//==================== 
 		// Methods
 		//==================== 
@@ -62,15 +132,16 @@ namespace pegasus
 		 * @param type The asset type to de-serialize.
 		 * @param name The name of the resource within the Resources.xml file
 		 * 
-		 * @returns A pointer to a Asset resource.
+		 * @returns A pointer to a Asset resource, or the error that prevented it being created.
 		 */
-		Asset* deserialize(eAssetType type, const std::string& filename) const override;
+		Expected<Asset*> deserialize(eAssetType type, const std::string& filename) const override;
 
 		/**
 		 * @brief De-serializes the Resources.xml into a format that the pegasus engine can utilise.
 		 * 
 		 * When the Resources.xml file is de-serialized, it will de-serialize each tag in the Resources node
 		 * array. If the Resources file is not found or can't be opened, a NoResourceException will be thrown.
+		 * Resources without a known AssetType are skipped, and a warning is logged.
 		 * 
 		 * @param filename The file location of the Resources.xml file.
 		 */
@@ -26,6 +26,9 @@
 #include <cstdlib>   // Macros for exit failure or success.
 #include <stdexcept> // Catching any runtime_error exceptions being thrown.
 #include <array>     // An array of vertices.
+#include <algorithm> // Measuring the longest garbage collection.
+#include <chrono>    // The time spent collecting garbage and the time between frames.
+#include <fstream>   // Writing the lua profile.
 
 //====================
 // Pegasus includes
@@ -35,19 +38,19 @@
 #include <pegasus/utilities/file_policy.hpp>                      // Registering the file policy with a logger.
 #include <pegasus/utilities/logger_factory.hpp>                   // Storing and retrieval of different logs.
 #include <pegasus/core/config_file.hpp>                           // Loading the external configuration file.
-#include <pegasus/utilities/xml_serializable_service.hpp>         // Registering the xml serializable service with a factory.
-#include <pegasus/utilities/lua_serializable_service.hpp>         // Registering the lua serializable service with a factory.
-#include <pegasus/core/resources.hpp>                             // Loading and storing the Resources.xxx file.
+#include <pegasus/core/engine.hpp>                                // Creating the engine and its subsystems.
 #include <pegasus/utilities/exceptions/no_resource_exception.hpp> // Caught if the Resources.xxx file fails to load.
 #include <pegasus/core/window.hpp>                                // Creating an sdl window.
-#include <pegasus/core/resource_manager.hpp>                      // Registering factories.
 #include <pegasus/graphics/buffer.hpp>                            // Generating a vertex buffer.
 #include <pegasus/graphics/vertex.hpp>                            // Setting the vertices of the mesh.
 #include <pegasus/graphics/shader_program.hpp>                    // Creating a shader program and linking glsl files.
-#include <pegasus/graphics/shader_program_factory.hpp>
-#include <pegasus/graphics/texture_factory.hpp>
 #include <pegasus/graphics/texture.hpp>
-#include <pegasus/scripting/scripting_manager.hpp>
+#include <pegasus/graphics/release_queue.hpp>
+#include <pegasus/graphics/state_cache.hpp>                       // Reporting the skipped state changes.
+#include <pegasus/graphics/uniform_block.hpp>                     // The per-frame and per-material uniform blocks.
+#include <pegasus/graphics/program_binary_cache.hpp>              // Loading the shader programs linked by previous runs.
+#include <pegasus/graphics/shader_compiler.hpp>                   // Compiling the shader programs without stalling.
+#include <pegasus/graphics/shader_cache.hpp>                      // Reporting the shaders shared between programs.
 
 using namespace pegasus;
 
@@ -56,8 +59,8 @@ using namespace pegasus;
 //====================
 int main(int argc, char** argv)
 {
-	// The scripting state should be first object to be instantiated.
-	ScriptingManager::getInstance();
+	// The release queue must outlive every asset that releases its objects into it.
+	ReleaseQueue::getInstance();
 
 	// Create a logger object that will print messages to the console.
 	auto consoleLogger = std::make_unique<Logger>(std::make_unique<ConsolePolicy>());
@@ -89,100 +92,139 @@ int main(int argc, char** argv)
 	Logger::setWarningEnabled(config.get<bool>("Logging.warn_enabled"));
 	Logger::setErrorEnabled(config.get<bool>("Logging.error_enabled"));
 
-	// Create the factory that will generate the serializable services.
-	Factory<ISerializableService, std::string> factory;
-	// Register the serialization formats with their specified keys.
-	factory.registerType("xml", std::make_unique<XmlSerializableService>());
-	factory.registerType("lua", std::make_unique<LuaSerializableService>());
-
-	// Initialize the resources.
-	Resources resources;
-	// Set the serializable service to the value found within the configuration file.
-	resources.setService(factory.get(config.get<std::string>("Serialization.resource_format")));
-	// Test there are no issues with loading the resources file.
-    try
-    {
-		resources.load(config.get<std::string>("Core.resource_file"));
-    }
-    catch (NoResourceException& e)
-    {
-    	// Log that there was an issue opening or parsing the Resources.xxx file.
-		Logger& logger = LoggerFactory::getLogger("file.logger");
-		logger.error(e.what());
-		// Exit the application.
-        return EXIT_FAILURE;
-    }
-
+	// The window, and its context, must outlive every object that releases OpenGL objects.
 	Window window;
 	window.create(config);
+	// Delay the deletion of released objects until the GPU has finished with them.
+	ReleaseQueue::getInstance().setFenced(config.get<bool>("Graphics.release_fences"));
+	// Load the linked shader programs stored by previous runs.
+	ProgramBinaryCache::getInstance().setEnabled(config.get<bool>("Graphics.program_binary_cache"));
+	ProgramBinaryCache::getInstance().setDirectory(config.get<std::string>("Graphics.program_binary_directory"));
 
-	// Creating the shader factory.
-	auto shaderFactory = std::make_unique<ShaderProgramFactory>();
-	shaderFactory->setService(factory.get(config.get<std::string>("Serialization.shader_format")));
-	shaderFactory->setThreshold(config.get<unsigned int>("Resources.shader_threshold"));
-	// Creating the texture factory.
-	auto textureFactory = std::make_unique<TextureFactory>();
-	textureFactory->setService(factory.get(config.get<std::string>("Serialization.texture_format")));
-	textureFactory->setThreshold(config.get<unsigned int>("Resources.texture_threshold"));
-
-	// Registering the factories with the resource manager.
-	ResourceManager::getInstance().registerFactory(std::move(shaderFactory));
-	ResourceManager::getInstance().registerFactory(std::move(textureFactory));
-	
-	// Create the temporary vertices.
-	Vertex2D_t v1; v1.position = glm::vec2(-0.5f, -0.5f); v1.texCoord = glm::vec2(0.0f, 0.0f);
-	Vertex2D_t v2; v2.position = glm::vec2( 0.5f, -0.5f); v2.texCoord = glm::vec2(1.0f, 0.0f);
-	Vertex2D_t v3; v3.position = glm::vec2( 0.0f,  0.5f); v3.texCoord = glm::vec2(0.5f, 1.0f);
-	// Populate an array of vertices.
-	std::array<Vertex2D_t, 3> vertices;
-	vertices.at(0) = v1;
-	vertices.at(1) = v2;
-	vertices.at(2) = v3;
-
-	// Create a description for the buffer.
-	BufferDescription_t desc;
-	// "Zero" out the memory.
-	memset(&desc, 0, sizeof(BufferDescription_t));
-	// Populate the fields.
-	desc.bufferType = gl::eBufferType::VERTEX;
-	desc.drawType = gl::eDrawType::STATIC;
-	desc.stride = sizeof(Vertex2D_t);
-	desc.size = vertices.size();
-	desc.pData = vertices.data();
-
-	// Create the buffer with the description.
-	Buffer buffer(desc);
-	// Retrieve the shader.
-	ResourceHandle<ShaderProgram> shader = ResourceManager::getInstance().get<ShaderProgram>("asset.shader.basic");
-	shader->compile();
-	// Retrieve a texture.
-	ResourceHandle<Texture> texture = ResourceManager::getInstance().get<Texture>("asset.texture.basic");
-
-	// Continue to draw the window whilst it's running.
-	while (window.isRunning())
+	// The engine and the assets release their objects when they are destroyed at the end of this scope.
 	{
-		// Process any input.
-		window.pollEvents();
-		// Clear the buffer.
-		window.clear();
-		// Bind the texture.
-		Texture::bind(*texture.get());
-		// Bind the shader program.
-		ShaderProgram::bind(*shader.get());
-		// Process the uniform variables of the shader.
-		shader->process();
-		// Bind and draw the vertex buffer.
-		Buffer::bind(buffer);
-		glDrawArrays(GL_TRIANGLES, 0, 3);
-		Buffer::unbind(buffer);
-		// Unbind the shader program.
-		ShaderProgram::bind(*shader.get());
-		// Unbind the texture.
-		Texture::unbind(*texture.get());
-		// Swap the buffers.
-		window.swap();
+		// Create the engine, which owns the scripting state, resources and asset factories.
+		Engine engine;
+		// Test there are no issues with loading the resources file.
+	    try
+	    {
+			engine.initialise(config);
+	    }
+	    catch (NoResourceException& e)
+	    {
+	    	// Log that there was an issue opening or parsing the Resources.xxx file.
+			Logger& logger = LoggerFactory::getLogger("file.logger");
+			logger.error(e.what());
+			// Exit the application.
+	        return EXIT_FAILURE;
+	    }
+
+		// Create the temporary vertices.
+		Vertex2D_t v1; v1.position = glm::vec2(-0.5f, -0.5f); v1.texCoord = glm::vec2(0.0f, 0.0f);
+		Vertex2D_t v2; v2.position = glm::vec2( 0.5f, -0.5f); v2.texCoord = glm::vec2(1.0f, 0.0f);
+		Vertex2D_t v3; v3.position = glm::vec2( 0.0f,  0.5f); v3.texCoord = glm::vec2(0.5f, 1.0f);
+		// Populate an array of vertices.
+		std::array<Vertex2D_t, 3> vertices;
+		vertices.at(0) = v1;
+		vertices.at(1) = v2;
+		vertices.at(2) = v3;
+
+		// Create a description for the buffer.
+		BufferDescription_t desc;
+		// "Zero" out the memory.
+		memset(&desc, 0, sizeof(BufferDescription_t));
+		// Populate the fields.
+		desc.bufferType = gl::eBufferType::VERTEX;
+		desc.drawType = gl::eDrawType::STATIC;
+		desc.stride = sizeof(Vertex2D_t);
+		desc.size = vertices.size();
+		desc.pData = vertices.data();
+
+		// Create the buffer with the description.
+		Buffer buffer(desc);
+		// Retrieve the shader.
+		ResourceHandle<ShaderProgram> shader = engine.getResourceManager().get<ShaderProgram>("asset.shader.basic");
+		// Submit the program to the driver, it is drawn with the default program until it has been compiled.
+		ShaderCompiler::getInstance().submit(*shader.get());
+		// Retrieve a texture.
+		ResourceHandle<Texture> texture = engine.getResourceManager().get<Texture>("asset.texture.basic");
+		// Create the uniform blocks shared by every shader program.
+		UniformBlock<FrameData_t> frameData(eUniformBlock::FRAME);
+		frameData.set(&FrameData_t::viewProjection, glm::mat4(1.0f));
+		UniformBlock<MaterialData_t> materialData(eUniformBlock::MATERIAL);
+		materialData.set(&MaterialData_t::tint, glm::vec4(1.0f));
+		materialData.upload();
+
+		// The longest time spent collecting lua garbage within a single frame.
+		std::chrono::microseconds longestCollection(0);
+		// The start of the previous frame, used to advance the script tasks.
+		auto lastFrame = std::chrono::steady_clock::now();
+		// Continue to draw the window whilst it's running.
+		while (window.isRunning())
+		{
+			// Process any input.
+			window.pollEvents();
+			// Retry the assets that failed to load, if their files were fixed whilst the window was in the background.
+			if (window.isFocusGained())
+			{
+				engine.getResourceManager().revalidate();
+			}
+			// Resume the script tasks that are due this frame.
+			auto now = std::chrono::steady_clock::now();
+			double deltaTime = std::chrono::duration<double>(now - lastFrame).count();
+			engine.getScripting().getScheduler().update(deltaTime);
+			lastFrame = now;
+			// Upload the values of the frame, only the members that have changed are sent to the buffer.
+			frameData.set(&FrameData_t::time, frameData.get().time + static_cast<float>(deltaTime));
+			frameData.set(&FrameData_t::deltaTime, static_cast<float>(deltaTime));
+			frameData.set(&FrameData_t::resolution, glm::vec2(window.getSize()));
+			frameData.upload();
+			// Finish the shader programs the driver has compiled since the last frame.
+			ShaderCompiler::getInstance().poll();
+			// Clear the buffer.
+			window.clear();
+			// Bind the texture, the shader program and the vertex buffer. The bindings are left in place after
+			// drawing, so the state cache skips rebinding them on the next frame.
+			Texture::bind(*texture.get());
+			ShaderProgram::bind(*shader.get());
+			// Process the uniform variables of the shader.
+			shader->process();
+			// Draw the vertex buffer.
+			Buffer::bind(buffer);
+			glDrawArrays(GL_TRIANGLES, 0, 3);
+			// Swap the buffers.
+			window.swap();
+			// Delete the objects released during the frame, once the GPU has finished with them.
+			ReleaseQueue::getInstance().flush();
+			// Collect the lua garbage within the frame's budget, whilst the frame is being presented.
+			engine.getScripting().getCollector().step();
+			longestCollection = std::max(longestCollection, engine.getScripting().getCollector().getFrameTime());
+			// Start counting the lua allocations of the next frame.
+			engine.getScripting().getAllocator().endFrame();
+		}
+
+		// Report how many state changes never reached the driver.
+		LoggerFactory::getLogger("file.logger").info("OpenGL state changes issued:", gl::StateCache::getInstance().getIssuedCalls(),
+			"skipped:", gl::StateCache::getInstance().getSkippedCalls());
+		// Report how many shader programs skipped compilation.
+		LoggerFactory::getLogger("file.logger").info("Shader programs loaded from binaries:", ProgramBinaryCache::getInstance().getLoadedCount(),
+			"stored:", ProgramBinaryCache::getInstance().getStoredCount(), "rejected:", ProgramBinaryCache::getInstance().getRejectedCount());
+		LoggerFactory::getLogger("file.logger").info("Shaders shared between programs:", ShaderCache::getInstance().getHitCount(),
+			"compiled:", ShaderCache::getInstance().getMissCount(), "still referenced:", ShaderCache::getInstance().getStageCount());
+		// Report the worst frame of the lua garbage collector.
+		LoggerFactory::getLogger("file.logger").info("Longest lua garbage collection within a frame:", longestCollection.count(), "us");
+		// Write the samples of the lua profiler as folded stacks for a flamegraph.
+		if (engine.getScripting().getProfiler().isRunning())
+		{
+			engine.getScripting().getProfiler().stop();
+			std::ofstream profile("lua_profile.folded", std::ios::out | std::ios::trunc);
+			profile << engine.getScripting().getProfiler().getFoldedStacks();
+		}
 	}
 
+	// Delete the objects released by the engine and the assets, whilst the context still exists.
+	ReleaseQueue::getInstance().finish();
+
 	// Closing the configuration file.
 	config.close();
     // The application exited successfully.
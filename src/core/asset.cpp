@@ -61,13 +61,19 @@ namespace pegasus
     /**********************************************************/
     unsigned int Asset::getRefCount() const
     {
-        return m_references;
+        return m_references.load();
     }
 
     /**********************************************************/
     bool Asset::isReferenced() const
     {
-        return m_references > 0;
+        return m_references.load() > 0;
+    }
+
+    /**********************************************************/
+    std::size_t Asset::getMemoryUsage() const
+    {
+        return 0;
     }
 
     //====================
@@ -76,13 +82,15 @@ namespace pegasus
     /**********************************************************/
     void Asset::retain()
     {
-        ++m_references;
+        // Retaining requires no ordering, the caller already holds a reference.
+        m_references.fetch_add(1, std::memory_order_relaxed);
     }
 
     /**********************************************************/
     void Asset::release()
     {
-        --m_references;
+        // The final release must observe every write made through the other references.
+        m_references.fetch_sub(1, std::memory_order_acq_rel);
     }
 
 } // namespace pegasus
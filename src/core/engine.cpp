@@ -0,0 +1,149 @@
+/*
+* Pegasus Engine
+* 2017 - Benjamin Carter (bencarterdev@outlook.com)
+*
+* This software is provided 'as-is', without any express or implied warranty.
+* In no event will the authors be held liable for any damages arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it freely,
+* subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented;
+*    you must not claim that you wrote the original software.
+*    If you use this software in a product, an acknowledgement
+*    in the product documentation would be appreciated but is not required.
+*
+* 2. Altered source versions must be plainly marked as such,
+*    and must not be misrepresented as being the original software.
+*
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+//====================
+// Pegasus includes
+//====================
+#include <pegasus/core/engine.hpp>                           // Class declaration.
+#include <pegasus/core/config_file.hpp>                      // Reading the settings of the engine.
+#include <pegasus/utilities/logger_factory.hpp>              // Reporting the errors of script tasks.
+#include <pegasus/utilities/xml_serializable_service.hpp>    // Registering the xml serializable service.
+#include <pegasus/utilities/lua_serializable_service.hpp>    // Registering the lua serializable service.
+#include <pegasus/utilities/json_serializable_service.hpp>   // Registering the json serializable service.
+#include <pegasus/utilities/binary_serializable_service.hpp> // Registering the cooked binary serializable service.
+
+namespace pegasus
+{
+	//====================
+	// Ctors and dtor
+	//====================
+	/**********************************************************/
+	Engine::Engine()
+		: NonCopyable(), m_resources(), m_resourceManager(m_resources), m_scripting(), m_services()
+	{
+		// Register the serialization formats with their specified keys.
+		m_services.registerType("xml", std::make_unique<XmlSerializableService>());
+		m_services.registerType("lua", std::make_unique<LuaSerializableService>(m_scripting));
+		m_services.registerType("json", std::make_unique<JsonSerializableService>());
+		m_services.registerType("binary", std::make_unique<BinarySerializableService>());
+	}
+
+	//====================
+	// Getters and setters
+	//====================
+	/**********************************************************/
+	ScriptingManager& Engine::getScripting()
+	{
+		return m_scripting;
+	}
+
+	/**********************************************************/
+	ISerializableService& Engine::getService(const std::string& format)
+	{
+		return m_services.get(format);
+	}
+
+	/**********************************************************/
+	Resources& Engine::getResources()
+	{
+		return m_resources;
+	}
+
+	/**********************************************************/
+	ResourceManager& Engine::getResourceManager()
+	{
+		return m_resourceManager;
+	}
+
+	//====================
+	// Methods
+	//====================
+	/**********************************************************/
+	void Engine::initialise(const ConfigFile& config)
+	{
+		// Create enough lua states to de-serialize the lua files in parallel.
+		m_scripting.getPool().reserve(config.get<unsigned int>("Scripting.state_pool_size"));
+		// Bound the memory each lua state can allocate.
+		m_scripting.setMemoryLimit(static_cast<std::size_t>(config.get<unsigned int>("Scripting.memory_limit")) * 1024);
+		// Only collect the garbage of the main state at the end of each frame.
+		m_scripting.getCollector().setBudget(std::chrono::microseconds(config.get<unsigned int>("Scripting.gc_budget")));
+		// Sample the scripts of the main state, if requested.
+		m_scripting.getProfiler().setCapacity(config.get<unsigned int>("Scripting.profiler_samples"));
+		if (config.get<bool>("Scripting.profiler_enabled"))
+		{
+			m_scripting.getProfiler().start(config.get<unsigned int>("Scripting.profiler_rate"));
+		}
+		// Resume the script tasks within a budget each frame, assets are awaited by prefetching their shards.
+		TaskScheduler& scheduler = m_scripting.getScheduler();
+		scheduler.setBudget(std::chrono::microseconds(config.get<unsigned int>("Scripting.task_budget")));
+		scheduler.setAssetResolver([this](const std::string& name) {
+			m_resources.prefetch(name);
+			return !m_resources.isPending(name);
+		});
+		// Awaiting tasks are resumed with a handle to the loaded asset, or nil if it does not exist.
+		scheduler.setAssetLoader([this](const std::string& name) {
+			sol::state& lua = m_scripting.getState();
+			auto resource = m_resources.get(name);
+			if (!resource)
+			{
+				return sol::make_object(lua, sol::lua_nil);
+			}
+
+			switch (resource.getValue()->type)
+			{
+			case eAssetType::SHADER:
+				return sol::make_object(lua, m_resourceManager.get<ShaderProgram>(name));
+
+			case eAssetType::TEXTURE:
+				return sol::make_object(lua, m_resourceManager.get<Texture>(name));
+
+			default:
+				return sol::make_object(lua, sol::lua_nil);
+			}
+		});
+		scheduler.setErrorHandler([](const std::string& error) {
+			LoggerFactory::getLogger("file.logger").warning("A script task failed:", error);
+		});
+		// Compiled lua files are reused by every state and by later runs.
+		m_scripting.getBytecodeCache().setEnabled(config.get<bool>("Scripting.bytecode_cache"));
+		m_scripting.getBytecodeCache().setDirectory(config.get<std::string>("Scripting.bytecode_directory"));
+		// Set the serializable service to the value found within the configuration file.
+		m_resources.setService(this->getService(config.get<std::string>("Serialization.resource_format")));
+		// Large catalogs are split into shards that are loaded on demand.
+		m_resources.setShardCount(config.get<unsigned int>("Core.resource_shards"));
+		m_resources.load(config.get<std::string>("Core.resource_file"));
+
+		// Creating the shader factory.
+		auto shaderFactory = std::make_unique<ShaderProgramFactory>(m_resources);
+		shaderFactory->setService(this->getService(config.get<std::string>("Serialization.shader_format")));
+		shaderFactory->setThreshold(config.get<unsigned int>("Resources.shader_threshold"));
+		// Creating the texture factory.
+		auto textureFactory = std::make_unique<TextureFactory>(m_resources);
+		textureFactory->setService(this->getService(config.get<std::string>("Serialization.texture_format")));
+		textureFactory->setThreshold(config.get<unsigned int>("Resources.texture_threshold"));
+
+		// Registering the factories with the resource manager.
+		m_resourceManager.registerFactory(std::move(shaderFactory));
+		m_resourceManager.registerFactory(std::move(textureFactory));
+	}
+
+} // namespace pegasus
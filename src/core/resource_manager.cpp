@@ -36,17 +36,17 @@ namespace pegasus
     // Ctors and dtor
     //====================  
     /**********************************************************/
-    ResourceManager::ResourceManager()
-        : Singleton<ResourceManager>(), m_factories()
+    ResourceManager::ResourceManager(Resources& resources)
+        : NonCopyable(), m_factories(), m_resources(resources)
     {
         // Empty.
     }
 
     //==================== 
-    // Methods
+    // Private methods
     //==================== 
     /**********************************************************/
-    void ResourceManager::registerFactory(std::unique_ptr<IAssetFactory>&& factory)
+    void ResourceManager::insertFactory(std::unique_ptr<IAssetFactory>&& factory, std::size_t slot)
     {
         // If the factory is null, throw an exception.
         if (factory.get() == nullptr)
@@ -54,16 +54,86 @@ namespace pegasus
             throw std::runtime_error("Attempted to register a null factory.");
         }
 
-        // Look to see if the factory has already been registered.
-        auto itr = m_factories.find(factory->getType());
+        // The factory must be stored within the slot of the asset it creates, or it is cast to the wrong type.
+        if (factory->getTypeID() != slot)
+        {
+            throw std::runtime_error("Attempted to register a factory bound to another asset type.");
+        }
+
+        if (slot >= m_factories.size())
+        {
+            m_factories.resize(slot + 1);
+        }
+
         // The factory has already been registered, throw an exception.
-        if (itr != m_factories.end())
+        if (m_factories[slot])
         {
-			// TODO(Ben): Throw exception.
+            throw std::runtime_error("Attempted to register a duplicate factory.");
         }
 
         // Register the factory with the manager.
-		m_factories.insert({ factory->getType(), std::move(factory) });
+		m_factories[slot] = std::move(factory);
+    }
+
+    //==================== 
+    // Methods
+    //==================== 
+
+    /**********************************************************/
+    std::size_t ResourceManager::load(const std::string& prefix)
+    {
+        std::size_t count = 0;
+        for (auto& factory : m_factories)
+        {
+            if (factory)
+            {
+                count += factory->loadAll(prefix);
+            }
+        }
+
+        return count;
+    }
+
+    /**********************************************************/
+    std::size_t ResourceManager::unload(const std::string& prefix)
+    {
+        std::size_t count = 0;
+        for (auto& factory : m_factories)
+        {
+            if (factory)
+            {
+                count += factory->unloadAll(prefix);
+            }
+        }
+
+        return count;
+    }
+
+    /**********************************************************/
+    std::size_t ResourceManager::getMemoryUsage(const std::string& prefix) const
+    {
+        std::size_t usage = 0;
+        for (auto& factory : m_factories)
+        {
+            if (factory)
+            {
+                usage += factory->getMemoryUsage(prefix);
+            }
+        }
+
+        return usage;
+    }
+
+    /**********************************************************/
+    void ResourceManager::revalidate()
+    {
+        for (auto& factory : m_factories)
+        {
+            if (factory)
+            {
+                factory->revalidate();
+            }
+        }
     }
 
 } // namespace pegasus
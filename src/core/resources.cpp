@@ -20,11 +20,20 @@
 * 3. This notice may not be removed or altered from any source distribution.
 */
 
+//====================
+// C++ includes
+//====================
+#include <algorithm> // Merging the names listed from each shard.
+#include <map>       // Ordering the namespaces of the directory.
+#include <set>       // Listing each shard of a namespace once.
+#include <sstream>   // Reading and writing the shard indices of the directory.
+
 //====================
 // Pegasus includes
 //====================
 #include <pegasus/core/resources.hpp>                             // Class declaration.
 #include <pegasus/utilities/exceptions/no_resource_exception.hpp> // Throwing exceptions if resource not found.
+#include <pegasus/utilities/hash.hpp>                             // Hashing resource names into shards.
 
 //====================
 // Library includes
@@ -33,11 +42,94 @@
 
 namespace pegasus
 {
+	namespace
+	{
+		//====================
+		// Functions
+		//====================
+		/**********************************************************/
+		void buildIndex(const std::unordered_map<std::string, Resource_t>& resources, RadixTree<const Resource_t*>& index)
+		{
+			// The elements of the map never move, so the index can refer to them directly.
+			index.clear();
+			for (auto& resource : resources)
+			{
+				index.insert(resource.first, &resource.second);
+			}
+		}
+
+		/**********************************************************/
+		std::string getNamespace(const std::string& name)
+		{
+			std::size_t dot = name.find_last_of('.');
+			return dot == std::string::npos ? std::string() : name.substr(0, dot + 1);
+		}
+	} // namespace
+
+	//====================
+	// Ctors and dtor
+	//====================
+	/**********************************************************/
+	Resources::Resources()
+		: NonCopyable(), m_resources(), m_index(), m_directory(), m_pService(nullptr), m_shards(), m_shardCount(0), m_filename(), m_mutex(), 
+			m_queue(), m_workers(), m_activeWorkers(0), m_generation(0)
+	{
+		// Empty.
+	}
+
+	/**********************************************************/
+	Resources::~Resources()
+	{
+		this->wait();
+	}
+
 	//====================
-	// Static declaration.
+	// Private methods
 	//====================
-	std::unordered_map<std::string, Resource_t> Resources::m_resources;
-	ISerializableService* Resources::m_pService;
+	/**********************************************************/
+	Resources::Shard_t& Resources::loadShard(std::size_t index) const
+	{
+		Shard_t& shard = m_shards[index];
+		// Only the first caller de-serializes the shard, any other threads wait for it to finish.
+		std::call_once(shard.loaded, [this, &shard, index]() {
+			shard.resources = m_pService->deserializeResources(Resources::getShardFilename(m_filename, index));
+			buildIndex(shard.resources, shard.index);
+			shard.available = true;
+		});
+
+		return shard;
+	}
+
+	/**********************************************************/
+	void Resources::prefetchShards()
+	{
+		while (true)
+		{
+			std::size_t index;
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				// The queue has been drained, the next prefetch starts a new worker.
+				if (m_queue.empty())
+				{
+					m_activeWorkers--;
+					return;
+				}
+
+				index = m_queue.front();
+				m_queue.pop_front();
+			}
+
+			try
+			{
+				this->loadShard(index);
+			}
+			catch (std::exception&)
+			{
+				// The shard remains unloaded, the error is reported when the resource is requested.
+			}
+			m_shards[index].settled = true;
+		}
+	}
 
 	//====================
 	// Getters and setters
@@ -49,15 +141,147 @@ namespace pegasus
 	}
 
 	/**********************************************************/
-	const Resource_t& Resources::get(const std::string& name) const
+	void Resources::setShardCount(std::size_t count)
 	{
-		auto itr = m_resources.find(name);
-		if (itr == m_resources.end())
+		m_shardCount = count;
+	}
+
+	/**********************************************************/
+	std::size_t Resources::getShardCount() const
+	{
+		return m_shardCount;
+	}
+
+	/**********************************************************/
+	std::size_t Resources::getShardIndex(const std::string& name, std::size_t count)
+	{
+		return static_cast<std::size_t>(Hash::fnv1a(name) % count);
+	}
+
+	/**********************************************************/
+	std::string Resources::getShardFilename(const std::string& filename, std::size_t index)
+	{
+		// Insert the index before the extension, ignoring any dots within the directory.
+		std::size_t extension = filename.find_last_of('.');
+		std::size_t directory = filename.find_last_of("/\\");
+		if (extension == std::string::npos || (directory != std::string::npos && extension < directory))
 		{
-			throw NoResourceException("Unable to load file location for resource: " + name);
+			return filename + "." + std::to_string(index);
 		}
 
-		return itr->second;
+		return filename.substr(0, extension) + "." + std::to_string(index) + filename.substr(extension);
+	}
+
+	/**********************************************************/
+	std::unordered_map<std::string, Resource_t> Resources::getDirectory(const std::vector<std::string>& names, std::size_t count)
+	{
+		std::map<std::string, std::set<std::size_t>> namespaces;
+		for (auto& name : names)
+		{
+			namespaces[getNamespace(name)].insert(Resources::getShardIndex(name, count));
+		}
+
+		std::unordered_map<std::string, Resource_t> directory;
+		for (auto& entry : namespaces)
+		{
+			std::ostringstream shards;
+			for (std::size_t index : entry.second)
+			{
+				shards << (shards.tellp() > 0 ? " " : "") << index;
+			}
+			directory[entry.first] = Resource_t{ shards.str(), eAssetType::DIRECTORY };
+		}
+
+		return directory;
+	}
+
+	/**********************************************************/
+	std::size_t Resources::getGeneration() const
+	{
+		return m_generation.load();
+	}
+
+	/**********************************************************/
+	bool Resources::isPending(const std::string& name) const
+	{
+		if (!m_shards)
+		{
+			return false;
+		}
+
+		const Shard_t& shard = m_shards[Resources::getShardIndex(name, m_shardCount)];
+		return shard.requested.load() && !shard.settled.load();
+	}
+
+	/**********************************************************/
+	bool Resources::isShardLoaded(std::size_t index) const
+	{
+		return m_shards && index < m_shardCount && m_shards[index].available.load();
+	}
+
+	/**********************************************************/
+	Expected<const Resource_t*> Resources::get(const std::string& name) const
+	{
+		const std::unordered_map<std::string, Resource_t>* pResources = &m_resources;
+		if (m_shards)
+		{
+			// Search the shard the name hashes into, loading it if needed.
+			try
+			{
+				pResources = &this->loadShard(Resources::getShardIndex(name, m_shardCount)).resources;
+			}
+			catch (NoResourceException& e)
+			{
+				return Error_t{ eErrorCode::NOT_FOUND, e.what() };
+			}
+		}
+
+		auto itr = pResources->find(name);
+		if (itr == pResources->end())
+		{
+			return Error_t{ eErrorCode::NOT_FOUND, "Unable to load file location for resource: " + name };
+		}
+
+		return &itr->second;
+	}
+
+	/**********************************************************/
+	std::vector<std::string> Resources::list(const std::string& prefix) const
+	{
+		if (!m_shards)
+		{
+			return m_index.getKeys(prefix);
+		}
+
+		// The names beginning with the prefix are either within a namespace beginning with the prefix, or
+		// within the namespace the prefix itself belongs to, e.g. level3.tex lists level3.texture. and level3.
+		std::set<std::size_t> shards;
+		m_directory.forEach(prefix, [&shards](const std::string&, const std::vector<std::size_t>& indices) {
+			shards.insert(indices.begin(), indices.end());
+		});
+		const std::vector<std::size_t>* pParent = m_directory.find(getNamespace(prefix));
+		if (pParent)
+		{
+			shards.insert(pParent->begin(), pParent->end());
+		}
+
+		std::vector<std::string> names;
+		for (std::size_t i : shards)
+		{
+			try
+			{
+				this->loadShard(i).index.forEach(prefix, [&names](const std::string& name, const Resource_t*) {
+					names.push_back(name);
+				});
+			}
+			catch (NoResourceException&)
+			{
+				// The shard cannot be loaded, the error is reported when one of its resources is requested.
+			}
+		}
+
+		std::sort(names.begin(), names.end());
+		return names;
 	}
 
 	//====================
@@ -66,7 +290,117 @@ namespace pegasus
 	/**********************************************************/
 	void Resources::load(const std::string& filename)
 	{
-		m_resources = m_pService->deserializeResources(filename);
+		// Any shards still loading refer to the previous manifest.
+		this->wait();
+		m_generation++;
+		m_directory.clear();
+
+		if (m_shardCount == 0)
+		{
+			m_shards.reset();
+			m_resources = m_pService->deserializeResources(filename);
+			buildIndex(m_resources, m_index);
+			return;
+		}
+
+		// The Resources file only holds the directory of namespaces, the shards are populated on first access.
+		m_filename = filename;
+		m_resources.clear();
+		m_index.clear();
+		for (auto& entry : m_pService->deserializeResources(filename))
+		{
+			if (entry.second.type != eAssetType::DIRECTORY)
+			{
+				continue;
+			}
+
+			std::vector<std::size_t> indices;
+			std::istringstream shards(entry.second.path);
+			std::size_t index;
+			while (shards >> index)
+			{
+				// Ignore any shards beyond the shard count, the directory was generated for another layout.
+				if (index < m_shardCount)
+				{
+					indices.push_back(index);
+				}
+			}
+			m_directory.insert(entry.first, std::move(indices));
+		}
+
+		m_shards.reset(new Shard_t[m_shardCount]);
+		for (std::size_t i = 0; i < m_shardCount; i++)
+		{
+			m_shards[i].requested = false;
+			m_shards[i].settled = false;
+			m_shards[i].available = false;
+		}
+	}
+
+	/**********************************************************/
+	void Resources::prefetch(const std::string& name)
+	{
+		if (!m_shards)
+		{
+			return;
+		}
+
+		std::size_t index = Resources::getShardIndex(name, m_shardCount);
+		// The shard has already been loaded or queued.
+		if (m_shards[index].requested.exchange(true))
+		{
+			return;
+		}
+
+		// The service cannot be used from multiple threads, load the shard immediately.
+		if (!m_pService->isConcurrent())
+		{
+			// The shard has settled by the time this returns, even if it fails to load.
+			m_shards[index].settled = true;
+			try
+			{
+				this->loadShard(index);
+			}
+			catch (std::exception&)
+			{
+				// The shard remains unloaded, the error is reported when the resource is requested, as with the workers.
+			}
+			return;
+		}
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_queue.push_back(index);
+		// The running workers will pick the shard up once they are free.
+		if (m_activeWorkers >= MAX_PREFETCH_THREADS)
+		{
+			return;
+		}
+
+		m_activeWorkers++;
+		m_workers.push_back(std::async(std::launch::async, &Resources::prefetchShards, this));
+	}
+
+	/**********************************************************/
+	void Resources::wait()
+	{
+		// Shards may be prefetched whilst waiting, so keep waiting until no workers remain.
+		while (true)
+		{
+			std::vector<std::future<void>> workers;
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				if (m_workers.empty())
+				{
+					return;
+				}
+				workers.swap(m_workers);
+			}
+
+			for (auto& worker : workers)
+			{
+				worker.wait();
+			}
+		}
 	}
 
 } // namespace pegasus
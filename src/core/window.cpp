@@ -28,10 +28,13 @@
 //====================
 // Pegasus includes
 //====================
-#include <pegasus/core/window.hpp>               // Class declaration.
-#include <pegasus/utilities/logger_factory.hpp>  // Getting the relevant logs.
-#include <pegasus/core/config_file.hpp>          // Retrieving variables from the configuration file.
-#include <pegasus/graphics/gl.hpp>               // Initializing and rendering with OpenGL.
+#include <pegasus/core/window.hpp>                   // Class declaration.
+#include <pegasus/utilities/logger_factory.hpp>      // Getting the relevant logs.
+#include <pegasus/core/config_file.hpp>              // Retrieving variables from the configuration file.
+#include <pegasus/graphics/gl.hpp>                   // Initializing and rendering with OpenGL.
+#include <pegasus/graphics/state_cache.hpp>          // Resetting the cached state of the new context.
+#include <pegasus/graphics/program_binary_cache.hpp> // Querying the driver of the new context.
+#include <pegasus/graphics/shader_compiler.hpp>      // Querying parallel compilation support of the new context.
 
 //====================
 // Library includes
@@ -46,7 +49,7 @@ namespace pegasus
 	/**********************************************************/
 	Window::Window()
 		: NonCopyable(), m_logger(LoggerFactory::getLogger("file.logger")), m_pHandle(nullptr), m_context(),
-			m_settings(), m_title(), m_size(), m_background(), m_running(false)
+			m_settings(), m_title(), m_size(), m_background(), m_running(false), m_focusGained(false)
 	{
 		// Empty.
 	}
@@ -118,6 +121,12 @@ namespace pegasus
 		return m_running;
 	}
 
+	/**********************************************************/
+	bool Window::isFocusGained() const
+	{
+		return m_focusGained;
+	}
+
 	//====================
 	// Methods
 	//====================
@@ -172,6 +181,12 @@ namespace pegasus
 		{
 			throw std::runtime_error("GLEW failed to initialize: ");
 		}
+		// The new context has its default state, which the cache cannot know.
+		gl::StateCache::getInstance().invalidate();
+		// Program binaries are only valid for the driver of the new context.
+		ProgramBinaryCache::getInstance().invalidate();
+		// Parallel compilation must be enabled again for the new context.
+		ShaderCompiler::getInstance().invalidate();
 		// The window creation is successful.
 		m_running = true;
 		// Check that no GL errors have occured during initialization.
@@ -184,6 +199,7 @@ namespace pegasus
 	void Window::pollEvents()
 	{
 		SDL_Event e;
+		m_focusGained = false;
 		// Poll all the events and process the output.
 		while (SDL_PollEvent(&e))
 		{
@@ -192,6 +208,11 @@ namespace pegasus
 			{
 				this->close();
 			}
+			// The user has returned to the window.
+			else if (e.type == SDL_WINDOWEVENT && e.window.event == SDL_WINDOWEVENT_FOCUS_GAINED)
+			{
+				m_focusGained = true;
+			}
 		}
 	}
 
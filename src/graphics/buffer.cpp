@@ -28,8 +28,9 @@
 //====================
 // Pegasus includes
 //====================
-#include <pegasus/graphics/buffer.hpp> // Class declaration.
-#include <pegasus/graphics/gl.hpp>     // OpenGL encapsulated functions.
+#include <pegasus/graphics/buffer.hpp>        // Class declaration.
+#include <pegasus/graphics/gl.hpp>            // OpenGL encapsulated functions.
+#include <pegasus/graphics/release_queue.hpp> // Deferring the deletion of the buffer.
 #include <pegasus/graphics/vertex.hpp>
 
 namespace pegasus
@@ -61,11 +62,8 @@ namespace pegasus
 	/**********************************************************/
 	Buffer::~Buffer()
 	{
-		if (m_ID)
-		{
-			glDeleteBuffers(1, &m_ID);
-			m_ID = 0;
-		}
+		ReleaseQueue::getInstance().release(eObjectType::BUFFER, m_ID);
+		m_ID = 0;
 	}
 
 	//====================
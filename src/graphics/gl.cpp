@@ -29,6 +29,7 @@
 // Pegasus includes
 //====================
 #include <pegasus/graphics/gl.hpp>
+#include <pegasus/graphics/state_cache.hpp>
 #include <pegasus/utilities/logger.hpp>
 #include <pegasus/utilities/logger_factory.hpp>
 
@@ -60,7 +61,7 @@ namespace pegasus
 		/**********************************************************/
 		void bindBuffer(eBufferType type, GLuint ID)
 		{
-			glBindBuffer(static_cast<GLenum>(type), ID);
+			StateCache::getInstance().bindBuffer(static_cast<GLenum>(type), ID);
 		}
 
 		/**********************************************************/
@@ -126,6 +127,19 @@ namespace pegasus
         	glLinkProgram(ID);
         }
 
+        /**********************************************************/
+        bool uniformBlockBinding(GLuint ID, const char* pName, GLuint binding)
+        {
+        	GLuint index = glGetUniformBlockIndex(ID, pName);
+        	if (index == GL_INVALID_INDEX)
+        	{
+        		return false;
+        	}
+
+        	glUniformBlockBinding(ID, index, binding);
+        	return true;
+        }
+
         /**********************************************************/
         GLuint genTexture()
         {
@@ -139,13 +153,13 @@ namespace pegasus
         /**********************************************************/
         void bindTexture(eTextureType type, GLuint ID)
         {
-        	glBindTexture(static_cast<GLenum>(type), ID);
+        	StateCache::getInstance().bindTexture(static_cast<GLenum>(type), ID);
         }
 
 		/**********************************************************/
 		void clearColor(GLclampf r, GLclampf g, GLclampf b, GLclampf a)
 		{
-			glClearColor(r, g, b, a);
+			StateCache::getInstance().clearColor(glm::vec4(r, g, b, a));
 		}
 
 		/**********************************************************/
@@ -163,13 +177,13 @@ namespace pegasus
 		/**********************************************************/
 		void enable(GLenum flag)
 		{
-			glEnable(flag);
+			StateCache::getInstance().enable(flag);
 		}
 
 		/**********************************************************/
 		void disable(GLenum flag)
 		{
-			glDisable(flag);
+			StateCache::getInstance().disable(flag);
 		}
 
 		/**********************************************************/
@@ -0,0 +1,325 @@
+/*
+* Pegasus Engine
+* 2017 - Benjamin Carter (bencarterdev@outlook.com)
+*
+* This software is provided 'as-is', without any express or implied warranty.
+* In no event will the authors be held liable for any damages arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it freely,
+* subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented;
+*    you must not claim that you wrote the original software.
+*    If you use this software in a product, an acknowledgement
+*    in the product documentation would be appreciated but is not required.
+*
+* 2. Altered source versions must be plainly marked as such,
+*    and must not be misrepresented as being the original software.
+*
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+//====================
+// C++ includes
+//====================
+#include <cstdio>   // Formatting the binary file names.
+#include <cstring>  // Reading and writing the header.
+#include <fstream>  // Reading and writing the binaries.
+#include <iterator> // Reading the entire binary file.
+
+//====================
+// Pegasus includes
+//====================
+#include <pegasus/graphics/program_binary_cache.hpp> // Class declaration.
+#include <pegasus/utilities/file_utils.hpp>          // Creating the cache directory and replacing the binaries.
+#include <pegasus/utilities/hash.hpp>                // Hashing the shaders, driver and binaries.
+
+namespace pegasus
+{
+	namespace
+	{
+		//====================
+		// Variables
+		//====================
+		/** Identifies a file as a program binary. */
+		const char BINARY_MAGIC[4] = { 'P', 'G', 'P', 'B' };
+
+		//====================
+		// Functions
+		//====================
+		/**********************************************************/
+		std::string getString(GLenum name)
+		{
+			const GLubyte* pString = glGetString(name);
+			return pString ? reinterpret_cast<const char*>(pString) : std::string();
+		}
+	} // namespace
+
+	//====================
+	// Ctors and dtor
+	//====================
+	/**********************************************************/
+	ProgramBinaryCache::ProgramBinaryCache()
+		: NonCopyable(), m_directory(), m_enabled(false), m_driver(0), m_supported(false), m_queried(false),
+		m_loaded(0), m_stored(0), m_rejected(0)
+	{
+		// Empty.
+	}
+
+	//====================
+	// Private methods
+	//====================
+	/**********************************************************/
+	void ProgramBinaryCache::query()
+	{
+		if (m_queried)
+		{
+			return;
+		}
+
+		m_queried = true;
+		// A binary is only valid for the exact driver that produced it.
+		m_driver = Hash::fnv1a(getString(GL_VERSION), Hash::fnv1a(getString(GL_RENDERER), Hash::fnv1a(getString(GL_VENDOR))));
+
+		// Some drivers expose the functions, but do not support any binary formats.
+		GLint formats = 0;
+		if (GLEW_VERSION_4_1 || GLEW_ARB_get_program_binary)
+		{
+			glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+		}
+		m_supported = formats > 0;
+	}
+
+	/**********************************************************/
+	std::string ProgramBinaryCache::getBinaryPath(std::uint64_t key) const
+	{
+		char name[32];
+		std::snprintf(name, sizeof(name), "%016llx.bin", static_cast<unsigned long long>(key));
+
+		return m_directory + "/" + name;
+	}
+
+	//====================
+	// Getters and setters
+	//====================
+	/**********************************************************/
+	ProgramBinaryCache& ProgramBinaryCache::getInstance()
+	{
+		// Each thread makes its own context current, so each thread caches the binaries of its own driver.
+		static thread_local ProgramBinaryCache cache;
+		return cache;
+	}
+
+	/**********************************************************/
+	void ProgramBinaryCache::setDirectory(const std::string& directory)
+	{
+		if (!directory.empty())
+		{
+			FileUtils::createDirectory(directory);
+		}
+
+		m_directory = directory;
+	}
+
+	/**********************************************************/
+	void ProgramBinaryCache::setEnabled(bool enabled)
+	{
+		m_enabled = enabled;
+	}
+
+	/**********************************************************/
+	bool ProgramBinaryCache::isEnabled()
+	{
+		if (!m_enabled || m_directory.empty())
+		{
+			return false;
+		}
+
+		this->query();
+		return m_supported;
+	}
+
+	/**********************************************************/
+	std::uint64_t ProgramBinaryCache::getKey(const std::vector<Shader*>& shaders)
+	{
+		if (shaders.empty())
+		{
+			return 0;
+		}
+
+		std::uint64_t key = Hash::OFFSET_BASIS;
+		for (const Shader* pShader : shaders)
+		{
+			// The shader was not loaded from a source, so the program cannot be identified.
+			std::uint64_t shaderKey = pShader->getKey();
+			if (shaderKey == 0)
+			{
+				return 0;
+			}
+
+			key = Hash::fnv1aBytes(&shaderKey, sizeof(shaderKey), key);
+		}
+
+		return key;
+	}
+
+	/**********************************************************/
+	std::size_t ProgramBinaryCache::getLoadedCount() const
+	{
+		return m_loaded;
+	}
+
+	/**********************************************************/
+	std::size_t ProgramBinaryCache::getStoredCount() const
+	{
+		return m_stored;
+	}
+
+	/**********************************************************/
+	std::size_t ProgramBinaryCache::getRejectedCount() const
+	{
+		return m_rejected;
+	}
+
+	//====================
+	// Methods
+	//====================
+	/**********************************************************/
+	void ProgramBinaryCache::prepare(GLuint ID)
+	{
+		if (this->isEnabled())
+		{
+			glProgramParameteri(ID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+		}
+	}
+
+	/**********************************************************/
+	bool ProgramBinaryCache::load(GLuint ID, std::uint64_t key)
+	{
+		if (key == 0 || !this->isEnabled())
+		{
+			return false;
+		}
+
+		GLenum format = GL_NONE;
+		std::vector<char> binary;
+		eBinaryStatus status = ProgramBinaryCache::readBinary(this->getBinaryPath(key), key, m_driver, format, binary);
+		// The program has not been cached yet.
+		if (status == eBinaryStatus::MISSING)
+		{
+			return false;
+		}
+
+		if (status == eBinaryStatus::INVALID)
+		{
+			m_rejected++;
+			return false;
+		}
+
+		// The driver may still reject the binary, e.g. after an update that kept the same version string.
+		glProgramBinary(ID, format, binary.data(), static_cast<GLsizei>(binary.size()));
+		GLint linked = GL_FALSE;
+		glGetProgramiv(ID, GL_LINK_STATUS, &linked);
+		if (linked != GL_TRUE)
+		{
+			m_rejected++;
+			return false;
+		}
+
+		m_loaded++;
+		return true;
+	}
+
+	/**********************************************************/
+	void ProgramBinaryCache::store(GLuint ID, std::uint64_t key)
+	{
+		if (key == 0 || !this->isEnabled())
+		{
+			return;
+		}
+
+		GLint length = 0;
+		glGetProgramiv(ID, GL_PROGRAM_BINARY_LENGTH, &length);
+		if (length <= 0)
+		{
+			return;
+		}
+
+		std::vector<char> binary(static_cast<std::size_t>(length));
+		GLsizei written = 0;
+		GLenum format = GL_NONE;
+		glGetProgramBinary(ID, length, &written, &format, binary.data());
+		if (written <= 0)
+		{
+			return;
+		}
+
+		// A failure to write only means the program is compiled again on the next run.
+		if (ProgramBinaryCache::writeBinary(this->getBinaryPath(key), key, m_driver, format, binary.data(), static_cast<std::size_t>(written)))
+		{
+			m_stored++;
+		}
+	}
+
+	/**********************************************************/
+	void ProgramBinaryCache::invalidate()
+	{
+		m_queried = false;
+		m_supported = false;
+		m_driver = 0;
+	}
+
+	/**********************************************************/
+	ProgramBinaryCache::eBinaryStatus ProgramBinaryCache::readBinary(const std::string& path, std::uint64_t key, std::uint64_t driver, GLenum& format,
+		std::vector<char>& binary)
+	{
+		std::ifstream file(path, std::ios::in | std::ios::binary);
+		if (!file.is_open())
+		{
+			return eBinaryStatus::MISSING;
+		}
+
+		std::vector<char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+		if (data.size() < sizeof(Header_t))
+		{
+			return eBinaryStatus::INVALID;
+		}
+
+		Header_t header;
+		std::memcpy(&header, data.data(), sizeof(Header_t));
+		// The binary was written by another driver, another format version or has been truncated or corrupted.
+		const char* pBinary = data.data() + sizeof(Header_t);
+		if (std::memcmp(header.magic, BINARY_MAGIC, sizeof(BINARY_MAGIC)) != 0 || header.version != VERSION || header.key != key ||
+			header.driver != driver || header.length != data.size() - sizeof(Header_t) ||
+			header.checksum != Hash::fnv1aBytes(pBinary, header.length))
+		{
+			return eBinaryStatus::INVALID;
+		}
+
+		format = header.format;
+		binary.assign(pBinary, pBinary + header.length);
+		return eBinaryStatus::VALID;
+	}
+
+	/**********************************************************/
+	bool ProgramBinaryCache::writeBinary(const std::string& path, std::uint64_t key, std::uint64_t driver, GLenum format, const char* pBinary, std::size_t length)
+	{
+		Header_t header;
+		std::memcpy(header.magic, BINARY_MAGIC, sizeof(BINARY_MAGIC));
+		header.version = VERSION;
+		header.key = key;
+		header.driver = driver;
+		header.checksum = Hash::fnv1aBytes(pBinary, length);
+		header.format = format;
+		header.length = static_cast<std::uint32_t>(length);
+
+		std::vector<char> data(sizeof(Header_t) + length);
+		std::memcpy(data.data(), &header, sizeof(Header_t));
+		std::memcpy(data.data() + sizeof(Header_t), pBinary, length);
+
+		// The file is replaced as a whole, so a crash never leaves a truncated binary behind.
+		return FileUtils::replaceFile(path, data.data(), data.size());
+	}
+
+} // namespace pegasus
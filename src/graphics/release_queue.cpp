@@ -0,0 +1,202 @@
+/*
+* Pegasus Engine
+* 2017 - Benjamin Carter (bencarterdev@outlook.com)
+*
+* This software is provided 'as-is', without any express or implied warranty.
+* In no event will the authors be held liable for any damages arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it freely,
+* subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented;
+*    you must not claim that you wrote the original software.
+*    If you use this software in a product, an acknowledgement
+*    in the product documentation would be appreciated but is not required.
+*
+* 2. Altered source versions must be plainly marked as such,
+*    and must not be misrepresented as being the original software.
+*
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+//====================
+// C++ includes
+//====================
+#include <utility> // Swapping the pending batch.
+
+//====================
+// Pegasus includes
+//====================
+#include <pegasus/graphics/release_queue.hpp> // Class declaration.
+#include <pegasus/graphics/state_cache.hpp>   // Forgetting the bindings of deleted objects.
+
+namespace pegasus
+{
+	//====================
+	// Ctors and dtor
+	//====================
+	/**********************************************************/
+	ReleaseQueue::ReleaseQueue()
+		: Singleton<ReleaseQueue>(), m_mutex(), m_pending(), m_batches(), m_fenced(true)
+	{
+		m_pending.fence = nullptr;
+	}
+
+	//====================
+	// Private methods
+	//====================
+	/**********************************************************/
+	void ReleaseQueue::destroy(Batch_t& batch)
+	{
+		if (batch.fence)
+		{
+			glDeleteSync(batch.fence);
+			batch.fence = nullptr;
+		}
+
+		// Buffers and textures can be deleted with a single call. Their IDs are reused, so the cache must forget them.
+		if (!batch.buffers.empty())
+		{
+			gl::StateCache::getInstance().forgetBuffers(batch.buffers.data(), batch.buffers.size());
+			glDeleteBuffers(static_cast<GLsizei>(batch.buffers.size()), batch.buffers.data());
+		}
+
+		if (!batch.textures.empty())
+		{
+			gl::StateCache::getInstance().forgetTextures(batch.textures.data(), batch.textures.size());
+			glDeleteTextures(static_cast<GLsizei>(batch.textures.size()), batch.textures.data());
+		}
+
+		for (GLuint ID : batch.programs)
+		{
+			gl::deleteProgram(ID);
+		}
+
+		for (GLuint ID : batch.shaders)
+		{
+			gl::deleteShader(ID);
+		}
+
+		batch.buffers.clear();
+		batch.programs.clear();
+		batch.shaders.clear();
+		batch.textures.clear();
+	}
+
+	//====================
+	// Getters and setters
+	//====================
+	/**********************************************************/
+	bool ReleaseQueue::isFenced() const
+	{
+		return m_fenced;
+	}
+
+	/**********************************************************/
+	void ReleaseQueue::setFenced(bool fenced)
+	{
+		m_fenced = fenced;
+	}
+
+	/**********************************************************/
+	std::size_t ReleaseQueue::getPendingCount() const
+	{
+		std::size_t count = 0;
+		for (auto& batch : m_batches)
+		{
+			count += batch.buffers.size() + batch.programs.size() + batch.shaders.size() + batch.textures.size();
+		}
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return count + m_pending.buffers.size() + m_pending.programs.size() + m_pending.shaders.size() + m_pending.textures.size();
+	}
+
+	//====================
+	// Methods
+	//====================
+	/**********************************************************/
+	void ReleaseQueue::release(eObjectType type, GLuint ID)
+	{
+		if (!ID)
+		{
+			return;
+		}
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		switch (type)
+		{
+		case eObjectType::BUFFER:
+			m_pending.buffers.push_back(ID);
+			break;
+
+		case eObjectType::PROGRAM:
+			m_pending.programs.push_back(ID);
+			break;
+
+		case eObjectType::SHADER:
+			m_pending.shaders.push_back(ID);
+			break;
+
+		case eObjectType::TEXTURE:
+			m_pending.textures.push_back(ID);
+			break;
+		}
+	}
+
+	/**********************************************************/
+	void ReleaseQueue::flush()
+	{
+		Batch_t batch;
+		batch.fence = nullptr;
+		{
+			// Only hold the lock long enough to take the released objects.
+			std::lock_guard<std::mutex> lock(m_mutex);
+			std::swap(batch, m_pending);
+		}
+
+		if (!batch.buffers.empty() || !batch.programs.empty() || !batch.shaders.empty() || !batch.textures.empty())
+		{
+			if (m_fenced && (GLEW_VERSION_3_2 || GLEW_ARB_sync))
+			{
+				// The objects may still be used by commands the GPU has not yet executed.
+				batch.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+				m_batches.push_back(std::move(batch));
+			}
+			else
+			{
+				ReleaseQueue::destroy(batch);
+			}
+		}
+
+		// The fences are signalled in order, so stop at the first frame the GPU is still working on.
+		while (!m_batches.empty())
+		{
+			GLenum status = glClientWaitSync(m_batches.front().fence, 0, 0);
+			if (status == GL_TIMEOUT_EXPIRED)
+			{
+				break;
+			}
+
+			ReleaseQueue::destroy(m_batches.front());
+			m_batches.pop_front();
+		}
+	}
+
+	/**********************************************************/
+	void ReleaseQueue::finish()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			ReleaseQueue::destroy(m_pending);
+		}
+
+		for (auto& batch : m_batches)
+		{
+			ReleaseQueue::destroy(batch);
+		}
+
+		m_batches.clear();
+	}
+
+} // namespace pegasus
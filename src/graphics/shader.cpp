@@ -28,9 +28,11 @@
 //====================
 // Pegasus includes
 //====================
-#include <pegasus/graphics/shader.hpp>           // Class declaration.
-#include <pegasus/utilities/file_reader.hpp>     // Loading the glsl source file from a directory.
-#include <pegasus/utilities/logger_factory.hpp>  // Loading a logging object.
+#include <pegasus/graphics/shader.hpp>              // Class declaration.
+#include <pegasus/graphics/shader_preprocessor.hpp> // Loading the glsl source file and its includes.
+#include <pegasus/utilities/logger_factory.hpp>     // Loading a logging object.
+#include <pegasus/graphics/release_queue.hpp>       // Deferring the deletion of the shader.
+#include <pegasus/utilities/hash.hpp>               // Hashing the type and source of the shader.
 
 namespace pegasus
 {
@@ -39,7 +41,7 @@ namespace pegasus
 	//====================
 	/**********************************************************/
 	Shader::Shader()
-		: m_logger(LoggerFactory::getLogger("file.logger")), m_ID(0), m_source(), m_type(), m_compiled(false)
+		: m_logger(LoggerFactory::getLogger("file.logger")), m_ID(0), m_source(), m_type(), m_compiled(false), m_key(0)
 	{
 		// Empty.
 	}
@@ -47,7 +49,7 @@ namespace pegasus
 	/**********************************************************/
 	Shader::~Shader()
 	{
-		gl::deleteShader(m_ID);
+		ReleaseQueue::getInstance().release(eObjectType::SHADER, m_ID);
 	}
 
 	//====================
@@ -65,6 +67,37 @@ namespace pegasus
 		return m_compiled;
 	}
 
+	/**********************************************************/
+	const std::string& Shader::getSource() const
+	{
+		return m_source;
+	}
+
+	/**********************************************************/
+	std::uint64_t Shader::getKey() const
+	{
+		return m_key;
+	}
+
+	/**********************************************************/
+	std::uint64_t Shader::getKey(gl::eShaderType type, const std::string& source)
+	{
+		if (source.empty())
+		{
+			return 0;
+		}
+
+		// Identical shaders share the same key, whichever file they were loaded from.
+		GLenum stage = static_cast<GLenum>(type);
+		return Hash::fnv1a(source, Hash::fnv1aBytes(&stage, sizeof(stage)));
+	}
+
+	/**********************************************************/
+	gl::eShaderType Shader::getType() const
+	{
+		return m_type;
+	}
+
 	//====================
 	// Methods
 	//====================
@@ -72,17 +105,17 @@ namespace pegasus
 	bool Shader::loadFromFile(gl::eShaderType type, const std::string& filename)
 	{
 		// TODO(Ben): Check for file extension.
-		// Create the reader and open the file.
-		FileReader reader(filename);
-		// Check that the file opened successfully, if not log a warning.
-		if (reader.failed())
+		// Read the file and resolve its includes.
+		ShaderPreprocessor preprocessor;
+		auto source = preprocessor.process(filename);
+		// Check that the file and its includes were read successfully, if not log a warning.
+		if (!source)
 		{
-			m_logger.warning("Failed to load shader file:", filename);
+			m_logger.warning("Failed to load shader file:", filename, source.getError().message);
 			return false;
 		}
 		// Store the source of the shader.
-		m_source = reader.getSource();
-		m_type = type;
+		this->loadFromSource(type, source.getValue());
 		// The file loaded successfully.
 		return true;
 	}
@@ -92,19 +125,32 @@ namespace pegasus
 	{
 		m_source = source;
 		m_type = type;
+		m_key = Shader::getKey(type, m_source);
 	}
 
 	/**********************************************************/
 	void Shader::compile()
+	{
+		this->submit();
+		this->check();
+	}
+
+	/**********************************************************/
+	void Shader::submit()
 	{
 		// Generate the ID for the shader.
 		m_ID = gl::createShader(m_type);
 		// Get the source of the shader and set it for the shader ID.
 		const GLchar* pSource = m_source.c_str();
 		glShaderSource(m_ID, 1, (const GLchar**)&pSource, nullptr);
-		// Compile the shader.
+		// Compile the shader, the driver may still be compiling it when the call returns.
 		glCompileShader(m_ID);
-		// Check the results of the compilation and log any errors.
+	}
+
+	/**********************************************************/
+	bool Shader::check()
+	{
+		// Check the results of the compilation and log any errors, this waits for the driver to finish compiling.
 		GLint status = gl::shaderStatus(m_ID);
 		// Check if the shader compiled successfully.
 		if (status != GL_TRUE)
@@ -115,8 +161,9 @@ namespace pegasus
 			// Get the contents of the log.
 			std::vector<GLchar> log(logSize);
 			glGetShaderInfoLog(m_ID, logSize, &logSize, &log[0]);
-			// Delete the shader as it failed to compile.
-			gl::deleteShader(m_ID);
+			// Release the shader as it failed to compile, the destructor skips the cleared ID.
+			ReleaseQueue::getInstance().release(eObjectType::SHADER, m_ID);
+			m_ID = 0;
 			// Log the issue.
 			m_logger.warning("GLSL shader failed to compile:", &log[0]);
 		}
@@ -127,10 +174,10 @@ namespace pegasus
 		}
 		// Success!
 		m_logger.debug("GLSL shader compiled successfully");
-		// Clear the shader source.
-		m_source.clear();
 		// Check for any gl problems.
 		PEGASUS_GL_CHECK_ERRORS();
+
+		return m_compiled;
 	}
 
 } // namespace pegasus
\ No newline at end of file
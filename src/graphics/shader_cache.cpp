@@ -0,0 +1,143 @@
+/*
+* Pegasus Engine
+* 2017 - Benjamin Carter (bencarterdev@outlook.com)
+*
+* This software is provided 'as-is', without any express or implied warranty.
+* In no event will the authors be held liable for any damages arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it freely,
+* subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented;
+*    you must not claim that you wrote the original software.
+*    If you use this software in a product, an acknowledgement
+*    in the product documentation would be appreciated but is not required.
+*
+* 2. Altered source versions must be plainly marked as such,
+*    and must not be misrepresented as being the original software.
+*
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+//====================
+// Pegasus includes
+//====================
+#include <pegasus/graphics/shader_cache.hpp> // Class declaration.
+
+namespace pegasus
+{
+	//====================
+	// Ctors and dtor
+	//====================
+	/**********************************************************/
+	ShaderCache::ShaderCache()
+		: NonCopyable(), m_stages(), m_hits(0), m_misses(0)
+	{
+		// Empty.
+	}
+
+	//====================
+	// Private methods
+	//====================
+	/**********************************************************/
+	Shader* ShaderCache::reference(std::uint64_t key)
+	{
+		auto itr = m_stages.find(key);
+		if (itr == m_stages.end())
+		{
+			return nullptr;
+		}
+
+		itr->second.references++;
+		m_hits++;
+		return &itr->second.shader;
+	}
+
+	//====================
+	// Getters and setters
+	//====================
+	/**********************************************************/
+	ShaderCache& ShaderCache::getInstance()
+	{
+		// Each thread makes its own context current, so each thread shares the shaders of its own context.
+		static thread_local ShaderCache cache;
+		return cache;
+	}
+
+	/**********************************************************/
+	std::size_t ShaderCache::getStageCount() const
+	{
+		return m_stages.size();
+	}
+
+	/**********************************************************/
+	std::size_t ShaderCache::getHitCount() const
+	{
+		return m_hits;
+	}
+
+	/**********************************************************/
+	std::size_t ShaderCache::getMissCount() const
+	{
+		return m_misses;
+	}
+
+	//====================
+	// Methods
+	//====================
+	/**********************************************************/
+	Shader* ShaderCache::acquire(gl::eShaderType type, const std::string& source)
+	{
+		std::uint64_t key = Shader::getKey(type, source);
+
+		Shader* pShader = this->reference(key);
+		if (pShader)
+		{
+			return pShader;
+		}
+
+		// The shader is not compiled until a program that references it is submitted.
+		Stage_t& stage = m_stages[key];
+		stage.shader.loadFromSource(type, source);
+		stage.references = 1;
+		m_misses++;
+
+		return &stage.shader;
+	}
+
+	/**********************************************************/
+	Shader* ShaderCache::load(gl::eShaderType type, const std::string& filename)
+	{
+		// The shader logs any issues with the file.
+		Shader shader;
+		if (!shader.loadFromFile(type, filename))
+		{
+			return nullptr;
+		}
+
+		return this->acquire(type, shader.getSource());
+	}
+
+	/**********************************************************/
+	void ShaderCache::release(Shader* pShader)
+	{
+		if (!pShader)
+		{
+			return;
+		}
+
+		auto itr = m_stages.find(pShader->getKey());
+		if (itr == m_stages.end() || &itr->second.shader != pShader)
+		{
+			return;
+		}
+
+		// The shader's ID is deleted through the release queue, once the GPU has finished with it.
+		if (--itr->second.references == 0)
+		{
+			m_stages.erase(itr);
+		}
+	}
+
+} // namespace pegasus
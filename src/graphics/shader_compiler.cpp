@@ -0,0 +1,153 @@
+/*
+* Pegasus Engine
+* 2017 - Benjamin Carter (bencarterdev@outlook.com)
+*
+* This software is provided 'as-is', without any express or implied warranty.
+* In no event will the authors be held liable for any damages arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it freely,
+* subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented;
+*    you must not claim that you wrote the original software.
+*    If you use this software in a product, an acknowledgement
+*    in the product documentation would be appreciated but is not required.
+*
+* 2. Altered source versions must be plainly marked as such,
+*    and must not be misrepresented as being the original software.
+*
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+//====================
+// C++ includes
+//====================
+#include <algorithm> // Removing the finished programs.
+
+//====================
+// Pegasus includes
+//====================
+#include <pegasus/graphics/shader_compiler.hpp> // Class declaration.
+#include <pegasus/graphics/shader_program.hpp>  // Submitting and finishing the programs.
+
+namespace pegasus
+{
+	//====================
+	// Ctors and dtor
+	//====================
+	/**********************************************************/
+	ShaderCompiler::ShaderCompiler()
+		: NonCopyable(), m_pending(), m_parallel(false), m_queried(false)
+	{
+		// Empty.
+	}
+
+	//====================
+	// Private methods
+	//====================
+	/**********************************************************/
+	void ShaderCompiler::query()
+	{
+		if (m_queried)
+		{
+			return;
+		}
+
+		m_queried = true;
+		// The maximum value lets the driver choose how many threads to compile with.
+		if (GLEW_KHR_parallel_shader_compile)
+		{
+			glMaxShaderCompilerThreadsKHR(0xFFFFFFFF);
+		}
+		else if (GLEW_ARB_parallel_shader_compile)
+		{
+			glMaxShaderCompilerThreadsARB(0xFFFFFFFF);
+		}
+		m_parallel = GLEW_KHR_parallel_shader_compile || GLEW_ARB_parallel_shader_compile;
+	}
+
+	//====================
+	// Getters and setters
+	//====================
+	/**********************************************************/
+	ShaderCompiler& ShaderCompiler::getInstance()
+	{
+		// Each thread makes its own context current, so each thread compiles the programs of its own context.
+		static thread_local ShaderCompiler compiler;
+		return compiler;
+	}
+
+	/**********************************************************/
+	bool ShaderCompiler::isParallel()
+	{
+		this->query();
+		return m_parallel;
+	}
+
+	/**********************************************************/
+	std::size_t ShaderCompiler::getPendingCount() const
+	{
+		return m_pending.size();
+	}
+
+	//====================
+	// Methods
+	//====================
+	/**********************************************************/
+	void ShaderCompiler::submit(ShaderProgram& program)
+	{
+		// The driver must be allowed its threads before the first program is compiled.
+		this->query();
+		program.submit();
+		// Programs loaded from the binary cache are finished immediately.
+		if (program.isPending())
+		{
+			m_pending.push_back(&program);
+		}
+	}
+
+	/**********************************************************/
+	void ShaderCompiler::cancel(ShaderProgram& program)
+	{
+		m_pending.erase(std::remove(m_pending.begin(), m_pending.end(), &program), m_pending.end());
+	}
+
+	/**********************************************************/
+	std::size_t ShaderCompiler::poll()
+	{
+		// Finish the completed programs in the order they were submitted, keeping the rest pending.
+		std::size_t pending = 0;
+		for (std::size_t i = 0; i < m_pending.size(); i++)
+		{
+			if (m_pending[i]->isReady())
+			{
+				m_pending[i]->finish();
+				continue;
+			}
+
+			m_pending[pending++] = m_pending[i];
+		}
+		m_pending.resize(pending);
+
+		return m_pending.size();
+	}
+
+	/**********************************************************/
+	void ShaderCompiler::finish()
+	{
+		for (ShaderProgram* pProgram : m_pending)
+		{
+			pProgram->finish();
+		}
+		m_pending.clear();
+	}
+
+	/**********************************************************/
+	void ShaderCompiler::invalidate()
+	{
+		m_queried = false;
+		m_parallel = false;
+	}
+
+} // namespace pegasus
@@ -0,0 +1,259 @@
+/*
+* Pegasus Engine
+* 2017 - Benjamin Carter (bencarterdev@outlook.com)
+*
+* This software is provided 'as-is', without any express or implied warranty.
+* In no event will the authors be held liable for any damages arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it freely,
+* subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented;
+*    you must not claim that you wrote the original software.
+*    If you use this software in a product, an acknowledgement
+*    in the product documentation would be appreciated but is not required.
+*
+* 2. Altered source versions must be plainly marked as such,
+*    and must not be misrepresented as being the original software.
+*
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+//====================
+// C++ includes
+//====================
+#include <algorithm> // Searching the included files.
+
+//====================
+// Pegasus includes
+//====================
+#include <pegasus/graphics/shader_preprocessor.hpp> // Class declaration.
+#include <pegasus/utilities/file_reader.hpp>        // Reading the glsl files.
+
+namespace pegasus
+{
+	namespace
+	{
+		//====================
+		// Functions
+		//====================
+		/**********************************************************/
+		bool isIdentifier(char c)
+		{
+			return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+		}
+
+		/**********************************************************/
+		bool isDirective(const std::string& line, const char* pName)
+		{
+			std::size_t i = line.find_first_not_of(" \t");
+			if (i == std::string::npos || line[i] != '#')
+			{
+				return false;
+			}
+
+			i = line.find_first_not_of(" \t", i + 1);
+			std::string name(pName);
+			return i != std::string::npos && line.compare(i, name.size(), name) == 0 &&
+				(i + name.size() == line.size() || !isIdentifier(line[i + name.size()]));
+		}
+
+		/**********************************************************/
+		std::string getIncludePath(const std::string& line)
+		{
+			// Only quoted paths are supported, there are no system include directories to search.
+			std::size_t begin = line.find('"');
+			std::size_t end = begin == std::string::npos ? std::string::npos : line.find('"', begin + 1);
+			if (end == std::string::npos || end == begin + 1)
+			{
+				return std::string();
+			}
+
+			return line.substr(begin + 1, end - begin - 1);
+		}
+
+		/**********************************************************/
+		std::string getDirectory(const std::string& filename)
+		{
+			std::size_t separator = filename.find_last_of("/\\");
+			return separator == std::string::npos ? std::string() : filename.substr(0, separator + 1);
+		}
+	} // namespace
+
+	//====================
+	// Ctors and dtor
+	//====================
+	/**********************************************************/
+	ShaderPreprocessor::ShaderPreprocessor()
+		: m_files()
+	{
+		// Empty.
+	}
+
+	//====================
+	// Private methods
+	//====================
+	/**********************************************************/
+	Error_t ShaderPreprocessor::include(const std::string& filename, std::string& output, bool nested)
+	{
+		FileReader reader(filename);
+		if (reader.failed())
+		{
+			return Error_t{ eErrorCode::NOT_FOUND, "Unable to read glsl file:" + filename };
+		}
+
+		std::size_t index = m_files.size();
+		m_files.push_back(filename);
+		// The shader itself must begin with its #version directive, so only included files are renumbered.
+		if (nested)
+		{
+			output += "#line 1 " + std::to_string(index) + "\n";
+		}
+
+		const std::string& source = reader.getSource();
+		std::string directory = getDirectory(filename);
+		std::size_t number = 1;
+		std::size_t begin = 0;
+		while (begin < source.size())
+		{
+			std::size_t end = std::min(source.find('\n', begin), source.size());
+			std::string line = source.substr(begin, end - begin);
+			begin = end + 1;
+
+			if (!isDirective(line, "include"))
+			{
+				output += line;
+				output += '\n';
+				number++;
+				continue;
+			}
+
+			std::string path = getIncludePath(line);
+			if (path.empty())
+			{
+				return Error_t{ eErrorCode::INVALID_FORMAT, "Malformed #include on line " + std::to_string(number) + " of glsl file:" + filename };
+			}
+
+			path = directory + path;
+			// The file has already been included, keep an empty line so the numbering is unchanged.
+			if (std::find(m_files.begin(), m_files.end(), path) != m_files.end())
+			{
+				output += '\n';
+			}
+			else
+			{
+				Error_t error = this->include(path, output, true);
+				if (error.code != eErrorCode::NONE)
+				{
+					return error;
+				}
+				// Resume the numbering of this file after the included file.
+				output += "#line " + std::to_string(number + 1) + " " + std::to_string(index) + "\n";
+			}
+			number++;
+		}
+
+		return Error_t{ eErrorCode::NONE, std::string() };
+	}
+
+	//====================
+	// Getters and setters
+	//====================
+	/**********************************************************/
+	const std::vector<std::string>& ShaderPreprocessor::getFiles() const
+	{
+		return m_files;
+	}
+
+	//====================
+	// Methods
+	//====================
+	/**********************************************************/
+	Expected<std::string> ShaderPreprocessor::process(const std::string& filename)
+	{
+		m_files.clear();
+
+		std::string output;
+		Error_t error = this->include(filename, output, false);
+		if (error.code != eErrorCode::NONE)
+		{
+			return error;
+		}
+
+		return output;
+	}
+
+	/**********************************************************/
+	std::string ShaderPreprocessor::define(const std::string& source, const std::vector<std::string>& defines)
+	{
+		if (defines.empty())
+		{
+			return source;
+		}
+
+		// Find the end of the #version directive, which must precede everything but comments.
+		std::size_t position = 0;
+		std::size_t number = 0;
+		std::size_t begin = 0;
+		while (begin < source.size())
+		{
+			std::size_t end = std::min(source.find('\n', begin), source.size());
+			number++;
+			if (isDirective(source.substr(begin, end - begin), "version"))
+			{
+				position = end;
+				break;
+			}
+			begin = end + 1;
+		}
+
+		std::string block;
+		for (const std::string& name : defines)
+		{
+			block += "#define " + name + " 1\n";
+		}
+
+		std::string output(source);
+		if (position == 0)
+		{
+			// There is no #version directive, the defines become the first lines of the shader.
+			block += "#line 1 0\n";
+			output.insert(0, block);
+		}
+		else
+		{
+			// Restore the numbering of the line following the #version directive.
+			block += "#line " + std::to_string(number + 1) + " 0\n";
+			if (position == output.size())
+			{
+				output += '\n';
+			}
+			output.insert(position + 1, block);
+		}
+
+		return output;
+	}
+
+	/**********************************************************/
+	bool ShaderPreprocessor::isReferenced(const std::string& source, const std::string& name)
+	{
+		if (name.empty())
+		{
+			return false;
+		}
+
+		for (std::size_t i = source.find(name); i != std::string::npos; i = source.find(name, i + 1))
+		{
+			bool begins = i == 0 || !isIdentifier(source[i - 1]);
+			bool ends = i + name.size() == source.size() || !isIdentifier(source[i + name.size()]);
+			if (begins && ends)
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+} // namespace pegasus
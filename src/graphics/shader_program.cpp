@@ -23,13 +23,21 @@
 //====================
 // C++ includes
 //====================
-#include <utility>  // Moving the shader to the shader program.
+#include <cassert> // Checking the lifetime of the permutations.
+#include <string>  // Naming the permutations.
 
 //====================
 // Pegasus includes
 //====================
-#include <pegasus/graphics/shader_program.hpp>  // Class declaration.
-#include <pegasus/utilities/logger_factory.hpp> // Logging messages to the external file.
+#include <pegasus/graphics/shader_program.hpp>       // Class declaration.
+#include <pegasus/utilities/logger_factory.hpp>      // Logging messages to the external file.
+#include <pegasus/graphics/release_queue.hpp>        // Deferring the deletion of the program.
+#include <pegasus/graphics/state_cache.hpp>          // Skipping redundant program binds.
+#include <pegasus/graphics/uniform_block.hpp>        // Attaching the shared uniform blocks.
+#include <pegasus/graphics/program_binary_cache.hpp> // Loading and storing the linked program.
+#include <pegasus/graphics/shader_preprocessor.hpp>  // Injecting the permutation defines.
+#include <pegasus/graphics/shader_compiler.hpp>      // Compiling the permutations without waiting for the driver.
+#include <pegasus/graphics/shader_cache.hpp>         // Sharing the shaders between programs.
 
 namespace pegasus
 {
@@ -60,7 +68,8 @@ namespace pegasus
 	//====================
 	/**********************************************************/
 	ShaderProgram::ShaderProgram()
-		: Asset(), m_logger(LoggerFactory::getLogger("file.logger")), m_shaders(), m_uniform(), m_compiled(false)
+		: Asset(), m_logger(LoggerFactory::getLogger("file.logger")), m_shaders(), m_uniform(), m_declarations(), m_plan(), m_planValues(),
+		m_options(), m_permutations(), m_masks(), m_key(0), m_pending(false), m_compiled(false)
 	{
 		m_ID = gl::createProgram();
 		m_uniform.setID(m_ID);
@@ -69,7 +78,96 @@ namespace pegasus
 	/**********************************************************/
 	ShaderProgram::~ShaderProgram()
 	{
-		gl::deleteProgram(m_ID);
+		// The compiler must not finish a program that no longer exists.
+		if (m_pending)
+		{
+			ShaderCompiler::getInstance().cancel(*this);
+		}
+		for (auto& permutation : m_permutations)
+		{
+			// Permutations are deleted with the program, nothing may still reference them.
+			assert(!permutation.second->isReferenced());
+			delete permutation.second;
+		}
+		for (Shader* pShader : m_shaders)
+		{
+			ShaderCache::getInstance().release(pShader);
+		}
+		ReleaseQueue::getInstance().release(eObjectType::PROGRAM, m_ID);
+	}
+
+	//====================
+	// Private methods
+	//====================
+	/**********************************************************/
+	void ShaderProgram::resolve()
+	{
+		m_plan.clear();
+		m_planValues.clear();
+
+		std::vector<unsigned char> value;
+		for (const UniformDeclaration_t& declaration : m_declarations)
+		{
+			// Declarations without a value refer to uniform blocks, which are read from the engine's buffers.
+			if (declaration.value.empty())
+			{
+				if (declaration.frequency == eUniformFrequency::CONSTANT)
+				{
+					m_logger.warning("ShaderProgram:", m_name, "declares constant uniform", declaration.name, "without a value.");
+					continue;
+				}
+
+				eUniformBlock binding = declaration.frequency == eUniformFrequency::FRAME ? eUniformBlock::FRAME : eUniformBlock::MATERIAL;
+				if (!gl::uniformBlockBinding(m_ID, declaration.name.c_str(), static_cast<GLuint>(binding)))
+				{
+					m_logger.warning("ShaderProgram:", m_name, "has no uniform block", declaration.name);
+				}
+				continue;
+			}
+
+			// Per-frame values are shared by every program, so they can only be read from the frame's uniform block.
+			if (declaration.frequency == eUniformFrequency::FRAME)
+			{
+				m_logger.warning("ShaderProgram:", m_name, "declares per-frame uniform", declaration.name, "with a value, declare its uniform block instead.");
+				continue;
+			}
+
+			UniformHandle_t handle = m_uniform.getHandle(declaration.name);
+			if (!m_uniform.encode(handle, declaration.value, value))
+			{
+				m_logger.warning("ShaderProgram:", m_name, "has no active uniform", declaration.name, "matching the declared value.");
+				continue;
+			}
+
+			if (declaration.frequency == eUniformFrequency::CONSTANT)
+			{
+				// Bake the value once, the uniform keeps it until the program is linked again.
+				m_uniform.setEncoded(handle, value.data());
+				continue;
+			}
+
+			m_plan.push_back(UniformBinding_t{ handle, m_planValues.size() });
+			m_planValues.insert(m_planValues.end(), value.begin(), value.end());
+		}
+	}
+
+	/**********************************************************/
+	void ShaderProgram::configure()
+	{
+		// Read the active uniforms once, so they are never looked up by name when they are set.
+		for (const std::string& name : m_uniform.reflect())
+		{
+			m_logger.warning("ShaderProgram:", m_name, "has uniform", name, "whose name hash collides with another uniform, it cannot be set.");
+		}
+		// Read the per-frame and per-material values from the buffers shared by every program.
+		bindUniformBlocks(m_ID);
+		// Compile the declared uniforms into the plan run by process().
+		this->resolve();
+		// It's succeeded, log an message and set the flag to true.
+		m_logger.debug("ShaderProgram:", m_name, "linked successfully,", m_uniform.getCount(), "active uniforms.");
+		m_compiled = true;
+		// Check for OpenGL errors.
+		PEGASUS_GL_CHECK_ERRORS();
 	}
 
 	//====================
@@ -103,47 +201,222 @@ namespace pegasus
 		return m_compiled;
 	}
 
+	/**********************************************************/
+	bool ShaderProgram::isPending() const
+	{
+		return m_pending;
+	}
+
+	/**********************************************************/
+	bool ShaderProgram::isReady() const
+	{
+		if (!m_pending || !(GLEW_KHR_parallel_shader_compile || GLEW_ARB_parallel_shader_compile))
+		{
+			return true;
+		}
+
+		// Querying the completion status never waits for the driver, unlike the link status.
+		GLint completed = GL_FALSE;
+		glGetProgramiv(m_ID, GL_COMPLETION_STATUS_KHR, &completed);
+		return completed == GL_TRUE;
+	}
+
+	/**********************************************************/
+	Uniform& ShaderProgram::getUniform()
+	{
+		return m_uniform;
+	}
+
+	/**********************************************************/
+	std::uint32_t ShaderProgram::getPermutationMask(const std::vector<std::string>& options) const
+	{
+		std::uint32_t mask = 0;
+		for (const std::string& option : options)
+		{
+			for (std::size_t i = 0; i < m_options.size(); i++)
+			{
+				if (m_options[i] == option)
+				{
+					mask |= 1u << i;
+				}
+			}
+		}
+
+		return mask;
+	}
+
+	/**********************************************************/
+	ShaderProgram* ShaderProgram::getPermutation(std::uint32_t mask)
+	{
+		// The permutation lives as long as the program, which the caller must be retaining.
+		assert(isReferenced());
+
+		auto itr = m_masks.find(mask);
+		if (itr != m_masks.end())
+		{
+			return itr->second;
+		}
+
+		// Define the selected options, only within the shaders that refer to them.
+		// Shaders the options leave unchanged are shared with this program.
+		ShaderCache& cache = ShaderCache::getInstance();
+		std::vector<Shader*> shaders;
+		for (Shader* pShader : m_shaders)
+		{
+			std::vector<std::string> defines;
+			for (std::size_t i = 0; i < m_options.size(); i++)
+			{
+				if ((mask & (1u << i)) != 0 && ShaderPreprocessor::isReferenced(pShader->getSource(), m_options[i]))
+				{
+					defines.push_back(m_options[i]);
+				}
+			}
+
+			shaders.push_back(cache.acquire(pShader->getType(), ShaderPreprocessor::define(pShader->getSource(), defines)));
+		}
+
+		// The program has not been submitted yet, identify it by its shaders.
+		if (m_key == 0)
+		{
+			m_key = ProgramBinaryCache::getKey(m_shaders);
+		}
+
+		// Masks that produce the same sources share a single program.
+		std::uint64_t key = ProgramBinaryCache::getKey(shaders);
+		ShaderProgram* pProgram = this;
+		auto permutation = m_permutations.find(key);
+		if (key != m_key && permutation == m_permutations.end())
+		{
+			pProgram = new ShaderProgram();
+			pProgram->setName(m_name + " [" + std::to_string(mask) + "]");
+			// The permutation takes over the references to its shaders.
+			pProgram->m_shaders = shaders;
+			pProgram->m_declarations = m_declarations;
+			// The permutation is drawn with the default program until the driver has compiled it.
+			ShaderCompiler::getInstance().submit(*pProgram);
+			m_permutations.insert({ key, pProgram });
+		}
+		else
+		{
+			if (key != m_key)
+			{
+				pProgram = permutation->second;
+			}
+			for (Shader* pShader : shaders)
+			{
+				cache.release(pShader);
+			}
+		}
+
+		m_masks.insert({ mask, pProgram });
+		return pProgram;
+	}
+
 	//====================
 	// Methods
 	//====================
 	/**********************************************************/
 	void ShaderProgram::attach(gl::eShaderType type, const std::string& filename)
 	{
-		Shader shader;
-		if (shader.loadFromFile(type, filename))
+		// The shader keeps its preprocessed source, so the permutations can define their options without reading the files again.
+		Shader* pShader = ShaderCache::getInstance().load(type, filename);
+		if (pShader)
 		{
-			m_shaders.push_back(shader);
+			m_shaders.push_back(pShader);
 		}
 	}
 
 	/**********************************************************/
 	void ShaderProgram::attach(const Shader& shader)
 	{
-		m_shaders.push_back(std::move(shader));
+		m_shaders.push_back(ShaderCache::getInstance().acquire(shader.getType(), shader.getSource()));
+	}
+
+	/**********************************************************/
+	void ShaderProgram::declare(const UniformDeclaration_t& declaration)
+	{
+		m_declarations.push_back(declaration);
+	}
+
+	/**********************************************************/
+	void ShaderProgram::declarePermutation(const std::string& option)
+	{
+		if (m_options.size() >= MAX_PERMUTATION_OPTIONS)
+		{
+			m_logger.warning("ShaderProgram:", m_name, "declares too many permutation options, ignoring", option);
+			return;
+		}
+
+		m_options.push_back(option);
 	}
 
 	/**********************************************************/
 	void ShaderProgram::compile()
 	{
-		// Compile all of the shaders attached to this program.
-		for (auto& shader : m_shaders)
+		this->submit();
+		this->finish();
+	}
+
+	/**********************************************************/
+	void ShaderProgram::submit()
+	{
+		// The program has already been submitted or compiled.
+		if (m_pending || m_compiled)
 		{
-			// Only compile if it hasn't been already.
-			if (!shader.isCompiled())
+			return;
+		}
+
+		ProgramBinaryCache& cache = ProgramBinaryCache::getInstance();
+		// Identify the program by the sources of its shaders.
+		m_key = ProgramBinaryCache::getKey(m_shaders);
+		if (cache.load(m_ID, m_key))
+		{
+			m_logger.debug("ShaderProgram:", m_name, "loaded from the program binary cache.");
+			this->configure();
+			return;
+		}
+
+		// Submit all of the shaders before any status is queried, so the driver never has to wait for one.
+		for (Shader* pShader : m_shaders)
+		{
+			// Only submit if it hasn't been already, shared shaders are compiled by the first program to use them.
+			if (pShader->getID() == 0)
 			{
-				shader.compile();
+				pShader->submit();
 			}
 			// Attach the shader to the program.
-			gl::attachShader(m_ID, shader.getID());
+			gl::attachShader(m_ID, pShader->getID());
 		}
-		// Link the shaders and program together.
+		// Allow the binary of the linked program to be retrieved.
+		cache.prepare(m_ID);
+		// Link the shaders and program together, the link status is checked by finish().
 		gl::linkProgram(m_ID);
+		m_pending = true;
+	}
+
+	/**********************************************************/
+	void ShaderProgram::finish()
+	{
+		if (!m_pending)
+		{
+			return;
+		}
+
+		m_pending = false;
 		// Retrieve the link state.
 		GLint linked;
 		glGetProgramiv(m_ID, GL_LINK_STATUS, &linked);
 		// The program didn't link successfully, get the error log and log it.
 		if (linked != GL_TRUE)
 		{
+			// The shaders are only checked once the link has failed, to report why.
+			for (Shader* pShader : m_shaders)
+			{
+				if (!pShader->isCompiled())
+				{
+					pShader->check();
+				}
+			}
 			// Retrieve the length of the log.
 			GLint logLength;
 			glGetProgramiv(m_ID, GL_INFO_LOG_LENGTH, &logLength);
@@ -152,40 +425,50 @@ namespace pegasus
 			glGetProgramInfoLog(m_ID, logLength, &logLength, &log[0]);
 			// Log the warning and delete the id.
 			m_logger.warning("ShaderProgram:", m_name, "failed. Error:", &log[0]);
+			for (Shader* pShader : m_shaders)
+			{
+				ShaderCache::getInstance().release(pShader);
+			}
 			m_shaders.clear();
-			// Delete the program and set the compilation flag to false.
-			gl::deleteProgram(m_ID);
+			// Release the program and set the compilation flag to false, the destructor skips the cleared ID.
+			ReleaseQueue::getInstance().release(eObjectType::PROGRAM, m_ID);
+			m_ID = 0;
+			m_uniform.setID(m_ID);
 			m_compiled = false;
+			return;
 		}
 		// Unlink the shaders from the program.
-		for (auto& shader : m_shaders)
+		for (Shader* pShader : m_shaders)
 		{
-			glDetachShader(m_ID, shader.getID()); 
+			glDetachShader(m_ID, pShader->getID());
 		}
+		// Persist the binary, so the next run can skip compiling and linking.
+		ProgramBinaryCache::getInstance().store(m_ID, m_key);
 
-		// It's succeeded, log an message and set the flag to true.
-		m_logger.debug("ShaderProgram:", m_name, "linked successfully.");
-		m_compiled = true;
-		// Check for OpenGL errors.
-		PEGASUS_GL_CHECK_ERRORS();
+		this->configure();
 	}
 
 	/**********************************************************/
 	void ShaderProgram::process()
 	{
-		m_uniform.set("u_texture", 0);
+		for (const UniformBinding_t& binding : m_plan)
+		{
+			m_uniform.setEncoded(binding.handle, &m_planValues[binding.offset]);
+		}
 	}
 
 	/**********************************************************/
 	void ShaderProgram::bind(const ShaderProgram& program)
 	{
-		glUseProgram(program.getID());
+		// Draw with the default program until the program has been compiled.
+		GLuint ID = program.isCompiled() ? program.getID() : ShaderProgram::getDefault()->getID();
+		gl::StateCache::getInstance().useProgram(ID);
 	}
 
 	/**********************************************************/
 	void ShaderProgram::unbind()
 	{
-		glUseProgram(0);
+		gl::StateCache::getInstance().useProgram(0);
 	}
 
 } // namespace pegasus
\ No newline at end of file
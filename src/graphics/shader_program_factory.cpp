@@ -26,8 +26,6 @@
 #include <pegasus/graphics/shader_program_factory.hpp>            // Class declaration.
 #include <pegasus/graphics/shader_program.hpp>                    // Loading in and storing shader programs.
 #include <pegasus/utilities/logger_factory.hpp>                   // Retrieving the log file.
-#include <pegasus/utilities/exceptions/serialize_exception.hpp>   // Catching any thrown serialize exceptions.
-#include <pegasus/utilities/exceptions/no_resource_exception.hpp> // Catching any thrown resource exceptions.
 
 namespace pegasus
 {
@@ -35,8 +33,8 @@ namespace pegasus
 	// Ctors and dtor
 	//====================
 	/**********************************************************/
-	ShaderProgramFactory::ShaderProgramFactory()
-		: IAssetFactory(typeid(ShaderProgram))
+	ShaderProgramFactory::ShaderProgramFactory(Resources& resources)
+		: IAssetFactory(resources, TypeID::get<ShaderProgram>(), eAssetType::SHADER)
 	{
 		m_logger.debug("ShaderProgramFactory constructed.");
 	}
@@ -45,45 +43,17 @@ namespace pegasus
 	// Methods
 	//====================
 	/**********************************************************/
-	Asset* ShaderProgramFactory::load(const std::string& name) // override
+	ShaderProgram* ShaderProgramFactory::load(const std::string& name) // override
 	{
-		// Check the threshold, and delete any non-referenced objects.
-		this->checkThreshold();
-		
-		try
+		Asset* pAsset = this->loadAsset(name);
+		// The shader program failed to load, fall back to the default.
+		if (!pAsset)
 		{
-			Resource_t resource = m_resources.get(name);
-			// See if the shader being requested has already been loaded.
-			auto itr = m_assets.find(resource.path);
-			// It has been found, return a copy of that object.
-			if (itr != m_assets.end())
-			{
-				return itr->second;
-			}
-			// De-serialize and create a new shader program.
-			auto shader = this->getService()->deserialize(eAssetType::SHADER, resource.path);
-			// Insert the shader into the map.
-			m_assets.insert({ resource.path, shader });
-			// Return the new shader program.
-			return shader;
-		}
-		catch (SerializeException& e)
-		{
-			m_logger.warning("ShaderProgramFactory:", e.what(), ". Returning default shader asset.");
-			return ShaderProgram::getDefault();
-		}
-		// Catch a wrong resource and return the default.
-		catch (NoResourceException& e)
-		{
-			m_logger.warning("ShaderProgramFactory:", e.what(), ". Returning default shader asset.");
-			return ShaderProgram::getDefault();
-		}
-		// Might aswell catch all, incase there's any problems that we're not expected.
-		catch (std::exception& e)
-		{
-			m_logger.warning("ShaderProgramFactory:", e.what(), ". Returning default shader asset.");
 			return ShaderProgram::getDefault();
 		}
+
+		// The factory only stores assets it created, so the type is known.
+		return static_cast<ShaderProgram*>(pAsset);
 	}
 
 } // namespace pegasus
\ No newline at end of file
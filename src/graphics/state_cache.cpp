@@ -0,0 +1,302 @@
+/*
+* Pegasus Engine
+* 2017 - Benjamin Carter (bencarterdev@outlook.com)
+*
+* This software is provided 'as-is', without any express or implied warranty.
+* In no event will the authors be held liable for any damages arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it freely,
+* subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented;
+*    you must not claim that you wrote the original software.
+*    If you use this software in a product, an acknowledgement
+*    in the product documentation would be appreciated but is not required.
+*
+* 2. Altered source versions must be plainly marked as such,
+*    and must not be misrepresented as being the original software.
+*
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+//====================
+// C++ includes
+//====================
+#include <algorithm> // Resetting the cached bindings.
+
+//====================
+// Pegasus includes
+//====================
+#include <pegasus/graphics/state_cache.hpp> // Class declaration.
+
+namespace pegasus
+{
+	namespace gl
+	{
+		//====================
+		// Ctors and dtor
+		//====================
+		/**********************************************************/
+		StateCache::StateCache()
+			: NonCopyable(), m_program(UNKNOWN), m_activeTexture(UNKNOWN), m_textures(), m_buffers(), m_bufferBases(), m_vertexArray(UNKNOWN),
+			m_capabilities(), m_blendSource(UNKNOWN), m_blendDestination(UNKNOWN), m_depthFunction(UNKNOWN), m_depthMask(UNKNOWN),
+			m_clearColour(), m_clearColourKnown(false), m_issued(0), m_skipped(0)
+		{
+			this->invalidate();
+		}
+
+		//====================
+		// Private methods
+		//====================
+		/**********************************************************/
+		bool StateCache::record(bool redundant)
+		{
+			if (redundant)
+			{
+				m_skipped++;
+				return false;
+			}
+
+			m_issued++;
+			return true;
+		}
+
+		//====================
+		// Getters and setters
+		//====================
+		/**********************************************************/
+		StateCache& StateCache::getInstance()
+		{
+			// Each thread makes its own context current, so each thread shadows its own state.
+			static thread_local StateCache cache;
+			return cache;
+		}
+
+		/**********************************************************/
+		std::size_t StateCache::getIssuedCalls() const
+		{
+			return m_issued;
+		}
+
+		/**********************************************************/
+		std::size_t StateCache::getSkippedCalls() const
+		{
+			return m_skipped;
+		}
+
+		/**********************************************************/
+		GLuint StateCache::getActiveTexture() const
+		{
+			return m_activeTexture;
+		}
+
+		//====================
+		// Methods
+		//====================
+		/**********************************************************/
+		void StateCache::useProgram(GLuint ID)
+		{
+			if (this->record(m_program == ID))
+			{
+				glUseProgram(ID);
+				m_program = ID;
+			}
+		}
+
+		/**********************************************************/
+		void StateCache::activeTexture(GLuint unit)
+		{
+			if (this->record(m_activeTexture == unit))
+			{
+				glActiveTexture(GL_TEXTURE0 + unit);
+				m_activeTexture = unit;
+			}
+		}
+
+		/**********************************************************/
+		void StateCache::bindTexture(GLenum target, GLuint ID)
+		{
+			// Units beyond the shadowed range, or an unknown active unit, cannot be tracked.
+			if (m_activeTexture >= MAX_TEXTURE_UNITS)
+			{
+				this->record(false);
+				glBindTexture(target, ID);
+				return;
+			}
+
+			TextureBinding_t& binding = m_textures[m_activeTexture];
+			if (this->record(binding.target == target && binding.ID == ID))
+			{
+				glBindTexture(target, ID);
+				binding = { target, ID };
+			}
+		}
+
+		/**********************************************************/
+		void StateCache::bindBuffer(GLenum target, GLuint ID)
+		{
+			auto it = m_buffers.find(target);
+			if (this->record(it != m_buffers.end() && it->second == ID))
+			{
+				glBindBuffer(target, ID);
+				m_buffers[target] = ID;
+			}
+		}
+
+		/**********************************************************/
+		void StateCache::bindBufferBase(GLenum target, GLuint index, GLuint ID)
+		{
+			std::uint64_t key = (static_cast<std::uint64_t>(target) << 32) | index;
+			auto it = m_bufferBases.find(key);
+			if (this->record(it != m_bufferBases.end() && it->second == ID))
+			{
+				glBindBufferBase(target, index, ID);
+				m_bufferBases[key] = ID;
+				m_buffers[target] = ID;
+			}
+		}
+
+		/**********************************************************/
+		void StateCache::bindVertexArray(GLuint ID)
+		{
+			if (this->record(m_vertexArray == ID))
+			{
+				glBindVertexArray(ID);
+				m_vertexArray = ID;
+				// The element array buffer is part of the vertex array state.
+				m_buffers.erase(GL_ELEMENT_ARRAY_BUFFER);
+			}
+		}
+
+		/**********************************************************/
+		void StateCache::enable(GLenum capability)
+		{
+			auto it = m_capabilities.find(capability);
+			if (this->record(it != m_capabilities.end() && it->second))
+			{
+				glEnable(capability);
+				m_capabilities[capability] = true;
+			}
+		}
+
+		/**********************************************************/
+		void StateCache::disable(GLenum capability)
+		{
+			auto it = m_capabilities.find(capability);
+			if (this->record(it != m_capabilities.end() && !it->second))
+			{
+				glDisable(capability);
+				m_capabilities[capability] = false;
+			}
+		}
+
+		/**********************************************************/
+		void StateCache::blendFunc(GLenum source, GLenum destination)
+		{
+			if (this->record(m_blendSource == source && m_blendDestination == destination))
+			{
+				glBlendFunc(source, destination);
+				m_blendSource = source;
+				m_blendDestination = destination;
+			}
+		}
+
+		/**********************************************************/
+		void StateCache::depthFunc(GLenum function)
+		{
+			if (this->record(m_depthFunction == function))
+			{
+				glDepthFunc(function);
+				m_depthFunction = function;
+			}
+		}
+
+		/**********************************************************/
+		void StateCache::depthMask(bool enabled)
+		{
+			GLuint mask = enabled ? GL_TRUE : GL_FALSE;
+			if (this->record(m_depthMask == mask))
+			{
+				glDepthMask(static_cast<GLboolean>(mask));
+				m_depthMask = mask;
+			}
+		}
+
+		/**********************************************************/
+		void StateCache::clearColor(const glm::vec4& colour)
+		{
+			if (this->record(m_clearColourKnown && m_clearColour == colour))
+			{
+				glClearColor(colour.x, colour.y, colour.z, colour.w);
+				m_clearColour = colour;
+				m_clearColourKnown = true;
+			}
+		}
+
+		/**********************************************************/
+		void StateCache::forgetBuffers(const GLuint* pIDs, std::size_t count)
+		{
+			for (std::size_t i = 0; i < count; i++)
+			{
+				for (auto& buffer : m_buffers)
+				{
+					if (buffer.second == pIDs[i])
+					{
+						buffer.second = 0;
+					}
+				}
+				// Deleting a buffer also unbinds it from the indexed binding points.
+				for (auto& buffer : m_bufferBases)
+				{
+					if (buffer.second == pIDs[i])
+					{
+						buffer.second = 0;
+					}
+				}
+			}
+		}
+
+		/**********************************************************/
+		void StateCache::forgetTextures(const GLuint* pIDs, std::size_t count)
+		{
+			for (std::size_t i = 0; i < count; i++)
+			{
+				// Deleting a texture unbinds it from every unit of the context.
+				for (auto& binding : m_textures)
+				{
+					if (binding.ID == pIDs[i])
+					{
+						binding.ID = 0;
+					}
+				}
+			}
+		}
+
+		/**********************************************************/
+		void StateCache::invalidate()
+		{
+			m_program = UNKNOWN;
+			m_activeTexture = UNKNOWN;
+			std::fill(m_textures.begin(), m_textures.end(), TextureBinding_t{ 0, UNKNOWN });
+			m_buffers.clear();
+			m_bufferBases.clear();
+			m_vertexArray = UNKNOWN;
+			m_capabilities.clear();
+			m_blendSource = UNKNOWN;
+			m_blendDestination = UNKNOWN;
+			m_depthFunction = UNKNOWN;
+			m_depthMask = UNKNOWN;
+			m_clearColourKnown = false;
+		}
+
+		/**********************************************************/
+		void StateCache::resetStatistics()
+		{
+			m_issued = 0;
+			m_skipped = 0;
+		}
+
+	} // namespace gl
+
+} // namespace pegasus
@@ -25,6 +25,8 @@
 //====================
 #include <pegasus/graphics/texture.hpp>          // Class declaration.
 #include <pegasus/utilities/logger_factory.hpp>  // Initializing the logger.
+#include <pegasus/graphics/release_queue.hpp>    // Deferring the deletion of the texture.
+#include <pegasus/graphics/state_cache.hpp>      // Skipping redundant texture binds.
 
 //====================
 // Library includes
@@ -43,14 +45,14 @@ namespace pegasus
 	//====================
 	/**********************************************************/
 	Texture::Texture()
-		: Asset(), m_logger(LoggerFactory::getLogger("file.logger")), m_size(), m_type()
+		: Asset(), m_logger(LoggerFactory::getLogger("file.logger")), m_size(), m_type(), m_memoryUsage(0)
 	{
 		m_ID = gl::genTexture();
 	}
 
 	/**********************************************************/
 	Texture::Texture(const TextureDescription_t& description)
-		: Asset(), m_logger(LoggerFactory::getLogger("file.logger")), m_size(), m_type()
+		: Asset(), m_logger(LoggerFactory::getLogger("file.logger")), m_size(), m_type(), m_memoryUsage(0)
 	{
 		m_ID = gl::genTexture();
 		this->loadFromFile(description);
@@ -59,10 +61,8 @@ namespace pegasus
 	/**********************************************************/
 	Texture::~Texture()
 	{
-		if (m_ID)
-		{
-			glDeleteTextures(1, &m_ID);
-		}
+		// The texture may be destroyed off the render thread, so it is deleted at the end of the frame.
+		ReleaseQueue::getInstance().release(eObjectType::TEXTURE, m_ID);
 	}
 
 	//====================
@@ -91,6 +91,12 @@ namespace pegasus
 		return m_type;
 	}
 
+	/**********************************************************/
+	std::size_t Texture::getMemoryUsage() const // override
+	{
+		return m_memoryUsage;
+	}
+
 	//====================
 	// Methods
 	//====================
@@ -112,6 +118,9 @@ namespace pegasus
 
 		// Auto-detect the rgb type.
 		GLenum format = pSurface->format->BytesPerPixel == 3 ? GL_RGB : GL_RGBA;
+		// The mip-map chain adds roughly a third to the size of the base image.
+		std::size_t bytes = static_cast<std::size_t>(m_size.x) * m_size.y * (format == GL_RGB ? 3 : 4);
+		m_memoryUsage = bytes + bytes / 3;
 
 		// Bind the texture and set the information.
 		Texture::bind(*this);
@@ -137,7 +146,7 @@ namespace pegasus
 	/**********************************************************/
 	void Texture::bind(const Texture& texture, GLuint location/*= 0*/)
 	{
-		glActiveTexture(GL_TEXTURE0 + location);
+		gl::StateCache::getInstance().activeTexture(location);
 		gl::bindTexture(texture.getType(), texture.getID());
 	}
 
@@ -26,8 +26,6 @@
 #include <pegasus/graphics/texture_factory.hpp>                   // Class declaration.
 #include <pegasus/graphics/texture.hpp>                           // Loading in and storing shader programs.
 #include <pegasus/utilities/logger.hpp>                           // Logging messages within factories.
-#include <pegasus/utilities/exceptions/serialize_exception.hpp>   // Catching any thrown serialize exceptions.
-#include <pegasus/utilities/exceptions/no_resource_exception.hpp> // Catching any thrown resource exceptions.
 
 namespace pegasus
 {
@@ -35,8 +33,8 @@ namespace pegasus
 	// Ctors and dtor
 	//====================
 	/**********************************************************/
-	TextureFactory::TextureFactory()
-		: IAssetFactory(typeid(Texture))
+	TextureFactory::TextureFactory(Resources& resources)
+		: IAssetFactory(resources, TypeID::get<Texture>(), eAssetType::TEXTURE)
 	{
 		m_logger.debug("TextureFactory constructed.");
 	}
@@ -45,45 +43,17 @@ namespace pegasus
 	// Methods
 	//====================
 	/**********************************************************/
-	Asset* TextureFactory::load(const std::string& name) // override
+	Texture* TextureFactory::load(const std::string& name) // override
 	{
-		// Check the threshold, and delete any non-referenced objects.
-		this->checkThreshold();
-		
-		try
+		Asset* pAsset = this->loadAsset(name);
+		// The texture failed to load, fall back to the default.
+		if (!pAsset)
 		{
-			Resource_t resource = m_resources.get(name);
-			// See if the texture being requested has already been loaded.
-			auto itr = m_assets.find(resource.path);
-			// It has been found, return a copy of that object.
-			if (itr != m_assets.end())
-			{
-				return itr->second;
-			}
-			// De-serialize and create a new texture.
-			auto texture = this->getService()->deserialize(eAssetType::TEXTURE, resource.path);
-			// Insert the texture into the map.
-			m_assets.insert({ resource.path, texture });
-			// Return the new texture.
-			return texture;
-		}
-		catch (SerializeException& e)
-		{
-			m_logger.warning("TextureFactory:", e.what(), ". Returning default texture asset.");
-			return Texture::getDefault();
-		}
-		// Catch a wrong resource and return the default.
-		catch (NoResourceException& e)
-		{
-			m_logger.warning("TextureFactory:", e.what(), ". Returning default texture asset.");
-			return Texture::getDefault();
-		}
-		// Might aswell catch all, incase there's any problems that we're not expected.
-		catch (std::exception& e)
-		{
-			m_logger.warning("TextureFactory:", e.what(), ". Returning default texture asset.");
 			return Texture::getDefault();
 		}
+
+		// The factory only stores assets it created, so the type is known.
+		return static_cast<Texture*>(pAsset);
 	}
 
 } // namespace pegasus
\ No newline at end of file
@@ -20,10 +20,23 @@
 * 3. This notice may not be removed or altered from any source distribution.
 */
 
+//====================
+// C++ includes
+//====================
+#include <algorithm> // Sorting and searching the reflected uniforms.
+#include <cstring>   // Comparing and copying the shadowed values.
+#include <utility>   // Pairing the reflected uniforms with their names.
+
 //====================
 // Pegasus includes
 //====================
-#include <pegasus/graphics/uniform.hpp> // Class declaration.
+#include <pegasus/graphics/uniform.hpp>     // Class declaration.
+#include <pegasus/graphics/state_cache.hpp> // Binding the program before uploading a value.
+
+//====================
+// Library includes
+//====================
+#include <glm/gtc/type_ptr.hpp> // Passing the matrices to OpenGL.
 
 namespace pegasus
 {
@@ -32,11 +45,334 @@ namespace pegasus
 	//====================
 	/**********************************************************/
 	Uniform::Uniform()
-		: m_ID(0)
+		: m_ID(0), m_entries(), m_elements(), m_values()
 	{
 		// Empty.
 	}
 
+	//====================
+	// Private methods
+	//====================
+	/**********************************************************/
+	std::size_t Uniform::getTypeSize(GLenum type)
+	{
+		switch (type)
+		{
+		case GL_FLOAT_VEC2:
+		case GL_INT_VEC2:
+		case GL_UNSIGNED_INT_VEC2:
+		case GL_BOOL_VEC2:
+			return 2 * sizeof(GLint);
+
+		case GL_FLOAT_VEC3:
+		case GL_INT_VEC3:
+		case GL_UNSIGNED_INT_VEC3:
+		case GL_BOOL_VEC3:
+			return 3 * sizeof(GLint);
+
+		case GL_FLOAT_VEC4:
+		case GL_INT_VEC4:
+		case GL_UNSIGNED_INT_VEC4:
+		case GL_BOOL_VEC4:
+		case GL_FLOAT_MAT2:
+			return 4 * sizeof(GLfloat);
+
+		case GL_FLOAT_MAT2x3:
+		case GL_FLOAT_MAT3x2:
+			return 6 * sizeof(GLfloat);
+
+		case GL_FLOAT_MAT2x4:
+		case GL_FLOAT_MAT4x2:
+			return 8 * sizeof(GLfloat);
+
+		case GL_FLOAT_MAT3:
+			return 9 * sizeof(GLfloat);
+
+		case GL_FLOAT_MAT3x4:
+		case GL_FLOAT_MAT4x3:
+			return 12 * sizeof(GLfloat);
+
+		case GL_FLOAT_MAT4:
+			return 16 * sizeof(GLfloat);
+
+		default:
+			// Scalars and samplers.
+			return sizeof(GLint);
+		}
+	}
+
+	/**********************************************************/
+	GLenum Uniform::getValueType(GLenum type)
+	{
+		switch (type)
+		{
+		case GL_FLOAT:
+		case GL_FLOAT_VEC2:
+		case GL_FLOAT_VEC3:
+		case GL_FLOAT_VEC4:
+		case GL_INT_VEC2:
+		case GL_INT_VEC3:
+		case GL_INT_VEC4:
+		case GL_UNSIGNED_INT:
+		case GL_UNSIGNED_INT_VEC2:
+		case GL_UNSIGNED_INT_VEC3:
+		case GL_UNSIGNED_INT_VEC4:
+		case GL_FLOAT_MAT2:
+		case GL_FLOAT_MAT3:
+		case GL_FLOAT_MAT4:
+		case GL_FLOAT_MAT2x3:
+		case GL_FLOAT_MAT3x2:
+		case GL_FLOAT_MAT2x4:
+		case GL_FLOAT_MAT4x2:
+		case GL_FLOAT_MAT3x4:
+		case GL_FLOAT_MAT4x3:
+			return type;
+
+		case GL_BOOL_VEC2:
+			return GL_INT_VEC2;
+
+		case GL_BOOL_VEC3:
+			return GL_INT_VEC3;
+
+		case GL_BOOL_VEC4:
+			return GL_INT_VEC4;
+
+		default:
+			// Integers, booleans and samplers.
+			return GL_INT;
+		}
+	}
+
+	/**********************************************************/
+	void Uniform::bind() const
+	{
+		gl::StateCache::getInstance().useProgram(m_ID);
+	}
+
+	/**********************************************************/
+	void Uniform::upload(GLint location, int value)
+	{
+		glUniform1i(location, value);
+	}
+
+	/**********************************************************/
+	void Uniform::upload(GLint location, unsigned int value)
+	{
+		glUniform1ui(location, value);
+	}
+
+	/**********************************************************/
+	void Uniform::upload(GLint location, float value)
+	{
+		glUniform1f(location, value);
+	}
+
+	/**********************************************************/
+	void Uniform::upload(GLint location, const glm::vec2& value)
+	{
+		glUniform2f(location, value.x, value.y);
+	}
+
+	/**********************************************************/
+	void Uniform::upload(GLint location, const glm::vec3& value)
+	{
+		glUniform3f(location, value.x, value.y, value.z);
+	}
+
+	/**********************************************************/
+	void Uniform::upload(GLint location, const glm::vec4& value)
+	{
+		glUniform4f(location, value.x, value.y, value.z, value.w);
+	}
+
+	/**********************************************************/
+	void Uniform::upload(GLint location, const glm::ivec2& value)
+	{
+		glUniform2i(location, value.x, value.y);
+	}
+
+	/**********************************************************/
+	void Uniform::upload(GLint location, const glm::ivec3& value)
+	{
+		glUniform3i(location, value.x, value.y, value.z);
+	}
+
+	/**********************************************************/
+	void Uniform::upload(GLint location, const glm::ivec4& value)
+	{
+		glUniform4i(location, value.x, value.y, value.z, value.w);
+	}
+
+	/**********************************************************/
+	void Uniform::upload(GLint location, const glm::uvec2& value)
+	{
+		glUniform2ui(location, value.x, value.y);
+	}
+
+	/**********************************************************/
+	void Uniform::upload(GLint location, const glm::uvec3& value)
+	{
+		glUniform3ui(location, value.x, value.y, value.z);
+	}
+
+	/**********************************************************/
+	void Uniform::upload(GLint location, const glm::uvec4& value)
+	{
+		glUniform4ui(location, value.x, value.y, value.z, value.w);
+	}
+
+	/**********************************************************/
+	void Uniform::upload(GLint location, const glm::mat2& value)
+	{
+		glUniformMatrix2fv(location, 1, GL_FALSE, glm::value_ptr(value));
+	}
+
+	/**********************************************************/
+	void Uniform::upload(GLint location, const glm::mat3& value)
+	{
+		glUniformMatrix3fv(location, 1, GL_FALSE, glm::value_ptr(value));
+	}
+
+	/**********************************************************/
+	void Uniform::upload(GLint location, const glm::mat4& value)
+	{
+		glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(value));
+	}
+
+	/**********************************************************/
+	void Uniform::upload(GLint location, const glm::mat2x3& value)
+	{
+		glUniformMatrix2x3fv(location, 1, GL_FALSE, glm::value_ptr(value));
+	}
+
+	/**********************************************************/
+	void Uniform::upload(GLint location, const glm::mat3x2& value)
+	{
+		glUniformMatrix3x2fv(location, 1, GL_FALSE, glm::value_ptr(value));
+	}
+
+	/**********************************************************/
+	void Uniform::upload(GLint location, const glm::mat2x4& value)
+	{
+		glUniformMatrix2x4fv(location, 1, GL_FALSE, glm::value_ptr(value));
+	}
+
+	/**********************************************************/
+	void Uniform::upload(GLint location, const glm::mat4x2& value)
+	{
+		glUniformMatrix4x2fv(location, 1, GL_FALSE, glm::value_ptr(value));
+	}
+
+	/**********************************************************/
+	void Uniform::upload(GLint location, const glm::mat3x4& value)
+	{
+		glUniformMatrix3x4fv(location, 1, GL_FALSE, glm::value_ptr(value));
+	}
+
+	/**********************************************************/
+	void Uniform::upload(GLint location, const glm::mat4x3& value)
+	{
+		glUniformMatrix4x3fv(location, 1, GL_FALSE, glm::value_ptr(value));
+	}
+
+	/**********************************************************/
+	void Uniform::upload(GLint location, GLenum type, const unsigned char* pValue)
+	{
+		const GLfloat* pFloats = reinterpret_cast<const GLfloat*>(pValue);
+		const GLint* pInts = reinterpret_cast<const GLint*>(pValue);
+		const GLuint* pUInts = reinterpret_cast<const GLuint*>(pValue);
+		switch (type)
+		{
+		case GL_FLOAT:
+			glUniform1fv(location, 1, pFloats);
+			break;
+
+		case GL_FLOAT_VEC2:
+			glUniform2fv(location, 1, pFloats);
+			break;
+
+		case GL_FLOAT_VEC3:
+			glUniform3fv(location, 1, pFloats);
+			break;
+
+		case GL_FLOAT_VEC4:
+			glUniform4fv(location, 1, pFloats);
+			break;
+
+		case GL_INT_VEC2:
+		case GL_BOOL_VEC2:
+			glUniform2iv(location, 1, pInts);
+			break;
+
+		case GL_INT_VEC3:
+		case GL_BOOL_VEC3:
+			glUniform3iv(location, 1, pInts);
+			break;
+
+		case GL_INT_VEC4:
+		case GL_BOOL_VEC4:
+			glUniform4iv(location, 1, pInts);
+			break;
+
+		case GL_UNSIGNED_INT:
+			glUniform1uiv(location, 1, pUInts);
+			break;
+
+		case GL_UNSIGNED_INT_VEC2:
+			glUniform2uiv(location, 1, pUInts);
+			break;
+
+		case GL_UNSIGNED_INT_VEC3:
+			glUniform3uiv(location, 1, pUInts);
+			break;
+
+		case GL_UNSIGNED_INT_VEC4:
+			glUniform4uiv(location, 1, pUInts);
+			break;
+
+		case GL_FLOAT_MAT2:
+			glUniformMatrix2fv(location, 1, GL_FALSE, pFloats);
+			break;
+
+		case GL_FLOAT_MAT3:
+			glUniformMatrix3fv(location, 1, GL_FALSE, pFloats);
+			break;
+
+		case GL_FLOAT_MAT4:
+			glUniformMatrix4fv(location, 1, GL_FALSE, pFloats);
+			break;
+
+		case GL_FLOAT_MAT2x3:
+			glUniformMatrix2x3fv(location, 1, GL_FALSE, pFloats);
+			break;
+
+		case GL_FLOAT_MAT3x2:
+			glUniformMatrix3x2fv(location, 1, GL_FALSE, pFloats);
+			break;
+
+		case GL_FLOAT_MAT2x4:
+			glUniformMatrix2x4fv(location, 1, GL_FALSE, pFloats);
+			break;
+
+		case GL_FLOAT_MAT4x2:
+			glUniformMatrix4x2fv(location, 1, GL_FALSE, pFloats);
+			break;
+
+		case GL_FLOAT_MAT3x4:
+			glUniformMatrix3x4fv(location, 1, GL_FALSE, pFloats);
+			break;
+
+		case GL_FLOAT_MAT4x3:
+			glUniformMatrix4x3fv(location, 1, GL_FALSE, pFloats);
+			break;
+
+		// Integers, booleans and samplers.
+		default:
+			glUniform1iv(location, 1, pInts);
+			break;
+		}
+	}
+
 	//====================
 	// Getters and setters
 	//====================
@@ -46,28 +382,214 @@ namespace pegasus
 		m_ID = ID;
 	}
 
-	//====================
-	// Private methods
-	//====================
 	/**********************************************************/
-	GLint Uniform::getLocation(const std::string& name) const
+	UniformHandle_t Uniform::getHandle(std::uint64_t hash) const
 	{
-		return glGetUniformLocation(m_ID, name.c_str());
+		auto it = std::lower_bound(m_entries.begin(), m_entries.end(), hash, [](const Entry_t& entry, std::uint64_t value) {
+			return entry.hash < value;
+		});
+
+		if (it == m_entries.end() || it->hash != hash)
+		{
+			return UniformHandle_t{ ~0u };
+		}
+
+		return UniformHandle_t{ static_cast<std::uint32_t>(it - m_entries.begin()) };
+	}
+
+	/**********************************************************/
+	UniformHandle_t Uniform::getHandle(const std::string& name) const
+	{
+		return this->getHandle(Hash::fnv1a(name));
+	}
+
+	/**********************************************************/
+	GLint Uniform::getLocation(UniformHandle_t handle) const
+	{
+		return handle.index < m_entries.size() ? m_entries[handle.index].location : -1;
+	}
+
+	/**********************************************************/
+	GLenum Uniform::getType(UniformHandle_t handle) const
+	{
+		return handle.index < m_entries.size() ? m_entries[handle.index].type : GL_NONE;
+	}
+
+	/**********************************************************/
+	std::size_t Uniform::getCount() const
+	{
+		return m_entries.size();
 	}
 
 	//====================
 	// Methods
 	//====================
 	/**********************************************************/
-	void Uniform::setParameter(GLint location, int value) const
+	std::vector<std::string> Uniform::reflect()
 	{
-		glUniform1i(location, value);
+		m_entries.clear();
+		m_elements.clear();
+		m_values.clear();
+
+		GLint count = 0;
+		GLint maxLength = 0;
+		glGetProgramiv(m_ID, GL_ACTIVE_UNIFORMS, &count);
+		glGetProgramiv(m_ID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+
+		// The names are only kept until the collisions between their hashes have been found.
+		std::vector<std::pair<Entry_t, std::string>> uniforms;
+		std::vector<GLchar> buffer(static_cast<std::size_t>(std::max(maxLength, 1)));
+		for (GLint i = 0; i < count; i++)
+		{
+			GLsizei length = 0;
+			GLint size = 0;
+			GLenum type = GL_NONE;
+			glGetActiveUniform(m_ID, static_cast<GLuint>(i), static_cast<GLsizei>(buffer.size()), &length, &size, &type, buffer.data());
+
+			GLint location = glGetUniformLocation(m_ID, buffer.data());
+			// Uniforms within uniform blocks have no location, and are set through their buffer.
+			if (location < 0)
+			{
+				continue;
+			}
+
+			// Arrays are reported with the suffix of their first element, which is not part of the name.
+			std::string name(buffer.data(), static_cast<std::size_t>(length));
+			if (name.size() > 3 && name.compare(name.size() - 3, 3, "[0]") == 0)
+			{
+				name.resize(name.size() - 3);
+			}
+
+			uniforms.push_back({ Entry_t{ Hash::fnv1a(name), location, type, Uniform::getValueType(type), std::max(size, 1), 0, Uniform::getTypeSize(type), 0 }, name });
+		}
+
+		std::sort(uniforms.begin(), uniforms.end(), [](const std::pair<Entry_t, std::string>& left, const std::pair<Entry_t, std::string>& right) {
+			return left.first.hash < right.first.hash;
+		});
+
+		std::vector<std::string> collisions;
+		std::size_t offset = 0;
+		for (std::size_t i = 0; i < uniforms.size(); i++)
+		{
+			Entry_t& entry = uniforms[i].first;
+			// A handle could refer to either uniform, so neither can be set.
+			bool previous = i > 0 && uniforms[i - 1].first.hash == entry.hash;
+			bool next = i + 1 < uniforms.size() && uniforms[i + 1].first.hash == entry.hash;
+			if (previous || next)
+			{
+				collisions.push_back(uniforms[i].second);
+				continue;
+			}
+
+			// The elements of an array may not have consecutive locations, so each is looked up once.
+			entry.offset = offset;
+			entry.element = m_elements.size();
+			m_elements.push_back(Element_t{ entry.location, false });
+			for (GLint element = 1; element < entry.size; element++)
+			{
+				std::string name = uniforms[i].second + "[" + std::to_string(element) + "]";
+				m_elements.push_back(Element_t{ glGetUniformLocation(m_ID, name.c_str()), false });
+			}
+
+			m_entries.push_back(entry);
+			offset += entry.bytes * static_cast<std::size_t>(entry.size);
+		}
+		m_values.assign(offset, 0);
+
+		return collisions;
+	}
+
+	/**********************************************************/
+	bool Uniform::encode(UniformHandle_t handle, const std::vector<float>& components, std::vector<unsigned char>& value) const
+	{
+		if (handle.index >= m_entries.size())
+		{
+			return false;
+		}
+
+		const Entry_t& entry = m_entries[handle.index];
+		// Every component of every type is four bytes.
+		if (components.size() * sizeof(GLint) != entry.bytes)
+		{
+			return false;
+		}
+
+		value.resize(entry.bytes);
+		for (std::size_t i = 0; i < components.size(); i++)
+		{
+			switch (entry.type)
+			{
+			case GL_FLOAT:
+			case GL_FLOAT_VEC2:
+			case GL_FLOAT_VEC3:
+			case GL_FLOAT_VEC4:
+			case GL_FLOAT_MAT2:
+			case GL_FLOAT_MAT3:
+			case GL_FLOAT_MAT4:
+			case GL_FLOAT_MAT2x3:
+			case GL_FLOAT_MAT3x2:
+			case GL_FLOAT_MAT2x4:
+			case GL_FLOAT_MAT4x2:
+			case GL_FLOAT_MAT3x4:
+			case GL_FLOAT_MAT4x3:
+				std::memcpy(&value[i * sizeof(GLfloat)], &components[i], sizeof(GLfloat));
+				break;
+
+			case GL_UNSIGNED_INT:
+			case GL_UNSIGNED_INT_VEC2:
+			case GL_UNSIGNED_INT_VEC3:
+			case GL_UNSIGNED_INT_VEC4:
+			{
+				GLuint component = static_cast<GLuint>(components[i]);
+				std::memcpy(&value[i * sizeof(GLuint)], &component, sizeof(GLuint));
+				break;
+			}
+
+			// Integers, booleans and samplers.
+			default:
+			{
+				GLint component = static_cast<GLint>(components[i]);
+				std::memcpy(&value[i * sizeof(GLint)], &component, sizeof(GLint));
+				break;
+			}
+			}
+		}
+
+		return true;
+	}
+
+	/**********************************************************/
+	void Uniform::setEncoded(UniformHandle_t handle, const unsigned char* pValue, std::size_t element)
+	{
+		if (handle.index >= m_entries.size() || element >= static_cast<std::size_t>(m_entries[handle.index].size))
+		{
+			return;
+		}
+
+		const Entry_t& entry = m_entries[handle.index];
+		Element_t& shadow = m_elements[entry.element + element];
+		unsigned char* pShadow = m_values.data() + entry.offset + element * entry.bytes;
+		if (shadow.known && std::memcmp(pShadow, pValue, entry.bytes) == 0)
+		{
+			return;
+		}
+
+		this->bind();
+		Uniform::upload(shadow.location, entry.type, pValue);
+		std::memcpy(pShadow, pValue, entry.bytes);
+		shadow.known = true;
+	}
+
+	/**********************************************************/
+	void Uniform::set(UniformHandle_t handle, bool value)
+	{
+		this->set(handle, 0, static_cast<int>(value));
 	}
 
 	/**********************************************************/
-	void Uniform::setParameter(GLint location, const glm::vec4& vector) const
+	void Uniform::set(UniformHandle_t handle, std::size_t element, bool value)
 	{
-		glUniform4f(location, vector.x, vector.y, vector.z, vector.w);
+		this->set(handle, element, static_cast<int>(value));
 	}
 
-} // namespace pegasus 
\ No newline at end of file
+} // namespace pegasus
@@ -0,0 +1,68 @@
+/*
+* Pegasus Engine
+* 2017 - Benjamin Carter (bencarterdev@outlook.com)
+*
+* This software is provided 'as-is', without any express or implied warranty.
+* In no event will the authors be held liable for any damages arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it freely,
+* subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented;
+*    you must not claim that you wrote the original software.
+*    If you use this software in a product, an acknowledgement
+*    in the product documentation would be appreciated but is not required.
+*
+* 2. Altered source versions must be plainly marked as such,
+*    and must not be misrepresented as being the original software.
+*
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+//====================
+// Pegasus includes
+//====================
+#include <pegasus/graphics/uniform_block.hpp> // Function declarations.
+
+namespace pegasus
+{
+	namespace
+	{
+		//====================
+		// Structures
+		//====================
+		/**
+		 * @brief The name of a shared block within the glsl and its binding point.
+		 */
+		struct BlockBinding_t
+		{
+			/** The name of the block. */
+			const char*   pName;
+			/** The binding point of the block. */
+			eUniformBlock binding;
+		};
+
+		//====================
+		// Variables
+		//====================
+		/** Every shared uniform block, glsl 330 cannot declare the binding point of a block itself. */
+		const BlockBinding_t BLOCK_BINDINGS[] = {
+			{ "FrameData", eUniformBlock::FRAME },
+			{ "MaterialData", eUniformBlock::MATERIAL }
+		};
+	} // namespace
+
+	//====================
+	// Functions
+	//====================
+	/**********************************************************/
+	void bindUniformBlocks(GLuint ID)
+	{
+		for (const BlockBinding_t& block : BLOCK_BINDINGS)
+		{
+			gl::uniformBlockBinding(ID, block.pName, static_cast<GLuint>(block.binding));
+		}
+	}
+
+} // namespace pegasus
@@ -0,0 +1,273 @@
+/*
+* Pegasus Engine
+* 2017 - Benjamin Carter (bencarterdev@outlook.com)
+*
+* This software is provided 'as-is', without any express or implied warranty.
+* In no event will the authors be held liable for any damages arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it freely,
+* subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented;
+*    you must not claim that you wrote the original software.
+*    If you use this software in a product, an acknowledgement
+*    in the product documentation would be appreciated but is not required.
+*
+* 2. Altered source versions must be plainly marked as such,
+*    and must not be misrepresented as being the original software.
+*
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+//====================
+// C++ includes
+//====================
+#include <algorithm> // Copying the smaller of two block sizes.
+#include <cstdlib>   // Allocating the pages and large blocks.
+#include <cstring>   // Copying blocks between size classes.
+#include <new>       // Catching failures to retain a shrunk block.
+
+//====================
+// Pegasus includes
+//====================
+#include <pegasus/scripting/lua_allocator.hpp> // Class declaration.
+
+namespace pegasus
+{
+	namespace
+	{
+		//====================
+		// Functions
+		//====================
+		/**********************************************************/
+		void add(std::atomic<std::size_t>& counter, std::size_t amount)
+		{
+			// Only the thread using the state writes the counters, so they do not need a read-modify-write.
+			counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+		}
+	} // namespace
+
+	//====================
+	// Ctors and dtor
+	//====================
+	/**********************************************************/
+	LuaAllocator::LuaAllocator(std::size_t limit)
+		: NonCopyable(), m_free(), m_pages(), m_liveBytes(0), m_peakBytes(0), m_totalAllocations(0), m_frameAllocations(0), 
+			m_frameBytes(0), m_failedAllocations(0), m_limit(limit), m_pResize(&std::realloc)
+	{
+		m_free.fill(nullptr);
+	}
+
+	/**********************************************************/
+	LuaAllocator::~LuaAllocator()
+	{
+		for (void* pPage : m_pages)
+		{
+			std::free(pPage);
+		}
+	}
+
+	//====================
+	// Private methods
+	//====================
+	/**********************************************************/
+	std::size_t LuaAllocator::getSizeClass(std::size_t size)
+	{
+		return (size - 1) / SIZE_CLASS_STEP;
+	}
+
+	/**********************************************************/
+	void* LuaAllocator::allocate(std::size_t size)
+	{
+		if (size > MAX_SMALL_SIZE)
+		{
+			return std::malloc(size);
+		}
+
+		std::size_t sizeClass = LuaAllocator::getSizeClass(size);
+		// Carve a new page into blocks once the size class has run out.
+		if (!m_free[sizeClass])
+		{
+			char* pPage = static_cast<char*>(std::malloc(PAGE_SIZE));
+			if (!pPage)
+			{
+				return nullptr;
+			}
+			m_pages.push_back(pPage);
+
+			std::size_t blockSize = (sizeClass + 1) * SIZE_CLASS_STEP;
+			for (std::size_t offset = 0; offset + blockSize <= PAGE_SIZE; offset += blockSize)
+			{
+				Block_t* pBlock = reinterpret_cast<Block_t*>(pPage + offset);
+				pBlock->pNext = m_free[sizeClass];
+				m_free[sizeClass] = pBlock;
+			}
+		}
+
+		Block_t* pBlock = m_free[sizeClass];
+		m_free[sizeClass] = pBlock->pNext;
+		return pBlock;
+	}
+
+	/**********************************************************/
+	void LuaAllocator::deallocate(void* pBlock, std::size_t size)
+	{
+		if (size > MAX_SMALL_SIZE)
+		{
+			std::free(pBlock);
+			return;
+		}
+
+		std::size_t sizeClass = LuaAllocator::getSizeClass(size);
+		Block_t* pFree = static_cast<Block_t*>(pBlock);
+		pFree->pNext = m_free[sizeClass];
+		m_free[sizeClass] = pFree;
+	}
+
+	/**********************************************************/
+	void* LuaAllocator::reallocate(void* pBlock, std::size_t oldSize, std::size_t newSize)
+	{
+		// Release the block.
+		if (newSize == 0)
+		{
+			if (pBlock)
+			{
+				this->deallocate(pBlock, oldSize);
+				m_liveBytes.store(m_liveBytes.load(std::memory_order_relaxed) - oldSize, std::memory_order_relaxed);
+			}
+			return nullptr;
+		}
+
+		// Refuse any growth beyond the limit, lua raises a memory error in response.
+		std::size_t limit = m_limit.load(std::memory_order_relaxed);
+		std::size_t liveBytes = m_liveBytes.load(std::memory_order_relaxed);
+		if (limit != 0 && newSize > oldSize && liveBytes - oldSize + newSize > limit)
+		{
+			add(m_failedAllocations, 1);
+			return nullptr;
+		}
+
+		void* pResized = nullptr;
+		if (!pBlock)
+		{
+			pResized = this->allocate(newSize);
+			add(m_totalAllocations, 1);
+			add(m_frameAllocations, 1);
+		}
+		else if (oldSize > MAX_SMALL_SIZE && newSize > MAX_SMALL_SIZE)
+		{
+			pResized = m_pResize(pBlock, newSize);
+			// Lua assumes a shrink cannot fail, the block is still valid at its old size, which can be freed the same.
+			if (!pResized && newSize < oldSize)
+			{
+				pResized = pBlock;
+			}
+		}
+		else if (oldSize <= MAX_SMALL_SIZE && newSize <= MAX_SMALL_SIZE &&
+			LuaAllocator::getSizeClass(oldSize) == LuaAllocator::getSizeClass(newSize))
+		{
+			// The block already fits the new size.
+			pResized = pBlock;
+		}
+		else
+		{
+			// The block moves between the size classes and the system allocator.
+			pResized = this->allocate(newSize);
+			if (pResized)
+			{
+				std::memcpy(pResized, pBlock, std::min(oldSize, newSize));
+				this->deallocate(pBlock, oldSize);
+			}
+			else if (newSize < oldSize)
+			{
+				// Lua assumes a shrink cannot fail, keep the larger block and treat it as the new size from now on.
+				pResized = pBlock;
+				if (oldSize > MAX_SMALL_SIZE)
+				{
+					// The block will be released into a size class, so it is freed along with the pages.
+					try
+					{
+						m_pages.push_back(pBlock);
+					}
+					catch (std::bad_alloc&)
+					{
+						// The block can still be reused, it is only leaked once the allocator is destroyed.
+					}
+				}
+			}
+		}
+
+		// The original block is left untouched if the allocation failed.
+		if (!pResized)
+		{
+			add(m_failedAllocations, 1);
+			return nullptr;
+		}
+
+		if (newSize > oldSize)
+		{
+			add(m_frameBytes, newSize - oldSize);
+		}
+		liveBytes = liveBytes - oldSize + newSize;
+		m_liveBytes.store(liveBytes, std::memory_order_relaxed);
+		if (liveBytes > m_peakBytes.load(std::memory_order_relaxed))
+		{
+			m_peakBytes.store(liveBytes, std::memory_order_relaxed);
+		}
+		return pResized;
+	}
+
+	//====================
+	// Getters and setters
+	//====================
+	/**********************************************************/
+	void LuaAllocator::setLimit(std::size_t limit)
+	{
+		m_limit.store(limit, std::memory_order_relaxed);
+	}
+
+	/**********************************************************/
+	std::size_t LuaAllocator::getLimit() const
+	{
+		return m_limit.load(std::memory_order_relaxed);
+	}
+
+	/**********************************************************/
+	void LuaAllocator::setResize(Resize_t pResize)
+	{
+		m_pResize = pResize;
+	}
+
+	/**********************************************************/
+	LuaMemoryStatistics_t LuaAllocator::getStatistics() const
+	{
+		LuaMemoryStatistics_t statistics;
+		statistics.liveBytes = m_liveBytes.load(std::memory_order_relaxed);
+		statistics.peakBytes = m_peakBytes.load(std::memory_order_relaxed);
+		statistics.totalAllocations = m_totalAllocations.load(std::memory_order_relaxed);
+		statistics.frameAllocations = m_frameAllocations.load(std::memory_order_relaxed);
+		statistics.frameBytes = m_frameBytes.load(std::memory_order_relaxed);
+		statistics.failedAllocations = m_failedAllocations.load(std::memory_order_relaxed);
+
+		return statistics;
+	}
+
+	//====================
+	// Methods
+	//====================
+	/**********************************************************/
+	void LuaAllocator::endFrame()
+	{
+		m_frameAllocations.store(0, std::memory_order_relaxed);
+		m_frameBytes.store(0, std::memory_order_relaxed);
+	}
+
+	/**********************************************************/
+	void* LuaAllocator::luaAlloc(void* pUserData, void* pBlock, std::size_t oldSize, std::size_t newSize)
+	{
+		// When no block is given, newer versions of lua pass the type of the object instead of a size.
+		return static_cast<LuaAllocator*>(pUserData)->reallocate(pBlock, pBlock ? oldSize : 0, newSize);
+	}
+
+} // namespace pegasus
@@ -0,0 +1,261 @@
+/*
+* Pegasus Engine
+* 2017 - Benjamin Carter (bencarterdev@outlook.com)
+*
+* This software is provided 'as-is', without any express or implied warranty.
+* In no event will the authors be held liable for any damages arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it freely,
+* subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented;
+*    you must not claim that you wrote the original software.
+*    If you use this software in a product, an acknowledgement
+*    in the product documentation would be appreciated but is not required.
+*
+* 2. Altered source versions must be plainly marked as such,
+*    and must not be misrepresented as being the original software.
+*
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+//====================
+// C++ includes
+//====================
+#include <cstdio>  // Formatting the chunk file names.
+#include <cstring> // Reading and writing the header.
+
+//====================
+// Pegasus includes
+//====================
+#include <pegasus/scripting/lua_bytecode_cache.hpp> // Class declaration.
+#include <pegasus/utilities/file_reader.hpp>        // Reading the scripts and chunks from disk.
+#include <pegasus/utilities/file_utils.hpp>         // Creating the cache directory and replacing the chunks.
+#include <pegasus/utilities/hash.hpp>               // Hashing the scripts.
+
+namespace pegasus
+{
+	namespace
+	{
+		//====================
+		// Variables
+		//====================
+		/** Identifies a file as a lua chunk. */
+		const char CHUNK_MAGIC[4] = { 'P', 'G', 'L', 'C' };
+
+		//====================
+		// Functions
+		//====================
+		/**********************************************************/
+		int write(lua_State*, const void* pData, std::size_t size, void* pChunk)
+		{
+			static_cast<std::string*>(pChunk)->append(static_cast<const char*>(pData), size);
+			return 0;
+		}
+	} // namespace
+
+	//====================
+	// Ctors and dtor
+	//====================
+	/**********************************************************/
+	LuaBytecodeCache::LuaBytecodeCache()
+		: NonCopyable(), m_chunks(), m_directory(), m_enabled(true), m_mutex()
+	{
+		// Empty.
+	}
+
+	//====================
+	// Private methods
+	//====================
+	/**********************************************************/
+	std::string LuaBytecodeCache::getChunkPath(const std::string& directory, std::uint64_t file)
+	{
+		char name[32];
+		std::snprintf(name, sizeof(name), "%016llx.luac", static_cast<unsigned long long>(file));
+
+		return directory + "/" + name;
+	}
+
+	/**********************************************************/
+	std::string LuaBytecodeCache::readChunk(const std::string& path, std::uint64_t key)
+	{
+		FileReader reader(path);
+		const std::string& data = reader.getSource();
+		if (reader.failed() || data.size() < sizeof(Header_t))
+		{
+			return std::string();
+		}
+
+		Header_t header;
+		std::memcpy(&header, data.data(), sizeof(Header_t));
+		// The chunk was compiled from an older source, by another format version, or has been truncated or corrupted.
+		const char* pBytecode = data.data() + sizeof(Header_t);
+		if (std::memcmp(header.magic, CHUNK_MAGIC, sizeof(CHUNK_MAGIC)) != 0 || header.version != VERSION || header.key != key ||
+			header.length != data.size() - sizeof(Header_t) || header.checksum != Hash::fnv1aBytes(pBytecode, static_cast<std::size_t>(header.length)))
+		{
+			return std::string();
+		}
+
+		return std::string(pBytecode, static_cast<std::size_t>(header.length));
+	}
+
+	/**********************************************************/
+	sol::load_result LuaBytecodeCache::compile(sol::state& lua, std::uint64_t file, std::uint64_t key, const std::string& source, const std::string& filename)
+	{
+		sol::load_result result = lua.load_buffer(source.data(), source.size(), "@" + filename);
+		if (!result.valid())
+		{
+			return result;
+		}
+
+		// Dump the compiled function without removing it from the result.
+		std::string chunk;
+		sol::protected_function function = result;
+		function.push();
+		lua_dump(lua.lua_state(), &write, &chunk);
+		lua_pop(lua.lua_state(), 1);
+
+		std::string directory;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			// Only the thread that stores the chunk writes it to disk.
+			auto it = m_chunks.find(file);
+			if (it != m_chunks.end() && it->second.key == key)
+			{
+				return result;
+			}
+
+			// Any chunk compiled from a previous source of the script is evicted.
+			m_chunks[file] = Chunk_t{ key, chunk };
+			if (m_directory.empty())
+			{
+				return result;
+			}
+			directory = m_directory;
+		}
+
+		Header_t header;
+		std::memcpy(header.magic, CHUNK_MAGIC, sizeof(CHUNK_MAGIC));
+		header.version = VERSION;
+		header.key = key;
+		header.checksum = Hash::fnv1aBytes(chunk.data(), chunk.size());
+		header.length = chunk.size();
+		chunk.insert(0, reinterpret_cast<const char*>(&header), sizeof(Header_t));
+
+		// The chunk of the previous source is replaced. A failure to write only means the chunk is compiled again on the next run.
+		FileUtils::replaceFile(LuaBytecodeCache::getChunkPath(directory, file), chunk.data(), chunk.size());
+
+		return result;
+	}
+
+	//====================
+	// Getters and setters
+	//====================
+	/**********************************************************/
+	void LuaBytecodeCache::setDirectory(const std::string& directory)
+	{
+		if (!directory.empty())
+		{
+			FileUtils::createDirectory(directory);
+		}
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_directory = directory;
+	}
+
+	/**********************************************************/
+	std::string LuaBytecodeCache::getDirectory() const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_directory;
+	}
+
+	/**********************************************************/
+	void LuaBytecodeCache::setEnabled(bool enabled)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_enabled = enabled;
+	}
+
+	/**********************************************************/
+	bool LuaBytecodeCache::isEnabled() const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_enabled;
+	}
+
+	/**********************************************************/
+	std::size_t LuaBytecodeCache::getSize() const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_chunks.size();
+	}
+
+	//====================
+	// Methods
+	//====================
+	/**********************************************************/
+	sol::load_result LuaBytecodeCache::load(sol::state& lua, const std::string& filename)
+	{
+		FileReader reader(filename);
+		// Let lua report the missing file in the same way as an uncached script.
+		if (reader.failed() || !this->isEnabled())
+		{
+			return lua.load_file(filename);
+		}
+
+		// The source is hashed even when the chunk is in memory, as modification times are too coarse to detect every edit.
+		const std::string& source = reader.getSource();
+		std::uint64_t file = Hash::fnv1a(filename.c_str());
+		std::uint64_t key = Hash::fnv1aBytes(source.data(), source.size(), file);
+
+		std::string chunk;
+		std::string directory;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			auto it = m_chunks.find(file);
+			if (it != m_chunks.end() && it->second.key == key)
+			{
+				chunk = it->second.bytecode;
+			}
+			directory = m_directory;
+		}
+
+		// The chunk may have been written by a previous run.
+		bool persisted = false;
+		if (chunk.empty() && !directory.empty())
+		{
+			chunk = LuaBytecodeCache::readChunk(LuaBytecodeCache::getChunkPath(directory, file), key);
+			persisted = !chunk.empty();
+		}
+
+		if (!chunk.empty())
+		{
+			sol::load_result result = lua.load_buffer(chunk.data(), chunk.size(), "@" + filename);
+			if (result.valid())
+			{
+				if (persisted)
+				{
+					std::lock_guard<std::mutex> lock(m_mutex);
+					m_chunks[file] = Chunk_t{ key, std::move(chunk) };
+				}
+				return result;
+			}
+
+			// The chunk was compiled by an incompatible lua build, replace it.
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_chunks.erase(file);
+		}
+
+		return this->compile(lua, file, key, source, filename);
+	}
+
+	/**********************************************************/
+	void LuaBytecodeCache::clear()
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_chunks.clear();
+	}
+
+} // namespace pegasus
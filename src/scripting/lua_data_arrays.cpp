@@ -0,0 +1,111 @@
+/*
+* Pegasus Engine
+* 2017 - Benjamin Carter (bencarterdev@outlook.com)
+*
+* This software is provided 'as-is', without any express or implied warranty.
+* In no event will the authors be held liable for any damages arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it freely,
+* subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented;
+*    you must not claim that you wrote the original software.
+*    If you use this software in a product, an acknowledgement
+*    in the product documentation would be appreciated but is not required.
+*
+* 2. Altered source versions must be plainly marked as such,
+*    and must not be misrepresented as being the original software.
+*
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+//====================
+// Pegasus includes
+//====================
+#include <pegasus/scripting/lua_data_arrays.hpp> // Class declaration.
+
+namespace pegasus
+{
+	//====================
+	// Ctors and dtor
+	//====================
+	/**********************************************************/
+	LuaDataArrays::LuaDataArrays(sol::state& state)
+		: NonCopyable(), m_state(state), m_arrays(state.create_table()), m_viewTypes(),
+		m_ffi(LuaDataArrays::isFFIAvailable())
+	{
+		m_state["arrays"] = m_arrays;
+	}
+
+	//====================
+	// Private methods
+	//====================
+	/**********************************************************/
+	void LuaDataArrays::exposeFFI(const std::string& name, const std::string& type, void* pData, std::size_t count)
+	{
+		// The address is pushed as light userdata, which the FFI can cast to a typed pointer.
+		sol::table ffi = m_state["ffi"];
+		sol::protected_function cast = ffi["cast"];
+		this->getEntry(name, count)["data"] = cast(type + "*", pData).get<sol::object>();
+	}
+
+	/**********************************************************/
+	sol::table LuaDataArrays::getEntry(const std::string& name, std::size_t count)
+	{
+		sol::object existing = m_arrays[name];
+		sol::table entry = existing.get_type() == sol::type::table ? existing.as<sol::table>() : m_state.create_table();
+		entry["count"] = count;
+		m_arrays[name] = entry;
+
+		return entry;
+	}
+
+	//====================
+	// Getters and setters
+	//====================
+	/**********************************************************/
+	bool LuaDataArrays::isFFIAvailable()
+	{
+#if defined(PEGASUS_LUAJIT)
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	/**********************************************************/
+	void LuaDataArrays::setFFIEnabled(bool enabled)
+	{
+		m_ffi = enabled && LuaDataArrays::isFFIAvailable();
+	}
+
+	/**********************************************************/
+	bool LuaDataArrays::isFFIEnabled() const
+	{
+		return m_ffi;
+	}
+
+	//====================
+	// Methods
+	//====================
+	/**********************************************************/
+	void LuaDataArrays::declare(const std::string& declaration)
+	{
+		if (!LuaDataArrays::isFFIAvailable())
+		{
+			return;
+		}
+
+		sol::table ffi = m_state["ffi"];
+		sol::protected_function cdef = ffi["cdef"];
+		cdef(declaration);
+	}
+
+	/**********************************************************/
+	void LuaDataArrays::remove(const std::string& name)
+	{
+		m_arrays[name] = sol::lua_nil;
+	}
+
+} // namespace pegasus
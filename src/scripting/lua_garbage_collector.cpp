@@ -0,0 +1,162 @@
+/*
+* Pegasus Engine
+* 2017 - Benjamin Carter (bencarterdev@outlook.com)
+*
+* This software is provided 'as-is', without any express or implied warranty.
+* In no event will the authors be held liable for any damages arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it freely,
+* subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented;
+*    you must not claim that you wrote the original software.
+*    If you use this software in a product, an acknowledgement
+*    in the product documentation would be appreciated but is not required.
+*
+* 2. Altered source versions must be plainly marked as such,
+*    and must not be misrepresented as being the original software.
+*
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+//====================
+// C++ includes
+//====================
+#include <algorithm> // Clamping the step size.
+
+//====================
+// Pegasus includes
+//====================
+#include <pegasus/scripting/lua_garbage_collector.hpp> // Class declaration.
+
+namespace pegasus
+{
+	//====================
+	// Ctors and dtor
+	//====================
+	/**********************************************************/
+	LuaGarbageCollector::LuaGarbageCollector(sol::state& state, LuaAllocator& allocator)
+		: NonCopyable(), m_state(state), m_allocator(allocator), m_budget(0), m_frameTime(0), m_frameSteps(0),
+		m_stepSize(MIN_STEP_SIZE), m_cycleFinished(false), m_failedAllocations(0), m_liveBytes(0), m_collectedBytes(0), m_fullCollections(0)
+	{
+		// Empty.
+	}
+
+	//====================
+	// Private methods
+	//====================
+	/**********************************************************/
+	LuaMemoryStatistics_t LuaGarbageCollector::getStatistics() const
+	{
+#if defined(PEGASUS_LUAJIT)
+		// LuaJIT states do not use the allocator, so only the live bytes of the state can be measured.
+		lua_State* pState = m_state.lua_state();
+		std::size_t liveBytes = static_cast<std::size_t>(lua_gc(pState, LUA_GCCOUNT, 0)) * 1024 + static_cast<std::size_t>(lua_gc(pState, LUA_GCCOUNTB, 0));
+		LuaMemoryStatistics_t statistics = {};
+		statistics.liveBytes = liveBytes;
+		statistics.frameBytes = liveBytes > m_liveBytes ? liveBytes - m_liveBytes : 0;
+		return statistics;
+#else
+		return m_allocator.getStatistics();
+#endif
+	}
+
+	//====================
+	// Getters and setters
+	//====================
+	/**********************************************************/
+	void LuaGarbageCollector::setBudget(std::chrono::microseconds budget)
+	{
+		m_budget = budget;
+		lua_gc(m_state.lua_state(), m_budget.count() > 0 ? LUA_GCSTOP : LUA_GCRESTART, 0);
+	}
+
+	/**********************************************************/
+	std::chrono::microseconds LuaGarbageCollector::getBudget() const
+	{
+		return m_budget;
+	}
+
+	/**********************************************************/
+	std::chrono::microseconds LuaGarbageCollector::getFrameTime() const
+	{
+		return m_frameTime;
+	}
+
+	/**********************************************************/
+	std::size_t LuaGarbageCollector::getFrameSteps() const
+	{
+		return m_frameSteps;
+	}
+
+	/**********************************************************/
+	int LuaGarbageCollector::getStepSize() const
+	{
+		return m_stepSize;
+	}
+
+	/**********************************************************/
+	std::size_t LuaGarbageCollector::getFullCollectionCount() const
+	{
+		return m_fullCollections;
+	}
+
+	//====================
+	// Methods
+	//====================
+	/**********************************************************/
+	void LuaGarbageCollector::step()
+	{
+		m_frameTime = std::chrono::microseconds(0);
+		m_frameSteps = 0;
+		// Lua is collecting automatically.
+		if (m_budget.count() == 0)
+		{
+			return;
+		}
+
+		LuaMemoryStatistics_t statistics = this->getStatistics();
+		// Nothing has been allocated since the last cycle finished, so there is nothing to collect.
+		if (m_cycleFinished && statistics.frameBytes == 0)
+		{
+			return;
+		}
+
+		lua_State* pState = m_state.lua_state();
+		auto start = std::chrono::steady_clock::now();
+
+		// An allocation was refused because the collector fell behind, or the state is about to reach its limit, catch up immediately.
+		// A full collection cannot shrink memory that is still live, so near the limit it is only repeated once the state has used
+		// half of the room the last full collection left it, otherwise a large working set would stall every frame.
+		std::size_t limit = m_allocator.getLimit();
+		bool highWater = limit != 0 && static_cast<double>(statistics.liveBytes) * 100.0 >= static_cast<double>(limit) * HIGH_WATER_PERCENT;
+		bool grown = statistics.liveBytes >= m_collectedBytes + (limit - std::min(m_collectedBytes, limit)) / 2;
+		if (statistics.failedAllocations != m_failedAllocations || (highWater && grown))
+		{
+			m_failedAllocations = statistics.failedAllocations;
+			lua_gc(pState, LUA_GCCOLLECT, 0);
+			m_frameSteps = 1;
+			m_cycleFinished = true;
+			m_collectedBytes = this->getStatistics().liveBytes;
+			m_fullCollections++;
+		}
+		else
+		{
+			// Perform roughly as much work in each step as the state allocated during the frame.
+			m_stepSize = static_cast<int>(std::min<std::size_t>(std::max<std::size_t>(statistics.frameBytes / 1024, MIN_STEP_SIZE), MAX_STEP_SIZE));
+			do
+			{
+				m_frameSteps++;
+				m_cycleFinished = lua_gc(pState, LUA_GCSTEP, m_stepSize) != 0;
+			}
+			while (!m_cycleFinished && std::chrono::steady_clock::now() - start < m_budget);
+		}
+		// Lua 5.1 and LuaJIT reset the collection threshold whenever they step or collect, which restarts the automatic collector.
+		lua_gc(pState, LUA_GCSTOP, 0);
+
+		m_frameTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+		m_liveBytes = this->getStatistics().liveBytes;
+	}
+
+} // namespace pegasus
@@ -0,0 +1,256 @@
+/*
+* Pegasus Engine
+* 2017 - Benjamin Carter (bencarterdev@outlook.com)
+*
+* This software is provided 'as-is', without any express or implied warranty.
+* In no event will the authors be held liable for any damages arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it freely,
+* subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented;
+*    you must not claim that you wrote the original software.
+*    If you use this software in a product, an acknowledgement
+*    in the product documentation would be appreciated but is not required.
+*
+* 2. Altered source versions must be plainly marked as such,
+*    and must not be misrepresented as being the original software.
+*
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+//====================
+// C++ includes
+//====================
+#include <algorithm> // Replacing the separators within the function names.
+#include <map>       // Aggregating the unique call stacks in order.
+
+//====================
+// Pegasus includes
+//====================
+#include <pegasus/scripting/lua_profiler.hpp> // Class declaration.
+
+namespace pegasus
+{
+	namespace
+	{
+		//====================
+		// Variables
+		//====================
+		/** The address of this variable is the registry key of the profiler of a state. */
+		char PROFILER_KEY = 0;
+	} // namespace
+
+	//====================
+	// Ctors and dtor
+	//====================
+	/**********************************************************/
+	LuaProfiler::LuaProfiler(sol::state& state, std::size_t capacity)
+		: NonCopyable(), m_state(state), m_samples(), m_next(0), m_recorded(0), m_period(0), m_running(false), m_timer(),
+		m_mutex(), m_timerMutex(), m_stopped()
+	{
+		this->setCapacity(capacity);
+	}
+
+	/**********************************************************/
+	LuaProfiler::~LuaProfiler()
+	{
+		this->stop();
+	}
+
+	//====================
+	// Private methods
+	//====================
+	/**********************************************************/
+	void LuaProfiler::hook(lua_State* pState, lua_Debug*)
+	{
+		// Disarm the hook until the next period.
+		lua_sethook(pState, nullptr, 0, 0);
+
+		lua_pushlightuserdata(pState, &PROFILER_KEY);
+		lua_rawget(pState, LUA_REGISTRYINDEX);
+		LuaProfiler* pProfiler = static_cast<LuaProfiler*>(lua_touserdata(pState, -1));
+		lua_pop(pState, 1);
+
+		if (pProfiler)
+		{
+			pProfiler->sample(pState);
+		}
+	}
+
+	/**********************************************************/
+	void LuaProfiler::sample(lua_State* pState)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (m_samples.empty())
+		{
+			return;
+		}
+
+		Sample_t& sample = m_samples[m_next];
+		m_next = (m_next + 1) % m_samples.size();
+		m_recorded++;
+
+		lua_Debug debug;
+		sample.depth = 0;
+		while (sample.depth < MAX_DEPTH && lua_getstack(pState, static_cast<int>(sample.depth), &debug))
+		{
+			lua_getinfo(pState, "Sn", &debug);
+			if (sample.frames.size() <= sample.depth)
+			{
+				sample.frames.emplace_back();
+			}
+
+			// The string is assigned in place, so its memory is reused once the ring buffer has wrapped.
+			std::string& frame = sample.frames[sample.depth++];
+			frame.assign(debug.name ? debug.name : (debug.what && debug.what[0] == 'm' ? "main" : "?"));
+			frame.append("@");
+			frame.append(debug.short_src);
+			frame.append(":");
+			frame.append(std::to_string(debug.linedefined));
+		}
+	}
+
+	/**********************************************************/
+	void LuaProfiler::run()
+	{
+		std::unique_lock<std::mutex> lock(m_timerMutex);
+		while (!m_stopped.wait_for(lock, m_period, [this]() { return !m_running.load(); }))
+		{
+			this->trigger();
+		}
+	}
+
+	//====================
+	// Getters and setters
+	//====================
+	/**********************************************************/
+	void LuaProfiler::setCapacity(std::size_t capacity)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_samples.assign(capacity, Sample_t{ {}, 0 });
+		m_next = 0;
+		m_recorded = 0;
+	}
+
+	/**********************************************************/
+	bool LuaProfiler::isRunning() const
+	{
+		return m_running.load();
+	}
+
+	/**********************************************************/
+	std::size_t LuaProfiler::getSampleCount() const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_recorded;
+	}
+
+	/**********************************************************/
+	std::string LuaProfiler::getFoldedStacks() const
+	{
+		std::map<std::string, std::size_t> stacks;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			std::size_t count = std::min(m_recorded, m_samples.size());
+			for (std::size_t i = 0; i < count; i++)
+			{
+				const Sample_t& sample = m_samples[i];
+				// Samples taken outside of any lua function have no stack.
+				if (sample.depth == 0)
+				{
+					continue;
+				}
+
+				// Folded stacks list the outermost function first.
+				std::string stack;
+				for (std::size_t frame = sample.depth; frame > 0; frame--)
+				{
+					std::string name = sample.frames[frame - 1];
+					std::replace(name.begin(), name.end(), ';', ':');
+					stack.append(name);
+					stack.append(frame > 1 ? ";" : "");
+				}
+				stacks[stack]++;
+			}
+		}
+
+		std::string folded;
+		for (auto& stack : stacks)
+		{
+			folded.append(stack.first);
+			folded.append(" ");
+			folded.append(std::to_string(stack.second));
+			folded.append("\n");
+		}
+
+		return folded;
+	}
+
+	//====================
+	// Methods
+	//====================
+	/**********************************************************/
+	void LuaProfiler::start(unsigned int rate)
+	{
+		if (m_running.load())
+		{
+			return;
+		}
+
+		// Allow the hook to find the profiler from the state.
+		lua_State* pState = m_state.lua_state();
+		lua_pushlightuserdata(pState, &PROFILER_KEY);
+		lua_pushlightuserdata(pState, this);
+		lua_rawset(pState, LUA_REGISTRYINDEX);
+
+		m_running.store(true);
+		if (rate != 0)
+		{
+			m_period = std::chrono::microseconds(1000000 / rate);
+			m_timer = std::thread(&LuaProfiler::run, this);
+		}
+	}
+
+	/**********************************************************/
+	void LuaProfiler::trigger()
+	{
+		if (m_running.load())
+		{
+			// The hook is invoked by the next instruction the state executes.
+			lua_sethook(m_state.lua_state(), &LuaProfiler::hook, LUA_MASKCOUNT, 1);
+		}
+	}
+
+	/**********************************************************/
+	void LuaProfiler::stop()
+	{
+		if (!m_running.load())
+		{
+			return;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(m_timerMutex);
+			m_running.store(false);
+		}
+		m_stopped.notify_one();
+		if (m_timer.joinable())
+		{
+			m_timer.join();
+		}
+
+		// The timer may have armed the hook before it stopped.
+		lua_sethook(m_state.lua_state(), nullptr, 0, 0);
+	}
+
+	/**********************************************************/
+	void LuaProfiler::clear()
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_next = 0;
+		m_recorded = 0;
+	}
+
+} // namespace pegasus
@@ -0,0 +1,153 @@
+/*
+* Pegasus Engine
+* 2017 - Benjamin Carter (bencarterdev@outlook.com)
+*
+* This software is provided 'as-is', without any express or implied warranty.
+* In no event will the authors be held liable for any damages arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it freely,
+* subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented;
+*    you must not claim that you wrote the original software.
+*    If you use this software in a product, an acknowledgement
+*    in the product documentation would be appreciated but is not required.
+*
+* 2. Altered source versions must be plainly marked as such,
+*    and must not be misrepresented as being the original software.
+*
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+//====================
+// Pegasus includes
+//====================
+#include <pegasus/scripting/lua_state_pool.hpp> // Class declaration.
+
+namespace pegasus
+{
+	//====================
+	// Ctors and dtor
+	//====================
+	/**********************************************************/
+	LuaStatePool::Slot_t::Slot_t(std::size_t limit)
+#if defined(PEGASUS_LUAJIT)
+		// LuaJIT on 64-bit targets without LJ_GC64 refuses custom allocators, so the state allocates for itself.
+		: allocator(limit), state(sol::default_at_panic)
+#else
+		: allocator(limit), state(sol::default_at_panic, &LuaAllocator::luaAlloc, &allocator)
+#endif
+	{
+		// Empty.
+	}
+
+	/**********************************************************/
+	LuaStatePool::Lease::Lease(LuaStatePool& pool, Slot_t& slot)
+		: m_pPool(&pool), m_pSlot(&slot)
+	{
+		// Empty.
+	}
+
+	/**********************************************************/
+	LuaStatePool::Lease::Lease(Lease&& lease)
+		: m_pPool(lease.m_pPool), m_pSlot(lease.m_pSlot)
+	{
+		lease.m_pPool = nullptr;
+		lease.m_pSlot = nullptr;
+	}
+
+	/**********************************************************/
+	LuaStatePool::Lease::~Lease()
+	{
+		if (m_pPool)
+		{
+			m_pPool->release(*m_pSlot);
+		}
+	}
+
+	/**********************************************************/
+	LuaStatePool::LuaStatePool(std::function<void(sol::state&)> initialiser, std::size_t count)
+		: NonCopyable(), m_initialiser(std::move(initialiser)), m_slots(), m_free(), m_limit(0), m_mutex(), m_returned()
+	{
+		this->reserve(count);
+	}
+
+	//====================
+	// Private methods
+	//====================
+	/**********************************************************/
+	void LuaStatePool::release(Slot_t& slot)
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_free.push_back(&slot);
+		}
+
+		m_returned.notify_one();
+	}
+
+	//====================
+	// Getters and setters
+	//====================
+	/**********************************************************/
+	sol::state& LuaStatePool::Lease::getState() const
+	{
+		return m_pSlot->state;
+	}
+
+	/**********************************************************/
+	LuaAllocator& LuaStatePool::Lease::getAllocator() const
+	{
+		return m_pSlot->allocator;
+	}
+
+	/**********************************************************/
+	std::size_t LuaStatePool::getSize() const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_slots.size();
+	}
+
+	/**********************************************************/
+	void LuaStatePool::setMemoryLimit(std::size_t limit)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_limit = limit;
+		for (auto& slot : m_slots)
+		{
+			slot->allocator.setLimit(limit);
+		}
+	}
+
+	//====================
+	// Methods
+	//====================
+	/**********************************************************/
+	void LuaStatePool::reserve(std::size_t count)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		while (m_slots.size() < count)
+		{
+			auto slot = std::make_unique<Slot_t>(m_limit);
+			m_initialiser(slot->state);
+
+			m_free.push_back(slot.get());
+			m_slots.push_back(std::move(slot));
+			m_returned.notify_one();
+		}
+	}
+
+	/**********************************************************/
+	LuaStatePool::Lease LuaStatePool::acquire()
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_returned.wait(lock, [this]() { return !m_free.empty(); });
+
+		Slot_t* pSlot = m_free.back();
+		m_free.pop_back();
+
+		return Lease(*this, *pSlot);
+	}
+
+} // namespace pegasus
@@ -0,0 +1,201 @@
+/*
+* Pegasus Engine
+* 2017 - Benjamin Carter (bencarterdev@outlook.com)
+*
+* This software is provided 'as-is', without any express or implied warranty.
+* In no event will the authors be held liable for any damages arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it freely,
+* subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented;
+*    you must not claim that you wrote the original software.
+*    If you use this software in a product, an acknowledgement
+*    in the product documentation would be appreciated but is not required.
+*
+* 2. Altered source versions must be plainly marked as such,
+*    and must not be misrepresented as being the original software.
+*
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+//====================
+// C++ includes
+//====================
+#include <algorithm> // Filling and copying the values.
+#include <stdexcept> // Reporting invalid indices and layouts.
+#include <string>    // Describing the invalid indices.
+
+//====================
+// Pegasus includes
+//====================
+#include <pegasus/scripting/script_buffer.hpp> // Class declaration.
+
+namespace pegasus
+{
+	//====================
+	// Ctors and dtor
+	//====================
+	/**********************************************************/
+	ScriptBuffer::ScriptBuffer(std::size_t count, std::size_t components)
+		: m_data(count * std::max<std::size_t>(components, 1), 0.0f), m_components(std::max<std::size_t>(components, 1))
+	{
+		// Empty.
+	}
+
+	//====================
+	// Private methods
+	//====================
+	/**********************************************************/
+	void ScriptBuffer::checkLayout(const ScriptBuffer& other) const
+	{
+		if (other.m_components != m_components || other.m_data.size() != m_data.size())
+		{
+			throw std::invalid_argument("ScriptBuffer layouts differ: " + std::to_string(other.getCount()) + "x" + std::to_string(other.m_components) + 
+				" and " + std::to_string(this->getCount()) + "x" + std::to_string(m_components));
+		}
+	}
+
+	/**********************************************************/
+	std::size_t ScriptBuffer::getOffset(std::size_t index, std::size_t component) const
+	{
+		if (component >= m_components || index >= this->getCount())
+		{
+			throw std::out_of_range("ScriptBuffer element " + std::to_string(index) + "." + std::to_string(component) + " does not exist.");
+		}
+
+		return index * m_components + component;
+	}
+
+	//====================
+	// Getters and setters
+	//====================
+	/**********************************************************/
+	void ScriptBuffer::set(std::size_t index, std::size_t component, float value)
+	{
+		m_data[this->getOffset(index, component)] = value;
+	}
+
+	/**********************************************************/
+	float ScriptBuffer::get(std::size_t index, std::size_t component) const
+	{
+		return m_data[this->getOffset(index, component)];
+	}
+
+	/**********************************************************/
+	std::size_t ScriptBuffer::getCount() const
+	{
+		return m_data.size() / m_components;
+	}
+
+	/**********************************************************/
+	std::size_t ScriptBuffer::getComponents() const
+	{
+		return m_components;
+	}
+
+	/**********************************************************/
+	float* ScriptBuffer::getData()
+	{
+		return m_data.data();
+	}
+
+	/**********************************************************/
+	const float* ScriptBuffer::getData() const
+	{
+		return m_data.data();
+	}
+
+	//====================
+	// Methods
+	//====================
+	/**********************************************************/
+	void ScriptBuffer::resize(std::size_t count)
+	{
+		m_data.resize(count * m_components, 0.0f);
+	}
+
+	/**********************************************************/
+	void ScriptBuffer::fill(float value)
+	{
+		std::fill(m_data.begin(), m_data.end(), value);
+	}
+
+	/**********************************************************/
+	void ScriptBuffer::scale(float factor)
+	{
+		for (float& value : m_data)
+		{
+			value *= factor;
+		}
+	}
+
+	/**********************************************************/
+	void ScriptBuffer::add(const ScriptBuffer& other, float factor)
+	{
+		this->checkLayout(other);
+
+		const float* pOther = other.m_data.data();
+		float* pData = m_data.data();
+		for (std::size_t i = 0; i < m_data.size(); i++)
+		{
+			pData[i] += pOther[i] * factor;
+		}
+	}
+
+	/**********************************************************/
+	void ScriptBuffer::copy(const ScriptBuffer& other)
+	{
+		this->checkLayout(other);
+		std::copy(other.m_data.begin(), other.m_data.end(), m_data.begin());
+	}
+
+	/**********************************************************/
+	void ScriptBuffer::fromTable(const sol::table& table)
+	{
+		std::size_t count = std::min(table.size(), m_data.size());
+		for (std::size_t i = 0; i < count; i++)
+		{
+			m_data[i] = table[i + 1];
+		}
+	}
+
+	/**********************************************************/
+	sol::table ScriptBuffer::toTable(sol::this_state state) const
+	{
+		sol::state_view lua(state);
+		sol::table table = lua.create_table(static_cast<int>(m_data.size()), 0);
+		for (std::size_t i = 0; i < m_data.size(); i++)
+		{
+			table[i + 1] = m_data[i];
+		}
+
+		return table;
+	}
+
+	/**********************************************************/
+	void ScriptBuffer::bind(sol::state& state)
+	{
+		// The indices are shifted, so lua can address the elements and components starting at one.
+		state.new_usertype<ScriptBuffer>("ScriptBuffer",
+			sol::constructors<ScriptBuffer(std::size_t), ScriptBuffer(std::size_t, std::size_t)>(),
+			"get", [](const ScriptBuffer& buffer, std::size_t index, sol::optional<std::size_t> component) {
+				return buffer.get(index - 1, component.value_or(1) - 1);
+			},
+			"set", [](ScriptBuffer& buffer, std::size_t index, std::size_t component, float value) {
+				buffer.set(index - 1, component - 1, value);
+			},
+			"count", sol::readonly_property(&ScriptBuffer::getCount),
+			"components", sol::readonly_property(&ScriptBuffer::getComponents),
+			"resize", &ScriptBuffer::resize,
+			"fill", &ScriptBuffer::fill,
+			"scale", &ScriptBuffer::scale,
+			"add", &ScriptBuffer::add,
+			"copy", &ScriptBuffer::copy,
+			"from_table", &ScriptBuffer::fromTable,
+			"to_table", &ScriptBuffer::toTable,
+			sol::meta_function::length, &ScriptBuffer::getCount);
+	}
+
+} // namespace pegasus
@@ -23,72 +23,86 @@
 //====================
 // Pegasus includes
 //====================
-#include <pegasus/scripting/scripting_manager.hpp> // ScriptingManager class declaration.
-#include <pegasus/core/asset.hpp>                  // Binding the asset enum and class.
-#include <pegasus/graphics/gl.hpp>                 // Binding specific graphics API objects.
+#include <pegasus/scripting/scripting_manager.hpp>          // ScriptingManager class declaration.
+#include <pegasus/core/asset.hpp>                           // Binding the asset enum and class.
+#include <pegasus/graphics/gl.hpp>                          // Binding specific graphics API objects.
+#include <pegasus/graphics/shader_program_description.hpp> // Binding the uniform frequency enum.
 
 namespace pegasus
 {
 	//====================
-	// Private ctor
+	// Ctors and dtor
 	//====================
 	/**********************************************************/
 	ScriptingManager::ScriptingManager()
-		: Singleton<ScriptingManager>(), m_state()
+#if defined(PEGASUS_LUAJIT)
+		// LuaJIT on 64-bit targets without LJ_GC64 refuses custom allocators, so the state allocates for itself.
+		: NonCopyable(), m_allocator(), m_state(sol::default_at_panic), m_collector(m_state, m_allocator), m_profiler(m_state), m_scheduler(m_state), m_arrays(m_state), m_pool(&ScriptingManager::initialise, 1), m_bytecode()
+#else
+		: NonCopyable(), m_allocator(), m_state(sol::default_at_panic, &LuaAllocator::luaAlloc, &m_allocator), m_collector(m_state, m_allocator), m_profiler(m_state), m_scheduler(m_state), m_arrays(m_state), m_pool(&ScriptingManager::initialise, 1), m_bytecode()
+#endif
 	{
-		m_state.open_libraries(sol::lib::base, sol::lib::package, sol::lib::table, sol::lib::debug);
-		// Bind the different classes/objects/enums.
-		// Core library.
-		this->bindAssetType();
-		// Graphics library.
-		this->bindShaderType();
-		this->bindTextureType();
-		this->bindFilterType();
-		this->bindWrapType();
+		ScriptingManager::initialise(m_state);
+		// Only the scripts of the main state exchange bulk data with the engine.
+		ScriptBuffer::bind(m_state);
+#if defined(PEGASUS_LUAJIT)
+		// Only the main state can access engine memory, asset descriptions never receive the FFI.
+		m_state.open_libraries(sol::lib::jit, sol::lib::ffi);
+#endif
 	}
 
 	//====================
 	// Private methods
 	//====================
 	/**********************************************************/
-	void ScriptingManager::bindAssetType()
+	void ScriptingManager::bindAssetType(sol::state& state)
 	{
-		m_state.new_enum("AssetType",
+		state.new_enum("AssetType",
 			"Shader", eAssetType::SHADER,
-			"Texture", eAssetType::TEXTURE);
+			"Texture", eAssetType::TEXTURE,
+			"Directory", eAssetType::DIRECTORY);
 	}
 
 	/**********************************************************/
-	void ScriptingManager::bindShaderType()
+	void ScriptingManager::bindShaderType(sol::state& state)
 	{
-		m_state.new_enum("ShaderType",
+		state.new_enum("ShaderType",
 			"Vertex", gl::eShaderType::VERTEX,
 			"Fragment", gl::eShaderType::FRAGMENT);
 	}
 
 	/**********************************************************/
-	void ScriptingManager::bindTextureType()
+	void ScriptingManager::bindTextureType(sol::state& state)
 	{
-		m_state.new_enum("TextureType",
+		state.new_enum("TextureType",
 			"Texture2D", gl::eTextureType::TEXTURE_2D);
 	}
 
 	/**********************************************************/
-	void ScriptingManager::bindFilterType()
+	void ScriptingManager::bindFilterType(sol::state& state)
 	{
-		m_state.new_enum("FilterType",
+		state.new_enum("FilterType",
 			"Nearest", gl::eFilterType::NEAREST,
 			"Linear", gl::eFilterType::LINEAR);
 	}
 
 	/**********************************************************/
-	void ScriptingManager::bindWrapType()
+	void ScriptingManager::bindWrapType(sol::state& state)
 	{
-		m_state.new_enum("WrapType",
+		state.new_enum("WrapType",
 			"Repeat", gl::eWrapType::REPEAT,
 			"Clamp", gl::eWrapType::CLAMP);
 	}
 
+	/**********************************************************/
+	void ScriptingManager::bindUniformFrequency(sol::state& state)
+	{
+		state.new_enum("UniformFrequency",
+			"Constant", eUniformFrequency::CONSTANT,
+			"Frame", eUniformFrequency::FRAME,
+			"Material", eUniformFrequency::MATERIAL);
+	}
+
 	//====================
 	// Getters and setters
 	//====================
@@ -98,4 +112,76 @@ namespace pegasus
 		return m_state;
 	}
 
+	/**********************************************************/
+	LuaStatePool& ScriptingManager::getPool()
+	{
+		return m_pool;
+	}
+
+	/**********************************************************/
+	LuaBytecodeCache& ScriptingManager::getBytecodeCache()
+	{
+		return m_bytecode;
+	}
+
+	/**********************************************************/
+	LuaAllocator& ScriptingManager::getAllocator()
+	{
+		return m_allocator;
+	}
+
+	/**********************************************************/
+	LuaGarbageCollector& ScriptingManager::getCollector()
+	{
+		return m_collector;
+	}
+
+	/**********************************************************/
+	LuaProfiler& ScriptingManager::getProfiler()
+	{
+		return m_profiler;
+	}
+
+	/**********************************************************/
+	TaskScheduler& ScriptingManager::getScheduler()
+	{
+		return m_scheduler;
+	}
+
+	/**********************************************************/
+	LuaDataArrays& ScriptingManager::getArrays()
+	{
+		return m_arrays;
+	}
+
+	/**********************************************************/
+	void ScriptingManager::setMemoryLimit(std::size_t limit)
+	{
+#if defined(PEGASUS_LUAJIT)
+		// The allocators are not used by LuaJIT states, so the limit cannot be enforced.
+		(void)limit;
+#else
+		m_allocator.setLimit(limit);
+		m_pool.setMemoryLimit(limit);
+#endif
+	}
+
+	//====================
+	// Methods
+	//====================
+	/**********************************************************/
+	void ScriptingManager::initialise(sol::state& state)
+	{
+		state.open_libraries(sol::lib::base, sol::lib::package, sol::lib::coroutine, sol::lib::table, sol::lib::debug);
+		// Bind the different classes/objects/enums.
+		// Core library.
+		ScriptingManager::bindAssetType(state);
+		// Graphics library.
+		ScriptingManager::bindShaderType(state);
+		ScriptingManager::bindTextureType(state);
+		ScriptingManager::bindFilterType(state);
+		ScriptingManager::bindWrapType(state);
+		ScriptingManager::bindUniformFrequency(state);
+	}
+
 } // namespace pegasus
@@ -0,0 +1,260 @@
+/*
+* Pegasus Engine
+* 2017 - Benjamin Carter (bencarterdev@outlook.com)
+*
+* This software is provided 'as-is', without any express or implied warranty.
+* In no event will the authors be held liable for any damages arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it freely,
+* subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented;
+*    you must not claim that you wrote the original software.
+*    If you use this software in a product, an acknowledgement
+*    in the product documentation would be appreciated but is not required.
+*
+* 2. Altered source versions must be plainly marked as such,
+*    and must not be misrepresented as being the original software.
+*
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+//====================
+// C++ includes
+//====================
+#include <algorithm> // Waiting for at least a single frame.
+
+//====================
+// Pegasus includes
+//====================
+#include <pegasus/scripting/task_scheduler.hpp> // Class declaration.
+
+namespace pegasus
+{
+	namespace
+	{
+		//====================
+		// Variables
+		//====================
+		/** The lua functions that suspend a task, the first yielded value must match TaskScheduler::eWaitType. */
+		const char* WAIT_FUNCTIONS =
+			"function wait(seconds) coroutine.yield(1, seconds) end\n"
+			"function wait_frames(frames) coroutine.yield(2, frames) end\n"
+			"function await(name) return coroutine.yield(3, name) end\n";
+	} // namespace
+
+	//====================
+	// Ctors and dtor
+	//====================
+	/**********************************************************/
+	TaskScheduler::TaskScheduler(sol::state& state)
+		: NonCopyable(), m_state(state), m_tasks(), m_ready(), m_timers(), m_frameTimers(), m_awaiting(), m_resolver(),
+		m_loader(), m_errorHandler(), m_budget(0), m_frameTime(0), m_frameResumed(0), m_time(0.0), m_frame(0), m_nextID(1)
+	{
+		m_state.set_function("spawn", [this](const sol::function& function) { return this->spawn(function); });
+		m_state.script(WAIT_FUNCTIONS);
+	}
+
+	//====================
+	// Private methods
+	//====================
+	/**********************************************************/
+	void TaskScheduler::resume(std::size_t id)
+	{
+		auto it = m_tasks.find(id);
+		// The task has been cancelled.
+		if (it == m_tasks.end())
+		{
+			return;
+		}
+
+		// Tasks that awaited an asset are resumed with it.
+		Task_t& task = it->second;
+		sol::object value = sol::make_object(m_state, sol::lua_nil);
+		if (!task.asset.empty())
+		{
+			if (m_loader)
+			{
+				value = m_loader(task.asset);
+			}
+			task.asset.clear();
+		}
+
+		// The task may spawn other tasks, which invalidates the iterator but not the task itself.
+		sol::protected_function_result result = task.coroutine(value);
+		if (!result.valid())
+		{
+			if (m_errorHandler)
+			{
+				sol::error error = result;
+				m_errorHandler(error.what());
+			}
+			m_tasks.erase(id);
+			return;
+		}
+
+		// The function has returned, the task is finished.
+		if (result.status() != sol::call_status::yielded)
+		{
+			m_tasks.erase(id);
+			return;
+		}
+
+		// Schedule the task according to the condition it is waiting on.
+		eWaitType type = result.return_count() > 0 ? static_cast<eWaitType>(result.get<int>(0)) : eWaitType::NEXT_FRAME;
+		switch (type)
+		{
+		case eWaitType::TIME:
+			m_timers.push({ m_time + result.get<double>(1), id });
+			break;
+
+		case eWaitType::FRAMES:
+			m_frameTimers.push({ m_frame + static_cast<std::size_t>(std::max(result.get<int>(1), 1)), id });
+			break;
+
+		case eWaitType::ASSET:
+			task.asset = result.get<std::string>(1);
+			m_awaiting.push_back({ id, task.asset });
+			break;
+
+		default:
+			m_frameTimers.push({ m_frame + 1, id });
+			break;
+		}
+	}
+
+	/**********************************************************/
+	void TaskScheduler::wake()
+	{
+		while (!m_timers.empty() && m_timers.top().when <= m_time)
+		{
+			m_ready.push_back(m_timers.top().task);
+			m_timers.pop();
+		}
+
+		while (!m_frameTimers.empty() && m_frameTimers.top().when <= m_frame)
+		{
+			m_ready.push_back(m_frameTimers.top().task);
+			m_frameTimers.pop();
+		}
+
+		// Move the tasks whose assets are available to the ready queue, in the order they began waiting.
+		std::size_t waiting = 0;
+		for (std::size_t i = 0; i < m_awaiting.size(); i++)
+		{
+			if (!m_resolver || m_resolver(m_awaiting[i].second))
+			{
+				m_ready.push_back(m_awaiting[i].first);
+				continue;
+			}
+
+			// Keep the task waiting, compacting the list as the ready tasks are removed.
+			if (i != waiting)
+			{
+				m_awaiting[waiting] = std::move(m_awaiting[i]);
+			}
+			waiting++;
+		}
+		m_awaiting.resize(waiting);
+	}
+
+	//====================
+	// Getters and setters
+	//====================
+	/**********************************************************/
+	void TaskScheduler::setBudget(std::chrono::microseconds budget)
+	{
+		m_budget = budget;
+	}
+
+	/**********************************************************/
+	void TaskScheduler::setAssetResolver(std::function<bool(const std::string&)> resolver)
+	{
+		m_resolver = std::move(resolver);
+	}
+
+	/**********************************************************/
+	void TaskScheduler::setAssetLoader(std::function<sol::object(const std::string&)> loader)
+	{
+		m_loader = std::move(loader);
+	}
+
+	/**********************************************************/
+	void TaskScheduler::setErrorHandler(std::function<void(const std::string&)> handler)
+	{
+		m_errorHandler = std::move(handler);
+	}
+
+	/**********************************************************/
+	std::size_t TaskScheduler::getTaskCount() const
+	{
+		return m_tasks.size();
+	}
+
+	/**********************************************************/
+	std::chrono::microseconds TaskScheduler::getFrameTime() const
+	{
+		return m_frameTime;
+	}
+
+	/**********************************************************/
+	std::size_t TaskScheduler::getFrameResumed() const
+	{
+		return m_frameResumed;
+	}
+
+	//====================
+	// Methods
+	//====================
+	/**********************************************************/
+	std::size_t TaskScheduler::spawn(const sol::function& function)
+	{
+		std::size_t id = m_nextID++;
+		// Each task runs on its own lua thread, so it can be suspended independently.
+		sol::thread thread = sol::thread::create(m_state.lua_state());
+		sol::coroutine coroutine(thread.state(), function);
+
+		m_tasks.insert({ id, Task_t{ std::move(thread), std::move(coroutine) } });
+		m_ready.push_back(id);
+
+		return id;
+	}
+
+	/**********************************************************/
+	void TaskScheduler::cancel(std::size_t id)
+	{
+		// Any pending wake-ups of the task are skipped once it has been removed.
+		m_tasks.erase(id);
+	}
+
+	/**********************************************************/
+	void TaskScheduler::update(double deltaTime)
+	{
+		m_time += deltaTime;
+		m_frame++;
+		this->wake();
+
+		auto start = std::chrono::steady_clock::now();
+		m_frameResumed = 0;
+		// Tasks that were spawned or woken by a task resumed this frame are left until the next frame.
+		std::size_t due = m_ready.size();
+		while (due > 0)
+		{
+			std::size_t id = m_ready.front();
+			m_ready.pop_front();
+			due--;
+
+			this->resume(id);
+			m_frameResumed++;
+
+			if (m_budget.count() > 0 && std::chrono::steady_clock::now() - start >= m_budget)
+			{
+				break;
+			}
+		}
+
+		m_frameTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+	}
+
+} // namespace pegasus
@@ -0,0 +1,289 @@
+/*
+* Pegasus Engine
+* 2017 - Benjamin Carter (bencarterdev@outlook.com)
+*
+* This software is provided 'as-is', without any express or implied warranty.
+* In no event will the authors be held liable for any damages arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it freely,
+* subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented;
+*    you must not claim that you wrote the original software.
+*    If you use this software in a product, an acknowledgement
+*    in the product documentation would be appreciated but is not required.
+*
+* 2. Altered source versions must be plainly marked as such,
+*    and must not be misrepresented as being the original software.
+*
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+//====================
+// C++ includes
+//====================
+#include <cstring> // Comparing the magic of the cooked files.
+
+//====================
+// Pegasus includes
+//====================
+#include <pegasus/utilities/binary_serializable_service.hpp>      // Class declaration.
+#include <pegasus/utilities/mapped_file.hpp>                      // Mapping the cooked files into memory.
+#include <pegasus/utilities/exceptions/no_resource_exception.hpp> // Throwing an exception if there were any issues with the resource handling.
+#include <pegasus/graphics/shader_program.hpp>                    // De-serializing shader program objects.
+#include <pegasus/graphics/texture.hpp>                           // De-serializing texture objects.
+
+namespace pegasus
+{
+	namespace
+	{
+		//====================
+		// Functions
+		//====================
+		/**********************************************************/
+		template <typename T>
+		const T* read(const MappedFile& file, std::uint32_t offset, std::uint32_t count = 1)
+		{
+			// Check the range in 64-bits, so large counts cannot wrap around.
+			if (offset % 4 != 0 || static_cast<std::uint64_t>(offset) + static_cast<std::uint64_t>(count) * sizeof(T) > file.getSize())
+			{
+				return nullptr;
+			}
+
+			return reinterpret_cast<const T*>(file.getData() + offset);
+		}
+
+		/**********************************************************/
+		const char* read(const MappedFile& file, const CookedString_t& str)
+		{
+			if (static_cast<std::uint64_t>(str.offset) + str.length >= file.getSize() || file.getData()[str.offset + str.length] != '\0')
+			{
+				return nullptr;
+			}
+
+			return file.getData() + str.offset;
+		}
+
+		/**********************************************************/
+		Error_t outOfBounds(const std::string& filename)
+		{
+			return Error_t{ eErrorCode::INVALID_FORMAT, "Cooked file references data outside of the file:" + filename };
+		}
+	} // namespace
+
+	//====================
+	// Ctors and dtor
+	//====================
+	/**********************************************************/
+	BinarySerializableService::BinarySerializableService()
+		: ISerializableService()
+	{
+		// Empty.
+	}
+
+	//====================
+	// Private methods
+	//====================
+	/**********************************************************/
+	Expected<const CookedHeader_t*> BinarySerializableService::open(const std::string& filename, eCookedType type, MappedFile& file)
+	{
+		if (!file.open(filename))
+		{
+			return Error_t{ eErrorCode::NOT_FOUND, "Unable to de-serialize file:" + filename };
+		}
+
+		const CookedHeader_t* pHeader = read<CookedHeader_t>(file, 0);
+		if (!pHeader)
+		{
+			return Error_t{ eErrorCode::INVALID_FORMAT, "Cooked file is truncated:" + filename };
+		}
+
+		if (std::memcmp(pHeader->magic, COOKED_MAGIC, sizeof(COOKED_MAGIC)) != 0)
+		{
+			return Error_t{ eErrorCode::INVALID_FORMAT, "File is not a cooked asset:" + filename };
+		}
+
+		if (pHeader->version != COOKED_VERSION)
+		{
+			return Error_t{ eErrorCode::UNSUPPORTED, "Cooked file " + filename + " is version " + std::to_string(pHeader->version) +
+				", expected version " + std::to_string(COOKED_VERSION) + ". The asset must be re-cooked." };
+		}
+
+		if (pHeader->type != type)
+		{
+			return Error_t{ eErrorCode::UNSUPPORTED, "Cooked file contains the wrong asset type:" + filename };
+		}
+
+		if (pHeader->size != file.getSize())
+		{
+			return Error_t{ eErrorCode::INVALID_FORMAT, "Cooked file is truncated:" + filename };
+		}
+
+		return pHeader;
+	}
+
+	/**********************************************************/
+	Expected<Asset*> BinarySerializableService::deserializeShaderProgram(const std::string& filename) const
+	{
+		MappedFile file;
+		auto header = BinarySerializableService::open(filename, eCookedType::SHADER_PROGRAM, file);
+		if (!header)
+		{
+			return header.getError();
+		}
+
+		const CookedShaderProgram_t* pRoot = read<CookedShaderProgram_t>(file, sizeof(CookedHeader_t));
+		if (!pRoot)
+		{
+			return outOfBounds(filename);
+		}
+
+		if (pRoot->count == 0)
+		{
+			return Error_t{ eErrorCode::INVALID_FORMAT, "No glsl shaders have been defined in file:" + filename };
+		}
+
+		// Validate everything before any OpenGL objects are created.
+		const CookedShader_t* pShaders = read<CookedShader_t>(file, pRoot->offset, pRoot->count);
+		const char* pName = read(file, pRoot->name);
+		if (!pShaders || !pName)
+		{
+			return outOfBounds(filename);
+		}
+
+		for (std::uint32_t i = 0; i < pRoot->count; i++)
+		{
+			if (!read(file, pShaders[i].source))
+			{
+				return outOfBounds(filename);
+			}
+
+			if (pShaders[i].type != GL_VERTEX_SHADER && pShaders[i].type != GL_FRAGMENT_SHADER)
+			{
+				return Error_t{ eErrorCode::INVALID_FORMAT, "Invalid shader type in file:" + filename };
+			}
+		}
+
+		// Create the shader program.
+		ShaderProgram* pProgram = new ShaderProgram();
+		// Set the debug name.
+		pProgram->setName(pName);
+		// Attach each cooked shader.
+		for (std::uint32_t i = 0; i < pRoot->count; i++)
+		{
+			pProgram->attach(static_cast<gl::eShaderType>(pShaders[i].type), read(file, pShaders[i].source));
+		}
+		// Return the shader.
+		return pProgram;
+	}
+
+	/**********************************************************/
+	Expected<Asset*> BinarySerializableService::deserializeTexture(const std::string& filename) const
+	{
+		MappedFile file;
+		auto header = BinarySerializableService::open(filename, eCookedType::TEXTURE, file);
+		if (!header)
+		{
+			return header.getError();
+		}
+
+		const CookedTexture_t* pRoot = read<CookedTexture_t>(file, sizeof(CookedHeader_t));
+		const char* pSource = pRoot ? read(file, pRoot->source) : nullptr;
+		const char* pName = pRoot ? read(file, pRoot->name) : nullptr;
+		if (!pSource || !pName)
+		{
+			return outOfBounds(filename);
+		}
+
+		// There is no image, the texture cannot be created.
+		if (pRoot->source.length == 0)
+		{
+			return Error_t{ eErrorCode::INVALID_FORMAT, "No image source has been declared in file:" + filename };
+		}
+
+		// Create a texture description and populate its values.
+		TextureDescription_t desc;
+		desc.source.assign(pSource, pRoot->source.length);
+		desc.type = static_cast<gl::eTextureType>(pRoot->type);
+		desc.filtering = static_cast<gl::eFilterType>(pRoot->filtering);
+		desc.wrapping = static_cast<gl::eWrapType>(pRoot->wrapping);
+		// Create the texture from the description and return it.
+		Texture* pTexture = new Texture(desc);
+		pTexture->setName(pName);
+
+		return pTexture;
+	}
+
+	//====================
+	// Getters and setters
+	//====================
+	/**********************************************************/
+	bool BinarySerializableService::isConcurrent() const // override
+	{
+		return true;
+	}
+
+	//====================
+	// Methods
+	//====================
+	/**********************************************************/
+	Expected<Asset*> BinarySerializableService::deserialize(eAssetType type, const std::string& filename) const
+	{
+		switch (type)
+		{
+		case eAssetType::SHADER:
+			return this->deserializeShaderProgram(filename);
+
+		case eAssetType::TEXTURE:
+			return this->deserializeTexture(filename);
+
+		case eAssetType::DIRECTORY:
+		case eAssetType::NONE:
+			break;
+		}
+
+		return Error_t{ eErrorCode::UNSUPPORTED, "Cannot de-serialize asset type from file:" + filename };
+	}
+
+	/**********************************************************/
+	std::unordered_map<std::string, Resource_t> BinarySerializableService::deserializeResources(const std::string& filename) const
+	{
+		std::unordered_map<std::string, Resource_t> resources;
+
+		MappedFile file;
+		auto header = BinarySerializableService::open(filename, eCookedType::RESOURCES, file);
+		if (!header)
+		{
+			const Error_t& error = header.getError();
+			throw NoResourceException(error.code == eErrorCode::NOT_FOUND ? "Cannot open resource file: " + filename : error.message);
+		}
+
+		const CookedResources_t* pRoot = read<CookedResources_t>(file, sizeof(CookedHeader_t));
+		const CookedResource_t* pEntries = pRoot ? read<CookedResource_t>(file, pRoot->offset, pRoot->count) : nullptr;
+		if (!pEntries)
+		{
+			throw NoResourceException(outOfBounds(filename).message);
+		}
+
+		resources.reserve(pRoot->count);
+		for (std::uint32_t i = 0; i < pRoot->count; i++)
+		{
+			const char* pName = read(file, pEntries[i].name);
+			const char* pPath = read(file, pEntries[i].path);
+			if (!pName || !pPath)
+			{
+				throw NoResourceException(outOfBounds(filename).message);
+			}
+
+			Resource_t resource;
+			resource.path.assign(pPath, pEntries[i].path.length);
+			resource.type = pEntries[i].type <= static_cast<std::uint32_t>(eAssetType::NONE) ? static_cast<eAssetType>(pEntries[i].type) : eAssetType::NONE;
+
+			resources.emplace(std::string(pName, pEntries[i].name.length), std::move(resource));
+		}
+
+		return resources;
+	}
+
+} // namespace pegasus
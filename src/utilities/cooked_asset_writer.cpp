@@ -0,0 +1,174 @@
+/*
+* Pegasus Engine
+* 2017 - Benjamin Carter (bencarterdev@outlook.com)
+*
+* This software is provided 'as-is', without any express or implied warranty.
+* In no event will the authors be held liable for any damages arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it freely,
+* subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented;
+*    you must not claim that you wrote the original software.
+*    If you use this software in a product, an acknowledgement
+*    in the product documentation would be appreciated but is not required.
+*
+* 2. Altered source versions must be plainly marked as such,
+*    and must not be misrepresented as being the original software.
+*
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+//====================
+// C++ includes
+//====================
+#include <cstring> // Copying the strings into the file.
+#include <fstream> // Writing the cooked file to disk.
+
+//====================
+// Pegasus includes
+//====================
+#include <pegasus/utilities/cooked_asset_writer.hpp> // Class declaration.
+
+namespace pegasus
+{
+	//====================
+	// Private ctors
+	//====================
+	/**********************************************************/
+	CookedAssetWriter::CookedAssetWriter(eCookedType type)
+		: m_data()
+	{
+		std::uint32_t offset = this->allocate(sizeof(CookedHeader_t));
+		CookedHeader_t* pHeader = this->at<CookedHeader_t>(offset);
+		std::memcpy(pHeader->magic, COOKED_MAGIC, sizeof(COOKED_MAGIC));
+		pHeader->version = COOKED_VERSION;
+		pHeader->type = type;
+	}
+
+	//====================
+	// Private methods
+	//====================
+	/**********************************************************/
+	std::uint32_t CookedAssetWriter::allocate(std::size_t size)
+	{
+		std::size_t offset = m_data.size();
+		// Round up, so every structure that follows is aligned.
+		m_data.resize((offset + size + 3) & ~static_cast<std::size_t>(3), 0);
+
+		return static_cast<std::uint32_t>(offset);
+	}
+
+	/**********************************************************/
+	template <typename T>
+	T* CookedAssetWriter::at(std::uint32_t offset)
+	{
+		return reinterpret_cast<T*>(&m_data[offset]);
+	}
+
+	/**********************************************************/
+	CookedString_t CookedAssetWriter::addString(const std::string& str)
+	{
+		CookedString_t cooked;
+		// The allocation is zeroed, which provides the null-terminator.
+		cooked.offset = this->allocate(str.size() + 1);
+		cooked.length = static_cast<std::uint32_t>(str.size());
+		std::memcpy(&m_data[cooked.offset], str.data(), str.size());
+
+		return cooked;
+	}
+
+	/**********************************************************/
+	std::vector<char> CookedAssetWriter::finish()
+	{
+		this->at<CookedHeader_t>(0)->size = static_cast<std::uint32_t>(m_data.size());
+		return std::move(m_data);
+	}
+
+	//====================
+	// Methods
+	//====================
+	/**********************************************************/
+	std::vector<char> CookedAssetWriter::cookResources(const std::unordered_map<std::string, Resource_t>& resources)
+	{
+		CookedAssetWriter writer(eCookedType::RESOURCES);
+		std::uint32_t root = writer.allocate(sizeof(CookedResources_t));
+		std::uint32_t entries = writer.allocate(sizeof(CookedResource_t) * resources.size());
+		writer.at<CookedResources_t>(root)->count = static_cast<std::uint32_t>(resources.size());
+		writer.at<CookedResources_t>(root)->offset = entries;
+
+		std::uint32_t index = 0;
+		for (auto& resource : resources)
+		{
+			// Adding a string may re-allocate the file, so the entry is retrieved afterwards.
+			CookedString_t name = writer.addString(resource.first);
+			CookedString_t path = writer.addString(resource.second.path);
+
+			CookedResource_t* pEntry = writer.at<CookedResource_t>(entries + index * sizeof(CookedResource_t));
+			pEntry->name = name;
+			pEntry->path = path;
+			pEntry->type = static_cast<std::uint32_t>(resource.second.type);
+			index++;
+		}
+
+		return writer.finish();
+	}
+
+	/**********************************************************/
+	std::vector<char> CookedAssetWriter::cookShaderProgram(const std::string& name, const std::vector<std::pair<gl::eShaderType, std::string>>& shaders)
+	{
+		CookedAssetWriter writer(eCookedType::SHADER_PROGRAM);
+		std::uint32_t root = writer.allocate(sizeof(CookedShaderProgram_t));
+		std::uint32_t entries = writer.allocate(sizeof(CookedShader_t) * shaders.size());
+
+		CookedString_t programName = writer.addString(name);
+		CookedShaderProgram_t* pProgram = writer.at<CookedShaderProgram_t>(root);
+		pProgram->name = programName;
+		pProgram->count = static_cast<std::uint32_t>(shaders.size());
+		pProgram->offset = entries;
+
+		for (std::size_t i = 0; i < shaders.size(); i++)
+		{
+			CookedString_t source = writer.addString(shaders[i].second);
+
+			CookedShader_t* pShader = writer.at<CookedShader_t>(static_cast<std::uint32_t>(entries + i * sizeof(CookedShader_t)));
+			pShader->source = source;
+			pShader->type = static_cast<std::uint32_t>(shaders[i].first);
+		}
+
+		return writer.finish();
+	}
+
+	/**********************************************************/
+	std::vector<char> CookedAssetWriter::cookTexture(const std::string& name, const TextureDescription_t& description)
+	{
+		CookedAssetWriter writer(eCookedType::TEXTURE);
+		std::uint32_t root = writer.allocate(sizeof(CookedTexture_t));
+
+		CookedString_t textureName = writer.addString(name);
+		CookedString_t source = writer.addString(description.source);
+		CookedTexture_t* pTexture = writer.at<CookedTexture_t>(root);
+		pTexture->name = textureName;
+		pTexture->source = source;
+		pTexture->type = static_cast<std::uint32_t>(description.type);
+		pTexture->filtering = static_cast<std::uint32_t>(description.filtering);
+		pTexture->wrapping = static_cast<std::uint32_t>(description.wrapping);
+
+		return writer.finish();
+	}
+
+	/**********************************************************/
+	bool CookedAssetWriter::save(const std::string& filename, const std::vector<char>& data)
+	{
+		std::ofstream file(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+		if (file.fail())
+		{
+			return false;
+		}
+
+		file.write(data.data(), static_cast<std::streamsize>(data.size()));
+		return !file.fail();
+	}
+
+} // namespace pegasus
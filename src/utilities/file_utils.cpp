@@ -0,0 +1,117 @@
+/*
+* Pegasus Engine
+* 2017 - Benjamin Carter (bencarterdev@outlook.com)
+*
+* This software is provided 'as-is', without any express or implied warranty.
+* In no event will the authors be held liable for any damages arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it freely,
+* subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented;
+*    you must not claim that you wrote the original software.
+*    If you use this software in a product, an acknowledgement
+*    in the product documentation would be appreciated but is not required.
+*
+* 2. Altered source versions must be plainly marked as such,
+*    and must not be misrepresented as being the original software.
+*
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+//====================
+// C++ includes
+//====================
+#include <sys/types.h> // The stat structure.
+#include <sys/stat.h>  // Querying the file attributes and creating directories.
+#include <cerrno>      // Checking whether the directory already exists.
+#include <cstdio>      // Renaming the written files.
+#include <fstream>     // Writing the temporary files.
+#include <functional>  // Hashing the thread writing a temporary file.
+#include <string>      // Naming the temporary files.
+#include <thread>      // Naming the temporary files after the thread writing them.
+#if defined(_WIN32)
+#include <direct.h>    // Creating directories on windows.
+#include <process.h>   // Naming the temporary files after the process on windows.
+#else
+#include <unistd.h>    // Naming the temporary files after the process.
+#endif
+
+//====================
+// Pegasus includes
+//====================
+#include <pegasus/utilities/file_utils.hpp> // Class declaration.
+
+namespace pegasus
+{
+	//====================
+	// Methods
+	//====================
+	/**********************************************************/
+	std::int64_t FileUtils::getModifiedTime(const std::string& filename)
+	{
+#if defined(_WIN32)
+		struct _stat64 info;
+		if (_stat64(filename.c_str(), &info) != 0)
+		{
+			return -1;
+		}
+#else
+		struct stat info;
+		if (stat(filename.c_str(), &info) != 0)
+		{
+			return -1;
+		}
+#endif
+
+		return static_cast<std::int64_t>(info.st_mtime);
+	}
+
+	/**********************************************************/
+	bool FileUtils::createDirectory(const std::string& path)
+	{
+#if defined(_WIN32)
+		int result = _mkdir(path.c_str());
+#else
+		int result = mkdir(path.c_str(), 0755);
+#endif
+
+		return result == 0 || errno == EEXIST;
+	}
+
+	/**********************************************************/
+	bool FileUtils::replaceFile(const std::string& filename, const void* pData, std::size_t size)
+	{
+		// Processes and threads replacing the same file each write their own temporary file, the last rename wins.
+#if defined(_WIN32)
+		long long process = static_cast<long long>(_getpid());
+#else
+		long long process = static_cast<long long>(getpid());
+#endif
+		std::size_t thread = std::hash<std::thread::id>()(std::this_thread::get_id());
+		std::string temporary = filename + "." + std::to_string(process) + "." + std::to_string(thread) + ".tmp";
+		{
+			std::ofstream file(temporary, std::ios::out | std::ios::binary | std::ios::trunc);
+			if (!file.write(static_cast<const char*>(pData), static_cast<std::streamsize>(size)) || !file.flush())
+			{
+				file.close();
+				std::remove(temporary.c_str());
+				return false;
+			}
+		}
+
+#if defined(_WIN32)
+		// Renaming does not replace an existing file on windows.
+		std::remove(filename.c_str());
+#endif
+		if (std::rename(temporary.c_str(), filename.c_str()) != 0)
+		{
+			std::remove(temporary.c_str());
+			return false;
+		}
+
+		return true;
+	}
+
+} // namespace pegasus
@@ -20,11 +20,18 @@
 * 3. This notice may not be removed or altered from any source distribution.
 */
 
+//====================
+// C++ includes
+//====================
+#include <unordered_set> // Counting assets shared by multiple names once.
+#include <exception>     // Catching failures thrown by the serializable service.
+
 //====================
 // Pegasus includes
 //====================
 #include <pegasus/utilities/iasset_factory.hpp> // class declaration.
 #include <pegasus/utilities/logger_factory.hpp> // Retrieving the logger.
+#include <pegasus/utilities/file_utils.hpp>     // Detecting modified files.
 
 namespace pegasus
 {
@@ -32,9 +39,9 @@ namespace pegasus
 	// Ctors and dtor
 	//====================
 	/**********************************************************/
-	IAssetFactory::IAssetFactory(const std::type_index& type, std::size_t threshold/*= 10*/)
-		: m_pService(nullptr), m_type(type), m_threshold(threshold), m_logger(LoggerFactory::getLogger("file.logger")), 
-			m_assets(), m_resources()
+	IAssetFactory::IAssetFactory(Resources& resources, std::size_t typeID, eAssetType assetType, std::size_t threshold/*= 10*/)
+		: m_pService(nullptr), m_typeID(typeID), m_assetType(assetType), m_threshold(threshold), m_failures(), m_pinned(), m_logger(LoggerFactory::getLogger("file.logger")), 
+			m_assets(), m_resources(resources)
 	{
 		// Empty.
 	}
@@ -65,11 +72,17 @@ namespace pegasus
     }
 	
 	/**********************************************************/
-	const std::type_index& IAssetFactory::getType() const
+	std::size_t IAssetFactory::getTypeID() const
 	{
-		return m_type;
+		return m_typeID;
 	}
 	
+	/**********************************************************/
+	eAssetType IAssetFactory::getAssetType() const
+	{
+		return m_assetType;
+	}
+
 	/**********************************************************/
 	std::size_t IAssetFactory::getThreshold() const
 	{
@@ -104,5 +117,189 @@ namespace pegasus
 			}
 		}
 	}
+
+	/**********************************************************/
+	bool IAssetFactory::isFailed(const std::string& name)
+	{
+		auto itr = m_failures.find(name);
+		if (itr == m_failures.end())
+		{
+			return false;
+		}
+
+		// The Resources file has been re-loaded since the failure, so the name may now resolve.
+		if (itr->second.generation != m_resources.getGeneration())
+		{
+			m_failures.erase(itr);
+			return false;
+		}
+
+		return true;
+	}
+
+	/**********************************************************/
+	void IAssetFactory::setFailed(const std::string& name, const std::string& path)
+	{
+		Failure_t failure;
+		failure.generation = m_resources.getGeneration();
+		failure.path = path;
+		failure.modified = path.empty() ? -1 : FileUtils::getModifiedTime(path);
+
+		m_failures[name] = failure;
+	}
+
+	/**********************************************************/
+	Asset* IAssetFactory::loadAsset(const std::string& name)
+	{
+		// Check the threshold, and delete any non-referenced objects.
+		this->checkThreshold();
+
+		// The name has already failed to load, return the default without retrying.
+		if (this->isFailed(name))
+		{
+			return nullptr;
+		}
+
+		auto resource = m_resources.get(name);
+		if (!resource)
+		{
+			this->setFailed(name, std::string());
+			m_logger.warning("AssetFactory:", resource.getError().message, ". Returning default asset.");
+			return nullptr;
+		}
+
+		const std::string& path = resource.getValue()->path;
+		// See if the asset being requested has already been loaded.
+		auto itr = m_assets.find(path);
+		if (itr != m_assets.end())
+		{
+			return itr->second;
+		}
+
+		// De-serialize and create a new asset, a malformed file must not take down the caller.
+		Expected<Asset*> asset = Error_t{ eErrorCode::INVALID_FORMAT, "Unable to de-serialize " + path };
+		try
+		{
+			asset = m_pService->deserialize(m_assetType, path);
+		}
+		catch (std::exception& e)
+		{
+			asset = Error_t{ eErrorCode::INVALID_FORMAT, std::string("Unable to de-serialize ") + path + ": " + e.what() };
+		}
+
+		if (!asset)
+		{
+			this->setFailed(name, path);
+			m_logger.warning("AssetFactory:", asset.getError().message, ". Returning default asset.");
+			return nullptr;
+		}
+
+		// Insert the asset into the map.
+		m_assets.insert({ path, asset.getValue() });
+		return asset.getValue();
+	}
+
+	//====================
+	// Methods
+	//====================
+	/**********************************************************/
+	void IAssetFactory::revalidate()
+	{
+		for (auto itr = m_failures.begin(); itr != m_failures.end();)
+		{
+			const Failure_t& failure = itr->second;
+			if (failure.generation != m_resources.getGeneration() ||
+				(!failure.path.empty() && FileUtils::getModifiedTime(failure.path) != failure.modified))
+			{
+				itr = m_failures.erase(itr);
+			}
+			else
+			{
+				++itr;
+			}
+		}
+	}
 	
+	/**********************************************************/
+	std::size_t IAssetFactory::loadAll(const std::string& prefix)
+	{
+		std::size_t count = 0;
+		for (auto& name : m_resources.list(prefix))
+		{
+			auto resource = m_resources.get(name);
+			if (!resource || resource.getValue()->type != m_assetType || m_pinned.count(name))
+			{
+				continue;
+			}
+
+			Asset* pAsset = this->load(name);
+			// The default asset was returned, there is nothing to retain.
+			if (this->isFailed(name))
+			{
+				continue;
+			}
+
+			pAsset->retain();
+			m_pinned.insert({ name, pAsset });
+			count++;
+		}
+
+		return count;
+	}
+
+	/**********************************************************/
+	std::size_t IAssetFactory::unloadAll(const std::string& prefix)
+	{
+		std::size_t count = 0;
+		for (auto& name : m_resources.list(prefix))
+		{
+			auto pinned = m_pinned.find(name);
+			if (pinned != m_pinned.end())
+			{
+				pinned->second->release();
+				m_pinned.erase(pinned);
+			}
+
+			auto resource = m_resources.get(name);
+			if (!resource)
+			{
+				continue;
+			}
+
+			// Delete the asset if nothing else is using it.
+			auto itr = m_assets.find(resource.getValue()->path);
+			if (itr != m_assets.end() && !itr->second->isReferenced())
+			{
+				delete itr->second;
+				m_assets.erase(itr);
+				count++;
+			}
+		}
+
+		return count;
+	}
+
+	/**********************************************************/
+	std::size_t IAssetFactory::getMemoryUsage(const std::string& prefix) const
+	{
+		std::size_t usage = 0;
+		std::unordered_set<const Asset*> counted;
+		for (auto& name : m_resources.list(prefix))
+		{
+			auto resource = m_resources.get(name);
+			if (!resource)
+			{
+				continue;
+			}
+
+			auto itr = m_assets.find(resource.getValue()->path);
+			if (itr != m_assets.end() && counted.insert(itr->second).second)
+			{
+				usage += itr->second->getMemoryUsage();
+			}
+		}
+
+		return usage;
+	}
+
 } // namespace pegasus
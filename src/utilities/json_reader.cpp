@@ -0,0 +1,606 @@
+/*
+* Pegasus Engine
+* 2017 - Benjamin Carter (bencarterdev@outlook.com)
+*
+* This software is provided 'as-is', without any express or implied warranty.
+* In no event will the authors be held liable for any damages arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it freely,
+* subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented;
+*    you must not claim that you wrote the original software.
+*    If you use this software in a product, an acknowledgement
+*    in the product documentation would be appreciated but is not required.
+*
+* 2. Altered source versions must be plainly marked as such,
+*    and must not be misrepresented as being the original software.
+*
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+//====================
+// C++ includes
+//====================
+#include <cstdlib> // Converting numbers with strtod.
+#include <cstring> // Comparing literal values.
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#	define PEGASUS_JSON_SSE2
+#	include <emmintrin.h> // Scanning strings sixteen bytes at a time.
+#	if defined(_MSC_VER)
+#		include <intrin.h> // Finding the first flagged byte within a block.
+#	endif
+#endif
+
+//====================
+// Pegasus includes
+//====================
+#include <pegasus/utilities/json_reader.hpp> // Class declaration.
+
+namespace pegasus
+{
+	//====================
+	// Constant variables
+	//====================
+	/** The deepest nesting of objects and arrays before the document is rejected. */
+	const std::size_t MAX_DEPTH = 512;
+	/** The longest textual representation of a number that will be converted. */
+	const std::size_t MAX_NUMBER_LENGTH = 63;
+
+	//====================
+	// Functions
+	//====================
+	/**********************************************************/
+	static int hexValue(char c)
+	{
+		if (c >= '0' && c <= '9') return c - '0';
+		if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+		if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+
+		return -1;
+	}
+
+	/**********************************************************/
+	static bool isDigit(char c)
+	{
+		return c >= '0' && c <= '9';
+	}
+
+#if defined(PEGASUS_JSON_SSE2)
+	/**********************************************************/
+	static unsigned int firstBit(unsigned int mask)
+	{
+#	if defined(_MSC_VER)
+		unsigned long index;
+		_BitScanForward(&index, mask);
+		return index;
+#	else
+		return __builtin_ctz(mask);
+#	endif
+	}
+#endif
+
+	//====================
+	// Ctors and dtor
+	//====================
+	/**********************************************************/
+	JsonReader::JsonReader()
+		: m_pBegin(nullptr), m_pCursor(nullptr), m_pEnd(nullptr), m_pHandler(nullptr), m_error(), m_errorOffset(0)
+	{
+		// Empty.
+	}
+
+	//====================
+	// Private methods
+	//====================
+	/**********************************************************/
+	bool JsonReader::fail(const char* pMessage)
+	{
+		// Only the first error is of any use, anything after it is a consequence.
+		if (m_error.empty())
+		{
+			m_error = pMessage;
+			m_errorOffset = static_cast<std::size_t>(m_pCursor - m_pBegin);
+		}
+
+		return false;
+	}
+
+	/**********************************************************/
+	void JsonReader::skipWhitespace()
+	{
+		while (m_pCursor < m_pEnd && (*m_pCursor == ' ' || *m_pCursor == '\n' || *m_pCursor == '\r' || *m_pCursor == '\t'))
+		{
+			m_pCursor++;
+		}
+	}
+
+	/**********************************************************/
+	bool JsonReader::parseValue(std::size_t depth)
+	{
+		if (depth > MAX_DEPTH)
+		{
+			return this->fail("Document is nested too deeply.");
+		}
+
+		this->skipWhitespace();
+		if (m_pCursor >= m_pEnd)
+		{
+			return this->fail("Unexpected end of document.");
+		}
+
+		switch (*m_pCursor)
+		{
+		case '{':
+			return this->parseObject(depth);
+
+		case '[':
+			return this->parseArray(depth);
+
+		case '"':
+		{
+			m_pCursor++;
+			char* pValue;
+			std::size_t length;
+			if (!this->parseString(&pValue, length))
+			{
+				return false;
+			}
+
+			m_pHandler->onString(pValue, length);
+			return true;
+		}
+
+		case 't':
+		case 'f':
+		case 'n':
+			return this->parseLiteral();
+
+		default:
+			return this->parseNumber();
+		}
+	}
+
+	/**********************************************************/
+	bool JsonReader::parseObject(std::size_t depth)
+	{
+		// Skip the opening brace.
+		m_pCursor++;
+		m_pHandler->onStartObject();
+
+		this->skipWhitespace();
+		if (m_pCursor < m_pEnd && *m_pCursor == '}')
+		{
+			m_pCursor++;
+			m_pHandler->onEndObject();
+			return true;
+		}
+
+		for (;;)
+		{
+			// Parse the key.
+			this->skipWhitespace();
+			if (m_pCursor >= m_pEnd || *m_pCursor != '"')
+			{
+				return this->fail("Expected a string key.");
+			}
+
+			m_pCursor++;
+			char* pKey;
+			std::size_t length;
+			if (!this->parseString(&pKey, length))
+			{
+				return false;
+			}
+
+			this->skipWhitespace();
+			if (m_pCursor >= m_pEnd || *m_pCursor != ':')
+			{
+				return this->fail("Expected ':' after a key.");
+			}
+
+			m_pCursor++;
+			m_pHandler->onKey(pKey, length);
+
+			// Parse the value.
+			if (!this->parseValue(depth + 1))
+			{
+				return false;
+			}
+
+			this->skipWhitespace();
+			if (m_pCursor >= m_pEnd)
+			{
+				return this->fail("Unterminated object.");
+			}
+
+			if (*m_pCursor == ',')
+			{
+				m_pCursor++;
+				continue;
+			}
+
+			if (*m_pCursor == '}')
+			{
+				m_pCursor++;
+				m_pHandler->onEndObject();
+				return true;
+			}
+
+			return this->fail("Expected ',' or '}' within an object.");
+		}
+	}
+
+	/**********************************************************/
+	bool JsonReader::parseArray(std::size_t depth)
+	{
+		// Skip the opening bracket.
+		m_pCursor++;
+		m_pHandler->onStartArray();
+
+		this->skipWhitespace();
+		if (m_pCursor < m_pEnd && *m_pCursor == ']')
+		{
+			m_pCursor++;
+			m_pHandler->onEndArray();
+			return true;
+		}
+
+		for (;;)
+		{
+			if (!this->parseValue(depth + 1))
+			{
+				return false;
+			}
+
+			this->skipWhitespace();
+			if (m_pCursor >= m_pEnd)
+			{
+				return this->fail("Unterminated array.");
+			}
+
+			if (*m_pCursor == ',')
+			{
+				m_pCursor++;
+				continue;
+			}
+
+			if (*m_pCursor == ']')
+			{
+				m_pCursor++;
+				m_pHandler->onEndArray();
+				return true;
+			}
+
+			return this->fail("Expected ',' or ']' within an array.");
+		}
+	}
+
+	/**********************************************************/
+	bool JsonReader::parseString(char** ppValue, std::size_t& length)
+	{
+		char* pStart = m_pCursor;
+		char* pRead = m_pCursor;
+		// Unescaped characters are written behind the read position, the string never grows.
+		char* pWrite = m_pCursor;
+
+		for (;;)
+		{
+#if defined(PEGASUS_JSON_SSE2)
+			// Copy whole blocks until one contains a quote, an escape or a control character.
+			const __m128i quote = _mm_set1_epi8('"');
+			const __m128i escape = _mm_set1_epi8('\\');
+			const __m128i control = _mm_set1_epi8(0x1F);
+			while (m_pEnd - pRead >= 16)
+			{
+				__m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pRead));
+				// A byte is a control character if it is unchanged by an unsigned max with 0x1F.
+				__m128i flagged = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(block, quote), _mm_cmpeq_epi8(block, escape)),
+					_mm_cmpeq_epi8(_mm_max_epu8(block, control), control));
+				unsigned int mask = static_cast<unsigned int>(_mm_movemask_epi8(flagged));
+
+				if (mask == 0)
+				{
+					if (pWrite != pRead)
+					{
+						_mm_storeu_si128(reinterpret_cast<__m128i*>(pWrite), block);
+					}
+					pRead += 16;
+					pWrite += 16;
+					continue;
+				}
+
+				// Move the bytes before the flagged one, which is handled below.
+				unsigned int offset = firstBit(mask);
+				if (pWrite != pRead)
+				{
+					std::memmove(pWrite, pRead, offset);
+				}
+				pRead += offset;
+				pWrite += offset;
+				break;
+			}
+#endif
+			if (pRead >= m_pEnd)
+			{
+				m_pCursor = pRead;
+				return this->fail("Unterminated string.");
+			}
+
+			char c = *pRead;
+			if (c == '"')
+			{
+				// Terminate the string in place of the closing quote, or earlier if it was unescaped.
+				*pWrite = '\0';
+				*ppValue = pStart;
+				length = static_cast<std::size_t>(pWrite - pStart);
+				m_pCursor = pRead + 1;
+				return true;
+			}
+
+			if (static_cast<unsigned char>(c) < 0x20)
+			{
+				m_pCursor = pRead;
+				return this->fail("Control character within a string.");
+			}
+
+			if (c != '\\')
+			{
+				*pWrite++ = *pRead++;
+				continue;
+			}
+
+			// Handle the escape sequence.
+			if (m_pEnd - pRead < 2)
+			{
+				m_pCursor = pRead;
+				return this->fail("Unterminated escape sequence.");
+			}
+
+			switch (pRead[1])
+			{
+			case '"':  *pWrite++ = '"';  pRead += 2; break;
+			case '\\': *pWrite++ = '\\'; pRead += 2; break;
+			case '/':  *pWrite++ = '/';  pRead += 2; break;
+			case 'b':  *pWrite++ = '\b'; pRead += 2; break;
+			case 'f':  *pWrite++ = '\f'; pRead += 2; break;
+			case 'n':  *pWrite++ = '\n'; pRead += 2; break;
+			case 'r':  *pWrite++ = '\r'; pRead += 2; break;
+			case 't':  *pWrite++ = '\t'; pRead += 2; break;
+
+			case 'u':
+			{
+				unsigned long codepoint = 0;
+				for (int pair = 0; ; pair++)
+				{
+					if (m_pEnd - pRead < 6)
+					{
+						m_pCursor = pRead;
+						return this->fail("Invalid unicode escape sequence.");
+					}
+
+					unsigned long unit = 0;
+					for (int i = 2; i < 6; i++)
+					{
+						int digit = hexValue(pRead[i]);
+						if (digit < 0)
+						{
+							m_pCursor = pRead;
+							return this->fail("Invalid unicode escape sequence.");
+						}
+						unit = (unit << 4) | static_cast<unsigned long>(digit);
+					}
+					pRead += 6;
+
+					if (pair == 0 && unit >= 0xD800 && unit <= 0xDBFF)
+					{
+						// A high surrogate, which must be followed by an escaped low surrogate.
+						codepoint = unit;
+						if (m_pEnd - pRead < 2 || pRead[0] != '\\' || pRead[1] != 'u')
+						{
+							m_pCursor = pRead;
+							return this->fail("Unpaired unicode surrogate.");
+						}
+						continue;
+					}
+
+					if (pair == 1)
+					{
+						if (unit < 0xDC00 || unit > 0xDFFF)
+						{
+							m_pCursor = pRead;
+							return this->fail("Unpaired unicode surrogate.");
+						}
+						codepoint = 0x10000 + ((codepoint - 0xD800) << 10) + (unit - 0xDC00);
+					}
+					else if (unit >= 0xDC00 && unit <= 0xDFFF)
+					{
+						m_pCursor = pRead;
+						return this->fail("Unpaired unicode surrogate.");
+					}
+					else
+					{
+						codepoint = unit;
+					}
+					break;
+				}
+
+				// Encode the codepoint as utf-8, which is never longer than the escape sequence.
+				if (codepoint < 0x80)
+				{
+					*pWrite++ = static_cast<char>(codepoint);
+				}
+				else if (codepoint < 0x800)
+				{
+					*pWrite++ = static_cast<char>(0xC0 | (codepoint >> 6));
+					*pWrite++ = static_cast<char>(0x80 | (codepoint & 0x3F));
+				}
+				else if (codepoint < 0x10000)
+				{
+					*pWrite++ = static_cast<char>(0xE0 | (codepoint >> 12));
+					*pWrite++ = static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+					*pWrite++ = static_cast<char>(0x80 | (codepoint & 0x3F));
+				}
+				else
+				{
+					*pWrite++ = static_cast<char>(0xF0 | (codepoint >> 18));
+					*pWrite++ = static_cast<char>(0x80 | ((codepoint >> 12) & 0x3F));
+					*pWrite++ = static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+					*pWrite++ = static_cast<char>(0x80 | (codepoint & 0x3F));
+				}
+				break;
+			}
+
+			default:
+				m_pCursor = pRead;
+				return this->fail("Invalid escape sequence.");
+			}
+		}
+	}
+
+	/**********************************************************/
+	bool JsonReader::parseNumber()
+	{
+		// Validate the number against the json grammar before converting it.
+		char* pStart = m_pCursor;
+		char* p = m_pCursor;
+
+		if (p < m_pEnd && *p == '-')
+		{
+			p++;
+		}
+
+		if (p >= m_pEnd || !isDigit(*p))
+		{
+			return this->fail("Invalid value.");
+		}
+
+		if (*p == '0')
+		{
+			p++;
+		}
+		else
+		{
+			while (p < m_pEnd && isDigit(*p)) p++;
+		}
+
+		if (p < m_pEnd && *p == '.')
+		{
+			p++;
+			if (p >= m_pEnd || !isDigit(*p))
+			{
+				m_pCursor = p;
+				return this->fail("Expected a digit after the decimal point.");
+			}
+			while (p < m_pEnd && isDigit(*p)) p++;
+		}
+
+		if (p < m_pEnd && (*p == 'e' || *p == 'E'))
+		{
+			p++;
+			if (p < m_pEnd && (*p == '+' || *p == '-')) p++;
+			if (p >= m_pEnd || !isDigit(*p))
+			{
+				m_pCursor = p;
+				return this->fail("Expected a digit within the exponent.");
+			}
+			while (p < m_pEnd && isDigit(*p)) p++;
+		}
+
+		// The buffer is not terminated after the number, so convert a terminated copy.
+		std::size_t length = static_cast<std::size_t>(p - pStart);
+		if (length > MAX_NUMBER_LENGTH)
+		{
+			return this->fail("Number is too long.");
+		}
+
+		char number[MAX_NUMBER_LENGTH + 1];
+		std::memcpy(number, pStart, length);
+		number[length] = '\0';
+
+		m_pCursor = p;
+		m_pHandler->onNumber(std::strtod(number, nullptr));
+		return true;
+	}
+
+	/**********************************************************/
+	bool JsonReader::parseLiteral()
+	{
+		std::size_t remaining = static_cast<std::size_t>(m_pEnd - m_pCursor);
+
+		if (remaining >= 4 && std::memcmp(m_pCursor, "true", 4) == 0)
+		{
+			m_pCursor += 4;
+			m_pHandler->onBool(true);
+			return true;
+		}
+
+		if (remaining >= 5 && std::memcmp(m_pCursor, "false", 5) == 0)
+		{
+			m_pCursor += 5;
+			m_pHandler->onBool(false);
+			return true;
+		}
+
+		if (remaining >= 4 && std::memcmp(m_pCursor, "null", 4) == 0)
+		{
+			m_pCursor += 4;
+			m_pHandler->onNull();
+			return true;
+		}
+
+		return this->fail("Invalid literal.");
+	}
+
+	//====================
+	// Getters and setters
+	//====================
+	/**********************************************************/
+	const std::string& JsonReader::getError() const
+	{
+		return m_error;
+	}
+
+	/**********************************************************/
+	std::size_t JsonReader::getErrorOffset() const
+	{
+		return m_errorOffset;
+	}
+
+	//====================
+	// Methods
+	//====================
+	/**********************************************************/
+	bool JsonReader::parse(char* pData, std::size_t size, IJsonHandler& handler)
+	{
+		m_pBegin = pData;
+		m_pCursor = pData;
+		m_pEnd = pData + size;
+		m_pHandler = &handler;
+		m_error.clear();
+		m_errorOffset = 0;
+
+		// Skip the utf-8 byte order mark, if present.
+		if (size >= 3 && std::memcmp(pData, "\xEF\xBB\xBF", 3) == 0)
+		{
+			m_pCursor += 3;
+		}
+
+		if (!this->parseValue(0))
+		{
+			return false;
+		}
+
+		// Only whitespace may follow the root value.
+		this->skipWhitespace();
+		if (m_pCursor != m_pEnd)
+		{
+			return this->fail("Unexpected data after the root value.");
+		}
+
+		return true;
+	}
+
+} // namespace pegasus
@@ -0,0 +1,541 @@
+/*
+* Pegasus Engine
+* 2017 - Benjamin Carter (bencarterdev@outlook.com)
+*
+* This software is provided 'as-is', without any express or implied warranty.
+* In no event will the authors be held liable for any damages arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it freely,
+* subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented;
+*    you must not claim that you wrote the original software.
+*    If you use this software in a product, an acknowledgement
+*    in the product documentation would be appreciated but is not required.
+*
+* 2. Altered source versions must be plainly marked as such,
+*    and must not be misrepresented as being the original software.
+*
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+//====================
+// C++ includes
+//====================
+#include <cstring> // Comparing keys and values without copying them.
+#include <vector>  // Storing the shaders declared by a shader program.
+
+//====================
+// Pegasus includes
+//====================
+#include <pegasus/utilities/json_serializable_service.hpp>        // Class declaration.
+#include <pegasus/utilities/json_reader.hpp>                      // Parsing the json documents.
+#include <pegasus/utilities/mapped_file.hpp>                      // Mapping the json files into memory.
+#include <pegasus/utilities/logger_factory.hpp>                   // Logging any Resources.json de-serialization issues.
+#include <pegasus/utilities/exceptions/no_resource_exception.hpp> // Throwing an exception if there were any issues with the resource handling.
+#include <pegasus/graphics/shader_program.hpp>                    // De-serializing shader program objects.
+#include <pegasus/graphics/texture.hpp>                           // De-serializing texture objects.
+
+namespace pegasus
+{
+	namespace
+	{
+		//====================
+		// Functions
+		//====================
+		/**********************************************************/
+		bool equals(const char* pValue, const char* pExpected)
+		{
+			return pValue && std::strcmp(pValue, pExpected) == 0;
+		}
+
+		/**********************************************************/
+		bool parseShaderType(const char* pValue, gl::eShaderType& type)
+		{
+			if (equals(pValue, "Vertex") || equals(pValue, "Fragment"))
+			{
+				type = equals(pValue, "Vertex") ? gl::eShaderType::VERTEX : gl::eShaderType::FRAGMENT;
+				return true;
+			}
+
+			return false;
+		}
+
+		/**********************************************************/
+		bool parseFilterType(const char* pValue, gl::eFilterType& filter)
+		{
+			if (equals(pValue, "Nearest") || equals(pValue, "Linear"))
+			{
+				filter = equals(pValue, "Nearest") ? gl::eFilterType::NEAREST : gl::eFilterType::LINEAR;
+				return true;
+			}
+
+			return false;
+		}
+
+		/**********************************************************/
+		bool parseWrapType(const char* pValue, gl::eWrapType& wrap)
+		{
+			if (equals(pValue, "Repeat") || equals(pValue, "Clamp"))
+			{
+				wrap = equals(pValue, "Repeat") ? gl::eWrapType::REPEAT : gl::eWrapType::CLAMP;
+				return true;
+			}
+
+			return false;
+		}
+
+		//====================
+		// Handlers
+		//====================
+		/**
+		 * @brief Base handler that tracks the nesting depth and the current key.
+		 *
+		 * Values that are not strings are ignored by default, the derived handlers only
+		 * override the callbacks they are interested in.
+		 */
+		class DepthHandler : public IJsonHandler
+		{
+		protected:
+			/** The amount of objects and arrays currently open. */
+			std::size_t m_depth = 0;
+			/** The key of the member currently being parsed. */
+			const char* m_pKey = nullptr;
+
+		public:
+			void onStartObject() override { m_depth++; }
+			void onEndObject() override { m_depth--; }
+			void onStartArray() override { m_depth++; }
+			void onEndArray() override { m_depth--; }
+			void onKey(const char* pKey, std::size_t length) override { m_pKey = pKey; }
+			void onString(const char* pValue, std::size_t length) override {}
+			void onNumber(double value) override {}
+			void onBool(bool value) override {}
+			void onNull() override {}
+		};
+
+		/**
+		 * @brief Collects the entries of the Resources array.
+		 *
+		 * { "Resources": [ { "name": "...", "source": "...", "asset_type": "Texture" } ] }
+		 */
+		class ResourcesHandler final : public DepthHandler
+		{
+		private:
+			/** Where the de-serialized resources are stored. */
+			std::unordered_map<std::string, Resource_t>& m_resources;
+			/** Logging any resources that could not be de-serialized. */
+			Logger&                                      m_logger;
+			/** Whether the array currently open is the Resources array. */
+			bool                                         m_inResources = false;
+			/** The name of the resource currently being parsed. */
+			const char*                                  m_pName = nullptr;
+			/** The resource currently being parsed. */
+			Resource_t                                   m_resource;
+
+		public:
+			ResourcesHandler(std::unordered_map<std::string, Resource_t>& resources, Logger& logger)
+				: m_resources(resources), m_logger(logger)
+			{
+			}
+
+			void onStartObject() override
+			{
+				DepthHandler::onStartObject();
+				if (m_inResources && m_depth == 3)
+				{
+					// The type is erroneous until a known asset_type is parsed.
+					m_pName = nullptr;
+					m_resource = Resource_t{ std::string(), eAssetType::NONE };
+				}
+			}
+
+			void onEndObject() override
+			{
+				if (m_inResources && m_depth == 3)
+				{
+					// The names don't exist, log a warning.
+					if (!m_pName || !*m_pName)
+					{
+						m_logger.warning("Resource unable to de-serialize correctly. A name has not been defined.");
+					}
+					// The type is missing or misspelled, log a warning.
+					else if (m_resource.type == eAssetType::NONE)
+					{
+						m_logger.warning("Resource", m_pName, "unable to de-serialize correctly. A valid asset_type has not been defined.");
+					}
+					else
+					{
+						m_resources.emplace(m_pName, std::move(m_resource));
+					}
+				}
+				DepthHandler::onEndObject();
+			}
+
+			void onStartArray() override
+			{
+				DepthHandler::onStartArray();
+				if (m_depth == 2 && equals(m_pKey, "Resources"))
+				{
+					m_inResources = true;
+				}
+			}
+
+			void onEndArray() override
+			{
+				if (m_depth == 2)
+				{
+					m_inResources = false;
+				}
+				DepthHandler::onEndArray();
+			}
+
+			void onString(const char* pValue, std::size_t length) override
+			{
+				if (!m_inResources || m_depth != 3)
+				{
+					return;
+				}
+
+				if (equals(m_pKey, "name"))
+				{
+					m_pName = pValue;
+				}
+				else if (equals(m_pKey, "source"))
+				{
+					m_resource.path.assign(pValue, length);
+				}
+				else if (equals(m_pKey, "asset_type"))
+				{
+					m_resource.type = equals(pValue, "Shader") ? eAssetType::SHADER : equals(pValue, "Texture") ? eAssetType::TEXTURE :
+						equals(pValue, "Directory") ? eAssetType::DIRECTORY : eAssetType::NONE;
+				}
+			}
+		};
+
+		/**
+		 * @brief Collects the name and shaders of a shader program.
+		 *
+		 * { "ShaderProgram": { "name": "...", "shaders": [ { "source": "...", "shader_type": "Vertex" } ] } }
+		 */
+		class ShaderProgramHandler final : public DepthHandler
+		{
+		public:
+			struct Shader_t
+			{
+				/** The source directory of the shader. */
+				const char* pSource = nullptr;
+				/** The type of shader, validated once the program has been parsed. */
+				const char* pType = nullptr;
+			};
+
+			/** Whether the ShaderProgram object is currently open. */
+			bool                  inProgram = false;
+			/** Whether the shaders array is currently open. */
+			bool                  inShaders = false;
+			/** The debug name of the program. */
+			const char*           pName = "";
+			/** The shaders declared by the program. */
+			std::vector<Shader_t> shaders;
+
+		public:
+			void onStartObject() override
+			{
+				DepthHandler::onStartObject();
+				if (m_depth == 2 && equals(m_pKey, "ShaderProgram"))
+				{
+					inProgram = true;
+				}
+				else if (inShaders && m_depth == 4)
+				{
+					shaders.emplace_back();
+				}
+			}
+
+			void onEndObject() override
+			{
+				if (m_depth == 2)
+				{
+					inProgram = false;
+				}
+				DepthHandler::onEndObject();
+			}
+
+			void onStartArray() override
+			{
+				DepthHandler::onStartArray();
+				if (inProgram && m_depth == 3 && equals(m_pKey, "shaders"))
+				{
+					inShaders = true;
+				}
+			}
+
+			void onEndArray() override
+			{
+				if (m_depth == 3)
+				{
+					inShaders = false;
+				}
+				DepthHandler::onEndArray();
+			}
+
+			void onString(const char* pValue, std::size_t length) override
+			{
+				if (!inProgram)
+				{
+					return;
+				}
+
+				if (m_depth == 2 && equals(m_pKey, "name"))
+				{
+					pName = pValue;
+				}
+				else if (inShaders && m_depth == 4 && equals(m_pKey, "source"))
+				{
+					shaders.back().pSource = pValue;
+				}
+				else if (inShaders && m_depth == 4 && equals(m_pKey, "shader_type"))
+				{
+					shaders.back().pType = pValue;
+				}
+			}
+		};
+
+		/**
+		 * @brief Collects the properties of a texture.
+		 *
+		 * { "Texture": { "name": "...", "texture_type": "Texture2D", "source": "...", "wrap_mode": "Clamp", "filter": "Nearest" } }
+		 */
+		class TextureHandler final : public DepthHandler
+		{
+		public:
+			/** Whether the Texture object is currently open. */
+			bool        inTexture = false;
+			/** The debug name of the texture. */
+			const char* pName = "";
+			/** The type of texture. */
+			const char* pType = "";
+			/** The file location of the image. */
+			const char* pSource = "";
+			/** The filtering mode of the texture. */
+			const char* pFilter = "";
+			/** The wrapping mode of the texture. */
+			const char* pWrap = "";
+
+		public:
+			void onStartObject() override
+			{
+				DepthHandler::onStartObject();
+				if (m_depth == 2 && equals(m_pKey, "Texture"))
+				{
+					inTexture = true;
+				}
+			}
+
+			void onEndObject() override
+			{
+				if (m_depth == 2)
+				{
+					inTexture = false;
+				}
+				DepthHandler::onEndObject();
+			}
+
+			void onString(const char* pValue, std::size_t length) override
+			{
+				if (!inTexture || m_depth != 2)
+				{
+					return;
+				}
+
+				if (equals(m_pKey, "name"))
+				{
+					pName = pValue;
+				}
+				else if (equals(m_pKey, "texture_type"))
+				{
+					pType = pValue;
+				}
+				else if (equals(m_pKey, "source"))
+				{
+					pSource = pValue;
+				}
+				else if (equals(m_pKey, "filter"))
+				{
+					pFilter = pValue;
+				}
+				else if (equals(m_pKey, "wrap_mode"))
+				{
+					pWrap = pValue;
+				}
+			}
+		};
+
+	} // namespace
+
+	//====================
+	// Ctors and dtor
+	//====================
+	/**********************************************************/
+	JsonSerializableService::JsonSerializableService()
+		: ISerializableService(), m_logger(LoggerFactory::getLogger("file.logger"))
+	{
+		// Empty.
+	}
+
+	//====================
+	// Private methods
+	//====================
+	/**********************************************************/
+	Error_t JsonSerializableService::parse(const std::string& filename, MappedFile& file, IJsonHandler& handler)
+	{
+		if (!file.open(filename))
+		{
+			return Error_t{ eErrorCode::NOT_FOUND, "Unable to de-serialize file:" + filename };
+		}
+
+		JsonReader reader;
+		if (!reader.parse(file.getData(), file.getSize(), handler))
+		{
+			return Error_t{ eErrorCode::INVALID_FORMAT, "Unable to de-serialize file:" + filename + " " + reader.getError() +
+				" (offset " + std::to_string(reader.getErrorOffset()) + ")" };
+		}
+
+		return Error_t{ eErrorCode::NONE, std::string() };
+	}
+
+	/**********************************************************/
+	Expected<Asset*> JsonSerializableService::deserializeShaderProgram(const std::string& filename) const
+	{
+		// The handler references the mapped file, which must remain open until the program is created.
+		MappedFile file;
+		ShaderProgramHandler handler;
+		Error_t error = JsonSerializableService::parse(filename, file, handler);
+		if (error.code != eErrorCode::NONE)
+		{
+			return error;
+		}
+
+		if (handler.shaders.empty())
+		{
+			return Error_t{ eErrorCode::INVALID_FORMAT, "No glsl shaders have been defined in file:" + filename };
+		}
+
+		// Validate every shader type before any OpenGL objects are created.
+		std::vector<gl::eShaderType> types(handler.shaders.size());
+		for (std::size_t i = 0; i < handler.shaders.size(); i++)
+		{
+			if (!parseShaderType(handler.shaders[i].pType, types[i]))
+			{
+				return Error_t{ eErrorCode::INVALID_FORMAT, "A shader without a valid shader_type has been declared in file:" + filename };
+			}
+			// A skipped shader would leave the program missing a stage, which would only fail once it links.
+			if (!handler.shaders[i].pSource)
+			{
+				return Error_t{ eErrorCode::INVALID_FORMAT, "A shader without a source has been declared in file:" + filename };
+			}
+		}
+
+		// Create the shader program.
+		ShaderProgram* pProgram = new ShaderProgram();
+		// Set the debug name.
+		pProgram->setName(handler.pName);
+		// Attach each declared shader.
+		for (std::size_t i = 0; i < handler.shaders.size(); i++)
+		{
+			pProgram->attach(types[i], handler.shaders[i].pSource);
+		}
+		// Return the shader.
+		return pProgram;
+	}
+
+	/**********************************************************/
+	Expected<Asset*> JsonSerializableService::deserializeTexture(const std::string& filename) const
+	{
+		MappedFile file;
+		TextureHandler handler;
+		Error_t error = JsonSerializableService::parse(filename, file, handler);
+		if (error.code != eErrorCode::NONE)
+		{
+			return error;
+		}
+
+		// There is no image, the texture cannot be created.
+		if (!*handler.pSource)
+		{
+			return Error_t{ eErrorCode::INVALID_FORMAT, "No image source has been declared in file:" + filename };
+		}
+
+		// Create a texture description and populate its values.
+		TextureDescription_t desc;
+		desc.source = handler.pSource;
+		desc.type = gl::eTextureType::TEXTURE_2D;
+		// Only 2D textures are supported.
+		if (!equals(handler.pType, "Texture2D"))
+		{
+			return Error_t{ eErrorCode::INVALID_FORMAT, "No valid texture_type has been declared in file:" + filename };
+		}
+		if (!parseFilterType(handler.pFilter, desc.filtering))
+		{
+			return Error_t{ eErrorCode::INVALID_FORMAT, "No valid filter has been declared in file:" + filename };
+		}
+		if (!parseWrapType(handler.pWrap, desc.wrapping))
+		{
+			return Error_t{ eErrorCode::INVALID_FORMAT, "No valid wrap_mode has been declared in file:" + filename };
+		}
+		// Create the texture from the description and return it.
+		Texture* pTexture = new Texture(desc);
+		pTexture->setName(handler.pName);
+
+		return pTexture;
+	}
+
+	//====================
+	// Getters and setters
+	//====================
+	/**********************************************************/
+	bool JsonSerializableService::isConcurrent() const // override
+	{
+		return true;
+	}
+
+	//====================
+	// Methods
+	//====================
+	/**********************************************************/
+	Expected<Asset*> JsonSerializableService::deserialize(eAssetType type, const std::string& filename) const
+	{
+		switch (type)
+		{
+		case eAssetType::SHADER:
+			return this->deserializeShaderProgram(filename);
+
+		case eAssetType::TEXTURE:
+			return this->deserializeTexture(filename);
+
+		case eAssetType::DIRECTORY:
+		case eAssetType::NONE:
+			break;
+		}
+
+		return Error_t{ eErrorCode::UNSUPPORTED, "Cannot de-serialize asset type from file:" + filename };
+	}
+
+	/**********************************************************/
+	std::unordered_map<std::string, Resource_t> JsonSerializableService::deserializeResources(const std::string& filename) const
+	{
+		std::unordered_map<std::string, Resource_t> resources;
+		ResourcesHandler handler(resources, m_logger);
+
+		MappedFile file;
+		Error_t error = JsonSerializableService::parse(filename, file, handler);
+		if (error.code != eErrorCode::NONE)
+		{
+			throw NoResourceException(error.code == eErrorCode::NOT_FOUND ? "Cannot open resource file: " + filename : error.message);
+		}
+
+		return resources;
+	}
+
+} // namespace pegasus
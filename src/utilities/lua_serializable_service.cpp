@@ -28,17 +28,42 @@
 #include <pegasus/scripting/scripting_manager.hpp>                // Retrieving the lua state.
 #include <pegasus/utilities/exceptions/no_resource_exception.hpp> // Throwing an exception if there were any issues with the resource handling.
 #include <pegasus/graphics/shader_program.hpp>                    // De-serializing shader program objects.
-#include <pegasus/utilities/exceptions/serialize_exception.hpp>   // Throwing errors if any de-serialization has failed.
 #include <pegasus/graphics/texture.hpp>                           // De-serializing texture objects.
 
 namespace pegasus
 {
+	namespace
+	{
+		//====================
+		// Functions
+		//====================
+		/**********************************************************/
+		bool run(LuaBytecodeCache& cache, sol::state& lua, sol::environment& environment, const std::string& filename)
+		{
+			// Load the compiled script, it is only parsed the first time it is seen.
+			sol::load_result chunk = cache.load(lua, filename);
+			if (!chunk.valid())
+			{
+				return false;
+			}
+
+			// Any globals declared by the script are written to the environment, and any
+			// globals it reads that it did not declare, such as the bound enums, fall back to the state.
+			environment = sol::environment(lua, sol::create, lua.globals());
+			sol::protected_function script = chunk;
+			sol::set_environment(environment, script);
+			// Execute the script and check there are no issues with it.
+			sol::protected_function_result result = script();
+			return result.valid();
+		}
+	} // namespace
+
 	//====================
 	// Ctors and dtor
 	//====================
 	/**********************************************************/
-	LuaSerializableService::LuaSerializableService()
-		: ISerializableService(), m_logger(LoggerFactory::getLogger("file.logger"))
+	LuaSerializableService::LuaSerializableService(ScriptingManager& scripting)
+		: ISerializableService(), m_logger(LoggerFactory::getLogger("file.logger")), m_scripting(scripting)
 	{
 		// Empty.
 	}
@@ -47,34 +72,93 @@ namespace pegasus
 	// Private methods
 	//====================
 	/**********************************************************/
-	Asset* LuaSerializableService::deserializeShaderProgram(const std::string& name) const
+	Expected<Asset*> LuaSerializableService::deserializeShaderProgram(const std::string& name) const
 	{
-		// Retrieve the lua state.
-		sol::state& lua = ScriptingManager::getInstance().getState();
-		// Load the specified script.
-		sol::function_result result = lua.script_file(name);
-		// Check if there are no issues with the script, if there is, throw an exception.
-		if (!result.valid())
+		// Parse the script, the state is returned to the pool before any OpenGL objects are created.
+		auto description = this->parseShaderProgram(name);
+		if (!description)
+		{
+			return description.getError();
+		}
+
+		// Create the shader program.
+		ShaderProgram* pProgram = new ShaderProgram();
+		// Set the debug name.
+		pProgram->setName(description.getValue().name);
+		// Attach each shader as an object within the program.
+		for (auto& shader : description.getValue().shaders)
+		{
+			pProgram->attach(shader.first, shader.second);
+		}
+		// Declare the uniforms, which are compiled into the binding plan once the program is linked.
+		for (auto& uniform : description.getValue().uniforms)
+		{
+			pProgram->declare(uniform);
+		}
+		// Declare the permutation options, which are compiled on first use.
+		for (auto& option : description.getValue().permutations)
+		{
+			pProgram->declarePermutation(option);
+		}
+		// Return the shader.
+		return pProgram;
+	}
+
+	/**********************************************************/
+	Expected<Asset*> LuaSerializableService::deserializeTexture(const std::string& name) const
+	{
+		// Parse the script, the state is returned to the pool before any OpenGL objects are created.
+		auto description = this->parseTexture(name);
+		if (!description)
 		{
-			throw SerializeException(std::string("Unable to de-serialize file:") + name);
+			return description.getError();
+		}
+
+		// Create the texture from the description and return it.
+		return new Texture(description.getValue());
+	}
+
+	//====================
+	// Getters and setters
+	//====================
+	/**********************************************************/
+	bool LuaSerializableService::isConcurrent() const // override
+	{
+		return true;
+	}
+
+	//====================
+	// Methods
+	//====================
+	/**********************************************************/
+	Expected<ShaderProgramDescription_t> LuaSerializableService::parseShaderProgram(const std::string& name) const
+	{
+		// Lease a lua state, every lua object below must be destroyed before the lease.
+		auto lease = m_scripting.getPool().acquire();
+		sol::environment environment;
+		// Check if there are no issues with the script, if there is, report the error.
+		if (!run(m_scripting.getBytecodeCache(), lease.getState(), environment, name))
+		{
+			return Error_t{ eErrorCode::INVALID_FORMAT, "Unable to de-serialize file:" + name };
 		}
 
 		// Get the root of the shader program.
-		sol::table root = lua["ShaderProgram"];
-		// Get the variables
+		sol::table root = environment["ShaderProgram"];
+		if (!root.valid())
+		{
+			return Error_t{ eErrorCode::INVALID_FORMAT, "No ShaderProgram table has been declared in file:" + name };
+		}
+		
+		ShaderProgramDescription_t description;
 		// Retrieve the name of the shader, if it's not defined, just set it to an empty string.
-		std::string shaderName = root.get_or("name", std::string());
+		description.name = root.get_or("name", std::string());
 		// Get the array of shaders to define.
 		sol::table shaders = root.get_or("shaders", sol::table());
 		if (shaders.empty())
 		{
-			throw SerializeException(std::string("No glsl shaders have been defined in file:") + name);
+			return Error_t{ eErrorCode::INVALID_FORMAT, "No glsl shaders have been defined in file:" + name };
 		}
 		
-		// Create the shader program.
-		ShaderProgram* pProgram = new ShaderProgram();
-		// Set the debu name.
-		pProgram->setName(shaderName);
 		// Loop through each attached shader.
 		for (std::size_t i = 0; i < shaders.size(); i++)
 		{
@@ -82,64 +166,128 @@ namespace pegasus
 			sol::table shader = shaders[i + 1];
 			// Get the name and type of the shader defined.
 			std::string source = shader.get_or("source", std::string());
-			// Get the shader type.
+			// Get the shader type, a missing or misspelled type is nil.
 			sol::object st = shader["shader_type"];
-			gl::eShaderType type = st.as<gl::eShaderType>();
-			// Attach the shader as an object within the program.
-			pProgram->attach(type, source);
+			if (!st.is<gl::eShaderType>())
+			{
+				return Error_t{ eErrorCode::INVALID_FORMAT, "A shader without a valid shader_type has been declared in file:" + name };
+			}
+			description.shaders.push_back({ st.as<gl::eShaderType>(), source });
 		}
-		// Return the shader.
-		return pProgram;
+
+		// Get the optional array of uniform declarations.
+		sol::table uniforms = root.get_or("uniforms", sol::table());
+		for (std::size_t i = 0; i < uniforms.size(); i++)
+		{
+			sol::table uniform = uniforms[i + 1];
+			UniformDeclaration_t declaration;
+			declaration.name = uniform.get_or("name", std::string());
+			if (declaration.name.empty())
+			{
+				return Error_t{ eErrorCode::INVALID_FORMAT, "A uniform without a name has been declared in file:" + name };
+			}
+
+			// Uniforms are constant unless declared otherwise.
+			sol::object frequency = uniform["frequency"];
+			declaration.frequency = frequency.is<eUniformFrequency>() ? frequency.as<eUniformFrequency>() : eUniformFrequency::CONSTANT;
+			// The value is either a single number, or an array of the components of a vector or matrix.
+			sol::object value = uniform["value"];
+			if (value.get_type() == sol::type::number)
+			{
+				declaration.value.push_back(value.as<float>());
+			}
+			else if (value.get_type() == sol::type::boolean)
+			{
+				declaration.value.push_back(value.as<bool>() ? 1.0f : 0.0f);
+			}
+			else if (value.get_type() == sol::type::table)
+			{
+				sol::table components = value.as<sol::table>();
+				for (std::size_t j = 0; j < components.size(); j++)
+				{
+					declaration.value.push_back(components.get_or(j + 1, 0.0f));
+				}
+			}
+			description.uniforms.push_back(std::move(declaration));
+		}
+
+		// Get the optional array of permutation options, each selected by a single bit of a mask.
+		sol::table permutations = root.get_or("permutations", sol::table());
+		if (permutations.size() > ShaderProgram::MAX_PERMUTATION_OPTIONS)
+		{
+			return Error_t{ eErrorCode::INVALID_FORMAT, "Too many permutation options have been declared in file:" + name };
+		}
+		for (std::size_t i = 0; i < permutations.size(); i++)
+		{
+			std::string option = permutations.get_or(i + 1, std::string());
+			if (option.empty())
+			{
+				return Error_t{ eErrorCode::INVALID_FORMAT, "An unnamed permutation option has been declared in file:" + name };
+			}
+			description.permutations.push_back(std::move(option));
+		}
+
+		return description;
 	}
 
 	/**********************************************************/
-	Asset* LuaSerializableService::deserializeTexture(const std::string& name) const
+	Expected<TextureDescription_t> LuaSerializableService::parseTexture(const std::string& name) const
 	{
-		// Retrieve the lua state.
-		sol::state& lua = ScriptingManager::getInstance().getState();
-		// Load the specified script.
-		sol::function_result result = lua.script_file(name);
-		// Check if there are no issues with the script, if there is, throw an exception.
-		if (!result.valid())
+		// Lease a lua state, every lua object below must be destroyed before the lease.
+		auto lease = m_scripting.getPool().acquire();
+		sol::environment environment;
+		// Check if there are no issues with the script, if there is, report the error.
+		if (!run(m_scripting.getBytecodeCache(), lease.getState(), environment, name))
 		{
-			throw SerializeException(std::string("Unable to de-serialize file:") + name);
+			return Error_t{ eErrorCode::INVALID_FORMAT, "Unable to de-serialize file:" + name };
 		}
 
 		// Get the root of the texture.
-		sol::table root = lua["Texture"];
-		// Get the variables
-		// Retrieve the name of the shader, if it's not defined, just set it to an empty string.
-		std::string textureName = root.get_or("name", std::string());
+		sol::table root = environment["Texture"];
+		if (!root.valid())
+		{
+			return Error_t{ eErrorCode::INVALID_FORMAT, "No Texture table has been declared in file:" + name };
+		}
+
 		// Get the texture type.
 		sol::object type = root["texture_type"];
 		// Get the image source.
 		std::string source = root.get_or("source", std::string());
-		// There is no image, throw an exception.
+		// There is no image, the texture cannot be created.
 		if (source.empty())
 		{
-			throw SerializeException(std::string("No image source has been declared in file:") + name);
+			return Error_t{ eErrorCode::INVALID_FORMAT, "No image source has been declared in file:" + name };
 		}
 		// Get the wrapping mode.
 		sol::object wrap = root["wrap_mode"];
 		// Get the filtering mode.
 		sol::object filter = root["filter"];
+		// A missing or misspelled enum is nil, rather than a value of the enum.
+		if (!type.is<gl::eTextureType>())
+		{
+			return Error_t{ eErrorCode::INVALID_FORMAT, "No valid texture_type has been declared in file:" + name };
+		}
+		if (!wrap.is<gl::eWrapType>())
+		{
+			return Error_t{ eErrorCode::INVALID_FORMAT, "No valid wrap_mode has been declared in file:" + name };
+		}
+		if (!filter.is<gl::eFilterType>())
+		{
+			return Error_t{ eErrorCode::INVALID_FORMAT, "No valid filter has been declared in file:" + name };
+		}
 		// Create a texture description and populate its values.
 		TextureDescription_t desc;
-		memset(&desc, 0, sizeof(TextureDescription_t));
 
 		desc.source = source;
 		desc.type = type.as<gl::eTextureType>();
 		desc.filtering = filter.as<gl::eFilterType>();
-		desc.wrapping = filter.as<gl::eWrapType>();
-		// Create the texture from the description and return it.
-		return new Texture(desc);
+		desc.wrapping = wrap.as<gl::eWrapType>();
+
+		return desc;
 	}
 
-	//====================
-	// Methods
-	//====================
 	/**********************************************************/
-	Asset* LuaSerializableService::deserialize(eAssetType type, const std::string& name) const
+	Expected<Asset*> LuaSerializableService::deserialize(eAssetType type, const std::string& name) const
 	{
 		switch (type)
 		{
@@ -148,27 +296,35 @@ namespace pegasus
 
 		case eAssetType::TEXTURE:
 			return this->deserializeTexture(name);
+
+		case eAssetType::DIRECTORY:
+		case eAssetType::NONE:
+			break;
 		}
 
-		return nullptr;
+		return Error_t{ eErrorCode::UNSUPPORTED, "Cannot de-serialize asset type from file:" + name };
 	}
 
 	/**********************************************************/
 	std::unordered_map<std::string, Resource_t> LuaSerializableService::deserializeResources(const std::string& filename) const
 	{
-		// Retrieve the lua state.
-		sol::state& lua = ScriptingManager::getInstance().getState();
-		// Load the specified script.
-		sol::function_result result = lua.script_file(filename);
+		// Populate the resources being stored in the table.
+		std::unordered_map<std::string, Resource_t> resources;
+		// Lease a lua state, every lua object below must be destroyed before the lease.
+		auto lease = m_scripting.getPool().acquire();
+		sol::environment environment;
 		// Check if there are no issues with the script, if there is, throw an exception.
-		if (!result.valid())
+		if (!run(m_scripting.getBytecodeCache(), lease.getState(), environment, filename))
 		{
 			throw NoResourceException("Cannot open resource file: " + filename);
 		}
 		// Grab the root table.
-		sol::table root = lua["Resources"];
-		// Populate the resources being stored in the table.
-		std::unordered_map<std::string, Resource_t> resources;
+		sol::table root = environment["Resources"];
+		if (!root.valid())
+		{
+			throw NoResourceException("No Resources table has been declared in file: " + filename);
+		}
+
 		for (std::size_t i = 0; i < root.size(); i++)
 		{
 			sol::table r = root[i + 1];
@@ -184,6 +340,12 @@ namespace pegasus
 			
 			std::string source = r.get_or("source", std::string());
 			sol::object type = r["asset_type"];
+			// The type is missing or misspelled, log a warning.
+			if (!type.is<eAssetType>())
+			{
+				m_logger.warning("Resource", name, "unable to de-serialize correctly. A valid asset_type has not been defined.");
+				continue;
+			}
 
 			Resource_t resource;
 			resource.path = source;
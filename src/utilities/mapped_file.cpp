@@ -0,0 +1,174 @@
+/*
+* Pegasus Engine
+* 2017 - Benjamin Carter (bencarterdev@outlook.com)
+*
+* This software is provided 'as-is', without any express or implied warranty.
+* In no event will the authors be held liable for any damages arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it freely,
+* subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented;
+*    you must not claim that you wrote the original software.
+*    If you use this software in a product, an acknowledgement
+*    in the product documentation would be appreciated but is not required.
+*
+* 2. Altered source versions must be plainly marked as such,
+*    and must not be misrepresented as being the original software.
+*
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+//====================
+// C++ includes
+//====================
+#if defined(_WIN32)
+#	define WIN32_LEAN_AND_MEAN
+#	include <windows.h>  // Mapping the file on windows.
+#else
+#	include <fcntl.h>    // Opening the file descriptor.
+#	include <sys/mman.h> // Mapping the file on posix platforms.
+#	include <sys/stat.h> // Retrieving the size of the file.
+#	include <unistd.h>   // Closing the file descriptor.
+#endif
+
+//====================
+// Pegasus includes
+//====================
+#include <pegasus/utilities/mapped_file.hpp> // Class declaration.
+
+namespace pegasus
+{
+	//====================
+	// Ctors and dtor
+	//====================
+	/**********************************************************/
+	MappedFile::MappedFile()
+		: NonCopyable(), m_pData(nullptr), m_size(0)
+	{
+		// Empty.
+	}
+
+	/**********************************************************/
+	MappedFile::MappedFile(const std::string& filename)
+		: NonCopyable(), m_pData(nullptr), m_size(0)
+	{
+		this->open(filename);
+	}
+
+	/**********************************************************/
+	MappedFile::~MappedFile()
+	{
+		this->close();
+	}
+
+	//====================
+	// Getters and setters
+	//====================
+	/**********************************************************/
+	char* MappedFile::getData() const
+	{
+		return m_pData;
+	}
+
+	/**********************************************************/
+	std::size_t MappedFile::getSize() const
+	{
+		return m_size;
+	}
+
+	/**********************************************************/
+	bool MappedFile::isOpen() const
+	{
+		return m_pData != nullptr;
+	}
+
+	//====================
+	// Methods
+	//====================
+	/**********************************************************/
+	bool MappedFile::open(const std::string& filename)
+	{
+		this->close();
+
+#if defined(_WIN32)
+		HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+		{
+			return false;
+		}
+
+		LARGE_INTEGER size;
+		if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+		{
+			CloseHandle(file);
+			return false;
+		}
+
+		// A copy-on-write mapping, so parsers can modify the contents without touching the file.
+		HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+		CloseHandle(file);
+		if (!mapping)
+		{
+			return false;
+		}
+
+		void* pData = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+		// The view keeps the mapping alive.
+		CloseHandle(mapping);
+		if (!pData)
+		{
+			return false;
+		}
+
+		m_size = static_cast<std::size_t>(size.QuadPart);
+#else
+		int file = ::open(filename.c_str(), O_RDONLY);
+		if (file < 0)
+		{
+			return false;
+		}
+
+		struct stat info;
+		if (fstat(file, &info) != 0 || info.st_size == 0)
+		{
+			::close(file);
+			return false;
+		}
+
+		// A private mapping, so parsers can modify the contents without touching the file.
+		void* pData = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ | PROT_WRITE, MAP_PRIVATE, file, 0);
+		// The mapping remains valid after the descriptor is closed.
+		::close(file);
+		if (pData == MAP_FAILED)
+		{
+			return false;
+		}
+
+		m_size = static_cast<std::size_t>(info.st_size);
+#endif
+
+		m_pData = static_cast<char*>(pData);
+		return true;
+	}
+
+	/**********************************************************/
+	void MappedFile::close()
+	{
+		if (!m_pData)
+		{
+			return;
+		}
+
+#if defined(_WIN32)
+		UnmapViewOfFile(m_pData);
+#else
+		munmap(m_pData, m_size);
+#endif
+
+		m_pData = nullptr;
+		m_size = 0;
+	}
+
+} // namespace pegasus
@@ -20,19 +20,87 @@
 * 3. This notice may not be removed or altered from any source distribution.
 */
 
+//====================
+// C++ includes
+//====================
+#include <cstring> // Comparing the parsed values without copying them.
+#include <utility> // Pairing the shader types with their sources.
+#include <vector>  // Validating the shaders before the program is created.
+
 //====================
 // Pegasus includes
 //====================
-#include <pegasus/utilities/xml_serializable_service.hpp> // Class declaration.
-#include <pegasus/utilities/exceptions/no_resource_exception.hpp>    // Throwing exceptions if resource not found.
+#include <pegasus/utilities/xml_serializable_service.hpp>         // Class declaration.
+#include <pegasus/utilities/exceptions/no_resource_exception.hpp> // Throwing exceptions if resource not found.
+#include <pegasus/utilities/mapped_file.hpp>                      // Mapping the xml files into memory.
+#include <pegasus/utilities/logger_factory.hpp>                   // Logging any Resources.xml de-serialization issues.
+#include <pegasus/graphics/shader_program.hpp>                    // De-serializing shader program objects.
+#include <pegasus/graphics/texture.hpp>                           // De-serializing texture objects.
 
 //====================
 // Library includes
 //====================
-#include <pugixml.hpp> // De-serializing the Resources.xml file.
+#include <pugixml.hpp> // Parsing the xml files.
 
 namespace pegasus
 {
+	//====================
+	// Functions
+	//====================
+	/**********************************************************/
+	static bool equals(const char* pValue, const char* pExpected)
+	{
+		return std::strcmp(pValue, pExpected) == 0;
+	}
+
+	/**********************************************************/
+	static bool parseShaderType(const char* pValue, gl::eShaderType& type)
+	{
+		if (equals(pValue, "Vertex") || equals(pValue, "Fragment"))
+		{
+			type = equals(pValue, "Vertex") ? gl::eShaderType::VERTEX : gl::eShaderType::FRAGMENT;
+			return true;
+		}
+
+		return false;
+	}
+
+	/**********************************************************/
+	static bool parseFilterType(const char* pValue, gl::eFilterType& filter)
+	{
+		if (equals(pValue, "Nearest") || equals(pValue, "Linear"))
+		{
+			filter = equals(pValue, "Nearest") ? gl::eFilterType::NEAREST : gl::eFilterType::LINEAR;
+			return true;
+		}
+
+		return false;
+	}
+
+	/**********************************************************/
+	static bool parseWrapType(const char* pValue, gl::eWrapType& wrap)
+	{
+		if (equals(pValue, "Repeat") || equals(pValue, "Clamp"))
+		{
+			wrap = equals(pValue, "Repeat") ? gl::eWrapType::REPEAT : gl::eWrapType::CLAMP;
+			return true;
+		}
+
+		return false;
+	}
+
+	/**********************************************************/
+	static bool parseAssetType(const char* pValue, eAssetType& type)
+	{
+		if (equals(pValue, "Shader") || equals(pValue, "Texture") || equals(pValue, "Directory"))
+		{
+			type = equals(pValue, "Shader") ? eAssetType::SHADER : equals(pValue, "Texture") ? eAssetType::TEXTURE : eAssetType::DIRECTORY;
+			return true;
+		}
+
+		return false;
+	}
+
 	//====================
 	// Ctors and dtor
 	//====================
@@ -42,13 +110,147 @@ namespace pegasus
 	{
 	}
 
+	//====================
+	// Private methods
+	//====================
+	/**********************************************************/
+	pugi::xml_document* XmlSerializableService::loadDocument(const std::string& filename, MappedFile& file)
+	{
+		// Reused between calls, so the document does not re-allocate its node pages for every file.
+		static thread_local pugi::xml_document document;
+
+		if (!file.open(filename))
+		{
+			return nullptr;
+		}
+
+		// Parse directly within the mapped pages, the values are terminated in-place rather than copied.
+		pugi::xml_parse_result result = document.load_buffer_inplace(file.getData(), file.getSize());
+		if (!result)
+		{
+			return nullptr;
+		}
+
+		return &document;
+	}
+
+	/**********************************************************/
+	Expected<Asset*> XmlSerializableService::deserializeShaderProgram(const std::string& filename) const
+	{
+		MappedFile file;
+		pugi::xml_document* pDocument = XmlSerializableService::loadDocument(filename, file);
+		if (!pDocument)
+		{
+			return Error_t{ eErrorCode::INVALID_FORMAT, "Unable to de-serialize file:" + filename };
+		}
+
+		// Get the root of the shader program.
+		pugi::xml_node root = pDocument->child("ShaderProgram");
+		// Get the list of shaders to define.
+		pugi::xml_node shaders = root.child("Shaders");
+		if (!shaders.child("Shader"))
+		{
+			return Error_t{ eErrorCode::INVALID_FORMAT, "No glsl shaders have been defined in file:" + filename };
+		}
+
+		// Validate every shader type before any OpenGL objects are created.
+		std::vector<std::pair<gl::eShaderType, const char*>> stages;
+		for (auto& shader : shaders.children("Shader"))
+		{
+			gl::eShaderType type;
+			if (!parseShaderType(shader.child_value("ShaderType"), type))
+			{
+				return Error_t{ eErrorCode::INVALID_FORMAT, "A shader without a valid ShaderType has been declared in file:" + filename };
+			}
+			stages.push_back({ type, shader.child_value("Source") });
+		}
+
+		// Create the shader program.
+		ShaderProgram* pProgram = new ShaderProgram();
+		// Set the debug name.
+		pProgram->setName(root.child_value("Name"));
+		// Attach each shader as an object within the program.
+		for (auto& stage : stages)
+		{
+			pProgram->attach(stage.first, stage.second);
+		}
+		// Return the shader.
+		return pProgram;
+	}
+
+	/**********************************************************/
+	Expected<Asset*> XmlSerializableService::deserializeTexture(const std::string& filename) const
+	{
+		MappedFile file;
+		pugi::xml_document* pDocument = XmlSerializableService::loadDocument(filename, file);
+		if (!pDocument)
+		{
+			return Error_t{ eErrorCode::INVALID_FORMAT, "Unable to de-serialize file:" + filename };
+		}
+
+		// Get the root of the texture.
+		pugi::xml_node root = pDocument->child("Texture");
+		// Get the image source.
+		const char* pSource = root.child_value("Source");
+		// There is no image, the texture cannot be created.
+		if (!*pSource)
+		{
+			return Error_t{ eErrorCode::INVALID_FORMAT, "No image source has been declared in file:" + filename };
+		}
+
+		// Create a texture description and populate its values.
+		TextureDescription_t desc;
+		desc.source = pSource;
+		desc.type = gl::eTextureType::TEXTURE_2D;
+		// Only 2D textures are supported.
+		if (!equals(root.child_value("TextureType"), "Texture2D"))
+		{
+			return Error_t{ eErrorCode::INVALID_FORMAT, "No valid TextureType has been declared in file:" + filename };
+		}
+		if (!parseFilterType(root.child_value("Filter"), desc.filtering))
+		{
+			return Error_t{ eErrorCode::INVALID_FORMAT, "No valid Filter has been declared in file:" + filename };
+		}
+		if (!parseWrapType(root.child_value("WrapMode"), desc.wrapping))
+		{
+			return Error_t{ eErrorCode::INVALID_FORMAT, "No valid WrapMode has been declared in file:" + filename };
+		}
+		// Create the texture from the description and return it.
+		Texture* pTexture = new Texture(desc);
+		pTexture->setName(root.child_value("Name"));
+
+		return pTexture;
+	}
+
+	//====================
+	// Getters and setters
+	//====================
+	/**********************************************************/
+	bool XmlSerializableService::isConcurrent() const // override
+	{
+		return true;
+	}
+
 	//====================
 	// Methods
 	//====================
 	/**********************************************************/
-	Asset* XmlSerializableService::deserialize(eAssetType type, const std::string& filename) const
+	Expected<Asset*> XmlSerializableService::deserialize(eAssetType type, const std::string& filename) const
 	{
-		return nullptr;
+		switch (type)
+		{
+		case eAssetType::SHADER:
+			return this->deserializeShaderProgram(filename);
+
+		case eAssetType::TEXTURE:
+			return this->deserializeTexture(filename);
+
+		case eAssetType::DIRECTORY:
+		case eAssetType::NONE:
+			break;
+		}
+
+		return Error_t{ eErrorCode::UNSUPPORTED, "Cannot de-serialize asset type from file:" + filename };
 	}
 
 	/**********************************************************/
@@ -56,27 +258,32 @@ namespace pegasus
 	{
 		std::unordered_map<std::string, Resource_t> resources;
 
-		// Load the xml document.
-		pugi::xml_document document;
-		pugi::xml_parse_result result = document.load_file(filename.c_str());
+		// Map and parse the xml document.
+		MappedFile file;
+		pugi::xml_document* pDocument = XmlSerializableService::loadDocument(filename, file);
 
 		// Check if it was successful.
-		if (!result)
+		if (!pDocument)
 		{
 			throw NoResourceException("Cannot open resource file: " + filename);
 		}
 
 		// Get the root "Resource" node. 
-		pugi::xml_node root = document.child("Resources");
+		pugi::xml_node root = pDocument->child("Resources");
 		for (auto& resource : root.children("Resource"))
 		{
-			std::string type = resource.child("AssetType").child_value();
+			const char* pName = resource.child_value("Name");
 
 			Resource_t r;
-			r.path = resource.child("Source").child_value();
-			r.type = type == "Shader" ? eAssetType::SHADER : type == "Texture" ? eAssetType::TEXTURE : eAssetType::NONE;
+			r.path = resource.child_value("Source");
+			// The type is missing or misspelled, log a warning.
+			if (!parseAssetType(resource.child_value("AssetType"), r.type))
+			{
+				LoggerFactory::getLogger("file.logger").warning("Resource", pName, "unable to de-serialize correctly. A valid AssetType has not been defined.");
+				continue;
+			}
 
-			resources.insert({ resource.child("Name").child_value() , r });
+			resources.emplace(pName, std::move(r));
 		}
 
 		return resources;
@@ -1,5 +1,226 @@
-#include <catch.hpp>
+/*
+* Pegasus Engine
+* 2017 - Benjamin Carter (bencarterdev@outlook.com)
+*
+* This software is provided 'as-is', without any express or implied warranty.
+* In no event will the authors be held liable for any damages arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it freely,
+* subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented;
+*    you must not claim that you wrote the original software.
+*    If you use this software in a product, an acknowledgement
+*    in the product documentation would be appreciated but is not required.
+*
+* 2. Altered source versions must be plainly marked as such,
+*    and must not be misrepresented as being the original software.
+*
+* 3. This notice may not be removed or altered from any source distribution.
+*/
 
+//====================
+// C++ includes
+//====================
+#include <cstdio>    // Removing the test files.
+#include <fstream>   // Writing the test asset files.
+#include <stdexcept> // Throwing from the serializable service.
+
+//====================
+// Pegasus includes
+//====================
+#include <pegasus/utilities/iasset_factory.hpp>              // Testing the IAssetFactory class.
+#include <pegasus/core/asset.hpp>                            // The assets created by the test factory.
+#include <pegasus/utilities/cooked_asset_writer.hpp>         // Writing the Resources files.
+#include <pegasus/utilities/binary_serializable_service.hpp> // Reading the Resources files.
+
+//====================
+// Library includes
+//====================
+#include <catch.hpp> // Unit test library.
+
+using namespace pegasus;
+
+namespace
+{
+	//====================
+	// Test classes
+	//====================
+	class TestAsset final : public Asset
+	{
+	public:
+		std::size_t getMemoryUsage() const override
+		{
+			return 64;
+		}
+	};
+
+	class TestService final : public ISerializableService
+	{
+	public:
+		/** The amount of times the factory has requested an asset. */
+		mutable std::size_t calls = 0;
+		/** Whether the requested assets fail to de-serialize. */
+		bool fail = false;
+		/** Whether the requested assets throw whilst de-serializing. */
+		bool raise = false;
+
+		Expected<Asset*> deserialize(eAssetType, const std::string& name) const override
+		{
+			calls++;
+			if (raise)
+			{
+				throw std::runtime_error("Malformed asset.");
+			}
+
+			if (fail)
+			{
+				return Error_t{ eErrorCode::INVALID_FORMAT, "Unable to de-serialize " + name };
+			}
+
+			return new TestAsset();
+		}
+
+		std::unordered_map<std::string, Resource_t> deserializeResources(const std::string&) const override
+		{
+			return std::unordered_map<std::string, Resource_t>();
+		}
+	};
+
+	class TestFactory final : public IAssetFactory
+	{
+	public:
+		/** The asset returned when a name fails to load. */
+		TestAsset defaultAsset;
+
+		explicit TestFactory(Resources& resources)
+			: IAssetFactory(resources, TypeID::get<TestAsset>(), eAssetType::TEXTURE)
+		{
+			// Empty.
+		}
+
+		TestAsset* load(const std::string& name) override
+		{
+			Asset* pAsset = this->loadAsset(name);
+			return pAsset ? static_cast<TestAsset*>(pAsset) : &defaultAsset;
+		}
+	};
+
+	//====================
+	// Functions
+	//====================
+	/**********************************************************/
+	void loadResources(Resources& resources, const std::string& filename)
+	{
+		std::unordered_map<std::string, Resource_t> values;
+		values["asset.texture.basic"] = { "test_asset_factory_basic.txt", eAssetType::TEXTURE };
+		REQUIRE(CookedAssetWriter::save(filename, CookedAssetWriter::cookResources(values)));
+		resources.load(filename);
+		std::remove(filename.c_str());
+	}
+
+} // namespace
+
+//====================
+// Unit tests
+//====================
+/**********************************************************/
 TEST_CASE("Empty test", "[number]")
 {
-}
\ No newline at end of file
+}
+
+/**********************************************************/
+TEST_CASE("IAssetFactory: Failed names are not de-serialized again.", "[AssetFactory]")
+{
+	// Arrange.
+	BinarySerializableService binary;
+	Resources resources;
+	resources.setService(binary);
+	loadResources(resources, "test_asset_factory_failed.bin");
+	TestService service;
+	service.fail = true;
+	TestFactory factory(resources);
+	factory.setService(service);
+	// Act.
+	TestAsset* pFirst = factory.load("asset.texture.basic");
+	TestAsset* pSecond = factory.load("asset.texture.basic");
+	TestAsset* pMissing = factory.load("asset.texture.missing");
+	// Assert.
+	REQUIRE(pFirst == &factory.defaultAsset);
+	REQUIRE(pSecond == &factory.defaultAsset);
+	REQUIRE(pMissing == &factory.defaultAsset);
+	REQUIRE(service.calls == 1);
+}
+
+/**********************************************************/
+TEST_CASE("IAssetFactory: Failed names are retried once the Resources file is re-loaded.", "[AssetFactory]")
+{
+	// Arrange.
+	BinarySerializableService binary;
+	Resources resources;
+	resources.setService(binary);
+	loadResources(resources, "test_asset_factory_reload.bin");
+	TestService service;
+	service.fail = true;
+	TestFactory factory(resources);
+	factory.setService(service);
+	factory.load("asset.texture.basic");
+	// Act.
+	service.fail = false;
+	loadResources(resources, "test_asset_factory_reload.bin");
+	TestAsset* pAsset = factory.load("asset.texture.basic");
+	// Assert.
+	REQUIRE(pAsset != &factory.defaultAsset);
+	REQUIRE(service.calls == 2);
+	REQUIRE(factory.load("asset.texture.basic") == pAsset);
+	REQUIRE(service.calls == 2);
+}
+
+/**********************************************************/
+TEST_CASE("IAssetFactory: Failed names are retried once revalidate finds the file modified.", "[AssetFactory]")
+{
+	// Arrange.
+	std::ofstream("test_asset_factory_basic.txt") << "broken";
+	BinarySerializableService binary;
+	Resources resources;
+	resources.setService(binary);
+	loadResources(resources, "test_asset_factory_revalidate.bin");
+	TestService service;
+	service.fail = true;
+	TestFactory factory(resources);
+	factory.setService(service);
+	factory.load("asset.texture.basic");
+	// Act.
+	factory.revalidate();
+	factory.load("asset.texture.basic");
+	std::size_t unmodifiedCalls = service.calls;
+	// Removing the file changes its modification time.
+	std::remove("test_asset_factory_basic.txt");
+	factory.revalidate();
+	factory.load("asset.texture.basic");
+	// Assert.
+	REQUIRE(unmodifiedCalls == 1);
+	REQUIRE(service.calls == 2);
+}
+
+/**********************************************************/
+TEST_CASE("IAssetFactory: Exceptions thrown by the service are reported as failures.", "[AssetFactory]")
+{
+	// Arrange.
+	BinarySerializableService binary;
+	Resources resources;
+	resources.setService(binary);
+	loadResources(resources, "test_asset_factory_exception.bin");
+	TestService service;
+	service.raise = true;
+	TestFactory factory(resources);
+	factory.setService(service);
+	// Act.
+	TestAsset* pAsset = nullptr;
+	REQUIRE_NOTHROW(pAsset = factory.load("asset.texture.basic"));
+	factory.load("asset.texture.basic");
+	// Assert.
+	REQUIRE(pAsset == &factory.defaultAsset);
+	REQUIRE(service.calls == 1);
+}
@@ -0,0 +1,149 @@
+/*
+* Pegasus Engine
+* 2017 - Benjamin Carter (bencarterdev@outlook.com)
+*
+* This software is provided 'as-is', without any express or implied warranty.
+* In no event will the authors be held liable for any damages arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it freely,
+* subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented;
+*    you must not claim that you wrote the original software.
+*    If you use this software in a product, an acknowledgement
+*    in the product documentation would be appreciated but is not required.
+*
+* 2. Altered source versions must be plainly marked as such,
+*    and must not be misrepresented as being the original software.
+*
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+//====================
+// C++ includes
+//====================
+#include <cstdio> // Removing the cooked files.
+
+//====================
+// Pegasus includes
+//====================
+#include <pegasus/utilities/cooked_asset_writer.hpp>              // Testing the CookedAssetWriter class.
+#include <pegasus/utilities/binary_serializable_service.hpp>      // Testing the BinarySerializableService class.
+#include <pegasus/utilities/exceptions/no_resource_exception.hpp> // Testing for correct exceptions being thrown.
+
+//====================
+// Library includes
+//====================
+#include <catch.hpp> // Unit test library.
+
+using namespace pegasus;
+
+//====================
+// Unit tests
+//====================
+/**********************************************************/
+TEST_CASE("CookedAssetWriter: Cooked resources are read back by the BinarySerializableService.", "[CookedAsset]")
+{
+	// Arrange.
+	std::unordered_map<std::string, Resource_t> resources;
+	resources["asset.texture.basic"] = { "assets/textures/basic_texture.bin", eAssetType::TEXTURE };
+	resources["asset.shader.basic"] = { "assets/shaders/basic_shader.bin", eAssetType::SHADER };
+	REQUIRE(CookedAssetWriter::save("test_resources.bin", CookedAssetWriter::cookResources(resources)));
+	BinarySerializableService service;
+	// Act.
+	auto values = service.deserializeResources("test_resources.bin");
+	std::remove("test_resources.bin");
+	// Assert.
+	REQUIRE(values.size() == 2);
+	REQUIRE(values["asset.texture.basic"].path == "assets/textures/basic_texture.bin");
+	REQUIRE(values["asset.texture.basic"].type == eAssetType::TEXTURE);
+	REQUIRE(values["asset.shader.basic"].path == "assets/shaders/basic_shader.bin");
+	REQUIRE(values["asset.shader.basic"].type == eAssetType::SHADER);
+}
+
+/**********************************************************/
+TEST_CASE("CookedAssetWriter: Cooked structures are aligned and terminated.", "[CookedAsset]")
+{
+	// Arrange.
+	TextureDescription_t desc;
+	desc.source = "data/textures/image.png";
+	desc.type = gl::eTextureType::TEXTURE_2D;
+	desc.filtering = gl::eFilterType::LINEAR;
+	desc.wrapping = gl::eWrapType::REPEAT;
+	// Act.
+	std::vector<char> data = CookedAssetWriter::cookTexture("texture", desc);
+	const CookedHeader_t* pHeader = reinterpret_cast<const CookedHeader_t*>(data.data());
+	const CookedTexture_t* pTexture = reinterpret_cast<const CookedTexture_t*>(data.data() + sizeof(CookedHeader_t));
+	// Assert.
+	REQUIRE(data.size() % 4 == 0);
+	REQUIRE(pHeader->size == data.size());
+	REQUIRE(pHeader->version == COOKED_VERSION);
+	REQUIRE(pHeader->type == eCookedType::TEXTURE);
+	REQUIRE(std::string(data.data() + pTexture->source.offset) == desc.source);
+	REQUIRE(pTexture->filtering == static_cast<std::uint32_t>(gl::eFilterType::LINEAR));
+	REQUIRE(pTexture->wrapping == static_cast<std::uint32_t>(gl::eWrapType::REPEAT));
+}
+
+/**********************************************************/
+TEST_CASE("BinarySerializableService: Reject cooked files of another version.", "[CookedAsset]")
+{
+	// Arrange.
+	std::vector<char> data = CookedAssetWriter::cookResources({});
+	reinterpret_cast<CookedHeader_t*>(data.data())->version = COOKED_VERSION + 1;
+	REQUIRE(CookedAssetWriter::save("test_resources_version.bin", data));
+	BinarySerializableService service;
+	// Assert.
+	REQUIRE_THROWS_AS(service.deserializeResources("test_resources_version.bin"), NoResourceException);
+	std::remove("test_resources_version.bin");
+}
+
+/**********************************************************/
+TEST_CASE("BinarySerializableService: Reject truncated cooked files.", "[CookedAsset]")
+{
+	// Arrange.
+	std::unordered_map<std::string, Resource_t> resources;
+	resources["asset.texture.basic"] = { "assets/textures/basic_texture.bin", eAssetType::TEXTURE };
+	std::vector<char> data = CookedAssetWriter::cookResources(resources);
+	data.resize(data.size() - 8);
+	REQUIRE(CookedAssetWriter::save("test_resources_truncated.bin", data));
+	BinarySerializableService service;
+	// Assert.
+	REQUIRE_THROWS_AS(service.deserializeResources("test_resources_truncated.bin"), NoResourceException);
+	std::remove("test_resources_truncated.bin");
+}
+
+/**********************************************************/
+TEST_CASE("BinarySerializableService: Load invalid Resources file.", "[CookedAsset]")
+{
+	// Arrange.
+	BinarySerializableService service;
+	// Assert.
+	REQUIRE_THROWS_AS(service.deserializeResources("garbage"), NoResourceException);
+}
+
+/**********************************************************/
+TEST_CASE("BinarySerializableService: Missing assets are reported without exceptions.", "[CookedAsset]")
+{
+	// Arrange.
+	BinarySerializableService service;
+	// Act.
+	auto result = service.deserialize(eAssetType::TEXTURE, "garbage");
+	// Assert.
+	REQUIRE_FALSE(result);
+	REQUIRE(result.getError().code == eErrorCode::NOT_FOUND);
+}
+
+/**********************************************************/
+TEST_CASE("BinarySerializableService: Cooked files of the wrong type are reported as unsupported.", "[CookedAsset]")
+{
+	// Arrange.
+	REQUIRE(CookedAssetWriter::save("test_resources_type.bin", CookedAssetWriter::cookResources({})));
+	BinarySerializableService service;
+	// Act.
+	auto result = service.deserialize(eAssetType::TEXTURE, "test_resources_type.bin");
+	std::remove("test_resources_type.bin");
+	// Assert.
+	REQUIRE_FALSE(result);
+	REQUIRE(result.getError().code == eErrorCode::UNSUPPORTED);
+}
@@ -0,0 +1,78 @@
+/*
+* Pegasus Engine
+* 2017 - Benjamin Carter (bencarterdev@outlook.com)
+*
+* This software is provided 'as-is', without any express or implied warranty.
+* In no event will the authors be held liable for any damages arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it freely,
+* subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented;
+*    you must not claim that you wrote the original software.
+*    If you use this software in a product, an acknowledgement
+*    in the product documentation would be appreciated but is not required.
+*
+* 2. Altered source versions must be plainly marked as such,
+*    and must not be misrepresented as being the original software.
+*
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+//====================
+// C++ includes
+//====================
+#include <cstdio>    // Removing the cooked files.
+#include <stdexcept> // Testing for unknown services.
+
+//====================
+// Pegasus includes
+//====================
+#include <pegasus/core/engine.hpp>                   // Testing the Engine class.
+#include <pegasus/utilities/cooked_asset_writer.hpp> // Writing the Resources files.
+
+//====================
+// Library includes
+//====================
+#include <catch.hpp> // Unit test library.
+
+using namespace pegasus;
+
+//====================
+// Unit tests
+//====================
+/**********************************************************/
+TEST_CASE("Engine: The serializable services are registered on construction.", "[Engine]")
+{
+	// Arrange.
+	Engine engine;
+	// Act & Assert.
+	REQUIRE_NOTHROW(engine.getService("xml"));
+	REQUIRE_NOTHROW(engine.getService("lua"));
+	REQUIRE_NOTHROW(engine.getService("json"));
+	REQUIRE_NOTHROW(engine.getService("binary"));
+	REQUIRE_THROWS_AS(engine.getService("yaml"), std::out_of_range);
+}
+
+/**********************************************************/
+TEST_CASE("Engine: Instances own independent subsystems.", "[Engine]")
+{
+	// Arrange.
+	std::unordered_map<std::string, Resource_t> values;
+	values["asset.texture.basic"] = { "assets/textures/basic_texture.bin", eAssetType::TEXTURE };
+	REQUIRE(CookedAssetWriter::save("test_engine_resources.bin", CookedAssetWriter::cookResources(values)));
+	Engine first;
+	Engine second;
+	// Act.
+	first.getResources().setService(first.getService("binary"));
+	first.getResources().load("test_engine_resources.bin");
+	std::remove("test_engine_resources.bin");
+	// Assert.
+	REQUIRE(&first.getScripting() != &second.getScripting());
+	REQUIRE(&first.getService("binary") != &second.getService("binary"));
+	REQUIRE(&first.getResources() != &second.getResources());
+	REQUIRE(&first.getResourceManager() != &second.getResourceManager());
+	REQUIRE(first.getResources().get("asset.texture.basic"));
+	REQUIRE(second.getResources().getGeneration() == 0);
+}
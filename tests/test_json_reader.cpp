@@ -0,0 +1,140 @@
+/*
+* Pegasus Engine
+* 2017 - Benjamin Carter (bencarterdev@outlook.com)
+*
+* This software is provided 'as-is', without any express or implied warranty.
+* In no event will the authors be held liable for any damages arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it freely,
+* subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented;
+*    you must not claim that you wrote the original software.
+*    If you use this software in a product, an acknowledgement
+*    in the product documentation would be appreciated but is not required.
+*
+* 2. Altered source versions must be plainly marked as such,
+*    and must not be misrepresented as being the original software.
+*
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+//====================
+// C++ includes
+//====================
+#include <string> // Recording and comparing the parsed values.
+
+//====================
+// Pegasus includes
+//====================
+#include <pegasus/utilities/json_reader.hpp> // Testing the JsonReader class.
+
+//====================
+// Library includes
+//====================
+#include <catch.hpp> // Unit test library.
+
+using namespace pegasus;
+
+//====================
+// Helpers
+//====================
+/**
+ * @brief Records every parsed value into a single string, so the order of events can be compared.
+ */
+class RecordingHandler final : public IJsonHandler
+{
+public:
+	std::string events;
+
+	void onStartObject() override { events += "{"; }
+	void onEndObject() override { events += "}"; }
+	void onStartArray() override { events += "["; }
+	void onEndArray() override { events += "]"; }
+	void onKey(const char* pKey, std::size_t length) override { events += "k:" + std::string(pKey, length) + ";"; }
+	void onString(const char* pValue, std::size_t length) override { events += "s:" + std::string(pValue, length) + ";"; }
+	void onNumber(double value) override { events += "n:" + std::to_string(value) + ";"; }
+	void onBool(bool value) override { events += value ? "true;" : "false;"; }
+	void onNull() override { events += "null;"; }
+};
+
+/**********************************************************/
+bool parse(std::string document, RecordingHandler& handler)
+{
+	JsonReader reader;
+	return reader.parse(&document[0], document.size(), handler);
+}
+
+//====================
+// Unit tests
+//====================
+/**********************************************************/
+TEST_CASE("JsonReader: Parse nested objects and arrays.", "[JsonReader]")
+{
+	// Arrange.
+	RecordingHandler handler;
+	// Act.
+	bool result = parse(R"({ "a": [1, -2.5e1, true, false, null], "b": { "c": "d" } })", handler);
+	// Assert.
+	REQUIRE(result);
+	REQUIRE(handler.events == "{k:a;[n:1.000000;n:-25.000000;true;false;null;]k:b;{k:c;s:d;}}");
+}
+
+/**********************************************************/
+TEST_CASE("JsonReader: Unescape strings in-place.", "[JsonReader]")
+{
+	// Arrange.
+	RecordingHandler handler;
+	// Act.
+	bool result = parse(R"(["a\"b\\c\/d\n", "\u00e9\u20ac\ud83d\ude00"])", handler);
+	// Assert.
+	REQUIRE(result);
+	REQUIRE(handler.events == "[s:a\"b\\c/d\n;s:\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80;]");
+}
+
+/**********************************************************/
+TEST_CASE("JsonReader: Unescape strings longer than a scanned block.", "[JsonReader]")
+{
+	// Arrange.
+	RecordingHandler handler;
+	std::string value(40, 'x');
+	// Act.
+	bool result = parse("\"" + value + "\\t" + value + "\\\"" + value + "\"", handler);
+	// Assert.
+	REQUIRE(result);
+	REQUIRE(handler.events == "s:" + value + "\t" + value + "\"" + value + ";");
+}
+
+/**********************************************************/
+TEST_CASE("JsonReader: Reject invalid documents.", "[JsonReader]")
+{
+	// Arrange.
+	RecordingHandler handler;
+	// Assert.
+	REQUIRE_FALSE(parse("", handler));
+	REQUIRE_FALSE(parse("{", handler));
+	REQUIRE_FALSE(parse(R"({"a" 1})", handler));
+	REQUIRE_FALSE(parse(R"([1,])", handler));
+	REQUIRE_FALSE(parse(R"("unterminated)", handler));
+	REQUIRE_FALSE(parse("\"control\x01\"", handler));
+	REQUIRE_FALSE(parse(R"("\ud83d")", handler));
+	REQUIRE_FALSE(parse(R"(01)", handler));
+	REQUIRE_FALSE(parse(R"(tru)", handler));
+	REQUIRE_FALSE(parse(R"({} {})", handler));
+}
+
+/**********************************************************/
+TEST_CASE("JsonReader: Report the offset of an error.", "[JsonReader]")
+{
+	// Arrange.
+	RecordingHandler handler;
+	JsonReader reader;
+	std::string document = R"({"a": ?})";
+	// Act.
+	bool result = reader.parse(&document[0], document.size(), handler);
+	// Assert.
+	REQUIRE_FALSE(result);
+	REQUIRE(reader.getErrorOffset() == 6);
+	REQUIRE(!reader.getError().empty());
+}
@@ -0,0 +1,160 @@
+/*
+* Pegasus Engine
+* 2017 - Benjamin Carter (bencarterdev@outlook.com)
+*
+* This software is provided 'as-is', without any express or implied warranty.
+* In no event will the authors be held liable for any damages arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it freely,
+* subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented;
+*    you must not claim that you wrote the original software.
+*    If you use this software in a product, an acknowledgement
+*    in the product documentation would be appreciated but is not required.
+*
+* 2. Altered source versions must be plainly marked as such,
+*    and must not be misrepresented as being the original software.
+*
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+//====================
+// C++ includes
+//====================
+#include <cstdio>  // Removing the generated documents.
+#include <fstream> // Writing the generated documents.
+#include <string>  // The document sources.
+
+//====================
+// Pegasus includes
+//====================
+#include <pegasus/utilities/json_serializable_service.hpp>        // Testing the JsonSerializableService class.
+#include <pegasus/utilities/exceptions/no_resource_exception.hpp> // Testing for correct exceptions being thrown.
+
+//====================
+// Library includes
+//====================
+#include <catch.hpp> // Unit test library.
+
+using namespace pegasus;
+
+namespace
+{
+	//====================
+	// Functions
+	//====================
+	/**********************************************************/
+	void writeDocument(const std::string& filename, const std::string& source)
+	{
+		std::ofstream file(filename, std::ios::out | std::ios::trunc);
+		file << source;
+	}
+} // namespace
+
+//====================
+// Unit tests
+//====================
+/**********************************************************/
+TEST_CASE("JsonSerializableService: Load Resources.json valid file.", "[JsonSerializableService]")
+{
+	// Arrange.
+	JsonSerializableService service;
+	// Act.
+	auto values = service.deserializeResources("Resources.json");
+	// Assert.
+	REQUIRE(values.size() == 2);
+	REQUIRE(values["asset.texture.basic"].path == "assets/textures/basic_texture.json");
+	REQUIRE(values["asset.texture.basic"].type == eAssetType::TEXTURE);
+	REQUIRE(values["asset.shader.basic"].type == eAssetType::SHADER);
+}
+
+/**********************************************************/
+TEST_CASE("JsonSerializableService: Load Resources.json invalid file.", "[JsonSerializableService]")
+{
+	// Arrange.
+	JsonSerializableService service;
+	writeDocument("test_resources_malformed.json", "{ \"Resources\": [ { \"name\": \"asset.texture.basic\", } ] }");
+	// Assert.
+	REQUIRE_THROWS_AS(service.deserializeResources("garbage"), NoResourceException);
+	REQUIRE_THROWS_AS(service.deserializeResources("test_resources_malformed.json"), NoResourceException);
+	std::remove("test_resources_malformed.json");
+}
+
+/**********************************************************/
+TEST_CASE("JsonSerializableService: Resources without a name or a known type are skipped.", "[JsonSerializableService]")
+{
+	// Arrange.
+	JsonSerializableService service;
+	writeDocument("test_resources_fields.json",
+		"{ \"Resources\": ["
+		"{ \"name\": \"asset.texture.valid\", \"source\": \"valid.json\", \"asset_type\": \"Texture\" },"
+		"{ \"source\": \"unnamed.json\", \"asset_type\": \"Texture\" },"
+		"{ \"name\": \"asset.texture.untyped\", \"source\": \"untyped.json\" },"
+		"{ \"name\": \"asset.texture.misspelled\", \"source\": \"misspelled.json\", \"asset_type\": \"Textrue\" }"
+		"] }");
+	// Act.
+	auto values = service.deserializeResources("test_resources_fields.json");
+	std::remove("test_resources_fields.json");
+	// Assert.
+	REQUIRE(values.size() == 1);
+	REQUIRE(values.count("asset.texture.valid") == 1);
+	REQUIRE(values["asset.texture.valid"].type == eAssetType::TEXTURE);
+}
+
+/**********************************************************/
+TEST_CASE("JsonSerializableService: Missing and malformed assets are reported without exceptions.", "[JsonSerializableService]")
+{
+	// Arrange.
+	JsonSerializableService service;
+	writeDocument("test_texture_malformed.json", "{ \"Texture\": { \"source\": ");
+	// Act.
+	auto missing = service.deserialize(eAssetType::TEXTURE, "garbage");
+	auto malformed = service.deserialize(eAssetType::TEXTURE, "test_texture_malformed.json");
+	std::remove("test_texture_malformed.json");
+	// Assert.
+	REQUIRE_FALSE(missing);
+	REQUIRE(missing.getError().code == eErrorCode::NOT_FOUND);
+	REQUIRE_FALSE(malformed);
+	REQUIRE(malformed.getError().code == eErrorCode::INVALID_FORMAT);
+}
+
+/**********************************************************/
+TEST_CASE("JsonSerializableService: Assets with missing or unknown fields are rejected.", "[JsonSerializableService]")
+{
+	// Arrange.
+	JsonSerializableService service;
+	writeDocument("test_texture_source.json", "{ \"Texture\": { \"texture_type\": \"Texture2D\", \"wrap_mode\": \"Clamp\", \"filter\": \"Linear\" } }");
+	writeDocument("test_texture_filter.json", "{ \"Texture\": { \"texture_type\": \"Texture2D\", \"source\": \"image.png\", \"wrap_mode\": \"Clamp\" } }");
+	writeDocument("test_texture_wrap.json", "{ \"Texture\": { \"texture_type\": \"Texture2D\", \"source\": \"image.png\", \"wrap_mode\": \"Mirror\", \"filter\": \"Linear\" } }");
+	writeDocument("test_shader_type.json", "{ \"ShaderProgram\": { \"shaders\": [ { \"source\": \"shader.glsl\", \"shader_type\": \"Geometry\" } ] } }");
+	writeDocument("test_shader_empty.json", "{ \"ShaderProgram\": { \"name\": \"empty\" } }");
+	writeDocument("test_shader_source.json", "{ \"ShaderProgram\": { \"shaders\": [ { \"shader_type\": \"Vertex\" } ] } }");
+	// Act.
+	auto source = service.deserialize(eAssetType::TEXTURE, "test_texture_source.json");
+	auto filter = service.deserialize(eAssetType::TEXTURE, "test_texture_filter.json");
+	auto wrap = service.deserialize(eAssetType::TEXTURE, "test_texture_wrap.json");
+	auto type = service.deserialize(eAssetType::SHADER, "test_shader_type.json");
+	auto empty = service.deserialize(eAssetType::SHADER, "test_shader_empty.json");
+	auto shaderSource = service.deserialize(eAssetType::SHADER, "test_shader_source.json");
+	std::remove("test_texture_source.json");
+	std::remove("test_texture_filter.json");
+	std::remove("test_texture_wrap.json");
+	std::remove("test_shader_type.json");
+	std::remove("test_shader_empty.json");
+	std::remove("test_shader_source.json");
+	// Assert.
+	REQUIRE_FALSE(source);
+	REQUIRE(source.getError().code == eErrorCode::INVALID_FORMAT);
+	REQUIRE_FALSE(filter);
+	REQUIRE(filter.getError().code == eErrorCode::INVALID_FORMAT);
+	REQUIRE_FALSE(wrap);
+	REQUIRE(wrap.getError().code == eErrorCode::INVALID_FORMAT);
+	REQUIRE_FALSE(type);
+	REQUIRE(type.getError().code == eErrorCode::INVALID_FORMAT);
+	REQUIRE_FALSE(empty);
+	REQUIRE(empty.getError().code == eErrorCode::INVALID_FORMAT);
+	REQUIRE_FALSE(shaderSource);
+	REQUIRE(shaderSource.getError().code == eErrorCode::INVALID_FORMAT);
+}
@@ -0,0 +1,185 @@
+/*
+* Pegasus Engine
+* 2017 - Benjamin Carter (bencarterdev@outlook.com)
+*
+* This software is provided 'as-is', without any express or implied warranty.
+* In no event will the authors be held liable for any damages arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it freely,
+* subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented;
+*    you must not claim that you wrote the original software.
+*    If you use this software in a product, an acknowledgement
+*    in the product documentation would be appreciated but is not required.
+*
+* 2. Altered source versions must be plainly marked as such,
+*    and must not be misrepresented as being the original software.
+*
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+//====================
+// C++ includes
+//====================
+#include <cstring>   // Filling the allocated blocks.
+#include <algorithm> // Recording the highest live bytes observed.
+#include <atomic>    // Stopping the reading thread.
+#include <thread>    // Reading the statistics from another thread.
+
+//====================
+// Pegasus includes
+//====================
+#include <pegasus/scripting/lua_allocator.hpp> // Testing the LuaAllocator class.
+
+//====================
+// Library includes
+//====================
+#include <catch.hpp> // Unit test library.
+
+using namespace pegasus;
+
+namespace
+{
+	//====================
+	// Functions
+	//====================
+	/**********************************************************/
+	void* failResize(void*, std::size_t)
+	{
+		return nullptr;
+	}
+} // namespace
+
+//====================
+// Unit tests
+//====================
+/**********************************************************/
+TEST_CASE("LuaAllocator: Allocations are counted.", "[LuaAllocator]")
+{
+	// Arrange.
+	LuaAllocator allocator;
+	// Act.
+	void* pSmall = LuaAllocator::luaAlloc(&allocator, nullptr, 0, 24);
+	void* pLarge = LuaAllocator::luaAlloc(&allocator, nullptr, 0, 1024);
+	// Assert.
+	REQUIRE(pSmall);
+	REQUIRE(pLarge);
+	REQUIRE(allocator.getStatistics().liveBytes == 1048);
+	REQUIRE(allocator.getStatistics().totalAllocations == 2);
+	REQUIRE(allocator.getStatistics().frameAllocations == 2);
+	REQUIRE(allocator.getStatistics().frameBytes == 1048);
+
+	LuaAllocator::luaAlloc(&allocator, pSmall, 24, 0);
+	LuaAllocator::luaAlloc(&allocator, pLarge, 1024, 0);
+	allocator.endFrame();
+
+	REQUIRE(allocator.getStatistics().liveBytes == 0);
+	REQUIRE(allocator.getStatistics().peakBytes == 1048);
+	REQUIRE(allocator.getStatistics().frameAllocations == 0);
+	REQUIRE(allocator.getStatistics().frameBytes == 0);
+}
+
+/**********************************************************/
+TEST_CASE("LuaAllocator: Small blocks are reused.", "[LuaAllocator]")
+{
+	// Arrange.
+	LuaAllocator allocator;
+	void* pFirst = LuaAllocator::luaAlloc(&allocator, nullptr, 0, 40);
+	LuaAllocator::luaAlloc(&allocator, pFirst, 40, 0);
+	// Act.
+	void* pSecond = LuaAllocator::luaAlloc(&allocator, nullptr, 0, 48);
+	// Assert.
+	REQUIRE(pFirst == pSecond);
+
+	LuaAllocator::luaAlloc(&allocator, pSecond, 48, 0);
+}
+
+/**********************************************************/
+TEST_CASE("LuaAllocator: Resized blocks keep their contents.", "[LuaAllocator]")
+{
+	// Arrange.
+	LuaAllocator allocator;
+	char* pBlock = static_cast<char*>(LuaAllocator::luaAlloc(&allocator, nullptr, 0, 16));
+	std::memset(pBlock, 7, 16);
+	// Act.
+	pBlock = static_cast<char*>(LuaAllocator::luaAlloc(&allocator, pBlock, 16, 200));
+	pBlock = static_cast<char*>(LuaAllocator::luaAlloc(&allocator, pBlock, 200, 4096));
+	pBlock = static_cast<char*>(LuaAllocator::luaAlloc(&allocator, pBlock, 4096, 8));
+	// Assert.
+	REQUIRE(pBlock);
+	for (int i = 0; i < 8; i++)
+	{
+		REQUIRE(pBlock[i] == 7);
+	}
+	REQUIRE(allocator.getStatistics().liveBytes == 8);
+
+	LuaAllocator::luaAlloc(&allocator, pBlock, 8, 0);
+}
+
+/**********************************************************/
+TEST_CASE("LuaAllocator: Growth beyond the limit is refused.", "[LuaAllocator]")
+{
+	// Arrange.
+	LuaAllocator allocator(1024);
+	void* pBlock = LuaAllocator::luaAlloc(&allocator, nullptr, 0, 512);
+	// Act.
+	void* pGrown = LuaAllocator::luaAlloc(&allocator, pBlock, 512, 2048);
+	void* pShrunk = LuaAllocator::luaAlloc(&allocator, pBlock, 512, 256);
+	// Assert.
+	REQUIRE(!pGrown);
+	REQUIRE(pShrunk);
+	REQUIRE(allocator.getStatistics().failedAllocations == 1);
+	REQUIRE(allocator.getStatistics().liveBytes == 256);
+
+	LuaAllocator::luaAlloc(&allocator, pShrunk, 256, 0);
+}
+
+/**********************************************************/
+TEST_CASE("LuaAllocator: Large blocks that fail to shrink are kept.", "[LuaAllocator]")
+{
+	// Arrange.
+	LuaAllocator allocator;
+	char* pBlock = static_cast<char*>(LuaAllocator::luaAlloc(&allocator, nullptr, 0, 4096));
+	std::memset(pBlock, 7, 4096);
+	allocator.setResize(&failResize);
+	// Act.
+	char* pShrunk = static_cast<char*>(LuaAllocator::luaAlloc(&allocator, pBlock, 4096, 1024));
+	char* pGrown = static_cast<char*>(LuaAllocator::luaAlloc(&allocator, pShrunk, 1024, 8192));
+	// Assert.
+	REQUIRE(pShrunk == pBlock);
+	REQUIRE(pShrunk[1023] == 7);
+	REQUIRE(!pGrown);
+	REQUIRE(allocator.getStatistics().liveBytes == 1024);
+	REQUIRE(allocator.getStatistics().failedAllocations == 1);
+
+	LuaAllocator::luaAlloc(&allocator, pShrunk, 1024, 0);
+}
+
+/**********************************************************/
+TEST_CASE("LuaAllocator: Statistics are read whilst another thread allocates.", "[LuaAllocator]")
+{
+	// Arrange.
+	LuaAllocator allocator;
+	std::atomic<bool> finished(false);
+	std::size_t observedPeak = 0;
+	std::thread reader([&]() {
+		while (!finished.load())
+		{
+			observedPeak = std::max(observedPeak, allocator.getStatistics().liveBytes);
+		}
+	});
+	// Act.
+	for (int i = 0; i < 10000; i++)
+	{
+		void* pBlock = LuaAllocator::luaAlloc(&allocator, nullptr, 0, 64);
+		LuaAllocator::luaAlloc(&allocator, pBlock, 64, 0);
+	}
+	finished = true;
+	reader.join();
+	// Assert.
+	REQUIRE(observedPeak <= 64);
+	REQUIRE(allocator.getStatistics().liveBytes == 0);
+	REQUIRE(allocator.getStatistics().totalAllocations == 10000);
+}
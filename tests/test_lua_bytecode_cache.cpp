@@ -0,0 +1,197 @@
+/*
+* Pegasus Engine
+* 2017 - Benjamin Carter (bencarterdev@outlook.com)
+*
+* This software is provided 'as-is', without any express or implied warranty.
+* In no event will the authors be held liable for any damages arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it freely,
+* subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented;
+*    you must not claim that you wrote the original software.
+*    If you use this software in a product, an acknowledgement
+*    in the product documentation would be appreciated but is not required.
+*
+* 2. Altered source versions must be plainly marked as such,
+*    and must not be misrepresented as being the original software.
+*
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+//====================
+// C++ includes
+//====================
+#include <cstdio>   // Removing the generated scripts.
+#include <fstream>  // Writing the generated scripts and chunks.
+#include <iterator> // Reading the chunk files.
+#include <string>   // The script sources.
+
+//====================
+// Pegasus includes
+//====================
+#include <pegasus/scripting/lua_bytecode_cache.hpp> // Testing the LuaBytecodeCache class.
+#include <pegasus/utilities/hash.hpp>               // Locating the chunk files.
+
+//====================
+// Library includes
+//====================
+#include <catch.hpp> // Unit test library.
+
+using namespace pegasus;
+
+namespace
+{
+	//====================
+	// Functions
+	//====================
+	/**********************************************************/
+	void writeScript(const std::string& filename, const std::string& source)
+	{
+		std::ofstream file(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+		file << source;
+	}
+
+	/**********************************************************/
+	std::string getChunkPath(const std::string& filename)
+	{
+		char name[32];
+		std::snprintf(name, sizeof(name), "%016llx.luac", static_cast<unsigned long long>(Hash::fnv1a(filename.c_str())));
+
+		return std::string("./") + name;
+	}
+
+	/**********************************************************/
+	int execute(LuaBytecodeCache& cache, sol::state& lua, const std::string& filename)
+	{
+		sol::load_result chunk = cache.load(lua, filename);
+		REQUIRE(chunk.valid());
+
+		sol::protected_function script = chunk;
+		return script();
+	}
+} // namespace
+
+//====================
+// Unit tests
+//====================
+/**********************************************************/
+TEST_CASE("LuaBytecodeCache: Scripts are compiled once.", "[LuaBytecodeCache]")
+{
+	// Arrange.
+	sol::state lua;
+	LuaBytecodeCache cache;
+	writeScript("test_bytecode.lua", "return 1 + 1");
+	// Act.
+	int first = execute(cache, lua, "test_bytecode.lua");
+	int second = execute(cache, lua, "test_bytecode.lua");
+	// Assert.
+	REQUIRE(first == 2);
+	REQUIRE(second == 2);
+	REQUIRE(cache.getSize() == 1);
+
+	std::remove("test_bytecode.lua");
+}
+
+/**********************************************************/
+TEST_CASE("LuaBytecodeCache: Modified scripts are compiled again, replacing their chunk.", "[LuaBytecodeCache]")
+{
+	// Arrange.
+	sol::state lua;
+	LuaBytecodeCache cache;
+	writeScript("test_bytecode.lua", "return 1");
+	execute(cache, lua, "test_bytecode.lua");
+	// Act.
+	writeScript("test_bytecode.lua", "return 2");
+	int result = execute(cache, lua, "test_bytecode.lua");
+	// Assert.
+	REQUIRE(result == 2);
+	REQUIRE(cache.getSize() == 1);
+
+	std::remove("test_bytecode.lua");
+}
+
+/**********************************************************/
+TEST_CASE("LuaBytecodeCache: Disabled caches compile every script.", "[LuaBytecodeCache]")
+{
+	// Arrange.
+	sol::state lua;
+	LuaBytecodeCache cache;
+	cache.setEnabled(false);
+	writeScript("test_bytecode.lua", "return 3");
+	// Act.
+	int result = execute(cache, lua, "test_bytecode.lua");
+	// Assert.
+	REQUIRE(result == 3);
+	REQUIRE(cache.getSize() == 0);
+
+	std::remove("test_bytecode.lua");
+}
+
+/**********************************************************/
+TEST_CASE("LuaBytecodeCache: Missing scripts report an error.", "[LuaBytecodeCache]")
+{
+	// Arrange.
+	sol::state lua;
+	LuaBytecodeCache cache;
+	// Act.
+	sol::load_result chunk = cache.load(lua, "garbage");
+	// Assert.
+	REQUIRE(!chunk.valid());
+}
+
+/**********************************************************/
+TEST_CASE("LuaBytecodeCache: Chunks are loaded from the cache directory by later runs.", "[LuaBytecodeCache]")
+{
+	// Arrange.
+	sol::state lua;
+	LuaBytecodeCache first;
+	first.setDirectory(".");
+	writeScript("test_bytecode.lua", "return 4");
+	execute(first, lua, "test_bytecode.lua");
+	LuaBytecodeCache second;
+	second.setDirectory(".");
+	// Act.
+	writeScript("test_bytecode.lua", "return 5");
+	execute(first, lua, "test_bytecode.lua");
+	int result = execute(second, lua, "test_bytecode.lua");
+	// Assert.
+	REQUIRE(result == 5);
+	REQUIRE(second.getSize() == 1);
+
+	std::remove("test_bytecode.lua");
+	std::remove(getChunkPath("test_bytecode.lua").c_str());
+}
+
+/**********************************************************/
+TEST_CASE("LuaBytecodeCache: Truncated and corrupted chunks are compiled again.", "[LuaBytecodeCache]")
+{
+	// Arrange.
+	sol::state lua;
+	LuaBytecodeCache first;
+	first.setDirectory(".");
+	writeScript("test_bytecode.lua", "return 6");
+	execute(first, lua, "test_bytecode.lua");
+	std::ifstream input(getChunkPath("test_bytecode.lua"), std::ios::in | std::ios::binary);
+	std::string chunk((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+	input.close();
+	REQUIRE(chunk.size() > 1);
+	// Act.
+	std::string corrupted = chunk;
+	corrupted.back() ^= 0x7F;
+	writeScript(getChunkPath("test_bytecode.lua"), corrupted);
+	LuaBytecodeCache second;
+	second.setDirectory(".");
+	int corruptedResult = execute(second, lua, "test_bytecode.lua");
+	writeScript(getChunkPath("test_bytecode.lua"), chunk.substr(0, chunk.size() - 1));
+	LuaBytecodeCache third;
+	third.setDirectory(".");
+	int truncatedResult = execute(third, lua, "test_bytecode.lua");
+	// Assert.
+	REQUIRE(corruptedResult == 6);
+	REQUIRE(truncatedResult == 6);
+
+	std::remove("test_bytecode.lua");
+	std::remove(getChunkPath("test_bytecode.lua").c_str());
+}
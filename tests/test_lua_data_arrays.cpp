@@ -0,0 +1,115 @@
+/*
+* Pegasus Engine
+* 2017 - Benjamin Carter (bencarterdev@outlook.com)
+*
+* This software is provided 'as-is', without any express or implied warranty.
+* In no event will the authors be held liable for any damages arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it freely,
+* subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented;
+*    you must not claim that you wrote the original software.
+*    If you use this software in a product, an acknowledgement
+*    in the product documentation would be appreciated but is not required.
+*
+* 2. Altered source versions must be plainly marked as such,
+*    and must not be misrepresented as being the original software.
+*
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+//====================
+// C++ includes
+//====================
+#include <vector> // The arrays exposed to lua.
+
+//====================
+// Pegasus includes
+//====================
+#include <pegasus/scripting/lua_data_arrays.hpp> // Testing the LuaDataArrays class.
+
+//====================
+// Library includes
+//====================
+#include <catch.hpp> // Unit test library.
+
+using namespace pegasus;
+
+namespace
+{
+	//====================
+	// Structures
+	//====================
+	/** A simple element type exposed to lua. */
+	struct Position_t
+	{
+		float x;
+		float y;
+	};
+
+	//====================
+	// Functions
+	//====================
+	/**********************************************************/
+	void bindPosition(sol::state& lua, LuaDataArrays& arrays)
+	{
+		lua.new_usertype<Position_t>("Position", "x", &Position_t::x, "y", &Position_t::y);
+		arrays.declare("typedef struct { float x, y; } Position;");
+	}
+} // namespace
+
+//====================
+// Unit tests
+//====================
+/**********************************************************/
+TEST_CASE("LuaDataArrays: Scripts update the elements of exposed arrays in place.", "[LuaDataArrays]")
+{
+	// Arrange.
+	sol::state lua;
+	lua.open_libraries(sol::lib::base, sol::lib::ffi);
+	LuaDataArrays arrays(lua);
+	bindPosition(lua, arrays);
+	std::vector<Position_t> positions(16, Position_t{ 1.0f, 2.0f });
+	arrays.expose("positions", "Position", positions.data(), positions.size());
+	// Act.
+	lua.script("local p = arrays.positions for i = 0, p.count - 1 do p.data[i].x = p.data[i].x + i end");
+	// Assert.
+	REQUIRE(positions[0].x == Approx(1.0f));
+	REQUIRE(positions[15].x == Approx(16.0f));
+	REQUIRE(positions[15].y == Approx(2.0f));
+}
+
+/**********************************************************/
+TEST_CASE("LuaDataArrays: Exposing an array again updates its count.", "[LuaDataArrays]")
+{
+	// Arrange.
+	sol::state lua;
+	lua.open_libraries(sol::lib::base, sol::lib::ffi);
+	LuaDataArrays arrays(lua);
+	bindPosition(lua, arrays);
+	std::vector<Position_t> positions(4, Position_t{ 0.0f, 0.0f });
+	arrays.expose("positions", "Position", positions.data(), positions.size());
+	// Act.
+	positions.resize(32);
+	arrays.expose("positions", "Position", positions.data(), positions.size());
+	// Assert.
+	REQUIRE(lua.script("return arrays.positions.count").get<std::size_t>() == 32);
+}
+
+/**********************************************************/
+TEST_CASE("LuaDataArrays: Removed arrays are no longer accessible.", "[LuaDataArrays]")
+{
+	// Arrange.
+	sol::state lua;
+	lua.open_libraries(sol::lib::base, sol::lib::ffi);
+	LuaDataArrays arrays(lua);
+	bindPosition(lua, arrays);
+	std::vector<Position_t> positions(4, Position_t{ 0.0f, 0.0f });
+	arrays.expose("positions", "Position", positions.data(), positions.size());
+	// Act.
+	arrays.remove("positions");
+	// Assert.
+	REQUIRE(lua.script("return arrays.positions == nil").get<bool>());
+}
@@ -0,0 +1,196 @@
+/*
+* Pegasus Engine
+* 2017 - Benjamin Carter (bencarterdev@outlook.com)
+*
+* This software is provided 'as-is', without any express or implied warranty.
+* In no event will the authors be held liable for any damages arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it freely,
+* subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented;
+*    you must not claim that you wrote the original software.
+*    If you use this software in a product, an acknowledgement
+*    in the product documentation would be appreciated but is not required.
+*
+* 2. Altered source versions must be plainly marked as such,
+*    and must not be misrepresented as being the original software.
+*
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+#if !defined(PEGASUS_LUAJIT)
+//====================
+// C++ includes
+//====================
+#include <chrono> // The budget of each frame.
+
+//====================
+// Pegasus includes
+//====================
+#include <pegasus/scripting/lua_garbage_collector.hpp> // Testing the LuaGarbageCollector class.
+#include <pegasus/scripting/lua_allocator.hpp>         // Measuring the memory of the state.
+
+//====================
+// Library includes
+//====================
+#include <catch.hpp> // Unit test library.
+
+using namespace pegasus;
+
+namespace
+{
+	//====================
+	// Functions
+	//====================
+	/**********************************************************/
+	void createGarbage(sol::state& state)
+	{
+		state.script("local garbage = {} for i = 1, 1000 do garbage[i] = string.rep('x', 64) .. i end");
+	}
+} // namespace
+
+//====================
+// Unit tests
+//====================
+/**********************************************************/
+TEST_CASE("LuaGarbageCollector: Zero budgets leave lua collecting automatically.", "[LuaGarbageCollector]")
+{
+	// Arrange.
+	LuaAllocator allocator;
+	sol::state state(sol::default_at_panic, &LuaAllocator::luaAlloc, &allocator);
+	state.open_libraries(sol::lib::base, sol::lib::string);
+	LuaGarbageCollector collector(state, allocator);
+	createGarbage(state);
+	// Act.
+	collector.step();
+	// Assert.
+	REQUIRE(collector.getBudget().count() == 0);
+	REQUIRE(collector.getFrameSteps() == 0);
+}
+
+/**********************************************************/
+TEST_CASE("LuaGarbageCollector: Steps are sized by the bytes allocated during the frame.", "[LuaGarbageCollector]")
+{
+	// Arrange.
+	int minimum = LuaGarbageCollector::MIN_STEP_SIZE;
+	int maximum = LuaGarbageCollector::MAX_STEP_SIZE;
+	LuaAllocator allocator;
+	sol::state state(sol::default_at_panic, &LuaAllocator::luaAlloc, &allocator);
+	state.open_libraries(sol::lib::base, sol::lib::string);
+	LuaGarbageCollector collector(state, allocator);
+	collector.setBudget(std::chrono::microseconds(1000));
+	createGarbage(state);
+	std::size_t frameBytes = allocator.getStatistics().frameBytes;
+	// Act.
+	collector.step();
+	// Assert.
+	REQUIRE(collector.getBudget().count() == 1000);
+	REQUIRE(collector.getFrameSteps() >= 1);
+	REQUIRE(collector.getStepSize() >= minimum);
+	REQUIRE(collector.getStepSize() <= maximum);
+	REQUIRE(collector.getStepSize() >= static_cast<int>(std::min<std::size_t>(frameBytes / 1024, maximum)));
+}
+
+/**********************************************************/
+TEST_CASE("LuaGarbageCollector: Nothing is collected once the cycle has finished and nothing was allocated.", "[LuaGarbageCollector]")
+{
+	// Arrange.
+	LuaAllocator allocator;
+	sol::state state(sol::default_at_panic, &LuaAllocator::luaAlloc, &allocator);
+	state.open_libraries(sol::lib::base, sol::lib::string);
+	LuaGarbageCollector collector(state, allocator);
+	collector.setBudget(std::chrono::hours(1));
+	createGarbage(state);
+	// The budget is large enough for the cycle to finish within the first frame.
+	collector.step();
+	allocator.endFrame();
+	// Act.
+	collector.step();
+	// Assert.
+	REQUIRE(collector.getFrameSteps() == 0);
+}
+
+/**********************************************************/
+TEST_CASE("LuaGarbageCollector: A full collection is run once the live bytes near the limit.", "[LuaGarbageCollector]")
+{
+	// Arrange.
+	const std::size_t limit = 4 * 1024 * 1024;
+	LuaAllocator allocator(limit);
+	sol::state state(sol::default_at_panic, &LuaAllocator::luaAlloc, &allocator);
+	state.open_libraries(sol::lib::base, sol::lib::string);
+	LuaGarbageCollector collector(state, allocator);
+	collector.setBudget(std::chrono::microseconds(1));
+	// The automatic collector is stopped, so the garbage accumulates until the high water mark.
+	while (allocator.getStatistics().liveBytes * 100 < limit * 75)
+	{
+		createGarbage(state);
+	}
+	std::size_t liveBytes = allocator.getStatistics().liveBytes;
+	// Act.
+	collector.step();
+	// Assert.
+	REQUIRE(allocator.getStatistics().failedAllocations == 0);
+	REQUIRE(collector.getFrameSteps() == 1);
+	REQUIRE(allocator.getStatistics().liveBytes < liveBytes / 2);
+	REQUIRE(collector.getFullCollectionCount() == 1);
+}
+
+/**********************************************************/
+TEST_CASE("LuaGarbageCollector: A live working set near the limit is not fully collected every frame.", "[LuaGarbageCollector]")
+{
+	// Arrange.
+	const std::size_t limit = 4 * 1024 * 1024;
+	LuaAllocator allocator(limit);
+	sol::state state(sol::default_at_panic, &LuaAllocator::luaAlloc, &allocator);
+	state.open_libraries(sol::lib::base, sol::lib::string);
+	LuaGarbageCollector collector(state, allocator);
+	// The strings are kept alive, so a full collection cannot bring the state below the high water mark.
+	state.script("kept = {}");
+	state.collect_garbage();
+	while (allocator.getStatistics().liveBytes * 100 < limit * 75)
+	{
+		state.script("for i = 1, 1000 do kept[#kept + 1] = string.rep('x', 64) .. #kept end");
+		state.collect_garbage();
+	}
+	collector.setBudget(std::chrono::microseconds(1));
+	collector.step();
+	allocator.endFrame();
+	// Act.
+	state.script("local garbage = string.rep('x', 1024)");
+	collector.step();
+	// Assert.
+	REQUIRE(allocator.getStatistics().liveBytes * 100 >= limit * 75);
+	REQUIRE(collector.getFullCollectionCount() == 1);
+	REQUIRE(collector.getFrameSteps() >= 1);
+}
+
+/**********************************************************/
+TEST_CASE("LuaGarbageCollector: Nothing is collected outside of step.", "[LuaGarbageCollector]")
+{
+	// Arrange.
+	LuaAllocator allocator;
+	sol::state state(sol::default_at_panic, &LuaAllocator::luaAlloc, &allocator);
+	state.open_libraries(sol::lib::base, sol::lib::string);
+	LuaGarbageCollector collector(state, allocator);
+	collector.setBudget(std::chrono::microseconds(1));
+	createGarbage(state);
+	// Stepping resets the collection threshold within lua.
+	collector.step();
+	// Act.
+	state.script("local proxy = newproxy(true) getmetatable(proxy).__gc = function() collected = true end");
+	for (int i = 0; i < 200; i++)
+	{
+		createGarbage(state);
+	}
+	bool collectedOutside = state["collected"].valid();
+	// Finish the cycle in progress and the next, which must collect the proxy.
+	collector.setBudget(std::chrono::hours(1));
+	collector.step();
+	collector.step();
+	// Assert.
+	REQUIRE_FALSE(collectedOutside);
+	REQUIRE(state["collected"].valid());
+}
+#endif//!PEGASUS_LUAJIT
@@ -0,0 +1,137 @@
+/*
+* Pegasus Engine
+* 2017 - Benjamin Carter (bencarterdev@outlook.com)
+*
+* This software is provided 'as-is', without any express or implied warranty.
+* In no event will the authors be held liable for any damages arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it freely,
+* subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented;
+*    you must not claim that you wrote the original software.
+*    If you use this software in a product, an acknowledgement
+*    in the product documentation would be appreciated but is not required.
+*
+* 2. Altered source versions must be plainly marked as such,
+*    and must not be misrepresented as being the original software.
+*
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+#if !defined(PEGASUS_LUAJIT)
+//====================
+// Pegasus includes
+//====================
+#include <pegasus/scripting/lua_profiler.hpp> // Testing the LuaProfiler class.
+
+//====================
+// Library includes
+//====================
+#include <catch.hpp> // Unit test library.
+
+using namespace pegasus;
+
+namespace
+{
+	//====================
+	// Variables
+	//====================
+	/** A script that triggers a sample from within a named function. */
+	const char* SAMPLED_SCRIPT =
+		"function spin() sample() local total = 0 for i = 1, 10 do total = total + i end return total end\n"
+		"spin()";
+} // namespace
+
+//====================
+// Unit tests
+//====================
+/**********************************************************/
+TEST_CASE("LuaProfiler: Triggered profilers sample the call stack.", "[LuaProfiler]")
+{
+	// Arrange.
+	sol::state lua;
+	lua.open_libraries(sol::lib::base);
+	LuaProfiler profiler(lua, 1024);
+	lua.set_function("sample", [&profiler]() { profiler.trigger(); });
+	// Act.
+	profiler.start(0);
+	lua.script(SAMPLED_SCRIPT);
+	profiler.stop();
+	// Assert.
+	REQUIRE(!profiler.isRunning());
+	REQUIRE(profiler.getSampleCount() == 1);
+	REQUIRE(profiler.getFoldedStacks().find("spin@") != std::string::npos);
+	REQUIRE(profiler.getFoldedStacks().find(" 1\n") != std::string::npos);
+}
+
+/**********************************************************/
+TEST_CASE("LuaProfiler: Each trigger records a single sample.", "[LuaProfiler]")
+{
+	// Arrange.
+	sol::state lua;
+	lua.open_libraries(sol::lib::base);
+	LuaProfiler profiler(lua, 2);
+	lua.set_function("sample", [&profiler]() { profiler.trigger(); });
+	profiler.start(0);
+	// Act.
+	lua.script("for i = 1, 3 do sample() end");
+	profiler.stop();
+	std::string stacks = profiler.getFoldedStacks();
+	// Assert.
+	REQUIRE(profiler.getSampleCount() == 3);
+	REQUIRE(stacks.find("main@") == 0);
+	REQUIRE(stacks.find(" 2\n") == stacks.size() - 3);
+}
+
+/**********************************************************/
+TEST_CASE("LuaProfiler: Stopped profilers record nothing.", "[LuaProfiler]")
+{
+	// Arrange.
+	sol::state lua;
+	lua.open_libraries(sol::lib::base);
+	LuaProfiler profiler(lua, 1024);
+	lua.set_function("sample", [&profiler]() { profiler.trigger(); });
+	// Act.
+	lua.script(SAMPLED_SCRIPT);
+	// Assert.
+	REQUIRE(!profiler.isRunning());
+	REQUIRE(profiler.getSampleCount() == 0);
+	REQUIRE(profiler.getFoldedStacks().empty());
+}
+
+/**********************************************************/
+TEST_CASE("LuaProfiler: Cleared profilers discard their samples.", "[LuaProfiler]")
+{
+	// Arrange.
+	sol::state lua;
+	lua.open_libraries(sol::lib::base);
+	LuaProfiler profiler(lua, 1024);
+	lua.set_function("sample", [&profiler]() { profiler.trigger(); });
+	profiler.start(0);
+	lua.script(SAMPLED_SCRIPT);
+	// Act.
+	profiler.clear();
+	profiler.stop();
+	// Assert.
+	REQUIRE(profiler.getSampleCount() == 0);
+	REQUIRE(profiler.getFoldedStacks().empty());
+}
+
+/**********************************************************/
+TEST_CASE("LuaProfiler: Timed profilers start and stop their timer.", "[LuaProfiler]")
+{
+	// Arrange.
+	sol::state lua;
+	lua.open_libraries(sol::lib::base);
+	LuaProfiler profiler(lua, 1024);
+	// Act.
+	profiler.start(1000);
+	bool running = profiler.isRunning();
+	profiler.stop();
+	// Assert.
+	REQUIRE(running);
+	REQUIRE(!profiler.isRunning());
+}
+#endif//!PEGASUS_LUAJIT
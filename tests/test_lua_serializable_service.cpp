@@ -20,11 +20,18 @@
 * 3. This notice may not be removed or altered from any source distribution.
 */
 
+//====================
+// C++ includes
+//====================
+#include <cstdio>  // Removing the generated scripts.
+#include <fstream> // Writing the generated scripts.
+
 //====================
 // Pegasus includes
 //====================
 #include <pegasus/utilities/lua_serializable_service.hpp> // Testing the LuaSerializableService class.
 #include <pegasus/utilities/exceptions/no_resource_exception.hpp> // Testing for correct exceptions being thrown.
+#include <pegasus/scripting/scripting_manager.hpp> // The lua state used by the service.
 
 //====================
 // Library includes
@@ -33,6 +40,19 @@
 
 using namespace pegasus;
 
+namespace
+{
+	//====================
+	// Functions
+	//====================
+	/**********************************************************/
+	void writeScript(const std::string& filename, const std::string& source)
+	{
+		std::ofstream file(filename, std::ios::out | std::ios::trunc);
+		file << source;
+	}
+} // namespace
+
 //====================
 // Unit tests
 //====================
@@ -40,7 +60,8 @@ using namespace pegasus;
 TEST_CASE("LuaSerializableService: Load Rsources.lua valid file.", "[LuaSerializableService]")
 {
 	// Arrange.
-	LuaSerializableService service;
+	ScriptingManager scripting;
+	LuaSerializableService service(scripting);
 	// Act.
 	auto values = service.deserializeResources("Resources.lua");
 	// Assert.
@@ -51,7 +72,77 @@ TEST_CASE("LuaSerializableService: Load Rsources.lua valid file.", "[LuaSerializ
 TEST_CASE("LuaSerializableService: Load Resources.lua invalid file.", "[LuaSerializableService]")
 {
 	// Arrange.
-	LuaSerializableService service;
+	ScriptingManager scripting;
+	LuaSerializableService service(scripting);
 	// Assert.
 	REQUIRE_THROWS_AS(service.deserializeResources("garbage"), NoResourceException);
-}
\ No newline at end of file
+}
+
+/**********************************************************/
+TEST_CASE("LuaSerializableService: Shader programs declare their uniforms.", "[LuaSerializableService]")
+{
+	// Arrange.
+	ScriptingManager scripting;
+	LuaSerializableService service(scripting);
+	// Act.
+	auto description = service.parseShaderProgram("assets/shaders/basic_shader.lua");
+	// Assert.
+	REQUIRE(description);
+	const auto& uniforms = description.getValue().uniforms;
+	REQUIRE(uniforms.size() == 3);
+	REQUIRE(uniforms[0].name == "u_texture");
+	REQUIRE(uniforms[0].frequency == eUniformFrequency::CONSTANT);
+	REQUIRE(uniforms[0].value.size() == 1);
+	REQUIRE(uniforms[1].frequency == eUniformFrequency::FRAME);
+	REQUIRE(uniforms[1].value.empty());
+	REQUIRE(uniforms[2].frequency == eUniformFrequency::MATERIAL);
+}
+
+/**********************************************************/
+TEST_CASE("LuaSerializableService: Shader programs declare their permutation options.", "[LuaSerializableService]")
+{
+	// Arrange.
+	ScriptingManager scripting;
+	LuaSerializableService service(scripting);
+	// Act.
+	auto description = service.parseShaderProgram("assets/shaders/basic_shader.lua");
+	// Assert.
+	REQUIRE(description);
+	REQUIRE(description.getValue().permutations.size() == 1);
+	REQUIRE(description.getValue().permutations[0] == "ALPHA_TEST");
+}
+
+/**********************************************************/
+TEST_CASE("LuaSerializableService: Shaders without a valid type are rejected.", "[LuaSerializableService]")
+{
+	// Arrange.
+	ScriptingManager scripting;
+	LuaSerializableService service(scripting);
+	writeScript("test_shader_type.lua", "ShaderProgram = { shaders = { { source = \"shader.glsl\", shader_type = ShaderType.Vertx } } }");
+	// Act.
+	auto description = service.parseShaderProgram("test_shader_type.lua");
+	std::remove("test_shader_type.lua");
+	// Assert.
+	REQUIRE_FALSE(description);
+	REQUIRE(description.getError().code == eErrorCode::INVALID_FORMAT);
+}
+
+/**********************************************************/
+TEST_CASE("LuaSerializableService: Textures with a missing or misspelled enum are rejected.", "[LuaSerializableService]")
+{
+	// Arrange.
+	ScriptingManager scripting;
+	LuaSerializableService service(scripting);
+	writeScript("test_texture_filter.lua", "Texture = { texture_type = TextureType.Texture2D, source = \"image.png\", wrap_mode = WrapType.Clamp, filter = FilterType.Lineer }");
+	writeScript("test_texture_wrap.lua", "Texture = { texture_type = TextureType.Texture2D, source = \"image.png\", filter = FilterType.Linear }");
+	// Act.
+	auto filter = service.parseTexture("test_texture_filter.lua");
+	auto wrap = service.parseTexture("test_texture_wrap.lua");
+	std::remove("test_texture_filter.lua");
+	std::remove("test_texture_wrap.lua");
+	// Assert.
+	REQUIRE_FALSE(filter);
+	REQUIRE(filter.getError().code == eErrorCode::INVALID_FORMAT);
+	REQUIRE_FALSE(wrap);
+	REQUIRE(wrap.getError().code == eErrorCode::INVALID_FORMAT);
+}
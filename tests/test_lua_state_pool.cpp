@@ -0,0 +1,114 @@
+/*
+* Pegasus Engine
+* 2017 - Benjamin Carter (bencarterdev@outlook.com)
+*
+* This software is provided 'as-is', without any express or implied warranty.
+* In no event will the authors be held liable for any damages arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it freely,
+* subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented;
+*    you must not claim that you wrote the original software.
+*    If you use this software in a product, an acknowledgement
+*    in the product documentation would be appreciated but is not required.
+*
+* 2. Altered source versions must be plainly marked as such,
+*    and must not be misrepresented as being the original software.
+*
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+//====================
+// C++ includes
+//====================
+#include <set>    // Collecting the leased states.
+#include <thread> // Leasing states from multiple threads.
+#include <vector> // Storing the leases.
+
+//====================
+// Pegasus includes
+//====================
+#include <pegasus/scripting/lua_state_pool.hpp> // Testing the LuaStatePool class.
+
+//====================
+// Library includes
+//====================
+#include <catch.hpp> // Unit test library.
+
+using namespace pegasus;
+
+//====================
+// Unit tests
+//====================
+/**********************************************************/
+TEST_CASE("LuaStatePool: Each new state is initialised.", "[LuaStatePool]")
+{
+	// Arrange.
+	LuaStatePool pool([](sol::state& state) { state["initialised"] = true; }, 2);
+	// Act.
+	auto first = pool.acquire();
+	auto second = pool.acquire();
+	// Assert.
+	REQUIRE(pool.getSize() == 2);
+	REQUIRE(&first.getState() != &second.getState());
+	REQUIRE(first.getState().get<bool>("initialised"));
+	REQUIRE(second.getState().get<bool>("initialised"));
+}
+
+/**********************************************************/
+TEST_CASE("LuaStatePool: Reserving never shrinks the pool.", "[LuaStatePool]")
+{
+	// Arrange.
+	LuaStatePool pool([](sol::state&) {}, 3);
+	// Act.
+	pool.reserve(1);
+	// Assert.
+	REQUIRE(pool.getSize() == 3);
+}
+
+/**********************************************************/
+TEST_CASE("LuaStatePool: Returned states are leased again.", "[LuaStatePool]")
+{
+	// Arrange.
+	LuaStatePool pool([](sol::state&) {}, 1);
+	sol::state* pState = nullptr;
+	{
+		auto lease = pool.acquire();
+		pState = &lease.getState();
+	}
+	// Act.
+	auto lease = pool.acquire();
+	// Assert.
+	REQUIRE(&lease.getState() == pState);
+}
+
+/**********************************************************/
+TEST_CASE("LuaStatePool: Threads block until a state is returned.", "[LuaStatePool]")
+{
+	// Arrange.
+	LuaStatePool pool([](sol::state&) {}, 2);
+	std::vector<std::thread> threads;
+	std::vector<int> results(8, 0);
+	// Act.
+	for (std::size_t i = 0; i < results.size(); i++)
+	{
+		threads.emplace_back([&pool, &results, i]()
+		{
+			auto lease = pool.acquire();
+			results[i] = lease.getState().script("return 1 + 1");
+		});
+	}
+
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+	// Assert.
+	for (int result : results)
+	{
+		REQUIRE(result == 2);
+	}
+	REQUIRE(pool.getSize() == 2);
+}
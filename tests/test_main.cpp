@@ -1,2 +1,13 @@
-#define CATCH_CONFIG_MAIN
-#include <catch.hpp>
\ No newline at end of file
+#define CATCH_CONFIG_RUNNER
+#include <catch.hpp>
+
+#include <pegasus/utilities/logger_factory.hpp>
+#include <pegasus/utilities/file_policy.hpp>
+
+int main(int argc, char* argv[])
+{
+	// The services and factories log through the file logger, which is otherwise registered by the application.
+	pegasus::LoggerFactory::registerLogger("file.logger", std::make_unique<pegasus::Logger>(std::make_unique<pegasus::FilePolicy>("test_messages.log")));
+
+	return Catch::Session().run(argc, argv);
+}
@@ -0,0 +1,232 @@
+/*
+* Pegasus Engine
+* 2017 - Benjamin Carter (bencarterdev@outlook.com)
+*
+* This software is provided 'as-is', without any express or implied warranty.
+* In no event will the authors be held liable for any damages arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it freely,
+* subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented;
+*    you must not claim that you wrote the original software.
+*    If you use this software in a product, an acknowledgement
+*    in the product documentation would be appreciated but is not required.
+*
+* 2. Altered source versions must be plainly marked as such,
+*    and must not be misrepresented as being the original software.
+*
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+//====================
+// C++ includes
+//====================
+#include <cstdio>   // Removing the generated binaries.
+#include <cstring>  // Patching the headers of the binaries.
+#include <fstream>  // Reading and writing the binary files.
+#include <iterator> // Reading the binary files.
+#include <string>   // The file locations of the binaries.
+#include <thread>   // Checking that each thread has its own cache.
+#include <vector>   // The contents of the binaries.
+
+//====================
+// Pegasus includes
+//====================
+#include <pegasus/graphics/program_binary_cache.hpp> // Testing the ProgramBinaryCache class.
+
+//====================
+// Library includes
+//====================
+#include <catch.hpp> // Unit test library.
+
+using namespace pegasus;
+
+namespace
+{
+	//====================
+	// Variables
+	//====================
+	/** The file location of the generated binary. */
+	const char* BINARY_FILE = "test_program_binary.bin";
+	/** The key of the generated binary. */
+	const std::uint64_t KEY = 0x1234;
+	/** The driver of the generated binary. */
+	const std::uint64_t DRIVER = 0x5678;
+	/** The format of the generated binary. */
+	const GLenum FORMAT = 0x8741;
+	/** The offset of the version within the header. */
+	const std::size_t VERSION_OFFSET = 4;
+	/** The offset of the length within the header. */
+	const std::size_t LENGTH_OFFSET = 36;
+	/** The size of the header. */
+	const std::size_t HEADER_SIZE = 40;
+
+	//====================
+	// Functions
+	//====================
+	/**********************************************************/
+	std::vector<char> writeBinary()
+	{
+		std::vector<char> binary = { 'b', 'i', 'n', 'a', 'r', 'y' };
+		REQUIRE(ProgramBinaryCache::writeBinary(BINARY_FILE, KEY, DRIVER, FORMAT, binary.data(), binary.size()));
+
+		return binary;
+	}
+
+	/**********************************************************/
+	std::vector<char> readFile()
+	{
+		std::ifstream file(BINARY_FILE, std::ios::in | std::ios::binary);
+		return std::vector<char>((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+	}
+
+	/**********************************************************/
+	void writeFile(const std::vector<char>& data)
+	{
+		std::ofstream file(BINARY_FILE, std::ios::out | std::ios::binary | std::ios::trunc);
+		file.write(data.data(), data.size());
+	}
+
+	/**********************************************************/
+	ProgramBinaryCache::eBinaryStatus readBinary(std::uint64_t key = KEY, std::uint64_t driver = DRIVER)
+	{
+		GLenum format = GL_NONE;
+		std::vector<char> binary;
+		return ProgramBinaryCache::readBinary(BINARY_FILE, key, driver, format, binary);
+	}
+} // namespace
+
+//====================
+// Unit tests
+//====================
+/**********************************************************/
+TEST_CASE("ProgramBinaryCache: Written binaries are read back.", "[ProgramBinaryCache]")
+{
+	// Arrange.
+	std::vector<char> written = writeBinary();
+	GLenum format = GL_NONE;
+	std::vector<char> binary;
+	// Act.
+	ProgramBinaryCache::eBinaryStatus status = ProgramBinaryCache::readBinary(BINARY_FILE, KEY, DRIVER, format, binary);
+	// Assert.
+	REQUIRE(status == ProgramBinaryCache::eBinaryStatus::VALID);
+	REQUIRE(format == FORMAT);
+	REQUIRE(binary == written);
+	REQUIRE(readFile().size() == HEADER_SIZE + written.size());
+	std::remove(BINARY_FILE);
+}
+
+/**********************************************************/
+TEST_CASE("ProgramBinaryCache: Missing binaries are reported as missing.", "[ProgramBinaryCache]")
+{
+	// Arrange.
+	std::remove(BINARY_FILE);
+	// Act.
+	ProgramBinaryCache::eBinaryStatus status = readBinary();
+	// Assert.
+	REQUIRE(status == ProgramBinaryCache::eBinaryStatus::MISSING);
+}
+
+/**********************************************************/
+TEST_CASE("ProgramBinaryCache: Binaries of another program or driver are invalid.", "[ProgramBinaryCache]")
+{
+	// Arrange.
+	writeBinary();
+	// Act.
+	ProgramBinaryCache::eBinaryStatus otherKey = readBinary(KEY + 1, DRIVER);
+	ProgramBinaryCache::eBinaryStatus otherDriver = readBinary(KEY, DRIVER + 1);
+	// Assert.
+	REQUIRE(otherKey == ProgramBinaryCache::eBinaryStatus::INVALID);
+	REQUIRE(otherDriver == ProgramBinaryCache::eBinaryStatus::INVALID);
+	std::remove(BINARY_FILE);
+}
+
+/**********************************************************/
+TEST_CASE("ProgramBinaryCache: Binaries with a corrupt header are invalid.", "[ProgramBinaryCache]")
+{
+	// Arrange.
+	writeBinary();
+	std::vector<char> data = readFile();
+	std::uint32_t version = ProgramBinaryCache::VERSION + 1;
+	std::uint32_t length = 0;
+	std::memcpy(&length, &data[LENGTH_OFFSET], sizeof(length));
+	length++;
+	// Act.
+	std::vector<char> magic = data;
+	magic[0] = 'X';
+	writeFile(magic);
+	ProgramBinaryCache::eBinaryStatus magicStatus = readBinary();
+
+	std::vector<char> versioned = data;
+	std::memcpy(&versioned[VERSION_OFFSET], &version, sizeof(version));
+	writeFile(versioned);
+	ProgramBinaryCache::eBinaryStatus versionStatus = readBinary();
+
+	std::vector<char> lengthened = data;
+	std::memcpy(&lengthened[LENGTH_OFFSET], &length, sizeof(length));
+	writeFile(lengthened);
+	ProgramBinaryCache::eBinaryStatus lengthStatus = readBinary();
+	// Assert.
+	REQUIRE(magicStatus == ProgramBinaryCache::eBinaryStatus::INVALID);
+	REQUIRE(versionStatus == ProgramBinaryCache::eBinaryStatus::INVALID);
+	REQUIRE(lengthStatus == ProgramBinaryCache::eBinaryStatus::INVALID);
+	std::remove(BINARY_FILE);
+}
+
+/**********************************************************/
+TEST_CASE("ProgramBinaryCache: Corrupted binaries fail their checksum.", "[ProgramBinaryCache]")
+{
+	// Arrange.
+	writeBinary();
+	std::vector<char> data = readFile();
+	data.back() ^= 0x1;
+	writeFile(data);
+	// Act.
+	ProgramBinaryCache::eBinaryStatus status = readBinary();
+	// Assert.
+	REQUIRE(status == ProgramBinaryCache::eBinaryStatus::INVALID);
+	std::remove(BINARY_FILE);
+}
+
+/**********************************************************/
+TEST_CASE("ProgramBinaryCache: Truncated binaries are invalid.", "[ProgramBinaryCache]")
+{
+	// Arrange.
+	writeBinary();
+	std::vector<char> data = readFile();
+	// Act.
+	writeFile(std::vector<char>(data.begin(), data.end() - 1));
+	ProgramBinaryCache::eBinaryStatus binaryStatus = readBinary();
+	writeFile(std::vector<char>(data.begin(), data.begin() + HEADER_SIZE / 2));
+	ProgramBinaryCache::eBinaryStatus headerStatus = readBinary();
+	writeFile(std::vector<char>());
+	ProgramBinaryCache::eBinaryStatus emptyStatus = readBinary();
+	// Assert.
+	REQUIRE(binaryStatus == ProgramBinaryCache::eBinaryStatus::INVALID);
+	REQUIRE(headerStatus == ProgramBinaryCache::eBinaryStatus::INVALID);
+	REQUIRE(emptyStatus == ProgramBinaryCache::eBinaryStatus::INVALID);
+	std::remove(BINARY_FILE);
+}
+
+/**********************************************************/
+TEST_CASE("ProgramBinaryCache: Each thread has its own cache.", "[ProgramBinaryCache]")
+{
+	// Arrange.
+	ProgramBinaryCache& cache = ProgramBinaryCache::getInstance();
+	cache.setEnabled(true);
+	ProgramBinaryCache* pOther = nullptr;
+	bool otherEnabled = true;
+	// Act.
+	std::thread thread([&]() {
+		// The thread has not enabled its cache, so its context is never queried.
+		pOther = &ProgramBinaryCache::getInstance();
+		otherEnabled = pOther->isEnabled();
+	});
+	thread.join();
+	cache.setEnabled(false);
+	// Assert.
+	REQUIRE(pOther != &cache);
+	REQUIRE_FALSE(otherEnabled);
+}
@@ -0,0 +1,103 @@
+/*
+* Pegasus Engine
+* 2017 - Benjamin Carter (bencarterdev@outlook.com)
+*
+* This software is provided 'as-is', without any express or implied warranty.
+* In no event will the authors be held liable for any damages arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it freely,
+* subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented;
+*    you must not claim that you wrote the original software.
+*    If you use this software in a product, an acknowledgement
+*    in the product documentation would be appreciated but is not required.
+*
+* 2. Altered source versions must be plainly marked as such,
+*    and must not be misrepresented as being the original software.
+*
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+//====================
+// C++ includes
+//====================
+#include <string> // The keys of the tree.
+#include <vector> // Comparing the enumerated keys.
+
+//====================
+// Pegasus includes
+//====================
+#include <pegasus/utilities/radix_tree.hpp> // Testing the RadixTree class.
+
+//====================
+// Library includes
+//====================
+#include <catch.hpp> // Unit test library.
+
+using namespace pegasus;
+
+//====================
+// Unit tests
+//====================
+/**********************************************************/
+TEST_CASE("RadixTree: Find inserted keys.", "[RadixTree]")
+{
+	// Arrange.
+	RadixTree<int> tree;
+	// Act.
+	tree.insert("asset.texture.basic", 1);
+	tree.insert("asset.texture.brick", 2);
+	tree.insert("asset.texture", 3);
+	tree.insert("asset.shader.basic", 4);
+	tree.insert("asset.texture.basic", 5);
+	// Assert.
+	REQUIRE(tree.getSize() == 4);
+	REQUIRE(*tree.find("asset.texture.basic") == 5);
+	REQUIRE(*tree.find("asset.texture.brick") == 2);
+	REQUIRE(*tree.find("asset.texture") == 3);
+	REQUIRE(*tree.find("asset.shader.basic") == 4);
+	REQUIRE(tree.find("asset.texture.b") == nullptr);
+	REQUIRE(tree.find("asset") == nullptr);
+	REQUIRE(tree.find("asset.texture.basics") == nullptr);
+}
+
+/**********************************************************/
+TEST_CASE("RadixTree: Enumerate keys by prefix in order.", "[RadixTree]")
+{
+	// Arrange.
+	RadixTree<int> tree;
+	tree.insert("level3.texture.wall", 0);
+	tree.insert("level3.shader.water", 0);
+	tree.insert("level30.texture.sky", 0);
+	tree.insert("level2.texture.wall", 0);
+	// Assert.
+	REQUIRE(tree.getKeys("level3.") == std::vector<std::string>({ "level3.shader.water", "level3.texture.wall" }));
+	REQUIRE(tree.getKeys("level3") == std::vector<std::string>({ "level3.shader.water", "level3.texture.wall", "level30.texture.sky" }));
+	REQUIRE(tree.getKeys("level3.tex") == std::vector<std::string>({ "level3.texture.wall" }));
+	REQUIRE(tree.getKeys("level4").empty());
+	REQUIRE(tree.getKeys("level3.texture.wall.normal").empty());
+	REQUIRE(tree.getKeys("").size() == 4);
+}
+
+/**********************************************************/
+TEST_CASE("RadixTree: Erase keys and keep the remaining keys.", "[RadixTree]")
+{
+	// Arrange.
+	RadixTree<int> tree;
+	tree.insert("asset.texture.basic", 1);
+	tree.insert("asset.texture.brick", 2);
+	tree.insert("asset.texture", 3);
+	// Act.
+	REQUIRE(tree.erase("asset.texture.basic"));
+	REQUIRE(tree.erase("asset.texture"));
+	REQUIRE_FALSE(tree.erase("asset.texture"));
+	REQUIRE_FALSE(tree.erase("asset"));
+	// Assert.
+	REQUIRE(tree.getSize() == 1);
+	REQUIRE(*tree.find("asset.texture.brick") == 2);
+	REQUIRE(tree.getKeys("asset.") == std::vector<std::string>({ "asset.texture.brick" }));
+	tree.insert("asset.texture.basic", 4);
+	REQUIRE(tree.getKeys("asset.texture.b") == std::vector<std::string>({ "asset.texture.basic", "asset.texture.brick" }));
+}
@@ -0,0 +1,190 @@
+/*
+* Pegasus Engine
+* 2017 - Benjamin Carter (bencarterdev@outlook.com)
+*
+* This software is provided 'as-is', without any express or implied warranty.
+* In no event will the authors be held liable for any damages arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it freely,
+* subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented;
+*    you must not claim that you wrote the original software.
+*    If you use this software in a product, an acknowledgement
+*    in the product documentation would be appreciated but is not required.
+*
+* 2. Altered source versions must be plainly marked as such,
+*    and must not be misrepresented as being the original software.
+*
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+//====================
+// C++ includes
+//====================
+#include <cstdio>    // Removing the cooked files.
+#include <stdexcept> // Testing for duplicate factories.
+
+//====================
+// Pegasus includes
+//====================
+#include <pegasus/core/resource_manager.hpp>                 // Testing the ResourceManager class.
+#include <pegasus/core/asset.hpp>                            // The assets created by the test factory.
+#include <pegasus/utilities/cooked_asset_writer.hpp>         // Writing the Resources files.
+#include <pegasus/utilities/binary_serializable_service.hpp> // Reading the Resources files.
+
+//====================
+// Library includes
+//====================
+#include <catch.hpp> // Unit test library.
+
+using namespace pegasus;
+
+namespace
+{
+	//====================
+	// Test classes
+	//====================
+	class TestAsset final : public Asset
+	{
+	public:
+		std::size_t getMemoryUsage() const override
+		{
+			return 64;
+		}
+	};
+
+	class TestService final : public ISerializableService
+	{
+	public:
+		Expected<Asset*> deserialize(eAssetType, const std::string&) const override
+		{
+			return new TestAsset();
+		}
+
+		std::unordered_map<std::string, Resource_t> deserializeResources(const std::string&) const override
+		{
+			return std::unordered_map<std::string, Resource_t>();
+		}
+	};
+
+	class TestFactory final : public IAssetFactory
+	{
+	public:
+		/** The type of asset the factory creates. */
+		typedef TestAsset AssetType;
+
+		/** The asset returned when a name fails to load. */
+		TestAsset defaultAsset;
+
+		explicit TestFactory(Resources& resources)
+			: IAssetFactory(resources, TypeID::get<TestAsset>(), eAssetType::TEXTURE)
+		{
+			// Empty.
+		}
+
+		TestAsset* load(const std::string& name) override
+		{
+			Asset* pAsset = this->loadAsset(name);
+			return pAsset ? static_cast<TestAsset*>(pAsset) : &defaultAsset;
+		}
+	};
+
+	//====================
+	// Functions
+	//====================
+	/**********************************************************/
+	void loadResources(Resources& resources, const std::string& filename)
+	{
+		std::unordered_map<std::string, Resource_t> values;
+		values["level3.texture.wall"] = { "assets/textures/wall.bin", eAssetType::TEXTURE };
+		values["level3.texture.floor"] = { "assets/textures/floor.bin", eAssetType::TEXTURE };
+		values["level3.shader.water"] = { "assets/shaders/water.bin", eAssetType::SHADER };
+		values["level4.texture.sky"] = { "assets/textures/sky.bin", eAssetType::TEXTURE };
+		REQUIRE(CookedAssetWriter::save(filename, CookedAssetWriter::cookResources(values)));
+		resources.load(filename);
+		std::remove(filename.c_str());
+	}
+
+} // namespace
+
+namespace pegasus
+{
+	//====================
+	// Traits
+	//====================
+	template <>
+	struct AssetFactoryTraits<TestAsset>
+	{
+		/** The factory that loads the test assets. */
+		typedef TestFactory Factory;
+	};
+
+} // namespace pegasus
+
+//====================
+// Unit tests
+//====================
+/**********************************************************/
+TEST_CASE("ResourceManager: Namespaces are loaded and unloaded as a whole.", "[ResourceManager]")
+{
+	// Arrange.
+	BinarySerializableService binary;
+	Resources resources;
+	resources.setService(binary);
+	loadResources(resources, "test_resource_manager_namespace.bin");
+	TestService service;
+	auto factory = std::make_unique<TestFactory>(resources);
+	factory->setService(service);
+	ResourceManager manager(resources);
+	manager.registerFactory(std::move(factory));
+	// Act.
+	std::size_t loaded = manager.load("level3.");
+	std::size_t reloaded = manager.load("level3.");
+	std::size_t usage = manager.getMemoryUsage("level3.");
+	std::size_t total = manager.getMemoryUsage("");
+	std::size_t unloaded = manager.unload("level3.");
+	// Assert.
+	REQUIRE(loaded == 2);
+	REQUIRE(reloaded == 0);
+	REQUIRE(usage == 128);
+	REQUIRE(total == 128);
+	REQUIRE(unloaded == 2);
+	REQUIRE(manager.getMemoryUsage("") == 0);
+}
+
+/**********************************************************/
+TEST_CASE("ResourceManager: Referenced assets survive their namespace being unloaded.", "[ResourceManager]")
+{
+	// Arrange.
+	BinarySerializableService binary;
+	Resources resources;
+	resources.setService(binary);
+	loadResources(resources, "test_resource_manager_referenced.bin");
+	TestService service;
+	auto factory = std::make_unique<TestFactory>(resources);
+	factory->setService(service);
+	ResourceManager manager(resources);
+	manager.registerFactory(std::move(factory));
+	manager.load("level3.");
+	// Act.
+	ResourceHandle<TestAsset> wall = manager.get<TestAsset>("level3.texture.wall");
+	std::size_t unloaded = manager.unload("level3.");
+	// Assert.
+	REQUIRE(unloaded == 1);
+	REQUIRE(manager.getMemoryUsage("level3.") == 64);
+	REQUIRE(manager.getMemoryUsage("level4.") == 0);
+}
+
+/**********************************************************/
+TEST_CASE("ResourceManager: Registering a duplicate factory throws an exception.", "[ResourceManager]")
+{
+	// Arrange.
+	Resources resources;
+	ResourceManager manager(resources);
+	manager.registerFactory<TestFactory>();
+	// Act & Assert.
+	REQUIRE_THROWS_AS(manager.registerFactory<TestFactory>(), std::runtime_error);
+	REQUIRE_THROWS_AS(manager.registerFactory(std::unique_ptr<TestFactory>()), std::runtime_error);
+}
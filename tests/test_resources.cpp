@@ -0,0 +1,230 @@
+/*
+* Pegasus Engine
+* 2017 - Benjamin Carter (bencarterdev@outlook.com)
+*
+* This software is provided 'as-is', without any express or implied warranty.
+* In no event will the authors be held liable for any damages arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it freely,
+* subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented;
+*    you must not claim that you wrote the original software.
+*    If you use this software in a product, an acknowledgement
+*    in the product documentation would be appreciated but is not required.
+*
+* 2. Altered source versions must be plainly marked as such,
+*    and must not be misrepresented as being the original software.
+*
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+//====================
+// C++ includes
+//====================
+#include <cstdio>  // Removing the cooked files.
+#include <string>  // Generating resource names.
+#include <vector>  // Grouping the resources into shards.
+
+//====================
+// Pegasus includes
+//====================
+#include <pegasus/core/resources.hpp>                        // Testing the Resources class.
+#include <pegasus/utilities/cooked_asset_writer.hpp>         // Writing the Resources files.
+#include <pegasus/utilities/binary_serializable_service.hpp> // Reading the Resources files.
+#include <pegasus/utilities/iserializable_service.hpp>       // Reading the Resources files on the calling thread.
+
+//====================
+// Library includes
+//====================
+#include <catch.hpp> // Unit test library.
+
+using namespace pegasus;
+
+namespace
+{
+	/**
+	 * @brief Reads the cooked files on the calling thread, as services that share state must.
+	 */
+	class SerialService final : public ISerializableService
+	{
+	private:
+		/** The service that reads the cooked files. */
+		BinarySerializableService m_service;
+
+	public:
+		/**********************************************************/
+		Expected<Asset*> deserialize(eAssetType type, const std::string& name) const override
+		{
+			return m_service.deserialize(type, name);
+		}
+
+		/**********************************************************/
+		std::unordered_map<std::string, Resource_t> deserializeResources(const std::string& filename) const override
+		{
+			return m_service.deserializeResources(filename);
+		}
+	};
+} // namespace
+
+//====================
+// Unit tests
+//====================
+/**********************************************************/
+TEST_CASE("Resources: Unknown names are reported without exceptions.", "[Resources]")
+{
+	// Arrange.
+	std::unordered_map<std::string, Resource_t> values;
+	values["asset.texture.basic"] = { "assets/textures/basic_texture.bin", eAssetType::TEXTURE };
+	REQUIRE(CookedAssetWriter::save("test_resources_lookup.bin", CookedAssetWriter::cookResources(values)));
+	BinarySerializableService service;
+	Resources resources;
+	resources.setService(service);
+	std::size_t generation = resources.getGeneration();
+	// Act.
+	resources.load("test_resources_lookup.bin");
+	std::remove("test_resources_lookup.bin");
+	auto found = resources.get("asset.texture.basic");
+	auto missing = resources.get("asset.texture.missing");
+	// Assert.
+	REQUIRE(resources.getGeneration() == generation + 1);
+	REQUIRE(found);
+	REQUIRE(found.getValue()->path == "assets/textures/basic_texture.bin");
+	REQUIRE_FALSE(missing);
+	REQUIRE(missing.getError().code == eErrorCode::NOT_FOUND);
+}
+
+/**********************************************************/
+TEST_CASE("Resources: List the names within a namespace.", "[Resources]")
+{
+	// Arrange.
+	std::unordered_map<std::string, Resource_t> values;
+	values["level3.texture.wall"] = { "assets/textures/wall.bin", eAssetType::TEXTURE };
+	values["level3.shader.water"] = { "assets/shaders/water.bin", eAssetType::SHADER };
+	values["level30.texture.sky"] = { "assets/textures/sky.bin", eAssetType::TEXTURE };
+	REQUIRE(CookedAssetWriter::save("test_resources_list.bin", CookedAssetWriter::cookResources(values)));
+	BinarySerializableService service;
+	Resources resources;
+	resources.setService(service);
+	// Act.
+	resources.load("test_resources_list.bin");
+	std::remove("test_resources_list.bin");
+	// Assert.
+	REQUIRE(resources.list("level3.") == std::vector<std::string>({ "level3.shader.water", "level3.texture.wall" }));
+	REQUIRE(resources.list("level3").size() == 3);
+	REQUIRE(resources.list("level4.").empty());
+}
+
+/**********************************************************/
+TEST_CASE("Resources: Instances load independent manifests.", "[Resources]")
+{
+	// Arrange.
+	std::unordered_map<std::string, Resource_t> first;
+	first["asset.texture.first"] = { "assets/textures/first.bin", eAssetType::TEXTURE };
+	std::unordered_map<std::string, Resource_t> second;
+	second["asset.texture.second"] = { "assets/textures/second.bin", eAssetType::TEXTURE };
+	REQUIRE(CookedAssetWriter::save("test_resources_first.bin", CookedAssetWriter::cookResources(first)));
+	REQUIRE(CookedAssetWriter::save("test_resources_second.bin", CookedAssetWriter::cookResources(second)));
+	BinarySerializableService service;
+	Resources firstResources;
+	Resources secondResources;
+	firstResources.setService(service);
+	secondResources.setService(service);
+	// Act.
+	firstResources.load("test_resources_first.bin");
+	secondResources.load("test_resources_second.bin");
+	std::remove("test_resources_first.bin");
+	std::remove("test_resources_second.bin");
+	// Assert.
+	REQUIRE(firstResources.get("asset.texture.first"));
+	REQUIRE_FALSE(firstResources.get("asset.texture.second"));
+	REQUIRE(secondResources.get("asset.texture.second"));
+	REQUIRE_FALSE(secondResources.get("asset.texture.first"));
+	REQUIRE(firstResources.getGeneration() == 1);
+	REQUIRE(secondResources.getGeneration() == 1);
+}
+
+/**********************************************************/
+TEST_CASE("Resources: Listing a namespace only loads the shards holding it.", "[Resources]")
+{
+	// Arrange.
+	const std::size_t count = 16;
+	std::vector<std::string> names = { "level3.texture.wall", "level3.shader.water", "level30.texture.sky" };
+	for (std::size_t i = 0; i < 32; i++)
+	{
+		names.push_back("asset.texture.generated_" + std::to_string(i));
+	}
+	std::vector<std::unordered_map<std::string, Resource_t>> shards(count);
+	for (auto& name : names)
+	{
+		shards[Resources::getShardIndex(name, count)][name] = { "assets/textures/" + name + ".bin", eAssetType::TEXTURE };
+	}
+	REQUIRE(CookedAssetWriter::save("test_resources_sharded.bin", CookedAssetWriter::cookResources(Resources::getDirectory(names, count))));
+	for (std::size_t i = 0; i < count; i++)
+	{
+		REQUIRE(CookedAssetWriter::save(Resources::getShardFilename("test_resources_sharded.bin", i), CookedAssetWriter::cookResources(shards[i])));
+	}
+	BinarySerializableService service;
+	Resources resources;
+	resources.setService(service);
+	resources.setShardCount(count);
+	// Act.
+	resources.load("test_resources_sharded.bin");
+	std::vector<std::string> listed = resources.list("level3.");
+	std::vector<bool> loaded;
+	for (std::size_t i = 0; i < count; i++)
+	{
+		loaded.push_back(resources.isShardLoaded(i));
+	}
+	std::vector<std::string> partial = resources.list("level3");
+	std::remove("test_resources_sharded.bin");
+	for (std::size_t i = 0; i < count; i++)
+	{
+		std::remove(Resources::getShardFilename("test_resources_sharded.bin", i).c_str());
+	}
+	// Assert.
+	REQUIRE(listed == std::vector<std::string>({ "level3.shader.water", "level3.texture.wall" }));
+	REQUIRE(partial.size() == 3);
+	for (std::size_t i = 0; i < count; i++)
+	{
+		bool holdsNamespace = i == Resources::getShardIndex("level3.texture.wall", count) || i == Resources::getShardIndex("level3.shader.water", count);
+		REQUIRE(loaded[i] == holdsNamespace);
+	}
+}
+
+/**********************************************************/
+TEST_CASE("Resources: The directory lists the shards of each namespace once.", "[Resources]")
+{
+	// Arrange.
+	std::vector<std::string> names = { "level3.texture.wall", "level3.texture.floor", "root" };
+	// Act.
+	auto directory = Resources::getDirectory(names, 1);
+	// Assert.
+	REQUIRE(directory.size() == 2);
+	REQUIRE(directory["level3.texture."].path == "0");
+	REQUIRE(directory["level3.texture."].type == eAssetType::DIRECTORY);
+	REQUIRE(directory[""].path == "0");
+}
+
+/**********************************************************/
+TEST_CASE("Resources: Shards that fail to prefetch are reported when requested.", "[Resources]")
+{
+	// Arrange.
+	const std::size_t count = 4;
+	std::vector<std::string> names = { "asset.texture.missing" };
+	REQUIRE(CookedAssetWriter::save("test_resources_prefetch.bin", CookedAssetWriter::cookResources(Resources::getDirectory(names, count))));
+	SerialService service;
+	Resources resources;
+	resources.setService(service);
+	resources.setShardCount(count);
+	resources.load("test_resources_prefetch.bin");
+	std::remove("test_resources_prefetch.bin");
+	// Act.
+	REQUIRE_NOTHROW(resources.prefetch("asset.texture.missing"));
+	auto missing = resources.get("asset.texture.missing");
+	// Assert.
+	REQUIRE_FALSE(resources.isShardLoaded(Resources::getShardIndex("asset.texture.missing", count)));
+	REQUIRE_FALSE(missing);
+	REQUIRE(missing.getError().code == eErrorCode::NOT_FOUND);
+}
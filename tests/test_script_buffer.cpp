@@ -0,0 +1,120 @@
+/*
+* Pegasus Engine
+* 2017 - Benjamin Carter (bencarterdev@outlook.com)
+*
+* This software is provided 'as-is', without any express or implied warranty.
+* In no event will the authors be held liable for any damages arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it freely,
+* subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented;
+*    you must not claim that you wrote the original software.
+*    If you use this software in a product, an acknowledgement
+*    in the product documentation would be appreciated but is not required.
+*
+* 2. Altered source versions must be plainly marked as such,
+*    and must not be misrepresented as being the original software.
+*
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+//====================
+// C++ includes
+//====================
+#include <stdexcept> // Catching invalid layouts and indices.
+
+//====================
+// Pegasus includes
+//====================
+#include <pegasus/scripting/script_buffer.hpp> // Testing the ScriptBuffer class.
+
+//====================
+// Library includes
+//====================
+#include <catch.hpp> // Unit test library.
+
+using namespace pegasus;
+
+//====================
+// Unit tests
+//====================
+/**********************************************************/
+TEST_CASE("ScriptBuffer: Values are packed by element and component.", "[ScriptBuffer]")
+{
+	// Arrange.
+	ScriptBuffer buffer(4, 2);
+	// Act.
+	buffer.set(2, 1, 5.0f);
+	// Assert.
+	REQUIRE(buffer.getCount() == 4);
+	REQUIRE(buffer.getComponents() == 2);
+	REQUIRE(buffer.get(2, 1) == Approx(5.0f));
+	REQUIRE(buffer.getData()[5] == Approx(5.0f));
+	REQUIRE_THROWS_AS(buffer.get(4, 0), std::out_of_range);
+	REQUIRE_THROWS_AS(buffer.get(0, 2), std::out_of_range);
+}
+
+/**********************************************************/
+TEST_CASE("ScriptBuffer: Scaled buffers are added in a single call.", "[ScriptBuffer]")
+{
+	// Arrange.
+	ScriptBuffer positions(1000, 2);
+	ScriptBuffer velocities(1000, 2);
+	positions.fill(1.0f);
+	velocities.fill(2.0f);
+	// Act.
+	positions.add(velocities, 0.5f);
+	positions.scale(3.0f);
+	// Assert.
+	REQUIRE(positions.get(0, 0) == Approx(6.0f));
+	REQUIRE(positions.get(999, 1) == Approx(6.0f));
+}
+
+/**********************************************************/
+TEST_CASE("ScriptBuffer: Buffers with different layouts cannot be combined.", "[ScriptBuffer]")
+{
+	// Arrange.
+	ScriptBuffer positions(10, 2);
+	ScriptBuffer identifiers(20, 1);
+	// Assert.
+	REQUIRE_THROWS_AS(positions.add(identifiers, 1.0f), std::invalid_argument);
+	REQUIRE_THROWS_AS(positions.copy(identifiers), std::invalid_argument);
+}
+
+/**********************************************************/
+TEST_CASE("ScriptBuffer: Resizing keeps the existing values.", "[ScriptBuffer]")
+{
+	// Arrange.
+	ScriptBuffer buffer(2, 3);
+	buffer.fill(7.0f);
+	// Act.
+	buffer.resize(4);
+	// Assert.
+	REQUIRE(buffer.getCount() == 4);
+	REQUIRE(buffer.get(1, 2) == Approx(7.0f));
+	REQUIRE(buffer.get(3, 2) == Approx(0.0f));
+}
+
+/**********************************************************/
+TEST_CASE("ScriptBuffer: Scripts process whole buffers and index from one.", "[ScriptBuffer]")
+{
+	// Arrange.
+	sol::state lua;
+	lua.open_libraries(sol::lib::base);
+	ScriptBuffer::bind(lua);
+	// Act.
+	lua.script(
+		"positions = ScriptBuffer.new(3, 2)\n"
+		"velocities = ScriptBuffer.new(3, 2)\n"
+		"velocities:from_table({ 1, 2, 3, 4, 5, 6 })\n"
+		"positions:add(velocities, 2)\n"
+		"first = positions:get(1, 2)\n"
+		"values = positions:to_table()\n");
+	ScriptBuffer& positions = lua.get<ScriptBuffer&>("positions");
+	// Assert.
+	REQUIRE(positions.get(2, 1) == Approx(12.0f));
+	REQUIRE(lua.get<float>("first") == Approx(4.0f));
+	REQUIRE(lua.script("return #values").get<int>() == 6);
+}
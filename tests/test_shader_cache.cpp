@@ -0,0 +1,210 @@
+/*
+* Pegasus Engine
+* 2017 - Benjamin Carter (bencarterdev@outlook.com)
+*
+* This software is provided 'as-is', without any express or implied warranty.
+* In no event will the authors be held liable for any damages arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it freely,
+* subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented;
+*    you must not claim that you wrote the original software.
+*    If you use this software in a product, an acknowledgement
+*    in the product documentation would be appreciated but is not required.
+*
+* 2. Altered source versions must be plainly marked as such,
+*    and must not be misrepresented as being the original software.
+*
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+//====================
+// C++ includes
+//====================
+#include <cstdio>  // Removing the generated shader.
+#include <fstream> // Writing the generated shader.
+#include <string>  // The sources of the shaders.
+#include <thread>  // Checking that each thread has its own cache.
+
+//====================
+// Pegasus includes
+//====================
+#include <pegasus/graphics/shader_cache.hpp> // Testing the ShaderCache class.
+
+//====================
+// Library includes
+//====================
+#include <catch.hpp> // Unit test library.
+
+using namespace pegasus;
+
+namespace
+{
+	//====================
+	// Variables
+	//====================
+	/** The file location of the generated shader. */
+	const char* SHADER_FILE = "test_shader_cache.glsl";
+	/** The source of the shaders. */
+	const std::string SOURCE = "#version 330 core\nvoid main() {}\n";
+
+	//====================
+	// Functions
+	//====================
+	/**********************************************************/
+	void writeShader(const std::string& source)
+	{
+		std::ofstream file(SHADER_FILE, std::ios::out | std::ios::trunc);
+		file << source;
+	}
+} // namespace
+
+//====================
+// Unit tests
+//====================
+/**********************************************************/
+TEST_CASE("ShaderCache: Identical shaders are shared.", "[ShaderCache]")
+{
+	// Arrange.
+	ShaderCache& cache = ShaderCache::getInstance();
+	std::size_t stages = cache.getStageCount();
+	std::size_t hits = cache.getHitCount();
+	std::size_t misses = cache.getMissCount();
+	// Act.
+	Shader* pFirst = cache.acquire(gl::eShaderType::VERTEX, SOURCE);
+	Shader* pSecond = cache.acquire(gl::eShaderType::VERTEX, SOURCE);
+	// Assert.
+	REQUIRE(pFirst == pSecond);
+	REQUIRE(pFirst->getSource() == SOURCE);
+	REQUIRE(cache.getStageCount() == stages + 1);
+	REQUIRE(cache.getHitCount() == hits + 1);
+	REQUIRE(cache.getMissCount() == misses + 1);
+	cache.release(pFirst);
+	cache.release(pSecond);
+}
+
+/**********************************************************/
+TEST_CASE("ShaderCache: Shaders of different types are not shared.", "[ShaderCache]")
+{
+	// Arrange.
+	ShaderCache& cache = ShaderCache::getInstance();
+	std::size_t stages = cache.getStageCount();
+	// Act.
+	Shader* pVertex = cache.acquire(gl::eShaderType::VERTEX, SOURCE);
+	Shader* pFragment = cache.acquire(gl::eShaderType::FRAGMENT, SOURCE);
+	// Assert.
+	REQUIRE(pVertex != pFragment);
+	REQUIRE(cache.getStageCount() == stages + 2);
+	cache.release(pVertex);
+	cache.release(pFragment);
+}
+
+/**********************************************************/
+TEST_CASE("ShaderCache: Shaders are kept until the last reference is released.", "[ShaderCache]")
+{
+	// Arrange.
+	ShaderCache& cache = ShaderCache::getInstance();
+	std::size_t stages = cache.getStageCount();
+	Shader* pFirst = cache.acquire(gl::eShaderType::VERTEX, SOURCE);
+	Shader* pSecond = cache.acquire(gl::eShaderType::VERTEX, SOURCE);
+	// Act.
+	cache.release(pFirst);
+	std::size_t referenced = cache.getStageCount();
+	cache.release(pSecond);
+	// Assert.
+	REQUIRE(referenced == stages + 1);
+	REQUIRE(cache.getStageCount() == stages);
+}
+
+/**********************************************************/
+TEST_CASE("ShaderCache: Shaders that are not shared are not released.", "[ShaderCache]")
+{
+	// Arrange.
+	ShaderCache& cache = ShaderCache::getInstance();
+	std::size_t stages = cache.getStageCount();
+	Shader* pShader = cache.acquire(gl::eShaderType::VERTEX, SOURCE);
+	Shader other;
+	other.loadFromSource(gl::eShaderType::VERTEX, SOURCE);
+	// Act.
+	cache.release(&other);
+	cache.release(nullptr);
+	// Assert.
+	REQUIRE(cache.getStageCount() == stages + 1);
+	cache.release(pShader);
+	REQUIRE(cache.getStageCount() == stages);
+}
+
+/**********************************************************/
+TEST_CASE("ShaderCache: Loading a file twice shares the shader.", "[ShaderCache]")
+{
+	// Arrange.
+	ShaderCache& cache = ShaderCache::getInstance();
+	writeShader(SOURCE);
+	// Act.
+	Shader* pFirst = cache.load(gl::eShaderType::VERTEX, SHADER_FILE);
+	Shader* pSecond = cache.load(gl::eShaderType::VERTEX, SHADER_FILE);
+	// Assert.
+	REQUIRE(pFirst != nullptr);
+	REQUIRE(pFirst == pSecond);
+	cache.release(pFirst);
+	cache.release(pSecond);
+	std::remove(SHADER_FILE);
+}
+
+/**********************************************************/
+TEST_CASE("ShaderCache: Loading a changed file creates a new shader.", "[ShaderCache]")
+{
+	// Arrange.
+	ShaderCache& cache = ShaderCache::getInstance();
+	writeShader(SOURCE);
+	Shader* pFirst = cache.load(gl::eShaderType::VERTEX, SHADER_FILE);
+	// Act.
+	writeShader(SOURCE + "// Changed.\n");
+	Shader* pSecond = cache.load(gl::eShaderType::VERTEX, SHADER_FILE);
+	// Assert.
+	REQUIRE(pFirst != pSecond);
+	REQUIRE(pSecond->getSource() != pFirst->getSource());
+	cache.release(pFirst);
+	cache.release(pSecond);
+	std::remove(SHADER_FILE);
+}
+
+/**********************************************************/
+TEST_CASE("ShaderCache: Missing files are not loaded.", "[ShaderCache]")
+{
+	// Arrange.
+	ShaderCache& cache = ShaderCache::getInstance();
+	std::size_t stages = cache.getStageCount();
+	// Act.
+	Shader* pShader = cache.load(gl::eShaderType::VERTEX, "missing_shader.glsl");
+	// Assert.
+	REQUIRE(pShader == nullptr);
+	REQUIRE(cache.getStageCount() == stages);
+}
+
+/**********************************************************/
+TEST_CASE("ShaderCache: Each thread has its own cache.", "[ShaderCache]")
+{
+	// Arrange.
+	ShaderCache& cache = ShaderCache::getInstance();
+	Shader* pShader = cache.acquire(gl::eShaderType::VERTEX, SOURCE);
+	ShaderCache* pOther = nullptr;
+	Shader* pOtherShader = nullptr;
+	std::size_t otherHits = 1;
+	// Act.
+	std::thread thread([&]() {
+		// The shader would belong to the context of another thread.
+		pOther = &ShaderCache::getInstance();
+		pOtherShader = pOther->acquire(gl::eShaderType::VERTEX, SOURCE);
+		otherHits = pOther->getHitCount();
+		pOther->release(pOtherShader);
+	});
+	thread.join();
+	// Assert.
+	REQUIRE(pOther != &cache);
+	REQUIRE(pOtherShader != pShader);
+	REQUIRE(otherHits == 0);
+	cache.release(pShader);
+}
@@ -0,0 +1,260 @@
+/*
+* Pegasus Engine
+* 2017 - Benjamin Carter (bencarterdev@outlook.com)
+*
+* This software is provided 'as-is', without any express or implied warranty.
+* In no event will the authors be held liable for any damages arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it freely,
+* subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented;
+*    you must not claim that you wrote the original software.
+*    If you use this software in a product, an acknowledgement
+*    in the product documentation would be appreciated but is not required.
+*
+* 2. Altered source versions must be plainly marked as such,
+*    and must not be misrepresented as being the original software.
+*
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+//====================
+// C++ includes
+//====================
+#include <set>    // The programs the driver has completed.
+#include <thread> // Checking that each thread has its own compiler.
+
+//====================
+// Pegasus includes
+//====================
+#include <pegasus/graphics/shader_compiler.hpp> // Testing the ShaderCompiler class.
+#include <pegasus/graphics/shader_program.hpp>  // The programs submitted to the compiler.
+
+//====================
+// Library includes
+//====================
+#include <catch.hpp> // Unit test library.
+
+using namespace pegasus;
+
+namespace
+{
+	//====================
+	// Variables
+	//====================
+	/** The ID given to the next program that is created. */
+	GLuint nextProgram = 1;
+	/** The programs whose compilation the driver reports as complete. */
+	std::set<GLuint> completed;
+	/** The amount of times the driver was queried for the completion status. */
+	std::size_t completionQueries = 0;
+	/** The amount of times the driver was given its compiler threads. */
+	std::size_t threadCalls = 0;
+
+	//====================
+	// Functions
+	//====================
+	/**********************************************************/
+	GLuint GLAPIENTRY createProgram()
+	{
+		return nextProgram++;
+	}
+
+	/**********************************************************/
+	void GLAPIENTRY linkProgram(GLuint)
+	{
+		// Empty.
+	}
+
+	/**********************************************************/
+	void GLAPIENTRY getProgramiv(GLuint ID, GLenum name, GLint* pValue)
+	{
+		switch (name)
+		{
+		case GL_COMPLETION_STATUS_KHR:
+			completionQueries++;
+			*pValue = completed.count(ID) != 0 ? GL_TRUE : GL_FALSE;
+			break;
+
+		case GL_LINK_STATUS:
+			*pValue = GL_TRUE;
+			break;
+
+		default:
+			*pValue = 0;
+			break;
+		}
+	}
+
+	/**********************************************************/
+	GLuint GLAPIENTRY getUniformBlockIndex(GLuint, const GLchar*)
+	{
+		return GL_INVALID_INDEX;
+	}
+
+	/**********************************************************/
+	void GLAPIENTRY maxShaderCompilerThreads(GLuint)
+	{
+		threadCalls++;
+	}
+
+	/**********************************************************/
+	ShaderCompiler& getCompiler(GLboolean khr, GLboolean arb)
+	{
+		// There is no context within the tests, so the driver reports what each test asks of it.
+		__glewCreateProgram = &createProgram;
+		__glewLinkProgram = &linkProgram;
+		__glewGetProgramiv = &getProgramiv;
+		__glewGetUniformBlockIndex = &getUniformBlockIndex;
+		__glewMaxShaderCompilerThreadsKHR = &maxShaderCompilerThreads;
+		__glewMaxShaderCompilerThreadsARB = &maxShaderCompilerThreads;
+		__GLEW_KHR_parallel_shader_compile = khr;
+		__GLEW_ARB_parallel_shader_compile = arb;
+		completed.clear();
+		completionQueries = 0;
+		threadCalls = 0;
+
+		ShaderCompiler& compiler = ShaderCompiler::getInstance();
+		compiler.invalidate();
+
+		return compiler;
+	}
+} // namespace
+
+//====================
+// Unit tests
+//====================
+/**********************************************************/
+TEST_CASE("ShaderCompiler: The driver is queried once.", "[ShaderCompiler]")
+{
+	// Arrange.
+	ShaderCompiler& compiler = getCompiler(GL_TRUE, GL_FALSE);
+	// Act.
+	bool parallel = compiler.isParallel();
+	compiler.isParallel();
+	// Assert.
+	REQUIRE(parallel);
+	REQUIRE(threadCalls == 1);
+}
+
+/**********************************************************/
+TEST_CASE("ShaderCompiler: Invalidating the compiler queries the driver again.", "[ShaderCompiler]")
+{
+	// Arrange.
+	ShaderCompiler& compiler = getCompiler(GL_FALSE, GL_TRUE);
+	compiler.isParallel();
+	// Act.
+	__GLEW_ARB_parallel_shader_compile = GL_FALSE;
+	compiler.invalidate();
+	bool parallel = compiler.isParallel();
+	// Assert.
+	REQUIRE_FALSE(parallel);
+	REQUIRE(threadCalls == 1);
+}
+
+/**********************************************************/
+TEST_CASE("ShaderCompiler: Submitted programs are pending until they are polled.", "[ShaderCompiler]")
+{
+	// Arrange.
+	ShaderCompiler& compiler = getCompiler(GL_TRUE, GL_FALSE);
+	ShaderProgram program;
+	// Act.
+	compiler.submit(program);
+	// Assert.
+	REQUIRE(compiler.getPendingCount() == 1);
+	REQUIRE(program.isPending());
+	REQUIRE_FALSE(program.isCompiled());
+}
+
+/**********************************************************/
+TEST_CASE("ShaderCompiler: Polling only finishes the programs the driver has completed.", "[ShaderCompiler]")
+{
+	// Arrange.
+	ShaderCompiler& compiler = getCompiler(GL_TRUE, GL_FALSE);
+	ShaderProgram first;
+	ShaderProgram second;
+	compiler.submit(first);
+	compiler.submit(second);
+	completed.insert(second.getID());
+	// Act.
+	std::size_t pending = compiler.poll();
+	// Assert.
+	REQUIRE(pending == 1);
+	REQUIRE(first.isPending());
+	REQUIRE(second.isCompiled());
+	REQUIRE(completionQueries == 2);
+}
+
+/**********************************************************/
+TEST_CASE("ShaderCompiler: Polling without parallel compilation finishes every program.", "[ShaderCompiler]")
+{
+	// Arrange.
+	ShaderCompiler& compiler = getCompiler(GL_FALSE, GL_FALSE);
+	ShaderProgram first;
+	ShaderProgram second;
+	compiler.submit(first);
+	compiler.submit(second);
+	// Act.
+	std::size_t pending = compiler.poll();
+	// Assert.
+	REQUIRE(pending == 0);
+	REQUIRE(first.isCompiled());
+	REQUIRE(second.isCompiled());
+	REQUIRE(completionQueries == 0);
+	REQUIRE(threadCalls == 0);
+}
+
+/**********************************************************/
+TEST_CASE("ShaderCompiler: Finishing waits for every pending program.", "[ShaderCompiler]")
+{
+	// Arrange.
+	ShaderCompiler& compiler = getCompiler(GL_TRUE, GL_FALSE);
+	ShaderProgram first;
+	ShaderProgram second;
+	compiler.submit(first);
+	compiler.submit(second);
+	// Act.
+	compiler.finish();
+	// Assert.
+	REQUIRE(compiler.getPendingCount() == 0);
+	REQUIRE(first.isCompiled());
+	REQUIRE(second.isCompiled());
+	REQUIRE(completionQueries == 0);
+}
+
+/**********************************************************/
+TEST_CASE("ShaderCompiler: Deleted programs are no longer pending.", "[ShaderCompiler]")
+{
+	// Arrange.
+	ShaderCompiler& compiler = getCompiler(GL_TRUE, GL_FALSE);
+	ShaderProgram* pProgram = new ShaderProgram();
+	compiler.submit(*pProgram);
+	// Act.
+	delete pProgram;
+	// Assert.
+	REQUIRE(compiler.getPendingCount() == 0);
+	REQUIRE(compiler.poll() == 0);
+}
+
+/**********************************************************/
+TEST_CASE("ShaderCompiler: Each thread has its own compiler.", "[ShaderCompiler]")
+{
+	// Arrange.
+	ShaderCompiler& compiler = getCompiler(GL_TRUE, GL_FALSE);
+	ShaderProgram program;
+	compiler.submit(program);
+	ShaderCompiler* pOther = nullptr;
+	std::size_t otherPending = 1;
+	// Act.
+	std::thread thread([&]() {
+		pOther = &ShaderCompiler::getInstance();
+		otherPending = pOther->getPendingCount();
+	});
+	thread.join();
+	// Assert.
+	REQUIRE(pOther != &compiler);
+	REQUIRE(otherPending == 0);
+	REQUIRE(compiler.getPendingCount() == 1);
+}
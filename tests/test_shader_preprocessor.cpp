@@ -0,0 +1,135 @@
+/*
+* Pegasus Engine
+* 2017 - Benjamin Carter (bencarterdev@outlook.com)
+*
+* This software is provided 'as-is', without any express or implied warranty.
+* In no event will the authors be held liable for any damages arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it freely,
+* subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented;
+*    you must not claim that you wrote the original software.
+*    If you use this software in a product, an acknowledgement
+*    in the product documentation would be appreciated but is not required.
+*
+* 2. Altered source versions must be plainly marked as such,
+*    and must not be misrepresented as being the original software.
+*
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+//====================
+// C++ includes
+//====================
+#include <cstdio>  // Removing the generated shaders.
+#include <fstream> // Writing the generated shaders.
+#include <string>  // The shader sources.
+
+//====================
+// Pegasus includes
+//====================
+#include <pegasus/graphics/shader_preprocessor.hpp> // Testing the ShaderPreprocessor class.
+
+//====================
+// Library includes
+//====================
+#include <catch.hpp> // Unit test library.
+
+using namespace pegasus;
+
+namespace
+{
+	//====================
+	// Functions
+	//====================
+	/**********************************************************/
+	void writeShader(const std::string& filename, const std::string& source)
+	{
+		std::ofstream file(filename, std::ios::out | std::ios::trunc);
+		file << source;
+	}
+} // namespace
+
+//====================
+// Unit tests
+//====================
+/**********************************************************/
+TEST_CASE("ShaderPreprocessor: Includes are replaced by the included file.", "[ShaderPreprocessor]")
+{
+	// Arrange.
+	ShaderPreprocessor preprocessor;
+	writeShader("test_common.glsl", "float half_value(float v) { return v * 0.5; }\n");
+	writeShader("test_shader.glsl", "#version 330 core\n#include \"test_common.glsl\"\nvoid main() {}\n");
+	// Act.
+	auto source = preprocessor.process("test_shader.glsl");
+	// Assert.
+	REQUIRE(source);
+	REQUIRE(source.getValue() == "#version 330 core\n#line 1 1\nfloat half_value(float v) { return v * 0.5; }\n#line 3 0\nvoid main() {}\n");
+	REQUIRE(preprocessor.getFiles().size() == 2);
+	REQUIRE(preprocessor.getFiles()[1] == "test_common.glsl");
+	// Clean up.
+	std::remove("test_common.glsl");
+	std::remove("test_shader.glsl");
+}
+
+/**********************************************************/
+TEST_CASE("ShaderPreprocessor: Files are included once.", "[ShaderPreprocessor]")
+{
+	// Arrange.
+	ShaderPreprocessor preprocessor;
+	writeShader("test_common.glsl", "#include \"test_shader.glsl\"\nconst float ONE = 1.0;\n");
+	writeShader("test_shader.glsl", "#version 330 core\n#include \"test_common.glsl\"\n  #  include \"test_common.glsl\"\n");
+	// Act.
+	auto source = preprocessor.process("test_shader.glsl");
+	// Assert.
+	REQUIRE(source);
+	REQUIRE(source.getValue() == "#version 330 core\n#line 1 1\n\nconst float ONE = 1.0;\n#line 3 0\n\n");
+	// Clean up.
+	std::remove("test_common.glsl");
+	std::remove("test_shader.glsl");
+}
+
+/**********************************************************/
+TEST_CASE("ShaderPreprocessor: Missing and malformed includes are errors.", "[ShaderPreprocessor]")
+{
+	// Arrange.
+	ShaderPreprocessor preprocessor;
+	writeShader("test_shader.glsl", "#version 330 core\n#include \"test_missing.glsl\"\n");
+	writeShader("test_malformed.glsl", "#version 330 core\n#include <test_missing.glsl>\n");
+	// Act.
+	auto missing = preprocessor.process("test_shader.glsl");
+	auto malformed = preprocessor.process("test_malformed.glsl");
+	// Assert.
+	REQUIRE_FALSE(missing);
+	REQUIRE(missing.getError().code == eErrorCode::NOT_FOUND);
+	REQUIRE_FALSE(malformed);
+	REQUIRE(malformed.getError().code == eErrorCode::INVALID_FORMAT);
+	// Clean up.
+	std::remove("test_shader.glsl");
+	std::remove("test_malformed.glsl");
+}
+
+/**********************************************************/
+TEST_CASE("ShaderPreprocessor: Defines are injected after the version directive.", "[ShaderPreprocessor]")
+{
+	// Arrange.
+	std::string source = "// Comment.\n#version 330 core\nvoid main() {}";
+	// Act.
+	std::string defined = ShaderPreprocessor::define(source, { "ALPHA_TEST", "SKINNED" });
+	// Assert.
+	REQUIRE(defined == "// Comment.\n#version 330 core\n#define ALPHA_TEST 1\n#define SKINNED 1\n#line 3 0\nvoid main() {}");
+	REQUIRE(ShaderPreprocessor::define(source, {}) == source);
+}
+
+/**********************************************************/
+TEST_CASE("ShaderPreprocessor: References must match whole identifiers.", "[ShaderPreprocessor]")
+{
+	// Arrange.
+	std::string source = "#ifdef ALPHA_TEST_SOFT\n#endif\n";
+	// Assert.
+	REQUIRE_FALSE(ShaderPreprocessor::isReferenced(source, "ALPHA_TEST"));
+	REQUIRE(ShaderPreprocessor::isReferenced(source, "ALPHA_TEST_SOFT"));
+	REQUIRE(ShaderPreprocessor::isReferenced("#if SKINNED", "SKINNED"));
+}
@@ -0,0 +1,235 @@
+/*
+* Pegasus Engine
+* 2017 - Benjamin Carter (bencarterdev@outlook.com)
+*
+* This software is provided 'as-is', without any express or implied warranty.
+* In no event will the authors be held liable for any damages arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it freely,
+* subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented;
+*    you must not claim that you wrote the original software.
+*    If you use this software in a product, an acknowledgement
+*    in the product documentation would be appreciated but is not required.
+*
+* 2. Altered source versions must be plainly marked as such,
+*    and must not be misrepresented as being the original software.
+*
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+//====================
+// C++ includes
+//====================
+#include <thread> // Checking that each thread has its own cache.
+
+//====================
+// Pegasus includes
+//====================
+#include <pegasus/graphics/state_cache.hpp> // Testing the StateCache class.
+
+//====================
+// Library includes
+//====================
+#include <catch.hpp> // Unit test library.
+
+using namespace pegasus;
+
+namespace
+{
+	//====================
+	// Variables
+	//====================
+	/** The amount of calls that reached the driver. */
+	std::size_t driverCalls = 0;
+
+	//====================
+	// Functions
+	//====================
+	/**********************************************************/
+	void GLAPIENTRY useProgram(GLuint)
+	{
+		driverCalls++;
+	}
+
+	/**********************************************************/
+	void GLAPIENTRY activeTexture(GLenum)
+	{
+		driverCalls++;
+	}
+
+	/**********************************************************/
+	void GLAPIENTRY bindBuffer(GLenum, GLuint)
+	{
+		driverCalls++;
+	}
+
+	/**********************************************************/
+	void GLAPIENTRY bindBufferBase(GLenum, GLuint, GLuint)
+	{
+		driverCalls++;
+	}
+
+	/**********************************************************/
+	void GLAPIENTRY bindVertexArray(GLuint)
+	{
+		driverCalls++;
+	}
+
+	/**********************************************************/
+	gl::StateCache& getCache()
+	{
+		// There is no context within the tests, so the calls that reach the driver are counted instead.
+		__glewUseProgram = &useProgram;
+		__glewActiveTexture = &activeTexture;
+		__glewBindBuffer = &bindBuffer;
+		__glewBindBufferBase = &bindBufferBase;
+		__glewBindVertexArray = &bindVertexArray;
+		driverCalls = 0;
+
+		gl::StateCache& cache = gl::StateCache::getInstance();
+		cache.invalidate();
+		cache.resetStatistics();
+
+		return cache;
+	}
+} // namespace
+
+//====================
+// Unit tests
+//====================
+/**********************************************************/
+TEST_CASE("StateCache: Redundant binds are skipped.", "[StateCache]")
+{
+	// Arrange.
+	gl::StateCache& cache = getCache();
+	// Act.
+	cache.useProgram(3);
+	cache.useProgram(3);
+	cache.useProgram(3);
+	// Assert.
+	REQUIRE(driverCalls == 1);
+	REQUIRE(cache.getIssuedCalls() == 1);
+	REQUIRE(cache.getSkippedCalls() == 2);
+}
+
+/**********************************************************/
+TEST_CASE("StateCache: Changed binds reach the driver.", "[StateCache]")
+{
+	// Arrange.
+	gl::StateCache& cache = getCache();
+	// Act.
+	cache.useProgram(1);
+	cache.useProgram(2);
+	cache.useProgram(1);
+	cache.activeTexture(0);
+	cache.activeTexture(4);
+	// Assert.
+	REQUIRE(driverCalls == 5);
+	REQUIRE(cache.getIssuedCalls() == 5);
+	REQUIRE(cache.getSkippedCalls() == 0);
+	REQUIRE(cache.getActiveTexture() == 4);
+}
+
+/**********************************************************/
+TEST_CASE("StateCache: Invalidated state reaches the driver again.", "[StateCache]")
+{
+	// Arrange.
+	gl::StateCache& cache = getCache();
+	cache.useProgram(1);
+	cache.bindBuffer(GL_ARRAY_BUFFER, 2);
+	// Act.
+	cache.invalidate();
+	cache.useProgram(1);
+	cache.bindBuffer(GL_ARRAY_BUFFER, 2);
+	// Assert.
+	REQUIRE(driverCalls == 4);
+	REQUIRE(cache.getSkippedCalls() == 0);
+}
+
+/**********************************************************/
+TEST_CASE("StateCache: Buffers are shadowed for each target.", "[StateCache]")
+{
+	// Arrange.
+	gl::StateCache& cache = getCache();
+	cache.bindBuffer(GL_ARRAY_BUFFER, 2);
+	cache.bindBuffer(GL_UNIFORM_BUFFER, 2);
+	// Act.
+	cache.bindBuffer(GL_ARRAY_BUFFER, 2);
+	cache.bindBuffer(GL_UNIFORM_BUFFER, 3);
+	// Assert.
+	REQUIRE(cache.getIssuedCalls() == 3);
+	REQUIRE(cache.getSkippedCalls() == 1);
+}
+
+/**********************************************************/
+TEST_CASE("StateCache: Indexed binds also bind the target.", "[StateCache]")
+{
+	// Arrange.
+	gl::StateCache& cache = getCache();
+	cache.bindBufferBase(GL_UNIFORM_BUFFER, 1, 7);
+	// Act.
+	cache.bindBufferBase(GL_UNIFORM_BUFFER, 1, 7);
+	cache.bindBufferBase(GL_UNIFORM_BUFFER, 2, 7);
+	cache.bindBuffer(GL_UNIFORM_BUFFER, 7);
+	// Assert.
+	REQUIRE(driverCalls == 2);
+	REQUIRE(cache.getSkippedCalls() == 2);
+}
+
+/**********************************************************/
+TEST_CASE("StateCache: Binding a vertex array forgets the element array buffer.", "[StateCache]")
+{
+	// Arrange.
+	gl::StateCache& cache = getCache();
+	cache.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 5);
+	// Act.
+	cache.bindVertexArray(1);
+	cache.bindVertexArray(1);
+	cache.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 5);
+	// Assert.
+	REQUIRE(driverCalls == 3);
+	REQUIRE(cache.getSkippedCalls() == 1);
+}
+
+/**********************************************************/
+TEST_CASE("StateCache: Deleted buffers are bound again.", "[StateCache]")
+{
+	// Arrange.
+	gl::StateCache& cache = getCache();
+	GLuint buffer = 4;
+	cache.bindBuffer(GL_ARRAY_BUFFER, buffer);
+	cache.bindBufferBase(GL_UNIFORM_BUFFER, 0, buffer);
+	// Act.
+	cache.forgetBuffers(&buffer, 1);
+	cache.bindBuffer(GL_ARRAY_BUFFER, 0);
+	cache.bindBuffer(GL_ARRAY_BUFFER, buffer);
+	cache.bindBufferBase(GL_UNIFORM_BUFFER, 0, buffer);
+	// Assert.
+	REQUIRE(driverCalls == 4);
+	REQUIRE(cache.getSkippedCalls() == 1);
+}
+
+/**********************************************************/
+TEST_CASE("StateCache: Each thread has its own cache.", "[StateCache]")
+{
+	// Arrange.
+	gl::StateCache& cache = getCache();
+	cache.useProgram(1);
+	gl::StateCache* pOther = nullptr;
+	std::size_t otherIssued = 0;
+	// Act.
+	std::thread thread([&]() {
+		pOther = &gl::StateCache::getInstance();
+		pOther->useProgram(1);
+		otherIssued = pOther->getIssuedCalls();
+	});
+	thread.join();
+	// Assert.
+	REQUIRE(pOther != &cache);
+	REQUIRE(otherIssued == 1);
+	REQUIRE(cache.getIssuedCalls() == 1);
+	REQUIRE(driverCalls == 2);
+}
@@ -0,0 +1,97 @@
+/*
+* Pegasus Engine
+* 2017 - Benjamin Carter (bencarterdev@outlook.com)
+*
+* This software is provided 'as-is', without any express or implied warranty.
+* In no event will the authors be held liable for any damages arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it freely,
+* subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented;
+*    you must not claim that you wrote the original software.
+*    If you use this software in a product, an acknowledgement
+*    in the product documentation would be appreciated but is not required.
+*
+* 2. Altered source versions must be plainly marked as such,
+*    and must not be misrepresented as being the original software.
+*
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+//====================
+// C++ includes
+//====================
+#include <cstddef> // The offsets of the test block.
+
+//====================
+// Pegasus includes
+//====================
+#include <pegasus/graphics/std140.hpp> // Testing the std140 layout checks.
+
+//====================
+// Library includes
+//====================
+#include <catch.hpp> // Unit test library.
+
+using namespace pegasus;
+
+namespace
+{
+	/** A block whose vec3 must be padded to a vec4, as the preceding float breaks its alignment. */
+	struct Misaligned_t
+	{
+		float     scale;
+		glm::vec3 direction;
+		float     padding[3];
+	};
+
+	/** The same block with explicit padding before the vec3. */
+	struct Padded_t
+	{
+		float     scale;
+		float     padding[3];
+		glm::vec3 direction;
+		float     intensity;
+	};
+} // namespace
+
+//====================
+// Unit tests
+//====================
+/**********************************************************/
+TEST_CASE("std140: Vectors are aligned to two or four components.", "[std140]")
+{
+	// Assert.
+	REQUIRE(std140::isAligned<float>(4));
+	REQUIRE(std140::isAligned<glm::vec2>(8));
+	REQUIRE_FALSE(std140::isAligned<glm::vec2>(4));
+	REQUIRE(std140::isAligned<glm::vec3>(16));
+	REQUIRE_FALSE(std140::isAligned<glm::vec3>(12));
+	REQUIRE_FALSE(std140::isAligned<glm::vec4>(8));
+	REQUIRE_FALSE(std140::isAligned<glm::mat4>(8));
+	// Array elements are always aligned to a vec4.
+	REQUIRE_FALSE(std140::isAligned<glm::vec4[4]>(8));
+	REQUIRE(std140::isAligned<glm::vec4[4]>(32));
+}
+
+/**********************************************************/
+TEST_CASE("std140: Members must be placed at a multiple of their alignment.", "[std140]")
+{
+	// Assert.
+	REQUIRE_FALSE(std140::isAligned<glm::vec3>(offsetof(Misaligned_t, direction)));
+	REQUIRE(std140::isAligned<glm::vec3>(offsetof(Padded_t, direction)));
+	// A float may follow a vec3 within the same vec4.
+	REQUIRE(std140::isAligned<float>(offsetof(Padded_t, intensity)));
+	REQUIRE(offsetof(Padded_t, intensity) == 28);
+}
+
+/**********************************************************/
+TEST_CASE("std140: Blocks must be padded to a multiple of a vec4.", "[std140]")
+{
+	// Assert.
+	REQUIRE(std140::isBlock<Padded_t>());
+	REQUIRE(std140::isBlock<glm::mat4>());
+	REQUIRE_FALSE(std140::isBlock<glm::vec3>());
+}
@@ -0,0 +1,176 @@
+/*
+* Pegasus Engine
+* 2017 - Benjamin Carter (bencarterdev@outlook.com)
+*
+* This software is provided 'as-is', without any express or implied warranty.
+* In no event will the authors be held liable for any damages arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it freely,
+* subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented;
+*    you must not claim that you wrote the original software.
+*    If you use this software in a product, an acknowledgement
+*    in the product documentation would be appreciated but is not required.
+*
+* 2. Altered source versions must be plainly marked as such,
+*    and must not be misrepresented as being the original software.
+*
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+//====================
+// C++ includes
+//====================
+#include <string> // The names of the awaited assets.
+
+//====================
+// Pegasus includes
+//====================
+#include <pegasus/scripting/task_scheduler.hpp> // Testing the TaskScheduler class.
+
+//====================
+// Library includes
+//====================
+#include <catch.hpp> // Unit test library.
+
+using namespace pegasus;
+
+//====================
+// Unit tests
+//====================
+/**********************************************************/
+TEST_CASE("TaskScheduler: Tasks waiting for frames are resumed after that many updates.", "[TaskScheduler]")
+{
+	// Arrange.
+	sol::state lua;
+	lua.open_libraries(sol::lib::base, sol::lib::coroutine);
+	TaskScheduler scheduler(lua);
+	lua.script("step = 0 spawn(function() step = 1 wait_frames(3) step = 2 end)");
+	// Act.
+	scheduler.update(0.0);
+	int waiting = lua["step"];
+	scheduler.update(0.0);
+	scheduler.update(0.0);
+	scheduler.update(0.0);
+	// Assert.
+	REQUIRE(waiting == 1);
+	REQUIRE(lua.get<int>("step") == 2);
+	REQUIRE(scheduler.getTaskCount() == 0);
+}
+
+/**********************************************************/
+TEST_CASE("TaskScheduler: Tasks waiting for time are resumed once it has elapsed.", "[TaskScheduler]")
+{
+	// Arrange.
+	sol::state lua;
+	lua.open_libraries(sol::lib::base, sol::lib::coroutine);
+	TaskScheduler scheduler(lua);
+	lua.script("done = false spawn(function() wait(1.0) done = true end)");
+	// Act.
+	scheduler.update(0.0);
+	scheduler.update(0.5);
+	bool early = lua["done"];
+	scheduler.update(0.5);
+	// Assert.
+	REQUIRE(!early);
+	REQUIRE(lua.get<bool>("done"));
+}
+
+/**********************************************************/
+TEST_CASE("TaskScheduler: Tasks awaiting assets are resumed once they are available.", "[TaskScheduler]")
+{
+	// Arrange.
+	sol::state lua;
+	lua.open_libraries(sol::lib::base, sol::lib::coroutine);
+	TaskScheduler scheduler(lua);
+	bool available = false;
+	std::string requested;
+	scheduler.setAssetResolver([&](const std::string& name) { requested = name; return available; });
+	lua.script("done = false spawn(function() await('asset.texture.basic') done = true end)");
+	// Act.
+	scheduler.update(0.0);
+	scheduler.update(0.0);
+	bool early = lua["done"];
+	available = true;
+	scheduler.update(0.0);
+	scheduler.update(0.0);
+	// Assert.
+	REQUIRE(!early);
+	REQUIRE(requested == "asset.texture.basic");
+	REQUIRE(lua.get<bool>("done"));
+}
+
+/**********************************************************/
+TEST_CASE("TaskScheduler: Tasks awaiting assets are resumed with the loaded asset.", "[TaskScheduler]")
+{
+	// Arrange.
+	sol::state lua;
+	lua.open_libraries(sol::lib::base, sol::lib::coroutine);
+	TaskScheduler scheduler(lua);
+	std::string loaded;
+	scheduler.setAssetResolver([](const std::string&) { return true; });
+	scheduler.setAssetLoader([&](const std::string& name) { loaded = name; return sol::make_object(lua, 42); });
+	lua.script("spawn(function() asset = await('asset.texture.basic') missing = await('asset.texture.missing') end)");
+	// Act.
+	scheduler.update(0.0);
+	scheduler.update(0.0);
+	scheduler.update(0.0);
+	// Assert.
+	REQUIRE(scheduler.getTaskCount() == 0);
+	REQUIRE(loaded == "asset.texture.missing");
+	REQUIRE(lua.get<int>("asset") == 42);
+	REQUIRE(lua.get<int>("missing") == 42);
+}
+
+/**********************************************************/
+TEST_CASE("TaskScheduler: Tasks awaiting assets without a loader are resumed with nil.", "[TaskScheduler]")
+{
+	// Arrange.
+	sol::state lua;
+	lua.open_libraries(sol::lib::base, sol::lib::coroutine);
+	TaskScheduler scheduler(lua);
+	lua.script("asset = true spawn(function() asset = await('asset.texture.basic') end)");
+	// Act.
+	scheduler.update(0.0);
+	scheduler.update(0.0);
+	// Assert.
+	REQUIRE(scheduler.getTaskCount() == 0);
+	REQUIRE(lua["asset"].get_type() == sol::type::lua_nil);
+}
+
+/**********************************************************/
+TEST_CASE("TaskScheduler: Cancelled tasks are never resumed.", "[TaskScheduler]")
+{
+	// Arrange.
+	sol::state lua;
+	lua.open_libraries(sol::lib::base, sol::lib::coroutine);
+	TaskScheduler scheduler(lua);
+	lua.script("done = false task = function() coroutine.yield() done = true end");
+	std::size_t id = scheduler.spawn(lua["task"]);
+	// Act.
+	scheduler.update(0.0);
+	scheduler.cancel(id);
+	scheduler.update(0.0);
+	// Assert.
+	REQUIRE(!lua.get<bool>("done"));
+	REQUIRE(scheduler.getTaskCount() == 0);
+}
+
+/**********************************************************/
+TEST_CASE("TaskScheduler: Failing tasks are reported and removed.", "[TaskScheduler]")
+{
+	// Arrange.
+	sol::state lua;
+	lua.open_libraries(sol::lib::base, sol::lib::coroutine);
+	TaskScheduler scheduler(lua);
+	std::string reported;
+	scheduler.setErrorHandler([&](const std::string& error) { reported = error; });
+	lua.script("spawn(function() error('task failed') end)");
+	// Act.
+	scheduler.update(0.0);
+	// Assert.
+	REQUIRE(reported.find("task failed") != std::string::npos);
+	REQUIRE(scheduler.getTaskCount() == 0);
+}
@@ -0,0 +1,57 @@
+/*
+* Pegasus Engine
+* 2017 - Benjamin Carter (bencarterdev@outlook.com)
+*
+* This software is provided 'as-is', without any express or implied warranty.
+* In no event will the authors be held liable for any damages arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it freely,
+* subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented;
+*    you must not claim that you wrote the original software.
+*    If you use this software in a product, an acknowledgement
+*    in the product documentation would be appreciated but is not required.
+*
+* 2. Altered source versions must be plainly marked as such,
+*    and must not be misrepresented as being the original software.
+*
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+//====================
+// Pegasus includes
+//====================
+#include <pegasus/utilities/type_id.hpp> // Testing the TypeID class.
+
+//====================
+// Library includes
+//====================
+#include <catch.hpp> // Unit test library.
+
+using namespace pegasus;
+
+namespace
+{
+	//====================
+	// Structures
+	//====================
+	struct First_t {};
+	struct Second_t {};
+} // namespace
+
+//====================
+// Unit tests
+//====================
+/**********************************************************/
+TEST_CASE("TypeID: Each type has a unique, constant identifier.", "[TypeID]")
+{
+	// Act.
+	std::size_t first = TypeID::get<First_t>();
+	std::size_t second = TypeID::get<Second_t>();
+	// Assert.
+	REQUIRE(first != second);
+	REQUIRE(TypeID::get<First_t>() == first);
+	REQUIRE(TypeID::get<Second_t>() == second);
+}
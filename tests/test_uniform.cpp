@@ -0,0 +1,314 @@
+/*
+* Pegasus Engine
+* 2017 - Benjamin Carter (bencarterdev@outlook.com)
+*
+* This software is provided 'as-is', without any express or implied warranty.
+* In no event will the authors be held liable for any damages arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it freely,
+* subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented;
+*    you must not claim that you wrote the original software.
+*    If you use this software in a product, an acknowledgement
+*    in the product documentation would be appreciated but is not required.
+*
+* 2. Altered source versions must be plainly marked as such,
+*    and must not be misrepresented as being the original software.
+*
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+//====================
+// C++ includes
+//====================
+#include <cstring> // Copying the names of the fake uniforms.
+#include <string>  // The names of the fake uniforms.
+#include <vector>  // The fake uniforms and the encoded values.
+
+//====================
+// Pegasus includes
+//====================
+#include <pegasus/graphics/uniform.hpp>     // Testing the Uniform class.
+#include <pegasus/graphics/state_cache.hpp> // Resetting the bound program.
+
+//====================
+// Library includes
+//====================
+#include <catch.hpp> // Unit test library.
+
+using namespace pegasus;
+
+namespace
+{
+	//====================
+	// Structures
+	//====================
+	/**
+	 * @brief An active uniform reported by the fake program.
+	 */
+	struct FakeUniform_t
+	{
+		/** The name reported by glGetActiveUniform. */
+		std::string        name;
+		/** The type of the uniform. */
+		GLenum             type;
+		/** The locations of each element, -1 within a uniform block. */
+		std::vector<GLint> locations;
+	};
+
+	//====================
+	// Variables
+	//====================
+	/** The active uniforms of the fake program, the elements of the array have scattered locations. */
+	const std::vector<FakeUniform_t> UNIFORMS = {
+		{ "u_colour", GL_FLOAT_VEC4, { 0 } },
+		{ "u_lights[0]", GL_FLOAT_VEC3, { 1, 5, 9, 13 } },
+		{ "u_block.member", GL_FLOAT, { -1 } },
+		{ "u_texture", GL_SAMPLER_2D, { 20 } }
+	};
+
+	/** The amount of values that reached the driver. */
+	std::size_t uploads = 0;
+	/** The location of the last uploaded value. */
+	GLint uploadLocation = -1;
+	/** The program bound by the last call that reached the driver. */
+	GLuint boundProgram = 0;
+	/** The amount of program binds that reached the driver. */
+	std::size_t binds = 0;
+
+	//====================
+	// Functions
+	//====================
+	/**********************************************************/
+	void GLAPIENTRY getProgramiv(GLuint, GLenum name, GLint* pValue)
+	{
+		*pValue = name == GL_ACTIVE_UNIFORMS ? static_cast<GLint>(UNIFORMS.size()) : 64;
+	}
+
+	/**********************************************************/
+	void GLAPIENTRY getActiveUniform(GLuint, GLuint index, GLsizei, GLsizei* pLength, GLint* pSize, GLenum* pType, GLchar* pName)
+	{
+		const FakeUniform_t& uniform = UNIFORMS[index];
+		std::strcpy(pName, uniform.name.c_str());
+		*pLength = static_cast<GLsizei>(uniform.name.size());
+		*pSize = static_cast<GLint>(uniform.locations.size());
+		*pType = uniform.type;
+	}
+
+	/**********************************************************/
+	GLint GLAPIENTRY getUniformLocation(GLuint, const GLchar* pName)
+	{
+		for (const FakeUniform_t& uniform : UNIFORMS)
+		{
+			std::string base = uniform.name.substr(0, uniform.name.find('['));
+			for (std::size_t element = 0; element < uniform.locations.size(); element++)
+			{
+				if (pName == uniform.name || pName == base + "[" + std::to_string(element) + "]")
+				{
+					return uniform.locations[pName == uniform.name ? 0 : element];
+				}
+			}
+		}
+
+		return -1;
+	}
+
+	/**********************************************************/
+	void GLAPIENTRY useProgram(GLuint program)
+	{
+		boundProgram = program;
+		binds++;
+	}
+
+	/**********************************************************/
+	void GLAPIENTRY uniform1i(GLint location, GLint)
+	{
+		uploadLocation = location;
+		uploads++;
+	}
+
+	/**********************************************************/
+	void GLAPIENTRY uniform1f(GLint location, GLfloat)
+	{
+		uploadLocation = location;
+		uploads++;
+	}
+
+	/**********************************************************/
+	void GLAPIENTRY uniform3f(GLint location, GLfloat, GLfloat, GLfloat)
+	{
+		uploadLocation = location;
+		uploads++;
+	}
+
+	/**********************************************************/
+	void GLAPIENTRY uniform4f(GLint location, GLfloat, GLfloat, GLfloat, GLfloat)
+	{
+		uploadLocation = location;
+		uploads++;
+	}
+
+	/**********************************************************/
+	void GLAPIENTRY uniform4i(GLint location, GLint, GLint, GLint, GLint)
+	{
+		uploadLocation = location;
+		uploads++;
+	}
+
+	/**********************************************************/
+	void GLAPIENTRY uniform4fv(GLint location, GLsizei, const GLfloat*)
+	{
+		uploadLocation = location;
+		uploads++;
+	}
+
+	/**********************************************************/
+	void reflect(Uniform& uniform)
+	{
+		// There is no context within the tests, so the fake program is reflected and the uploads are counted instead.
+		__glewGetProgramiv = &getProgramiv;
+		__glewGetActiveUniform = &getActiveUniform;
+		__glewGetUniformLocation = &getUniformLocation;
+		__glewUseProgram = &useProgram;
+		__glewUniform1i = &uniform1i;
+		__glewUniform1f = &uniform1f;
+		__glewUniform3f = &uniform3f;
+		__glewUniform4f = &uniform4f;
+		__glewUniform4i = &uniform4i;
+		__glewUniform4fv = &uniform4fv;
+		uploads = 0;
+		uploadLocation = -1;
+		boundProgram = 0;
+		binds = 0;
+		gl::StateCache::getInstance().invalidate();
+
+		uniform.setID(7);
+		uniform.reflect();
+	}
+} // namespace
+
+//====================
+// Unit tests
+//====================
+/**********************************************************/
+TEST_CASE("Uniform: Reflected uniforms are addressed by the hash of their names.", "[Uniform]")
+{
+	// Arrange.
+	Uniform uniform;
+	// Act.
+	reflect(uniform);
+	// Assert.
+	REQUIRE(uniform.getCount() == 3);
+	REQUIRE(uniform.getLocation(uniform.getHandle(Hash::fnv1a("u_colour"))) == 0);
+	REQUIRE(uniform.getLocation(uniform.getHandle("u_lights")) == 1);
+	REQUIRE(uniform.getType(uniform.getHandle("u_texture")) == GL_SAMPLER_2D);
+	REQUIRE(!uniform.getHandle("u_block.member").isValid());
+	REQUIRE(!uniform.getHandle("u_missing").isValid());
+	REQUIRE(uniform.getLocation(uniform.getHandle("u_missing")) == -1);
+}
+
+/**********************************************************/
+TEST_CASE("Uniform: Unchanged values are skipped.", "[Uniform]")
+{
+	// Arrange.
+	Uniform uniform;
+	reflect(uniform);
+	UniformHandle_t colour = uniform.getHandle("u_colour");
+	// Act.
+	uniform.set(colour, glm::vec4(1.0f));
+	uniform.set(colour, glm::vec4(1.0f));
+	std::size_t unchanged = uploads;
+	uniform.set(colour, glm::vec4(0.5f));
+	// Assert.
+	REQUIRE(unchanged == 1);
+	REQUIRE(uploads == 2);
+	REQUIRE(uploadLocation == 0);
+}
+
+/**********************************************************/
+TEST_CASE("Uniform: Changed values bind the program before they are uploaded.", "[Uniform]")
+{
+	// Arrange.
+	Uniform uniform;
+	reflect(uniform);
+	UniformHandle_t colour = uniform.getHandle("u_colour");
+	// Act.
+	uniform.set(colour, glm::vec4(1.0f));
+	uniform.set(colour, glm::vec4(0.5f));
+	uniform.set(uniform.getHandle("u_texture"), 3);
+	// Assert.
+	REQUIRE(uploads == 3);
+	REQUIRE(boundProgram == 7);
+	REQUIRE(binds == 1);
+}
+
+/**********************************************************/
+TEST_CASE("Uniform: Each element of an array is shadowed.", "[Uniform]")
+{
+	// Arrange.
+	Uniform uniform;
+	reflect(uniform);
+	UniformHandle_t lights = uniform.getHandle("u_lights");
+	// Act.
+	uniform.set(lights, 0, glm::vec3(1.0f));
+	uniform.set(lights, 2, glm::vec3(1.0f));
+	GLint location = uploadLocation;
+	uniform.set(lights, 0, glm::vec3(1.0f));
+	uniform.set(lights, 2, glm::vec3(1.0f));
+	uniform.set(lights, 4, glm::vec3(1.0f));
+	// Assert.
+	REQUIRE(location == 9);
+	REQUIRE(uploads == 2);
+}
+
+/**********************************************************/
+TEST_CASE("Uniform: Unchanged encoded values are skipped.", "[Uniform]")
+{
+	// Arrange.
+	Uniform uniform;
+	reflect(uniform);
+	UniformHandle_t colour = uniform.getHandle("u_colour");
+	std::vector<unsigned char> value;
+	bool encoded = uniform.encode(colour, { 1.0f, 0.0f, 0.0f, 1.0f }, value);
+	// Act.
+	uniform.setEncoded(colour, value.data());
+	uniform.setEncoded(colour, value.data());
+	uniform.set(colour, glm::vec4(1.0f, 0.0f, 0.0f, 1.0f));
+	// Assert.
+	REQUIRE(encoded);
+	REQUIRE(!uniform.encode(colour, { 1.0f }, value));
+	REQUIRE(uploads == 1);
+}
+
+/**********************************************************/
+TEST_CASE("Uniform: Reflecting the program again forgets the shadowed values.", "[Uniform]")
+{
+	// Arrange.
+	Uniform uniform;
+	reflect(uniform);
+	uniform.set(uniform.getHandle("u_colour"), glm::vec4(1.0f));
+	// Act.
+	uniform.reflect();
+	uniform.set(uniform.getHandle("u_colour"), glm::vec4(1.0f));
+	// Assert.
+	REQUIRE(uploads == 2);
+}
+
+/**********************************************************/
+TEST_CASE("Uniform: Values of another type are rejected.", "[Uniform]")
+{
+	// Arrange.
+	Uniform uniform;
+	reflect(uniform);
+	UniformHandle_t colour = uniform.getHandle("u_colour");
+	uniform.set(colour, glm::vec4(1.0f));
+	// Act.
+	uniform.set(colour, glm::ivec4(2));
+	uniform.set(uniform.getHandle("u_texture"), 3.0f);
+	uniform.set(colour, glm::vec4(1.0f));
+	// Assert.
+	REQUIRE(uploads == 1);
+	REQUIRE(uploadLocation == 0);
+}